@@ -0,0 +1,46 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    benchmark_timer.hpp
+//	Purpose: Timing helper shared by the geometry microbenchmarks.
+//============================================================================
+
+#ifndef __GEOMETRY_BENCHMARK_BENCHMARK_TIMER_HPP__
+#define __GEOMETRY_BENCHMARK_BENCHMARK_TIMER_HPP__
+
+#include <chrono>
+#include <cstdint>
+
+namespace cg
+{
+
+// Sink for benchmark results so the compiler cannot discard the work
+extern volatile float g_benchmark_sink;
+
+/**
+ * Runs a function several times and returns the fastest run.
+ * @param   runs  Number of timed runs.
+ * @param   fn    Function to time.
+ * @return  Returns the fastest run time in nanoseconds.
+ */
+template <typename F>
+double best_time_ns(uint32_t runs, F &&fn)
+{
+    double best = 0.0;
+    for(uint32_t r = 0; r < runs; r++)
+    {
+        auto   start = std::chrono::steady_clock::now();
+        fn();
+        auto   end = std::chrono::steady_clock::now();
+        double t = std::chrono::duration<double, std::nano>(end - start).count();
+        if(r == 0 || t < best) best = t;
+    }
+    return best;
+}
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,138 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr size_t   VERTEX_COUNTS[] = {10000, 1000000, 4000000};
+constexpr uint32_t RUNS = 5;
+
+// Serial scalar box: the straightforward loop
+AABB scalar_box(const std::vector<Point3> &points)
+{
+    AABB box;
+    for(const auto &p : points)
+    {
+        box.min_corner.x = std::min(box.min_corner.x, p.x);
+        box.min_corner.y = std::min(box.min_corner.y, p.y);
+        box.min_corner.z = std::min(box.min_corner.z, p.z);
+        box.max_corner.x = std::max(box.max_corner.x, p.x);
+        box.max_corner.y = std::max(box.max_corner.y, p.y);
+        box.max_corner.z = std::max(box.max_corner.z, p.z);
+    }
+    return box;
+}
+
+// Serial scalar Ritter sphere seeded from the extreme points along the axes
+BoundingSphere scalar_ritter(const std::vector<Point3> &points)
+{
+    size_t lo[3] = {0, 0, 0};
+    size_t hi[3] = {0, 0, 0};
+    for(size_t i = 0; i < points.size(); i++)
+    {
+        const float *p = &points[i].x;
+        for(int32_t k = 0; k < 3; k++)
+        {
+            if(p[k] < (&points[lo[k]].x)[k]) lo[k] = i;
+            if(p[k] > (&points[hi[k]].x)[k]) hi[k] = i;
+        }
+    }
+    int32_t best = 0;
+    float   best_d2 = -1.0f;
+    for(int32_t k = 0; k < 3; k++)
+    {
+        float d2 = (points[hi[k]] - points[lo[k]]).norm_squared();
+        if(d2 > best_d2)
+        {
+            best = k;
+            best_d2 = d2;
+        }
+    }
+    const Point3  &a = points[lo[best]];
+    const Point3  &b = points[hi[best]];
+    BoundingSphere s(Point3(0.5f * (a.x + b.x), 0.5f * (a.y + b.y), 0.5f * (a.z + b.z)),
+                     0.5f * std::sqrt(best_d2));
+    for(const auto &p : points)
+    {
+        Vector3 d = p - s.center;
+        float   d2 = d.norm_squared();
+        if(d2 <= s.radius * s.radius) continue;
+        float dist = std::sqrt(d2);
+        float radius = 0.5f * (s.radius + dist);
+        s.center = s.center + d * ((radius - s.radius) / dist);
+        s.radius = radius;
+    }
+    return s;
+}
+
+// Points of a randomly stretched and rotated ellipsoidal cloud
+std::vector<Point3> make_points(size_t count)
+{
+    std::vector<Point3> points(count);
+    for(auto &p : points)
+    {
+        float x = 4.0f * (rand_0_1() - 0.5f);
+        float y = 2.0f * (rand_0_1() - 0.5f);
+        float z = 1.0f * (rand_0_1() - 0.5f);
+        p = Point3(0.8f * x - 0.6f * y + 10.0f, 0.6f * x + 0.8f * y - 3.0f, z + 1.0f);
+    }
+    return points;
+}
+
+} // namespace
+
+void benchmark_bounds()
+{
+    logmsg("\nBounds of a vertex list (%u hardware threads, best of %u runs)",
+           std::max(std::thread::hardware_concurrency(), 1u),
+           RUNS);
+
+    for(size_t count : VERTEX_COUNTS)
+    {
+        std::vector<Point3> points = make_points(count);
+
+        AABB   expected = scalar_box(points);
+        AABB   box(points);
+        bool   match = box.min_corner == expected.min_corner &&
+                     box.max_corner == expected.max_corner;
+        double t0 = best_time_ns(RUNS,
+                                 [&]() { g_benchmark_sink = scalar_box(points).min_corner.x; });
+        double t1 = best_time_ns(RUNS, [&]() { g_benchmark_sink = AABB(points).min_corner.x; });
+        logmsg("  %8zu vertices  AABB    scalar %8.3f ms  SIMD/parallel %8.3f ms  speedup %5.1fx  "
+               "(%s)",
+               count,
+               t0 * 1.0e-6,
+               t1 * 1.0e-6,
+               t0 / t1,
+               match ? "match" : "MISMATCH");
+
+        BoundingSphere ritter = scalar_ritter(points);
+        BoundingSphere sphere(points);
+        float          worst = 0.0f;
+        for(const auto &p : points) worst = std::max(worst, (p - sphere.center).norm());
+        t0 = best_time_ns(RUNS, [&]() { g_benchmark_sink = scalar_ritter(points).radius; });
+        t1 = best_time_ns(RUNS, [&]() { g_benchmark_sink = BoundingSphere(points).radius; });
+        logmsg("  %8zu vertices  sphere  scalar %8.3f ms  SIMD/parallel %8.3f ms  speedup %5.1fx  "
+               "(radius %.4f vs Ritter %.4f, %s)",
+               count,
+               t0 * 1.0e-6,
+               t1 * 1.0e-6,
+               t0 / t1,
+               sphere.radius,
+               ritter.radius,
+               worst <= sphere.radius * 1.00001f ? "contains all" : "MISSES POINTS");
+    }
+}
+
+} // namespace cg
@@ -0,0 +1,142 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr size_t   OBJECT_COUNT = 100000;
+constexpr uint32_t RUNS = 20;
+
+// OpenGL perspective projection (same as gluPerspective with a 90 degree
+// field of view) looking down -z
+Matrix4x4 make_projection(float aspect, float near_z, float far_z)
+{
+    Matrix4x4 p;
+    p.m00() = 1.0f / aspect;
+    p.m11() = 1.0f;
+    p.m22() = -(far_z + near_z) / (far_z - near_z);
+    p.m23() = -2.0f * far_z * near_z / (far_z - near_z);
+    p.m32() = -1.0f;
+    p.m33() = 0.0f;
+    return p;
+}
+
+// Objects scattered around the camera, so most are outside the frustum
+Point3 random_center()
+{
+    float x = 400.0f * (rand_0_1() - 0.5f);
+    float y = 400.0f * (rand_0_1() - 0.5f);
+    float z = 400.0f * (rand_0_1() - 0.5f);
+    return Point3(x, y, z);
+}
+
+uint32_t count_visible(const std::vector<CullResult> &results)
+{
+    uint32_t visible = 0;
+    for(CullResult r : results) visible += (r != CullResult::OUTSIDE) ? 1 : 0;
+    return visible;
+}
+
+} // namespace
+
+void benchmark_frustum()
+{
+    logmsg("\nFrustum culling of %zu objects (best of %u runs)", OBJECT_COUNT, RUNS);
+
+    Matrix4x4 view;
+    view.rotate(30.0f, 0.0f, 1.0f, 0.0f);
+    Frustum frustum(make_projection(1.5f, 1.0f, 150.0f) * view);
+
+    std::vector<AABB>           boxes(OBJECT_COUNT);
+    std::vector<BoundingSphere> spheres(OBJECT_COUNT);
+    AABBTable                   box_table;
+    BoundingSphereTable         sphere_table;
+    for(size_t i = 0; i < OBJECT_COUNT; i++)
+    {
+        Point3 c = random_center();
+        float  e = 0.5f + 2.0f * rand_0_1();
+        boxes[i].min_corner = Point3(c.x - e, c.y - e, c.z - e);
+        boxes[i].max_corner = Point3(c.x + e, c.y + e, c.z + e);
+        spheres[i] = BoundingSphere(c, e);
+        box_table.push_back(boxes[i]);
+        sphere_table.push_back(spheres[i]);
+    }
+
+    std::vector<CullResult> scalar(OBJECT_COUNT), batch;
+    std::vector<uint8_t>    hints;
+
+    // Boxes
+    auto scalar_boxes = [&]()
+    {
+        for(size_t i = 0; i < OBJECT_COUNT; i++) scalar[i] = frustum.classify(boxes[i]);
+        g_benchmark_sink = static_cast<float>(scalar[0]);
+    };
+    double t0 = best_time_ns(RUNS, scalar_boxes);
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 frustum.classify(box_table, batch);
+                                 g_benchmark_sink = static_cast<float>(batch[0]);
+                             });
+    bool   match = batch == scalar;
+    frustum.classify(box_table, batch, &hints);
+    double t2 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 frustum.classify(box_table, batch, &hints);
+                                 g_benchmark_sink = static_cast<float>(batch[0]);
+                             });
+    match = match && batch == scalar;
+    logmsg("  boxes    scalar %7.3f ms  SoA %7.3f ms (%4.1fx)  SoA+hints %7.3f ms (%4.1fx)  "
+           "%u visible (%s)",
+           t0 * 1.0e-6,
+           t1 * 1.0e-6,
+           t0 / t1,
+           t2 * 1.0e-6,
+           t0 / t2,
+           count_visible(scalar),
+           match ? "match" : "MISMATCH");
+
+    // Spheres
+    auto scalar_spheres = [&]()
+    {
+        for(size_t i = 0; i < OBJECT_COUNT; i++) scalar[i] = frustum.classify(spheres[i]);
+        g_benchmark_sink = static_cast<float>(scalar[0]);
+    };
+    t0 = best_time_ns(RUNS, scalar_spheres);
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          frustum.classify(sphere_table, batch);
+                          g_benchmark_sink = static_cast<float>(batch[0]);
+                      });
+    match = batch == scalar;
+    hints.clear();
+    frustum.classify(sphere_table, batch, &hints);
+    t2 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          frustum.classify(sphere_table, batch, &hints);
+                          g_benchmark_sink = static_cast<float>(batch[0]);
+                      });
+    match = match && batch == scalar;
+    logmsg("  spheres  scalar %7.3f ms  SoA %7.3f ms (%4.1fx)  SoA+hints %7.3f ms (%4.1fx)  "
+           "%u visible (%s)",
+           t0 * 1.0e-6,
+           t1 * 1.0e-6,
+           t0 / t1,
+           t2 * 1.0e-6,
+           t0 / t2,
+           count_visible(scalar),
+           match ? "match" : "MISMATCH");
+}
+
+} // namespace cg
@@ -0,0 +1,143 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+// Out-of-line versions (reference_ops.cpp)
+namespace reference
+{
+float   dot(const Vector3 &v, const Vector3 &w);
+Vector3 scale(const Vector3 &v, float s);
+Point3  add(const Point3 &p, const Vector3 &v);
+Vector2 subtract(const Point2 &p, const Point2 &q);
+float   cross(const Vector2 &v, const Vector2 &w);
+float   m00(const Matrix4x4 &m);
+float   m11(const Matrix4x4 &m);
+float   m22(const Matrix4x4 &m);
+float   m33(const Matrix4x4 &m);
+} // namespace reference
+
+namespace
+{
+
+constexpr uint32_t ELEMENTS = 4096;
+constexpr uint32_t RUNS = 200;
+
+void report(const char *name, double out_of_line_ns, double inline_ns, uint32_t count)
+{
+    logmsg("  %-28s out-of-line %6.2f ns  inline %6.2f ns  speedup %5.2fx",
+           name,
+           out_of_line_ns / count,
+           inline_ns / count,
+           out_of_line_ns / inline_ns);
+}
+
+} // namespace
+
+void benchmark_inline_core()
+{
+    logmsg("Header-inline geometry core (%u elements, best of %u runs, ns per element)",
+           ELEMENTS,
+           RUNS);
+
+    std::vector<Vector3>   vectors(ELEMENTS);
+    std::vector<Point3>    points(ELEMENTS);
+    std::vector<Point2>    points2(ELEMENTS + 2);
+    std::vector<Matrix4x4> matrices(ELEMENTS);
+    for(uint32_t i = 0; i < ELEMENTS; i++)
+    {
+        vectors[i] = Vector3(rand_0_1(), rand_0_1(), rand_0_1());
+        points[i] = Point3(rand_0_1(), rand_0_1(), rand_0_1());
+        matrices[i] = Matrix4x4::translation(rand_0_1(), rand_0_1(), rand_0_1());
+        matrices[i].m00() = rand_0_1();
+    }
+    for(auto &p : points2) p = Point2(rand_0_1(), rand_0_1());
+
+    // Dot products
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 float sum = 0.0f;
+                                 for(uint32_t i = 0; i + 1 < ELEMENTS; i++)
+                                     sum += reference::dot(vectors[i], vectors[i + 1]);
+                                 g_benchmark_sink = sum;
+                             });
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 float sum = 0.0f;
+                                 for(uint32_t i = 0; i + 1 < ELEMENTS; i++)
+                                     sum += vectors[i].dot(vectors[i + 1]);
+                                 g_benchmark_sink = sum;
+                             });
+    report("Vector3::dot", t0, t1, ELEMENTS);
+
+    // Point advance: p = p + v * dt
+    std::vector<Point3> moved(ELEMENTS);
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < ELEMENTS; i++)
+                              moved[i] = reference::add(points[i],
+                                                        reference::scale(vectors[i], 0.016f));
+                          g_benchmark_sink = moved[ELEMENTS / 2].x;
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < ELEMENTS; i++)
+                              moved[i] = points[i] + vectors[i] * 0.016f;
+                          g_benchmark_sink = moved[ELEMENTS / 2].x;
+                      });
+    report("Point3 + Vector3 * s", t0, t1, ELEMENTS);
+
+    // 2D orientation tests: (b - a) x (c - a)
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          float sum = 0.0f;
+                          for(uint32_t i = 0; i < ELEMENTS; i++)
+                          {
+                              Vector2 ab = reference::subtract(points2[i + 1], points2[i]);
+                              Vector2 ac = reference::subtract(points2[i + 2], points2[i]);
+                              sum += reference::cross(ab, ac);
+                          }
+                          g_benchmark_sink = sum;
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          float sum = 0.0f;
+                          for(uint32_t i = 0; i < ELEMENTS; i++)
+                              sum += (points2[i + 1] - points2[i]).cross(points2[i + 2] - points2[i]);
+                          g_benchmark_sink = sum;
+                      });
+    report("Point2 orientation", t0, t1, ELEMENTS);
+
+    // Matrix element access
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          float sum = 0.0f;
+                          for(const auto &m : matrices)
+                              sum += reference::m00(m) + reference::m11(m) + reference::m22(m) +
+                                     reference::m33(m);
+                          g_benchmark_sink = sum;
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          float sum = 0.0f;
+                          for(const auto &m : matrices) sum += m.m00() + m.m11() + m.m22() + m.m33();
+                          g_benchmark_sink = sum;
+                      });
+    report("Matrix4x4::mNN() trace", t0, t1, ELEMENTS);
+}
+
+} // namespace cg
@@ -0,0 +1,113 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace reference
+{
+Matrix4x4 gauss_jordan_inverse(const Matrix4x4 &m);
+} // namespace reference
+
+namespace
+{
+
+constexpr uint32_t MATRICES = 1024;
+constexpr uint32_t RUNS = 200;
+
+// Largest difference from the identity of m * inverse
+float identity_error(const Matrix4x4 &m, const Matrix4x4 &inverse)
+{
+    Matrix4x4 p = m * inverse;
+    float     err = 0.0f;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++)
+            err = std::max(err, std::abs(p.m(r, c) - (r == c ? 1.0f : 0.0f)));
+    }
+    return err;
+}
+
+template <typename F>
+void time_inverse(const char *name, const std::vector<Matrix4x4> &src, double baseline_ns, F &&inv)
+{
+    std::vector<Matrix4x4> dst(src.size());
+    auto                   run = [&]()
+    {
+        for(size_t i = 0; i < src.size(); i++) dst[i] = inv(src[i]);
+        g_benchmark_sink = dst[src.size() / 2].m00();
+    };
+    double t = best_time_ns(RUNS, run);
+    float err = 0.0f;
+    for(size_t i = 0; i < src.size(); i++) err = std::max(err, identity_error(src[i], dst[i]));
+    logmsg("  %-28s %7.2f ns  %5.2fx  max |M*inv - I| %.2e",
+           name,
+           t / src.size(),
+           baseline_ns > 0.0 ? baseline_ns / t : 1.0,
+           err);
+}
+
+} // namespace
+
+void benchmark_inverse()
+{
+    logmsg("\nMatrix4x4 inverse (%u matrices, best of %u runs, ns per inverse)", MATRICES, RUNS);
+
+    // Rigid body matrices (rotation + translation). These are also affine
+    // and general so every path can be compared on the same input.
+    std::vector<Matrix4x4> rigid(MATRICES);
+    for(auto &m : rigid)
+    {
+        Vector3 axis(rand_0_1() - 0.5f, rand_0_1() - 0.5f, rand_0_1() - 0.5f);
+        axis.normalize();
+        float angle = rand_0_1() * 2.0f * PI;
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        float t = 1.0f - c;
+        m.m00() = t * axis.x * axis.x + c;
+        m.m01() = t * axis.x * axis.y - s * axis.z;
+        m.m02() = t * axis.x * axis.z + s * axis.y;
+        m.m10() = t * axis.x * axis.y + s * axis.z;
+        m.m11() = t * axis.y * axis.y + c;
+        m.m12() = t * axis.y * axis.z - s * axis.x;
+        m.m20() = t * axis.x * axis.z - s * axis.y;
+        m.m21() = t * axis.y * axis.z + s * axis.x;
+        m.m22() = t * axis.z * axis.z + c;
+        m.m03() = 10.0f * rand_0_1();
+        m.m13() = 10.0f * rand_0_1();
+        m.m23() = 10.0f * rand_0_1();
+    }
+
+    std::vector<Matrix4x4> baseline(MATRICES);
+    auto                   run_baseline = [&]()
+    {
+        for(uint32_t i = 0; i < MATRICES; i++)
+            baseline[i] = reference::gauss_jordan_inverse(rigid[i]);
+        g_benchmark_sink = baseline[MATRICES / 2].m00();
+    };
+    double t0 = best_time_ns(RUNS, run_baseline);
+
+    time_inverse("Gauss-Jordan (previous)",
+                 rigid,
+                 0.0,
+                 [](const Matrix4x4 &m) { return reference::gauss_jordan_inverse(m); });
+    time_inverse("get_inverse (cofactor)",
+                 rigid,
+                 t0,
+                 [](const Matrix4x4 &m) { return m.get_inverse(); });
+    time_inverse("get_affine_inverse",
+                 rigid,
+                 t0,
+                 [](const Matrix4x4 &m) { return m.get_affine_inverse(); });
+    time_inverse("get_rigid_inverse",
+                 rigid,
+                 t0,
+                 [](const Matrix4x4 &m) { return m.get_rigid_inverse(); });
+}
+
+} // namespace cg
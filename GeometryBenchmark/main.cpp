@@ -0,0 +1,80 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    GeometryBenchmark/main.cpp
+//	Purpose: Microbenchmarks for the geometry library. Results are written
+//           to the console and to GeometryBenchmark.log. Build in Release
+//           for meaningful timings.
+//============================================================================
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace cg
+{
+
+volatile float g_benchmark_sink = 0.0f;
+
+void benchmark_inline_core();
+void benchmark_inverse();
+void benchmark_vector_kernels();
+void benchmark_quaternion();
+void benchmark_matrix3x2();
+void benchmark_random();
+void benchmark_predicates();
+void benchmark_segment2_batch();
+void benchmark_segment2_grid();
+void benchmark_segment2_sweep();
+void benchmark_segment2_clip();
+void benchmark_mesh_bvh();
+void benchmark_ray_packet();
+void benchmark_bounds();
+void benchmark_frustum();
+
+// Simple logging function
+void logmsg(const char *message, ...)
+{
+    // Open file if not already opened
+    static FILE *lfile = NULL;
+    if(lfile == NULL) { lfile = fopen("GeometryBenchmark.log", "w"); }
+
+    va_list arg;
+    va_start(arg, message);
+    vprintf(message, arg);
+    putchar('\n');
+    va_end(arg);
+
+    va_start(arg, message);
+    vfprintf(lfile, message, arg);
+    putc('\n', lfile);
+    fflush(lfile);
+    va_end(arg);
+}
+
+} // namespace cg
+
+/**
+ * Main method. Entry point for application.
+ */
+int main(int argc, char *argv[])
+{
+    cg::benchmark_inline_core();
+    cg::benchmark_inverse();
+    cg::benchmark_vector_kernels();
+    cg::benchmark_quaternion();
+    cg::benchmark_matrix3x2();
+    cg::benchmark_random();
+    cg::benchmark_predicates();
+    cg::benchmark_segment2_batch();
+    cg::benchmark_segment2_grid();
+    cg::benchmark_segment2_sweep();
+    cg::benchmark_segment2_clip();
+    cg::benchmark_mesh_bvh();
+    cg::benchmark_ray_packet();
+    cg::benchmark_bounds();
+    cg::benchmark_frustum();
+    return 0;
+}
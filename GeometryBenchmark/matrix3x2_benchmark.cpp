@@ -0,0 +1,115 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t POINTS = 4096;
+constexpr uint32_t RUNS = 200;
+
+void report(const char *name, double matrix4x4_ns, double matrix3x2_ns, uint32_t count)
+{
+    logmsg("  %-24s Matrix4x4 %6.2f ns  Matrix3x2 %6.2f ns  speedup %5.2fx",
+           name,
+           matrix4x4_ns / count,
+           matrix3x2_ns / count,
+           matrix4x4_ns / matrix3x2_ns);
+}
+
+} // namespace
+
+void benchmark_matrix3x2()
+{
+    logmsg("\n2-D transforms (%u elements, best of %u runs, ns per element)", POINTS, RUNS);
+
+    // 2-D points. The 4x4 path needs them as Point3 with z = 0.
+    std::vector<Point2> points(POINTS);
+    std::vector<Point3> points3(POINTS);
+    for(uint32_t i = 0; i < POINTS; i++)
+    {
+        points[i] = Point2(rand_0_1() * 10.0f, rand_0_1() * 10.0f);
+        points3[i] = Point3(points[i].x, points[i].y, 0.0f);
+    }
+
+    Matrix4x4 m4;
+    m4.translate(1.0f, 2.0f, 0.0f);
+    m4.rotate_z(30.0f);
+    m4.scale(2.0f, 0.5f, 1.0f);
+    Matrix3x2 m3;
+    m3.translate(1.0f, 2.0f);
+    m3.rotate(30.0f);
+    m3.scale(2.0f, 0.5f);
+
+    // Batch point transforms
+    std::vector<Point3> out3(POINTS);
+    std::vector<Point2> out(POINTS);
+
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 m4.transform_points(points3.data(), out3.data(), POINTS);
+                                 g_benchmark_sink = out3[POINTS / 2].x;
+                             });
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 m3.transform_points(points.data(), out.data(), POINTS);
+                                 g_benchmark_sink = out[POINTS / 2].x;
+                             });
+    report("transform_points", t0, t1, POINTS);
+
+    // Composing node transforms (scene graph traversal)
+    std::vector<Matrix4x4> nodes4(POINTS);
+    std::vector<Matrix3x2> nodes3(POINTS);
+    for(uint32_t i = 0; i < POINTS; i++)
+    {
+        float angle = rand_0_1() * 360.0f;
+        nodes4[i].rotate_z(angle);
+        nodes4[i].translate(rand_0_1(), rand_0_1(), 0.0f);
+        nodes3[i].rotate(angle);
+        nodes3[i].translate(nodes4[i].m03(), nodes4[i].m13());
+    }
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          Matrix4x4 m;
+                          for(const auto &n : nodes4) m *= n;
+                          g_benchmark_sink = m.m03();
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          Matrix3x2 m;
+                          for(const auto &n : nodes3) m *= n;
+                          g_benchmark_sink = m.m02();
+                      });
+    report("compose", t0, t1, POINTS);
+
+    // Inverse (picking)
+    std::vector<Matrix4x4> inv4(POINTS);
+    std::vector<Matrix3x2> inv3(POINTS);
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < POINTS; i++)
+                              inv4[i] = nodes4[i].get_affine_inverse();
+                          g_benchmark_sink = inv4[POINTS / 2].m03();
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < POINTS; i++) inv3[i] = nodes3[i].get_inverse();
+                          g_benchmark_sink = inv3[POINTS / 2].m02();
+                      });
+    report("inverse (affine)", t0, t1, POINTS);
+}
+
+} // namespace cg
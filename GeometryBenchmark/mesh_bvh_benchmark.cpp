@@ -0,0 +1,252 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+// Bumpy sphere: (RINGS + 1) x SECTORS vertices (fits 16-bit indices),
+// 2 x RINGS x SECTORS triangles
+constexpr uint32_t RINGS = 254;
+constexpr uint32_t SECTORS = 256;
+constexpr uint32_t RAYS = 256;
+constexpr uint32_t RUNS = 3;
+
+// Larger bumpy sphere that needs 32-bit indices
+constexpr uint32_t LARGE_RINGS = 720;
+constexpr uint32_t LARGE_SECTORS = 720;
+
+// Vertices per mesh with 16-bit indices
+constexpr uint32_t MAX_16BIT_VERTICES = 65536;
+
+template <typename Index>
+void make_mesh(uint32_t             rings,
+               uint32_t             sectors,
+               std::vector<Point3> &vertices,
+               std::vector<Index>  &faces)
+{
+    for(uint32_t i = 0; i <= rings; i++)
+    {
+        for(uint32_t j = 0; j < sectors; j++)
+        {
+            float theta = PI * i / rings;
+            float phi = 2.0f * PI * j / sectors;
+            float r = 1.0f + 0.1f * std::sin(5.0f * theta) * std::cos(7.0f * phi);
+            vertices.push_back(Point3(r * std::sin(theta) * std::cos(phi),
+                                      r * std::cos(theta),
+                                      r * std::sin(theta) * std::sin(phi)));
+        }
+    }
+    for(uint32_t i = 0; i < rings; i++)
+    {
+        for(uint32_t j = 0; j < sectors; j++)
+        {
+            Index a = static_cast<Index>(i * sectors + j);
+            Index b = static_cast<Index>(i * sectors + (j + 1) % sectors);
+            Index c = static_cast<Index>((i + 1) * sectors + j);
+            Index d = static_cast<Index>((i + 1) * sectors + (j + 1) % sectors);
+            faces.insert(faces.end(), {a, c, b, b, c, d});
+        }
+    }
+}
+
+// Part of a large mesh re-indexed with 16-bit indices
+struct MeshChunk
+{
+    std::vector<Point3>   vertices;
+    std::vector<uint16_t> faces;
+    uint32_t              first_face;
+    MeshBVH               bvh;
+};
+
+// Splits a mesh into consecutive runs of faces that each use at most
+// MAX_16BIT_VERTICES vertices (the workaround needed without 32-bit indices)
+std::vector<MeshChunk> split_mesh(const std::vector<Point3>   &vertices,
+                                  const std::vector<uint32_t> &faces)
+{
+    std::vector<MeshChunk> chunks;
+    std::vector<int32_t>   local(vertices.size(), -1);
+    for(uint32_t f = 0; f < faces.size() / 3; f++)
+    {
+        if(chunks.empty() || chunks.back().vertices.size() + 3 > MAX_16BIT_VERTICES)
+        {
+            std::fill(local.begin(), local.end(), -1);
+            chunks.push_back(MeshChunk());
+            chunks.back().first_face = f;
+        }
+        MeshChunk &chunk = chunks.back();
+        for(uint32_t k = 0; k < 3; k++)
+        {
+            uint32_t v = faces[3 * f + k];
+            if(local[v] < 0)
+            {
+                local[v] = static_cast<int32_t>(chunk.vertices.size());
+                chunk.vertices.push_back(vertices[v]);
+            }
+            chunk.faces.push_back(static_cast<uint16_t>(local[v]));
+        }
+    }
+    for(auto &chunk : chunks) chunk.bvh.build(chunk.vertices, chunk.faces);
+    return chunks;
+}
+
+Point3 random_point(float radius)
+{
+    Vector3 v(rand_0_1() * 2.0f - 1.0f, rand_0_1() * 2.0f - 1.0f, rand_0_1() * 2.0f - 1.0f);
+    v.normalize();
+    return Point3(v.x * radius, v.y * radius, v.z * radius);
+}
+
+} // namespace
+
+void benchmark_mesh_bvh()
+{
+    std::vector<Point3>   vertices;
+    std::vector<uint16_t> faces;
+    make_mesh(RINGS, SECTORS, vertices, faces);
+    uint32_t triangles = static_cast<uint32_t>(faces.size() / 3);
+
+    logmsg("\nRay vs triangle mesh (%u triangles, %u rays, best of %u runs, us per ray)",
+           triangles,
+           RAYS,
+           RUNS);
+
+    auto    start = std::chrono::steady_clock::now();
+    MeshBVH bvh(vertices, faces);
+    auto    stop = std::chrono::steady_clock::now();
+    logmsg("  BVH build %.1f ms, %zu nodes",
+           std::chrono::duration<double, std::milli>(stop - start).count(),
+           bvh.node_count());
+
+    // Picking rays from outside toward the middle, and shadow rays that
+    // stop at t = 1 (mostly blocked)
+    std::vector<Ray3> rays(RAYS);
+    for(auto &ray : rays)
+    {
+        Point3 o = random_point(3.0f);
+        Point3 target = random_point(0.5f);
+        ray = Ray3(o, target - o);
+    }
+
+    bool   match = true;
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 float sum = 0.0f;
+                                 for(const auto &ray : rays)
+                                     sum += ray.intersect(vertices, faces, 1.0e30f).distance;
+                                 g_benchmark_sink = sum;
+                             });
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 float sum = 0.0f;
+                                 for(const auto &ray : rays)
+                                     sum += ray.intersect(bvh, 1.0e30f).distance;
+                                 g_benchmark_sink = sum;
+                             });
+    for(const auto &ray : rays)
+    {
+        RayMeshIntersectResult a = ray.intersect(vertices, faces, 1.0e30f);
+        RayMeshIntersectResult b = ray.intersect(bvh, 1.0e30f);
+        match = match && a.intersects == b.intersects && a.distance == b.distance &&
+                a.face_index == b.face_index;
+    }
+    logmsg("  %-24s linear %9.2f us  BVH %7.3f us  speedup %7.1fx  (%s)",
+           "nearest hit",
+           t0 * 1.0e-3 / RAYS,
+           t1 * 1.0e-3 / RAYS,
+           t0 / t1,
+           match ? "match" : "MISMATCH");
+
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          uint32_t blocked = 0;
+                          for(const auto &ray : rays)
+                              blocked += ray.does_intersect_exist(vertices, faces, 1.0f) ? 1 : 0;
+                          g_benchmark_sink = static_cast<float>(blocked);
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          uint32_t blocked = 0;
+                          for(const auto &ray : rays)
+                              blocked += ray.does_intersect_exist(bvh, 1.0f) ? 1 : 0;
+                          g_benchmark_sink = static_cast<float>(blocked);
+                      });
+    logmsg("  %-24s linear %9.2f us  BVH %7.3f us  speedup %7.1fx",
+           "occlusion (t < 1)",
+           t0 * 1.0e-3 / RAYS,
+           t1 * 1.0e-3 / RAYS,
+           t0 / t1);
+
+    // Large mesh: one hierarchy over 32-bit indices versus one hierarchy per
+    // 16-bit chunk
+    std::vector<Point3>   large_vertices;
+    std::vector<uint32_t> large_faces;
+    make_mesh(LARGE_RINGS, LARGE_SECTORS, large_vertices, large_faces);
+    MeshBVH                large_bvh(large_vertices, large_faces);
+    std::vector<MeshChunk> chunks = split_mesh(large_vertices, large_faces);
+    logmsg("  Large mesh: %zu vertices, %zu triangles, %zu 16-bit chunks",
+           large_vertices.size(),
+           large_faces.size() / 3,
+           chunks.size());
+
+    auto intersect_chunks = [&](const Ray3 &ray)
+    {
+        RayMeshIntersectResult nearest{false, 1.0e30f, 0.0f, 0.0f, 0};
+        for(const auto &chunk : chunks)
+        {
+            RayMeshIntersectResult r = ray.intersect(chunk.bvh, nearest.distance);
+            if(r.intersects)
+            {
+                nearest = r;
+                nearest.face_index += chunk.first_face;
+            }
+        }
+        if(!nearest.intersects) nearest.distance = 0.0f;
+        return nearest;
+    };
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          float sum = 0.0f;
+                          for(const auto &ray : rays) sum += intersect_chunks(ray).distance;
+                          g_benchmark_sink = sum;
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          float sum = 0.0f;
+                          for(const auto &ray : rays)
+                              sum += ray.intersect(large_bvh, 1.0e30f).distance;
+                          g_benchmark_sink = sum;
+                      });
+    match = true;
+    for(const auto &ray : rays)
+    {
+        RayMeshIntersectResult a = intersect_chunks(ray);
+        RayMeshIntersectResult b = ray.intersect(large_bvh, 1.0e30f);
+        match = match && a.intersects == b.intersects && a.distance == b.distance;
+    }
+    logmsg("  %-24s chunks %9.2f us  BVH %7.3f us  speedup %7.1fx  (%s)",
+           "nearest hit (32-bit)",
+           t0 * 1.0e-3 / RAYS,
+           t1 * 1.0e-3 / RAYS,
+           t0 / t1,
+           match ? "match" : "MISMATCH");
+}
+
+} // namespace cg
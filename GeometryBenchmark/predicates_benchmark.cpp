@@ -0,0 +1,92 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t POINTS = 1 << 16;
+constexpr uint32_t RUNS = 20;
+
+// Plain floating point orientation (what the predicates replace)
+inline double naive_orient2d(const Point2 &a, const Point2 &b, const Point2 &c)
+{
+    return (static_cast<double>(a.x) - c.x) * (static_cast<double>(b.y) - c.y) -
+           (static_cast<double>(a.y) - c.y) * (static_cast<double>(b.x) - c.x);
+}
+
+// Random points, or points within 1e-6 of the line y = x (consecutive
+// triples are nearly collinear, so the filter often falls back to exact
+// arithmetic)
+std::vector<Point2> make_points(bool near_collinear)
+{
+    std::vector<Point2> points(POINTS);
+    for(auto &p : points)
+    {
+        float t = rand_0_1();
+        if(near_collinear) p = Point2(0.5f + 11.5f * t, 0.5f + 11.5f * t + 1.0e-6f * rand_0_1());
+        else p = Point2(rand_0_1() * 24.0f, rand_0_1() * 24.0f);
+    }
+    return points;
+}
+
+// Runs an orientation function over consecutive point triples
+template <typename Orient>
+double time_orient(const std::vector<Point2> &points, const Orient &orient, int32_t &positive)
+{
+    return best_time_ns(RUNS,
+                        [&]()
+                        {
+                            int32_t n = 0;
+                            for(size_t i = 0; i + 2 < points.size(); i++)
+                                n += orient(points[i], points[i + 1], points[i + 2]) > 0.0 ? 1 : 0;
+                            positive = n;
+                            g_benchmark_sink = static_cast<float>(n);
+                        });
+}
+
+} // namespace
+
+void benchmark_predicates()
+{
+    logmsg("\nRobust predicates (%u point triples, best of %u runs, ns per test)", POINTS, RUNS);
+
+    for(bool near_collinear : {false, true})
+    {
+        std::vector<Point2> points = make_points(near_collinear);
+
+        int32_t naive_positive, positive;
+        double  t0 = time_orient(points, naive_orient2d, naive_positive);
+        double  t1 = time_orient(points,
+                                [](const Point2 &p, const Point2 &q, const Point2 &r)
+                                { return orient2d(p, q, r); },
+                                positive);
+        double  t2 = best_time_ns(RUNS,
+                                 [&]()
+                                 {
+                                     int32_t n = 0;
+                                     for(size_t i = 0; i + 3 < points.size(); i++)
+                                     {
+                                         n += incircle(points[i], points[i + 1], points[i + 2],
+                                                       points[i + 3]) > 0.0 ? 1 : 0;
+                                     }
+                                     g_benchmark_sink = static_cast<float>(n);
+                                 });
+        double  tests = static_cast<double>(POINTS - 2);
+        logmsg("  %-15s  plain orient %5.2f ns  orient2d %5.2f ns  incircle %6.2f ns  (%s)",
+               near_collinear ? "near collinear" : "random",
+               t0 / tests,
+               t1 / tests,
+               t2 / tests,
+               naive_positive == positive ? "same signs" : "signs differ");
+    }
+}
+
+} // namespace cg
@@ -0,0 +1,105 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t TRANSFORMS = 4096;
+constexpr uint32_t RUNS = 200;
+
+void report(const char *name, double matrix_ns, double quaternion_ns)
+{
+    logmsg("  %-30s Matrix4x4 %6.2f ns  quaternion %6.2f ns  speedup %5.2fx",
+           name,
+           matrix_ns / TRANSFORMS,
+           quaternion_ns / TRANSFORMS,
+           matrix_ns / quaternion_ns);
+}
+
+} // namespace
+
+void benchmark_quaternion()
+{
+    logmsg("\nRotation composition (%u transforms, best of %u runs, ns per transform)",
+           TRANSFORMS,
+           RUNS);
+
+    std::vector<Quaternion>     rotations(TRANSFORMS);
+    std::vector<Matrix4x4>      rotation_matrices(TRANSFORMS);
+    std::vector<DualQuaternion> rigid(TRANSFORMS);
+    std::vector<Matrix4x4>      rigid_matrices(TRANSFORMS);
+    for(uint32_t i = 0; i < TRANSFORMS; i++)
+    {
+        Vector3 axis(rand_0_1() - 0.5f, rand_0_1() - 0.5f, rand_0_1() - 0.5f);
+        rotations[i] = Quaternion::from_axis_angle(rand_0_1() * 10.0f, axis);
+        rotation_matrices[i] = rotations[i].get_matrix();
+        rigid[i] = DualQuaternion(rotations[i], Vector3(rand_0_1(), rand_0_1(), rand_0_1()));
+        rigid_matrices[i] = rigid[i].get_matrix();
+    }
+
+    // Accumulate a chain of rotations (as TransformNode::rotate does)
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 Matrix4x4 m;
+                                 for(const auto &r : rotation_matrices) m *= r;
+                                 g_benchmark_sink = m.m00();
+                             });
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 Quaternion q;
+                                 for(const auto &r : rotations) q *= r;
+                                 g_benchmark_sink = q.w;
+                             });
+    report("accumulate rotations", t0, t1);
+
+    // Accumulate rigid body transforms (deep hierarchy of rotate + translate)
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          Matrix4x4 m;
+                          for(const auto &r : rigid_matrices) m *= r;
+                          g_benchmark_sink = m.m03();
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          DualQuaternion q;
+                          for(const auto &r : rigid) q *= r;
+                          g_benchmark_sink = q.dual.x;
+                      });
+    report("accumulate rigid (dual quat)", t0, t1);
+
+    // Apply by angle/axis, building the matrix each time vs the quaternion
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          Matrix4x4 m;
+                          for(uint32_t i = 0; i < TRANSFORMS; i++)
+                              m.rotate(5.0f, rotations[i].x, rotations[i].y, rotations[i].z);
+                          g_benchmark_sink = m.m00();
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          Quaternion q;
+                          for(uint32_t i = 0; i < TRANSFORMS; i++)
+                          {
+                              Vector3 axis(rotations[i].x, rotations[i].y, rotations[i].z);
+                              q *= Quaternion::from_axis_angle(5.0f, axis);
+                          }
+                          g_benchmark_sink = q.get_matrix().m00();
+                      });
+    report("rotate(angle, axis)", t0, t1);
+}
+
+} // namespace cg
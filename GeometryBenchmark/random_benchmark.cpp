@@ -0,0 +1,101 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace reference
+{
+float rand_0_1();
+} // namespace reference
+
+namespace
+{
+
+constexpr uint32_t SAMPLES = 1 << 16;
+constexpr uint32_t RUNS = 50;
+
+void report(const char *name, double ns, double baseline_ns)
+{
+    logmsg("  %-32s %6.2f ns  %6.2fx", name, ns / SAMPLES, baseline_ns / ns);
+}
+
+} // namespace
+
+void benchmark_random()
+{
+    logmsg("\nRandom numbers (%u samples, best of %u runs, ns per sample)", SAMPLES, RUNS);
+
+    std::vector<float>  values(SAMPLES);
+    std::vector<Point2> disk(SAMPLES);
+    std::vector<Point3> sphere(SAMPLES);
+
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 for(auto &v : values) v = reference::rand_0_1();
+                                 g_benchmark_sink = values[SAMPLES / 2];
+                             });
+    report("std::rand (previous rand_0_1)", t0, t0);
+
+    double t = best_time_ns(RUNS,
+                            [&]()
+                            {
+                                for(auto &v : values) v = rand_0_1();
+                                g_benchmark_sink = values[SAMPLES / 2];
+                            });
+    report("rand_0_1", t, t0);
+
+    Random generator(1234);
+    t = best_time_ns(RUNS,
+                     [&]()
+                     {
+                         for(auto &v : values) v = generator.next_float();
+                         g_benchmark_sink = values[SAMPLES / 2];
+                     });
+    report("Random::next_float", t, t0);
+
+    t = best_time_ns(RUNS,
+                     [&]()
+                     {
+                         generator.fill_uniform(values);
+                         g_benchmark_sink = values[SAMPLES / 2];
+                     });
+    report("Random::fill_uniform", t, t0);
+
+    t = best_time_ns(RUNS,
+                     [&]()
+                     {
+                         generator.fill_in_disk(disk.data(), SAMPLES);
+                         g_benchmark_sink = disk[SAMPLES / 2].x;
+                     });
+    report("Random::fill_in_disk", t, t0);
+
+    t = best_time_ns(RUNS,
+                     [&]()
+                     {
+                         generator.fill_in_sphere(sphere.data(), SAMPLES);
+                         g_benchmark_sink = sphere[SAMPLES / 2].x;
+                     });
+    report("Random::fill_in_sphere", t, t0);
+
+    // Same seed and stream must reproduce the same values
+    Random             a(42, 7);
+    Random             b(42, 7);
+    std::vector<float> va(1000);
+    std::vector<float> vb(1000);
+    a.fill_uniform(va);
+    b.fill_uniform(vb);
+    float mean = 0.0f;
+    for(float v : va) mean += v;
+    logmsg("  deterministic per seed: %s, mean of 1000 samples %.3f",
+           va == vb ? "yes" : "NO",
+           mean / 1000.0f);
+}
+
+} // namespace cg
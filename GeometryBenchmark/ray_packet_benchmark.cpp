@@ -0,0 +1,237 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+// Camera-like rays from one origin through a RAY_SIDE x RAY_SIDE grid, tested
+// against OBJECTS random objects in front of the camera
+constexpr uint32_t RAY_SIDE = 64;
+constexpr uint32_t RAYS = RAY_SIDE * RAY_SIDE;
+constexpr uint32_t OBJECTS = 64;
+constexpr uint32_t RUNS = 5;
+
+float random_range(float lo, float hi) { return lo + (hi - lo) * rand_0_1(); }
+
+Point3 random_point()
+{
+    return Point3(random_range(-4.0f, 4.0f),
+                  random_range(-4.0f, 4.0f),
+                  random_range(-12.0f, -8.0f));
+}
+
+struct Scene
+{
+    std::vector<AABB>           boxes;
+    std::vector<BoundingSphere> spheres;
+    std::vector<Point3>         triangles; // 3 vertices per triangle
+};
+
+// Relative tolerance for the summed hit distances. The packet kernels can
+// round differently from the single ray code (e.g. fused multiply-adds).
+constexpr double DISTANCE_TOLERANCE = 1.0e-5;
+
+// Identifies a hit of ray r against object o (combined in hit_hash)
+inline uint64_t hit_id(size_t o, size_t r)
+{
+    uint64_t x = static_cast<uint64_t>(o) * RAYS + r + 1;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Hit count, which ray-object pairs hit, and sum of hit distances, compared
+// between the single ray and packet paths: hits exactly, distances within a
+// relative tolerance
+struct Totals
+{
+    uint32_t hits;
+    uint64_t hit_hash; // Sum of hit_id over the hits
+    double   distance;
+
+    bool operator==(const Totals &other) const
+    {
+        return hits == other.hits && hit_hash == other.hit_hash &&
+               std::abs(distance - other.distance) <=
+                   DISTANCE_TOLERANCE * std::max(std::abs(distance), std::abs(other.distance));
+    }
+};
+
+template <typename Object>
+Totals trace_single(const std::vector<Ray3> &rays, const std::vector<Object> &objects)
+{
+    Totals totals = {0, 0, 0.0};
+    for(size_t o = 0; o < objects.size(); o++)
+    {
+        for(size_t k = 0; k < rays.size(); k++)
+        {
+            RayObjectIntersectResult r = rays[k].intersect(objects[o]);
+            if(r.intersects)
+            {
+                totals.hits++;
+                totals.hit_hash += hit_id(o, k);
+                totals.distance += r.distance;
+            }
+        }
+    }
+    return totals;
+}
+
+template <typename Packet, typename Object>
+Totals trace_packets(const std::vector<Packet> &packets, const std::vector<Object> &objects)
+{
+    Totals totals = {0, 0, 0.0};
+    for(size_t o = 0; o < objects.size(); o++)
+    {
+        for(size_t p = 0; p < packets.size(); p++)
+        {
+            auto r = packets[p].intersect(objects[o]);
+            for(uint32_t lane = 0; lane < Packet::WIDTH; lane++)
+            {
+                if((r.mask & (1u << lane)) == 0) continue;
+                totals.hits++;
+                totals.hit_hash += hit_id(o, p * Packet::WIDTH + lane);
+                totals.distance += r.distance[lane];
+            }
+        }
+    }
+    return totals;
+}
+
+Totals trace_single_triangles(const std::vector<Ray3> &rays, const std::vector<Point3> &triangles)
+{
+    Totals totals = {0, 0, 0.0};
+    for(size_t i = 0; i < triangles.size(); i += 3)
+    {
+        for(size_t k = 0; k < rays.size(); k++)
+        {
+            RayTriangleIntersectResult r =
+                rays[k].intersect(triangles[i], triangles[i + 1], triangles[i + 2]);
+            if(r.intersects)
+            {
+                totals.hits++;
+                totals.hit_hash += hit_id(i / 3, k);
+                totals.distance += r.distance;
+            }
+        }
+    }
+    return totals;
+}
+
+template <typename Packet>
+Totals trace_packet_triangles(const std::vector<Packet> &packets,
+                              const std::vector<Point3> &triangles)
+{
+    Totals totals = {0, 0, 0.0};
+    for(size_t i = 0; i < triangles.size(); i += 3)
+    {
+        for(size_t p = 0; p < packets.size(); p++)
+        {
+            auto r = packets[p].intersect(triangles[i], triangles[i + 1], triangles[i + 2]);
+            for(uint32_t lane = 0; lane < Packet::WIDTH; lane++)
+            {
+                if((r.mask & (1u << lane)) == 0) continue;
+                totals.hits++;
+                totals.hit_hash += hit_id(i / 3, p * Packet::WIDTH + lane);
+                totals.distance += r.distance[lane];
+            }
+        }
+    }
+    return totals;
+}
+
+template <typename Packet>
+std::vector<Packet> make_packets(const std::vector<Ray3> &rays)
+{
+    std::vector<Packet> packets;
+    for(size_t i = 0; i < rays.size(); i += Packet::WIDTH)
+        packets.push_back(Packet(&rays[i], Packet::WIDTH));
+    return packets;
+}
+
+// Times the single ray, 4-wide and 8-wide versions of a test and logs ns per
+// ray-object test
+template <typename Single, typename Packet4, typename Packet8>
+void run_case(const char *name, Single &&single, Packet4 &&packet4, Packet8 &&packet8)
+{
+    const double tests = static_cast<double>(RAYS) * OBJECTS;
+    Totals       expected = single();
+    bool         match = packet4() == expected && packet8() == expected;
+
+    double t0 = best_time_ns(RUNS,
+                             [&]() { g_benchmark_sink = static_cast<float>(single().distance); });
+    double t1 = best_time_ns(RUNS,
+                             [&]() { g_benchmark_sink = static_cast<float>(packet4().distance); });
+    double t2 = best_time_ns(RUNS,
+                             [&]() { g_benchmark_sink = static_cast<float>(packet8().distance); });
+    logmsg("  %-10s single %6.2f ns  x4 %6.2f ns (%4.1fx)  x8 %6.2f ns (%4.1fx)  hits %4.1f%% (%s)",
+           name,
+           t0 / tests,
+           t1 / tests,
+           t0 / t1,
+           t2 / tests,
+           t0 / t2,
+           100.0 * expected.hits / tests,
+           match ? "match" : "MISMATCH");
+}
+
+} // namespace
+
+void benchmark_ray_packet()
+{
+    logmsg("\nRay packets (%u rays x %u objects, best of %u runs, ns per ray-object test)",
+           RAYS,
+           OBJECTS,
+           RUNS);
+
+    std::vector<Ray3> rays;
+    Point3            eye(0.0f, 0.0f, 0.0f);
+    for(uint32_t i = 0; i < RAY_SIDE; i++)
+    {
+        for(uint32_t j = 0; j < RAY_SIDE; j++)
+        {
+            Vector3 d((j + 0.5f) / RAY_SIDE - 0.5f, (i + 0.5f) / RAY_SIDE - 0.5f, -1.0f);
+            rays.push_back(Ray3(eye, d, true));
+        }
+    }
+    std::vector<Ray3Packet4> packets4 = make_packets<Ray3Packet4>(rays);
+    std::vector<Ray3Packet8> packets8 = make_packets<Ray3Packet8>(rays);
+
+    Scene scene;
+    for(uint32_t i = 0; i < OBJECTS; i++)
+    {
+        Point3 p = random_point();
+        float  s = random_range(0.2f, 1.5f);
+        scene.boxes.push_back(AABB(p, Point3(p.x + s, p.y + s, p.z + s)));
+        scene.spheres.push_back(BoundingSphere(random_point(), s));
+        Point3 v0 = random_point();
+        Point3 v1(v0.x + random_range(-2.0f, 2.0f), v0.y + random_range(-2.0f, 2.0f), v0.z);
+        Point3 v2(v0.x + random_range(-2.0f, 2.0f), v0.y + random_range(-2.0f, 2.0f), v0.z + 1.0f);
+        scene.triangles.insert(scene.triangles.end(), {v0, v1, v2});
+    }
+
+    run_case("AABB",
+             [&]() { return trace_single(rays, scene.boxes); },
+             [&]() { return trace_packets(packets4, scene.boxes); },
+             [&]() { return trace_packets(packets8, scene.boxes); });
+    run_case("sphere",
+             [&]() { return trace_single(rays, scene.spheres); },
+             [&]() { return trace_packets(packets4, scene.spheres); },
+             [&]() { return trace_packets(packets8, scene.spheres); });
+    run_case("triangle",
+             [&]() { return trace_single_triangles(rays, scene.triangles); },
+             [&]() { return trace_packet_triangles(packets4, scene.triangles); },
+             [&]() { return trace_packet_triangles(packets8, scene.triangles); });
+}
+
+} // namespace cg
@@ -0,0 +1,101 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    reference_ops.cpp
+//	Purpose: Out-of-line copies of geometry operations. Defined in their own
+//           translation unit so (without LTO) each use is a real call, as it
+//           was when these operations lived in geometry_lib.
+//============================================================================
+
+#include "geometry/geometry.hpp"
+
+#include <cstdlib>
+
+namespace cg
+{
+namespace reference
+{
+
+float dot(const Vector3 &v, const Vector3 &w) { return (v.x * w.x + v.y * w.y + v.z * w.z); }
+
+Vector3 scale(const Vector3 &v, float s) { return Vector3(v.x * s, v.y * s, v.z * s); }
+
+Point3 add(const Point3 &p, const Vector3 &v) { return Point3(p.x + v.x, p.y + v.y, p.z + v.z); }
+
+Vector2 subtract(const Point2 &p, const Point2 &q) { return Vector2(p.x - q.x, p.y - q.y); }
+
+float cross(const Vector2 &v, const Vector2 &w) { return (v.x * w.y - v.y * w.x); }
+
+// rand_0_1 before the xoshiro generator (shared std::rand state)
+float rand_0_1() { return (float)std::rand() / (float)RAND_MAX; }
+
+float m00(const Matrix4x4 &m) { return m.get()[0]; }
+float m11(const Matrix4x4 &m) { return m.get()[5]; }
+float m22(const Matrix4x4 &m) { return m.get()[10]; }
+float m33(const Matrix4x4 &m) { return m.get()[15]; }
+
+// Gauss-Jordan elimination with partial pivoting (the original get_inverse)
+Matrix4x4 gauss_jordan_inverse(const Matrix4x4 &m)
+{
+    int32_t   j, k;
+    int32_t   ind;
+    float     v1, v2;
+    Matrix4x4 t = m;
+    Matrix4x4 b;
+    for(int32_t i = 0; i < 4; i++)
+    {
+        // Find pivot
+        v1 = t.m(i, i);
+        ind = i;
+        for(j = i + 1; j < 4; j++)
+        {
+            if(std::abs(t.m(j, i)) > std::abs(v1))
+            {
+                ind = j;
+                v1 = t.m(j, i);
+            }
+        }
+
+        // Swap columns
+        if(ind != i)
+        {
+            for(j = 0; j < 4; j++)
+            {
+                v2 = b.m(i, j);
+                b.m(i, j) = b.m(ind, j);
+                b.m(ind, j) = v2;
+                v2 = t.m(i, j);
+                t.m(i, j) = t.m(ind, j);
+                t.m(ind, j) = v2;
+            }
+        }
+
+        if(v1 == 0.0f) return Matrix4x4();
+
+        for(j = 0; j < 4; j++)
+        {
+            t.m(i, j) /= v1;
+            b.m(i, j) /= v1;
+        }
+
+        // Eliminate column
+        for(j = 0; j < 4; j++)
+        {
+            if(j == i) continue;
+
+            v1 = t.m(j, i);
+            for(k = 0; k < 4; k++)
+            {
+                t.m(j, k) -= t.m(i, k) * v1;
+                b.m(j, k) -= b.m(i, k) * v1;
+            }
+        }
+    }
+    return b;
+}
+
+} // namespace reference
+} // namespace cg
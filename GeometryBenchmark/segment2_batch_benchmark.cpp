@@ -0,0 +1,89 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t EDGES = 32768;
+constexpr uint32_t QUERIES = 8;
+constexpr uint32_t RUNS = 50;
+
+} // namespace
+
+void benchmark_segment2_batch()
+{
+    logmsg("\nSegment intersection (%u edges, %u queries, best of %u runs, ns per test)",
+           EDGES,
+           QUERIES,
+           RUNS);
+
+    // Short random edges (polygon perimeters) and long query segments
+    // (dragged lines) across the same region
+    std::vector<LineSegment2> edges(EDGES);
+    for(auto &edge : edges)
+    {
+        Point2  a(rand_0_1() * 100.0f, rand_0_1() * 100.0f);
+        Vector2 d(rand_0_1() * 4.0f - 2.0f, rand_0_1() * 4.0f - 2.0f);
+        edge = LineSegment2(a, a + d);
+    }
+    std::vector<LineSegment2> queries(QUERIES);
+    for(auto &query : queries)
+    {
+        query = LineSegment2(Point2(rand_0_1() * 100.0f, rand_0_1() * 100.0f),
+                             Point2(rand_0_1() * 100.0f, rand_0_1() * 100.0f));
+    }
+    Segment2Table table(edges);
+
+    // Scalar loop over LineSegment2::intersect
+    std::vector<Point2> scalar_hits;
+    scalar_hits.reserve(EDGES);
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 scalar_hits.clear();
+                                 for(const auto &query : queries)
+                                 {
+                                     for(const auto &edge : edges)
+                                     {
+                                         Segment2IntersectionResult r = query.intersect(edge);
+                                         if(r.intersects) scalar_hits.push_back(r.intersect_point);
+                                     }
+                                 }
+                                 g_benchmark_sink = static_cast<float>(scalar_hits.size());
+                             });
+
+    // Batch kernel over the SoA table
+    std::vector<Segment2Hit> hits;
+    hits.reserve(EDGES);
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 hits.clear();
+                                 intersect_segments(queries.data(), QUERIES, table, hits);
+                                 g_benchmark_sink = static_cast<float>(hits.size());
+                             });
+
+    // The batch results must match the scalar results exactly
+    bool match = hits.size() == scalar_hits.size();
+    for(size_t i = 0; match && i < hits.size(); i++)
+        match = hits[i].point == scalar_hits[i];
+
+    uint32_t tests = EDGES * QUERIES;
+    logmsg("  %-24s scalar %6.2f ns  batch %6.2f ns  speedup %5.2fx  (%zu hits, %s)",
+           "segment vs edges",
+           t0 / tests,
+           t1 / tests,
+           t0 / t1,
+           hits.size(),
+           match ? "match" : "MISMATCH");
+}
+
+} // namespace cg
@@ -0,0 +1,147 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t SEGMENTS = 1 << 20;
+constexpr uint32_t RUNS = 10;
+
+// Random walk polylines (map layer) over a region larger than the viewport
+std::vector<LineSegment2> make_polylines()
+{
+    std::vector<LineSegment2> segments(SEGMENTS);
+    Point2                    p(0.0f, 0.0f);
+    for(uint32_t i = 0; i < SEGMENTS; i++)
+    {
+        // Start a new polyline every 256 segments
+        if(i % 256 == 0) p = Point2(rand_0_1() * 400.0f - 200.0f, rand_0_1() * 400.0f - 200.0f);
+        Point2 q = p + Vector2(rand_0_1() * 4.0f - 2.0f, rand_0_1() * 4.0f - 2.0f);
+        segments[i] = LineSegment2(p, q);
+        p = q;
+    }
+    return segments;
+}
+
+// Checks the batch results against the scalar clip (same segments kept, in
+// the same order, with end points within a small tolerance)
+template <typename ScalarClip>
+bool check(const std::vector<LineSegment2> &segments,
+           const std::vector<LineSegment2> &clipped,
+           const std::vector<uint32_t>     &indices,
+           const ScalarClip                &scalar_clip)
+{
+    size_t j = 0;
+    for(size_t i = 0; i < segments.size(); i++)
+    {
+        Segment2ClipResult r = scalar_clip(segments[i]);
+        bool               kept = j < indices.size() && indices[j] == i;
+        if(r.clipped != kept) return false;
+        if(!kept) continue;
+
+        const LineSegment2 &s = clipped[j++];
+        if((s.a - r.clip_segment.a).norm() > 1.0e-3f || (s.b - r.clip_segment.b).norm() > 1.0e-3f)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void benchmark_segment2_clip()
+{
+    logmsg("\nSegment clipping (%u polyline segments, best of %u runs)", SEGMENTS, RUNS);
+
+    std::vector<LineSegment2> segments = make_polylines();
+    std::vector<LineSegment2> scalar_clipped, clipped;
+    std::vector<uint32_t>     indices;
+    scalar_clipped.reserve(SEGMENTS);
+    clipped.reserve(SEGMENTS);
+    indices.reserve(SEGMENTS);
+
+    // Viewport
+    CRectangle r = {-60.0f, 60.0f, -40.0f, 40.0f};
+
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 scalar_clipped.clear();
+                                 for(const auto &s : segments)
+                                 {
+                                     Segment2ClipResult c = s.clip_to_rectangle(r);
+                                     if(c.clipped) scalar_clipped.push_back(c.clip_segment);
+                                 }
+                                 g_benchmark_sink = static_cast<float>(scalar_clipped.size());
+                             });
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 clipped.clear();
+                                 clip_segments_to_rectangle(segments.data(), SEGMENTS, r, clipped);
+                                 g_benchmark_sink = static_cast<float>(clipped.size());
+                             });
+    indices.clear();
+    clipped.clear();
+    clip_segments_to_rectangle(segments.data(), SEGMENTS, r, clipped, &indices);
+    bool match = check(segments,
+                       clipped,
+                       indices,
+                       [&](const LineSegment2 &s) { return s.clip_to_rectangle(r); });
+    logmsg("  rectangle  Cohen-Sutherland %7.3f ms  batch %7.3f ms  speedup %5.2fx  (%zu kept, %s)",
+           t0 * 1.0e-6,
+           t1 * 1.0e-6,
+           t0 / t1,
+           clipped.size(),
+           match ? "match" : "MISMATCH");
+
+    // Convex octagon inside the same region
+    std::vector<Point2> poly = {{-40.0f, -40.0f},
+                                {40.0f, -40.0f},
+                                {60.0f, -20.0f},
+                                {60.0f, 20.0f},
+                                {40.0f, 40.0f},
+                                {-40.0f, 40.0f},
+                                {-60.0f, 20.0f},
+                                {-60.0f, -20.0f}};
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          scalar_clipped.clear();
+                          for(const auto &s : segments)
+                          {
+                              Segment2ClipResult c = s.clip_to_polygon(poly);
+                              if(c.clipped) scalar_clipped.push_back(c.clip_segment);
+                          }
+                          g_benchmark_sink = static_cast<float>(scalar_clipped.size());
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          clipped.clear();
+                          clip_segments_to_polygon(segments.data(), SEGMENTS, poly, clipped);
+                          g_benchmark_sink = static_cast<float>(clipped.size());
+                      });
+    indices.clear();
+    clipped.clear();
+    clip_segments_to_polygon(segments.data(), SEGMENTS, poly, clipped, &indices);
+    match = check(segments,
+                  clipped,
+                  indices,
+                  [&](const LineSegment2 &s) { return s.clip_to_polygon(poly); });
+    logmsg("  polygon    Cyrus-Beck       %7.3f ms  batch %7.3f ms  speedup %5.2fx  (%zu kept, %s)",
+           t0 * 1.0e-6,
+           t1 * 1.0e-6,
+           t0 / t1,
+           clipped.size(),
+           match ? "match" : "MISMATCH");
+}
+
+} // namespace cg
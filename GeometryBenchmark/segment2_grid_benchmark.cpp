@@ -0,0 +1,92 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t SIDES = 6;
+constexpr float    RADIUS = 1.0f;
+constexpr float    SPACING = 4.0f; // Area per n-gon is SPACING^2
+constexpr uint32_t QUERIES = 64;
+constexpr uint32_t RUNS = 20;
+
+// Appends the edges of a regular n-gon
+void add_ngon(const Point2 &center, std::vector<LineSegment2> &edges)
+{
+    for(uint32_t i = 0; i < SIDES; i++)
+    {
+        float a0 = 2.0f * PI * i / SIDES;
+        float a1 = 2.0f * PI * (i + 1) / SIDES;
+        edges.push_back(LineSegment2(center + Vector2(std::cos(a0), std::sin(a0)) * RADIUS,
+                                     center + Vector2(std::cos(a1), std::sin(a1)) * RADIUS));
+    }
+}
+
+} // namespace
+
+void benchmark_segment2_grid()
+{
+    logmsg("\nDragged line vs n-gon edges (%u-gons at constant density, query length 10, "
+           "best of %u runs, ns per query)",
+           SIDES,
+           RUNS);
+
+    const uint32_t counts[] = {3, 10, 30, 100, 1000, 10000, 100000};
+    for(uint32_t ngons : counts)
+    {
+        // Scene grows with the n-gon count, so the density stays the same
+        float                     extent = SPACING * std::sqrt(static_cast<float>(ngons));
+        std::vector<LineSegment2> edges;
+        edges.reserve(ngons * SIDES);
+        for(uint32_t i = 0; i < ngons; i++)
+            add_ngon(Point2(rand_0_1() * extent, rand_0_1() * extent), edges);
+
+        Segment2Table table(edges);
+        Segment2Grid  grid(4.0f * RADIUS);
+        grid.add(edges);
+
+        // Fixed length queries (a dragged line) at random places
+        std::vector<LineSegment2> queries(QUERIES);
+        for(auto &query : queries)
+        {
+            Point2 a(rand_0_1() * extent, rand_0_1() * extent);
+            float  angle = rand_0_1() * 2.0f * PI;
+            query = LineSegment2(a, a + Vector2(std::cos(angle), std::sin(angle)) * 10.0f);
+        }
+
+        std::vector<Segment2Hit> hits;
+        double t0 = best_time_ns(RUNS,
+                                 [&]()
+                                 {
+                                     hits.clear();
+                                     for(const auto &query : queries)
+                                         intersect_segments(query, table, hits);
+                                     g_benchmark_sink = static_cast<float>(hits.size());
+                                 });
+        size_t table_hits = hits.size();
+        double t1 = best_time_ns(RUNS,
+                                 [&]()
+                                 {
+                                     hits.clear();
+                                     for(const auto &query : queries) grid.intersect(query, hits);
+                                     g_benchmark_sink = static_cast<float>(hits.size());
+                                 });
+        logmsg("  %6u n-gons  all edges %10.1f ns  grid %8.1f ns  speedup %8.1fx  (%s)",
+               ngons,
+               t0 / QUERIES,
+               t1 / QUERIES,
+               t0 / t1,
+               hits.size() == table_hits ? "match" : "MISMATCH");
+    }
+}
+
+} // namespace cg
@@ -0,0 +1,90 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+// Brute force above this many segments takes minutes, so only every
+// SAMPLE_STRIDE-th row of the pair matrix is timed and the time scaled up
+constexpr uint32_t SAMPLED_ABOVE = 20000;
+constexpr uint32_t SAMPLE_STRIDE = 50;
+
+// Pairwise LineSegment2::intersect over the pairs (i, j > i) for every
+// stride-th i
+size_t brute_force_count(const std::vector<LineSegment2> &segments, size_t stride)
+{
+    size_t count = 0;
+    for(size_t i = 0; i < segments.size(); i += stride)
+    {
+        for(size_t j = i + 1; j < segments.size(); j++)
+        {
+            if(segments[i].intersect(segments[j]).intersects) count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+void benchmark_segment2_sweep()
+{
+    logmsg("\nAll-pairs segment intersection (random segments, about 2 crossings per segment, "
+           "best of 3 runs, ms)");
+
+    const uint32_t counts[] = {1000, 10000, 100000};
+    for(uint32_t n : counts)
+    {
+        // Segment length shrinks with n so the number of crossings stays
+        // proportional to n
+        float                     length = 2.0f / std::sqrt(static_cast<float>(n));
+        std::vector<LineSegment2> segments(n);
+        for(auto &segment : segments)
+        {
+            Point2 a(rand_0_1(), rand_0_1());
+            float  angle = rand_0_1() * 2.0f * PI;
+            segment = LineSegment2(a, a + Vector2(std::cos(angle), std::sin(angle)) * length);
+        }
+
+        // Sampled rows are spread evenly, so they hold about 1 / stride of
+        // the pairs
+        size_t stride = (n > SAMPLED_ABOVE) ? SAMPLE_STRIDE : 1;
+        size_t brute_force = 0;
+        double t0 = best_time_ns((stride == 1) ? 3 : 1,
+                                 [&]()
+                                 {
+                                     brute_force = brute_force_count(segments, stride);
+                                     g_benchmark_sink = static_cast<float>(brute_force);
+                                 });
+        t0 *= static_cast<double>(stride);
+        brute_force *= stride;
+
+        std::vector<Segment2Crossing> crossings;
+        double t1 = best_time_ns(3,
+                                 [&]()
+                                 {
+                                     find_all_intersections(segments, crossings);
+                                     g_benchmark_sink = static_cast<float>(crossings.size());
+                                 });
+        logmsg("  %6u segments  brute force %10.2f ms%s  sweep %8.2f ms  speedup %7.1fx  "
+               "(%zu pairs, brute force %s%zu)",
+               n,
+               t0 * 1.0e-6,
+               (stride == 1) ? "" : " (est.)",
+               t1 * 1.0e-6,
+               t0 / t1,
+               crossings.size(),
+               (stride == 1) ? "" : "~",
+               brute_force);
+    }
+}
+
+} // namespace cg
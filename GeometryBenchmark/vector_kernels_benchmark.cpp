@@ -0,0 +1,166 @@
+#include "benchmark_timer.hpp"
+#include "geometry/geometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+namespace
+{
+
+constexpr uint32_t VECTORS = 1 << 20;
+constexpr uint32_t RUNS = 20;
+
+void report(const char *name, double scalar_ns, double aos_ns, double soa_ns)
+{
+    logmsg("  %-14s scalar %5.2f ns  AoS %5.2f ns (%4.2fx)  SoA %5.2f ns (%4.2fx)",
+           name,
+           scalar_ns / VECTORS,
+           aos_ns / VECTORS,
+           scalar_ns / aos_ns,
+           soa_ns / VECTORS,
+           scalar_ns / soa_ns);
+}
+
+} // namespace
+
+void benchmark_vector_kernels()
+{
+    logmsg("\nVector3 array kernels (%u vectors, best of %u runs, ns per vector)", VECTORS, RUNS);
+
+    std::vector<Vector3> a(VECTORS);
+    std::vector<Vector3> b(VECTORS);
+    for(uint32_t i = 0; i < VECTORS; i++)
+    {
+        a[i] = Vector3(rand_0_1() - 0.5f, rand_0_1() - 0.5f, rand_0_1() - 0.5f) * 100.0f;
+        b[i] = Vector3(rand_0_1() - 0.5f, rand_0_1() - 0.5f, rand_0_1() - 0.5f);
+        b[i].normalize();
+    }
+    Vector3Array soa_a(a);
+    Vector3Array soa_b(b);
+
+    std::vector<Vector3> out(VECTORS);
+    std::vector<float>   dots(VECTORS);
+    Vector3Array         soa_out;
+
+    // normalize (copy the input first so every run normalizes the same data)
+    double t0 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 std::copy(a.begin(), a.end(), out.begin());
+                                 for(auto &v : out) v.normalize();
+                                 g_benchmark_sink = out[VECTORS / 2].x;
+                             });
+    std::vector<Vector3> exact = out;
+    double t1 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 std::copy(a.begin(), a.end(), out.begin());
+                                 normalize_all(out.data(), out.size());
+                                 g_benchmark_sink = out[VECTORS / 2].x;
+                             });
+    double t2 = best_time_ns(RUNS,
+                             [&]()
+                             {
+                                 soa_out = soa_a;
+                                 normalize_all(soa_out);
+                                 g_benchmark_sink = soa_out.x()[VECTORS / 2];
+                             });
+    report("normalize", t0, t1, t2);
+
+    // dot
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < VECTORS; i++) dots[i] = a[i].dot(b[i]);
+                          g_benchmark_sink = dots[VECTORS / 2];
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          dot_many(a.data(), b.data(), dots.data(), VECTORS);
+                          g_benchmark_sink = dots[VECTORS / 2];
+                      });
+    t2 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          dot_many(soa_a, soa_b, dots.data());
+                          g_benchmark_sink = dots[VECTORS / 2];
+                      });
+    report("dot", t0, t1, t2);
+
+    // cross
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < VECTORS; i++) out[i] = a[i].cross(b[i]);
+                          g_benchmark_sink = out[VECTORS / 2].x;
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          cross_many(a.data(), b.data(), out.data(), VECTORS);
+                          g_benchmark_sink = out[VECTORS / 2].x;
+                      });
+    t2 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          cross_many(soa_a, soa_b, soa_out);
+                          g_benchmark_sink = soa_out.x()[VECTORS / 2];
+                      });
+    report("cross", t0, t1, t2);
+
+    // reflect
+    t0 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          for(uint32_t i = 0; i < VECTORS; i++) out[i] = a[i].reflect(b[i]);
+                          g_benchmark_sink = out[VECTORS / 2].x;
+                      });
+    t1 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          reflect_many(a.data(), b.data(), out.data(), VECTORS);
+                          g_benchmark_sink = out[VECTORS / 2].x;
+                      });
+    t2 = best_time_ns(RUNS,
+                      [&]()
+                      {
+                          reflect_many(soa_a, soa_b, soa_out);
+                          g_benchmark_sink = soa_out.x()[VECTORS / 2];
+                      });
+    report("reflect", t0, t1, t2);
+
+    // normalize_all against std::sqrt (same operations as Vector3::normalize)
+    std::copy(a.begin(), a.end(), out.begin());
+    normalize_all(out.data(), out.size());
+    float max_component = 0.0f;
+    float max_length = 0.0f;
+    for(uint32_t i = 0; i < VECTORS; i++)
+    {
+        Vector3 d = out[i] - exact[i];
+        max_component = std::max(max_component,
+                                 std::max(std::abs(d.x), std::max(std::abs(d.y), std::abs(d.z))));
+        max_length = std::max(max_length, std::abs(out[i].norm() - 1.0f));
+    }
+    logmsg("  normalize_all accuracy: max component error %.2e, max | |v| - 1 | %.2e",
+           max_component,
+           max_length);
+
+    float max_relative = 0.0f;
+    for(uint32_t i = 1; i < VECTORS; i++)
+    {
+        float x = static_cast<float>(i) * 0.01f;
+        float exact_inv = 1.0f / std::sqrt(x);
+        max_relative = std::max(max_relative, std::abs(fast_inv_sqrt(x) - exact_inv) / exact_inv);
+    }
+    logmsg("  fast_inv_sqrt accuracy: max relative error %.2e", max_relative);
+}
+
+} // namespace cg
@@ -0,0 +1,95 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Every point is inside the sphere (up to float rounding of the radius)
+bool contains_all(const BoundingSphere &sphere, const std::vector<Point3> &points)
+{
+    float limit = sphere.radius * (1.0f + 1.0e-5f) + 1.0e-6f;
+    for(const auto &p : points)
+    {
+        if((p - sphere.center).norm() > limit) return false;
+    }
+    return true;
+}
+
+// Box equals the component-wise min and max of the points
+bool is_tight_box(const AABB &box, const std::vector<Point3> &points)
+{
+    Point3 lo = points[0];
+    Point3 hi = points[0];
+    for(const auto &p : points)
+    {
+        lo = Point3(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+        hi = Point3(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+    }
+    return box.min_corner == lo && box.max_corner == hi;
+}
+
+} // namespace
+
+void test_bounds()
+{
+    logmsg("\nBounds from vertex lists\n");
+
+    // Empty list
+    std::vector<Point3> points;
+    AABB                box(points);
+    BoundingSphere      sphere(points);
+    check("Empty list gives an empty box", box.min_corner.x > box.max_corner.x);
+    check("Empty list gives a zero radius sphere at the origin",
+          sphere.radius == 0.0f && sphere.center == Point3(0.0f, 0.0f, 0.0f));
+
+    // Single point and repeated points
+    points.assign(1, Point3(1.0f, 2.0f, 3.0f));
+    box.create(points);
+    sphere = BoundingSphere(points);
+    check("Single point box", is_tight_box(box, points));
+    check("Single point sphere", sphere.center == points[0] && sphere.radius == 0.0f);
+    points.assign(100003, Point3(-4.0f, 0.5f, 2.0f));
+    box.create(points);
+    sphere = BoundingSphere(points);
+    check("Repeated points (parallel path) box", is_tight_box(box, points));
+    check("Repeated points (parallel path) sphere",
+          sphere.radius <= 1.0e-6f && contains_all(sphere, points));
+
+    // Collinear points
+    points.clear();
+    for(uint32_t i = 0; i < 1001; i++)
+    {
+        float s = static_cast<float>(i) * 0.01f;
+        points.push_back(Point3(s, 2.0f * s, -s));
+    }
+    box.create(points);
+    sphere = BoundingSphere(points);
+    check("Collinear points box", is_tight_box(box, points));
+    check("Collinear points sphere", contains_all(sphere, points));
+
+    // Points in the unit ball, an odd count above the parallel threshold.
+    // Ritter's sphere is not minimal, but should be close (radius near 1).
+    Random random(17);
+    points.clear();
+    while(points.size() < 300007)
+    {
+        Vector3 v = random_vector3(random, -1.0f, 1.0f);
+        if(v.norm_squared() <= 1.0f) points.push_back(Point3(v.x, v.y, v.z));
+    }
+    box.create(points);
+    sphere = BoundingSphere(points);
+    logmsg("Ball: box (%.4f, %.4f, %.4f) to (%.4f, %.4f, %.4f)", box.min_corner.x,
+           box.min_corner.y, box.min_corner.z, box.max_corner.x, box.max_corner.y,
+           box.max_corner.z);
+    check("Ball box matches a scalar min/max", is_tight_box(box, points));
+    check("Ball sphere contains every point", contains_all(sphere, points));
+    check("Ball sphere radius is within 10% of 1", sphere.radius < 1.1f);
+}
+
+} // namespace cg
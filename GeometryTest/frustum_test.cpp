@@ -0,0 +1,133 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+const char *cull_name(CullResult r)
+{
+    switch(r)
+    {
+        case CullResult::OUTSIDE: return "outside";
+        case CullResult::INTERSECTING: return "intersecting";
+        default: return "inside";
+    }
+}
+
+AABB box_at(float x, float y, float z, float half)
+{
+    return AABB(Point3(x - half, y - half, z - half), Point3(x + half, y + half, z + half));
+}
+
+} // namespace
+
+void test_frustum()
+{
+    logmsg("\nFrustum culling\n");
+
+    // The default frustum is the clip cube [-1,1]^3, whose planes are exact
+    Frustum f;
+
+    // Boxes inside, with a face on the right plane, touching it from
+    // outside, straddling it and outside, plus zero size boxes
+    const AABB boxes[7] = {box_at(0.0f, 0.0f, 0.0f, 0.5f), box_at(0.5f, 0.0f, 0.0f, 0.5f),
+                           box_at(1.5f, 0.0f, 0.0f, 0.5f), box_at(1.0f, 0.0f, 0.0f, 0.5f),
+                           box_at(2.0f, 0.0f, 0.0f, 0.5f), box_at(0.0f, 0.0f, 0.0f, 0.0f),
+                           box_at(2.0f, 0.0f, 0.0f, 0.0f)};
+    const CullResult expected[7] = {CullResult::INSIDE,       CullResult::INSIDE,
+                                    CullResult::INTERSECTING, CullResult::INTERSECTING,
+                                    CullResult::OUTSIDE,      CullResult::INSIDE,
+                                    CullResult::OUTSIDE};
+    bool box_match = true;
+    for(uint32_t i = 0; i < 7; i++)
+    {
+        CullResult r = f.classify(boxes[i]);
+        logmsg("Box %u: %s", i, cull_name(r));
+        box_match = box_match && r == expected[i];
+    }
+    check("Boxes on and around the clip cube planes", box_match);
+
+    // Spheres inside, touching from outside, outside, and zero radius on and
+    // just past a plane
+    const BoundingSphere spheres[5] = {BoundingSphere(Point3(0.0f, 0.0f, 0.0f), 0.5f),
+                                       BoundingSphere(Point3(0.0f, 1.5f, 0.0f), 0.5f),
+                                       BoundingSphere(Point3(0.0f, 0.0f, -2.0f), 0.5f),
+                                       BoundingSphere(Point3(1.0f, 0.0f, 0.0f), 0.0f),
+                                       BoundingSphere(Point3(1.001f, 0.0f, 0.0f), 0.0f)};
+    const CullResult     sphere_expected[5] = {CullResult::INSIDE, CullResult::INTERSECTING,
+                                               CullResult::OUTSIDE, CullResult::INSIDE,
+                                               CullResult::OUTSIDE};
+    bool sphere_match = true;
+    for(uint32_t i = 0; i < 5; i++)
+    {
+        CullResult r = f.classify(spheres[i]);
+        logmsg("Sphere %u: %s", i, cull_name(r));
+        sphere_match = sphere_match && r == sphere_expected[i];
+    }
+    check("Spheres on and around the clip cube planes", sphere_match);
+
+    // Plane hints: the rejecting plane is remembered, other results keep it
+    uint8_t hint = 0;
+    f.classify(boxes[4], hint);
+    bool hint_set = hint == Frustum::RIGHT;
+    f.classify(boxes[0], hint);
+    check("Rejecting plane is kept as the hint", hint_set && hint == Frustum::RIGHT);
+    check("Hinted test gives the same result",
+          f.classify(boxes[4], hint) == CullResult::OUTSIDE &&
+              f.classify(spheres[2], hint) == CullResult::OUTSIDE &&
+              hint == Frustum::NEAR_PLANE);
+
+    // Tables (odd size for the SIMD tail) match the single tests, with and
+    // without hints kept between calls
+    Frustum                     ortho(Matrix4x4::ortho(-10.0f, 10.0f, -5.0f, 5.0f, 1.0f, 100.0f));
+    Random                      random(5);
+    std::vector<AABB>           box_list(boxes, boxes + 7);
+    std::vector<BoundingSphere> sphere_list(spheres, spheres + 5);
+    for(uint32_t i = 0; i < 30; i++)
+    {
+        Point3 c = random_point3(random, -12.0f, 12.0f);
+        float  half = random.uniform(0.0f, 4.0f);
+        box_list.push_back(box_at(c.x, c.y, c.z - 50.0f, half));
+        sphere_list.push_back(BoundingSphere(Point3(c.x, c.y, c.z - 50.0f), half));
+    }
+    AABBTable           box_table;
+    BoundingSphereTable sphere_table;
+    for(const auto &box : box_list) box_table.push_back(box);
+    for(const auto &sphere : sphere_list) sphere_table.push_back(sphere);
+
+    std::vector<CullResult> results;
+    std::vector<uint8_t>    box_hints;
+    std::vector<uint8_t>    sphere_hints;
+    bool                    table_match = true;
+    uint32_t                counts[3] = {0, 0, 0};
+    for(uint32_t pass = 0; pass < 2; pass++)
+    {
+        ortho.classify(box_table, results, &box_hints);
+        for(size_t i = 0; i < box_list.size(); i++)
+        {
+            table_match = table_match && results[i] == ortho.classify(box_list[i]);
+            if(pass == 0) counts[static_cast<int>(results[i])]++;
+        }
+        ortho.classify(sphere_table, results, &sphere_hints);
+        for(size_t i = 0; i < sphere_list.size(); i++)
+            table_match = table_match && results[i] == ortho.classify(sphere_list[i]);
+    }
+    logmsg("Ortho frustum boxes: %u outside, %u intersecting, %u inside", counts[0], counts[1],
+           counts[2]);
+    check("Box and sphere tables match the single tests", table_match);
+
+    // Looking down -z: in front of, behind and across the near plane
+    check("Box in front of the camera is inside",
+          ortho.classify(box_at(0.0f, 0.0f, -50.0f, 1.0f)) == CullResult::INSIDE);
+    check("Box behind the camera is outside",
+          ortho.classify(box_at(0.0f, 0.0f, 5.0f, 1.0f)) == CullResult::OUTSIDE);
+    check("Box across the near plane is intersecting",
+          ortho.classify(box_at(0.0f, 0.0f, -1.0f, 0.5f)) == CullResult::INTERSECTING);
+}
+
+} // namespace cg
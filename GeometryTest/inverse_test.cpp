@@ -0,0 +1,115 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+namespace
+{
+
+// Largest difference from the identity allowed for M * inverse(M)
+constexpr float TOLERANCE = 1.0e-5f;
+
+float identity_error(const Matrix4x4 &m)
+{
+    float err = 0.0f;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++)
+            err = std::fmax(err, std::fabs(m.m(r, c) - ((r == c) ? 1.0f : 0.0f)));
+    }
+    return err;
+}
+
+// Matrix from its elements in row order
+Matrix4x4 from_rows(const float rows[4][4])
+{
+    Matrix4x4 m;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++) m.m(r, c) = rows[r][c];
+    }
+    return m;
+}
+
+// Rotation by angle radians in the plane of axes i and j
+Matrix4x4 rotation(uint32_t i, uint32_t j, float angle)
+{
+    Matrix4x4 m;
+    m.m(i, i) = std::cos(angle);
+    m.m(j, j) = std::cos(angle);
+    m.m(j, i) = std::sin(angle);
+    m.m(i, j) = -std::sin(angle);
+    return m;
+}
+
+float difference(const Matrix4x4 &a, const Matrix4x4 &b)
+{
+    float err = 0.0f;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++) err = std::fmax(err, std::fabs(a.m(r, c) - b.m(r, c)));
+    }
+    return err;
+}
+
+} // namespace
+
+void test_inverse()
+{
+    logmsg("\nMatrix4x4 inverses\n");
+
+    // General (projective) matrix
+    const float general_rows[4][4] = {{1.8f, -0.2f, 0.3f, 3.0f},
+                                      {0.4f, 0.45f, -0.6f, -1.0f},
+                                      {-0.5f, 0.1f, 1.4f, 2.0f},
+                                      {0.1f, 0.0f, -0.25f, 1.0f}};
+    Matrix4x4   general = from_rows(general_rows);
+    check("General inverse: M * inverse is the identity",
+          identity_error(general * general.get_inverse()) < TOLERANCE &&
+              identity_error(general.get_inverse() * general) < TOLERANCE);
+
+    // Affine matrix with non-uniform scale and shear
+    const float affine_rows[4][4] = {{1.0f, 0.5f, 0.0f, -4.0f},
+                                     {2.8f, 0.35f, 0.0f, 2.0f},
+                                     {0.0f, 0.2f, 0.25f, 1.0f},
+                                     {0.0f, 0.0f, 0.0f, 1.0f}};
+    Matrix4x4   affine = from_rows(affine_rows);
+    check("Affine inverse: M * inverse is the identity",
+          identity_error(affine * affine.get_affine_inverse()) < TOLERANCE);
+    check("Affine inverse matches the general inverse",
+          difference(affine.get_affine_inverse(), affine.get_inverse()) < TOLERANCE);
+
+    // Orthographic projection (affine, as used by reshape)
+    Matrix4x4 ortho;
+    ortho.m00() = 2.0f / 640.0f;
+    ortho.m11() = 2.0f / 480.0f;
+    ortho.m22() = -2.0f / 99.0f;
+    ortho.m03() = -1.0f;
+    ortho.m13() = -1.0f;
+    ortho.m23() = -101.0f / 99.0f;
+    HPoint3 corner = ortho.get_affine_inverse() * Point3(1.0f, 1.0f, 0.0f);
+    logmsg("Inverse orthographic maps (1, 1) to (%.2f, %.2f)", corner.x, corner.y);
+    check("Orthographic inverse maps NDC back to the window",
+          std::fabs(corner.x - 640.0f) < 1.0e-3f && std::fabs(corner.y - 480.0f) < 1.0e-3f);
+
+    // Rigid body matrix: rotations about z and x, then a translation
+    Matrix4x4 rigid = rotation(0, 1, 0.6f) * rotation(1, 2, -1.2f);
+    rigid.m03() = 1.0f;
+    rigid.m13() = -2.0f;
+    rigid.m23() = 5.0f;
+    check("Rigid inverse: M * inverse is the identity",
+          identity_error(rigid * rigid.get_rigid_inverse()) < TOLERANCE);
+    check("Rigid inverse matches the affine inverse",
+          difference(rigid.get_rigid_inverse(), rigid.get_affine_inverse()) < TOLERANCE);
+
+    // Singular matrices (logs a message) give the identity
+    Matrix4x4 singular;
+    singular.m11() = 0.0f;
+    check("Singular general inverse is the identity", singular.get_inverse() == Matrix4x4());
+    check("Singular affine inverse is the identity", singular.get_affine_inverse() == Matrix4x4());
+}
+
+} // namespace cg
@@ -9,6 +9,8 @@
 //
 //============================================================================
 
+#include "test_check.hpp"
+
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -16,13 +18,42 @@ namespace cg
 {
 
 void vector_test_module1();
+void test_matrix_product();
+void test_matrix_batch();
+void test_point_arrays();
+void test_inverse();
+void test_vector_kernels();
+void test_quaternion();
+void test_matrix3x2();
+void test_random();
+void test_segment2_batch();
+void test_segment2_grid();
+void test_segment2_sweep();
+void test_mesh_bvh();
+void test_ray_packets();
+void test_mesh_indices();
+void test_bounds();
+void test_frustum();
+void test_segment2_clip();
+void test_predicates();
+
+uint32_t g_check_failures = 0;
+
+// Current log file
+static FILE *lfile = NULL;
+
+// Close the current log file and log to another
+void open_log(const char *filename)
+{
+    if(lfile != NULL) { fclose(lfile); }
+    lfile = fopen(filename, "w");
+}
 
 // Simple logging function
 void logmsg(const char *message, ...)
 {
     // Open file if not already opened
-    static FILE *lfile = NULL;
-    if(lfile == NULL) { lfile = fopen("GeometryTest_Module1.log", "w"); }
+    if(lfile == NULL) { open_log("GeometryTest_Module1.log"); }
 
     va_list arg;
     va_start(arg, message);
@@ -32,6 +63,12 @@ void logmsg(const char *message, ...)
     va_end(arg);
 }
 
+void check(const char *name, bool ok)
+{
+    logmsg("  %-60s %s", name, ok ? "ok" : "FAILED");
+    if(!ok) { g_check_failures++; }
+}
+
 } // namespace cg
 
 /**
@@ -40,5 +77,29 @@ void logmsg(const char *message, ...)
 int main(int argc, char *argv[])
 {
     cg::vector_test_module1();
+
+    // Algorithm checks go to their own log (compared with
+    // GeometryTest_Algorithms_solution.log)
+    cg::open_log("GeometryTest_Algorithms.log");
+    cg::logmsg("Geometry Algorithm Tests");
+    cg::test_matrix_product();
+    cg::test_matrix_batch();
+    cg::test_point_arrays();
+    cg::test_inverse();
+    cg::test_vector_kernels();
+    cg::test_quaternion();
+    cg::test_matrix3x2();
+    cg::test_random();
+    cg::test_segment2_batch();
+    cg::test_segment2_grid();
+    cg::test_segment2_sweep();
+    cg::test_mesh_bvh();
+    cg::test_ray_packets();
+    cg::test_mesh_indices();
+    cg::test_bounds();
+    cg::test_frustum();
+    cg::test_segment2_clip();
+    cg::test_predicates();
+    cg::logmsg("\n%u checks failed", cg::g_check_failures);
     return 1;
 }
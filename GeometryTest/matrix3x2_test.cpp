@@ -0,0 +1,93 @@
+#include "geometry/geometry.hpp"
+#include "scene/transform_node_2d.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Largest element difference allowed between equivalent matrices
+constexpr float TOLERANCE = 1.0e-5f;
+
+// Largest difference between a 3x2 matrix and the x, y part of a 4x4 matrix
+float difference(const Matrix3x2 &a, const Matrix4x4 &b)
+{
+    float d[6] = {a.m00() - b.m00(), a.m01() - b.m01(), a.m02() - b.m03(),
+                  a.m10() - b.m10(), a.m11() - b.m11(), a.m12() - b.m13()};
+    float err = 0.0f;
+    for(float e : d) err = std::fmax(err, std::fabs(e));
+    return err;
+}
+
+bool same(const Point2 &a, const Point2 &b) { return a.x == b.x && a.y == b.y; }
+
+} // namespace
+
+void test_matrix3x2()
+{
+    logmsg("\nMatrix3x2 and TransformNode2D\n");
+
+    // The same operations on a 3x2 and a 4x4 matrix
+    Matrix3x2 m;
+    Matrix4x4 m4;
+    m.translate(3.0f, -2.0f);
+    m4.translate(3.0f, -2.0f, 0.0f);
+    m.rotate(30.0f);
+    m4.rotate_z(30.0f);
+    m.scale(2.0f, 0.5f);
+    m4.scale(2.0f, 0.5f, 1.0f);
+    check("Matrix3x2 operations match Matrix4x4", difference(m, m4) < TOLERANCE);
+    check("get_matrix4x4 expands to the 4x4 matrix",
+          difference(m, m.get_matrix4x4()) == 0.0f && m.get_matrix4x4().m22() == 1.0f &&
+              m.get_matrix4x4().m33() == 1.0f && m.get_matrix4x4().m23() == 0.0f);
+
+    Point2  p(1.5f, -4.0f);
+    Point2  mp = m * p;
+    HPoint3 mp4 = m4 * Point3(p.x, p.y, 0.0f);
+    Vector2 mv = m * Vector2(1.0f, 1.0f);
+    Vector3 mv4 = m4 * Vector3(1.0f, 1.0f, 0.0f);
+    check("Points transform like the 4x4 matrix",
+          std::fabs(mp.x - mp4.x) < TOLERANCE && std::fabs(mp.y - mp4.y) < TOLERANCE);
+    check("Vectors ignore the translation",
+          std::fabs(mv.x - mv4.x) < TOLERANCE && std::fabs(mv.y - mv4.y) < TOLERANCE);
+
+    // Composition and inverse
+    Matrix3x2 r = Matrix3x2::rotation(-45.0f);
+    Matrix3x2 rm = m;
+    rm *= r;
+    check("*= matches *", rm == m * r);
+    Matrix3x2 identity = m * m.get_inverse();
+    check("M * inverse is the identity",
+          std::fabs(identity.m00() - 1.0f) < TOLERANCE &&
+              std::fabs(identity.m11() - 1.0f) < TOLERANCE &&
+              std::fabs(identity.m01()) < TOLERANCE && std::fabs(identity.m10()) < TOLERANCE &&
+              std::fabs(identity.m02()) < TOLERANCE && std::fabs(identity.m12()) < TOLERANCE);
+    check("Singular matrix inverse (logs a message) is the identity",
+          Matrix3x2::scaling(0.0f, 1.0f).get_inverse() == Matrix3x2());
+
+    // Batch transforms match the single point transform
+    std::vector<Point2> points;
+    for(int32_t i = 0; i < 7; i++) points.push_back(Point2(0.5f * i - 1.0f, 2.0f - i));
+    std::vector<Point2> moved;
+    m.transform_points(points, moved);
+    bool batch_match = moved.size() == points.size();
+    for(size_t i = 0; batch_match && i < points.size(); i++)
+        batch_match = same(moved[i], m * points[i]);
+    check("Batch point transform matches the operator", batch_match);
+
+    // TransformNode2D keeps its operations as a 3x2 matrix
+    TransformNode2D node;
+    node.translate(3.0f, -2.0f);
+    node.rotate(30.0f);
+    node.scale(2.0f, 0.5f);
+    check("TransformNode2D matches the Matrix3x2 operations", node.get_matrix() == m);
+    node.load_identity();
+    check("load_identity resets the node", node.get_matrix() == Matrix3x2());
+}
+
+} // namespace cg
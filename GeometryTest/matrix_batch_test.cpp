@@ -0,0 +1,130 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Number of inputs: 2 SIMD blocks of 4 and a tail of 3
+constexpr size_t COUNT = 11;
+
+// Deterministic inputs with a mix of signs
+std::vector<Point3> sample_points()
+{
+    std::vector<Point3> points;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        float f = static_cast<float>(i);
+        points.push_back(Point3(0.5f * f - 2.0f, 3.0f - 0.25f * f * f, 1.25f * (f - 5.0f)));
+    }
+    return points;
+}
+
+std::vector<Vector3> sample_vectors()
+{
+    std::vector<Vector3> vectors;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        float f = static_cast<float>(i);
+        vectors.push_back(Vector3(1.0f - 0.75f * f, 0.125f * f, 2.0f - 0.5f * f));
+    }
+    return vectors;
+}
+
+// Perspective-like matrix: w = 2 - z, so a point with z = 2 has w = 0 (and
+// is not divided)
+Matrix4x4 sample_matrix()
+{
+    const float rows[4][4] = {{0.8f, -0.6f, 0.1f, 0.5f},
+                              {0.6f, 0.8f, -0.2f, -1.0f},
+                              {0.05f, 0.3f, 0.9f, 2.0f},
+                              {0.0f, 0.0f, -1.0f, 2.0f}};
+    Matrix4x4   m;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++) m.m(r, c) = rows[r][c];
+    }
+    return m;
+}
+
+bool same(const HPoint3 &a, const HPoint3 &b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+bool same(const Point3 &a, const Point3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+bool same(const Vector3 &a, const Vector3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+} // namespace
+
+void test_matrix_batch()
+{
+    logmsg("\nMatrix4x4 batch transforms\n");
+
+    Matrix4x4            m = sample_matrix();
+    std::vector<Point3>  points = sample_points();
+    std::vector<Vector3> vectors = sample_vectors();
+    points[7] = Point3(1.0f, -1.0f, 2.0f); // w = 0
+
+    // Pointer overloads against the single element operators
+    std::vector<HPoint3> hp(COUNT);
+    std::vector<Point3>  pp(COUNT);
+    std::vector<Vector3> vv(COUNT);
+    m.transform_points(points.data(), hp.data(), COUNT);
+    m.transform_points(points.data(), pp.data(), COUNT);
+    m.transform_vectors(vectors.data(), vv.data(), COUNT);
+    bool hpoints_match = true;
+    bool points_match = true;
+    bool vectors_match = true;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        hpoints_match = hpoints_match && same(hp[i], m * points[i]);
+        points_match = points_match && same(pp[i], (m * points[i]).to_cartesian());
+        vectors_match = vectors_match && same(vv[i], m * vectors[i]);
+    }
+    check("Batch HPoint3 transform matches the operator", hpoints_match);
+    check("Batch Point3 transform matches the operator and divide", points_match);
+    check("Batch Vector3 transform matches the operator", vectors_match);
+    check("Point with w = 0 is not divided",
+          hp[7].w == 0.0f && pp[7].x == hp[7].x && pp[7].y == hp[7].y && pp[7].z == hp[7].z);
+
+    // In place (same element type)
+    std::vector<Point3>  in_place = points;
+    std::vector<Vector3> in_place_vectors = vectors;
+    m.transform_points(in_place.data(), in_place.data(), COUNT);
+    m.transform_vectors(in_place_vectors.data(), in_place_vectors.data(), COUNT);
+    bool in_place_match = true;
+    for(size_t i = 0; i < COUNT; i++)
+        in_place_match = in_place_match && same(in_place[i], pp[i]) &&
+                         same(in_place_vectors[i], vv[i]);
+    check("In-place batch transforms match", in_place_match);
+
+    // Counts below one SIMD block and zero leave the rest untouched
+    std::vector<Point3> partial(COUNT, Point3(9.0f, 9.0f, 9.0f));
+    m.transform_points(points.data(), partial.data(), 3);
+    m.transform_points(points.data(), partial.data() + 3, 0);
+    check("Short batch writes only count elements",
+          same(partial[2], pp[2]) && same(partial[3], Point3(9.0f, 9.0f, 9.0f)));
+
+    // Vector overloads resize the destination
+    std::vector<HPoint3> hp_list(1);
+    std::vector<Point3>  p_list;
+    std::vector<Vector3> v_list(20);
+    m.transform_points(points, hp_list);
+    m.transform_points(points, p_list);
+    m.transform_vectors(vectors, v_list);
+    check("Vector overloads resize the destination",
+          hp_list.size() == COUNT && p_list.size() == COUNT && v_list.size() == COUNT);
+    check("Vector overloads match the pointer overloads",
+          same(hp_list[10], hp[10]) && same(p_list[10], pp[10]) && same(v_list[10], vv[10]));
+    std::vector<Point3> empty_list(4);
+    m.transform_points(std::vector<Point3>(), empty_list);
+    check("Empty list gives an empty result", empty_list.empty());
+}
+
+} // namespace cg
@@ -0,0 +1,104 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+namespace
+{
+
+// Largest difference allowed from the scalar reference. The kernels keep the
+// reference's operation order, but the reference below may be contracted to
+// fused multiply-adds when the compiler targets FMA.
+constexpr float TOLERANCE = 1.0e-4f;
+
+// Matrix with distinct elements and a non-trivial bottom row
+Matrix4x4 sample_matrix(float offset)
+{
+    Matrix4x4 m;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++)
+            m.m(r, c) = offset + 0.25f * r - 0.5f * c + 0.125f * (r * c);
+    }
+    return m;
+}
+
+// Row r of m applied to (x, y, z, w)
+float row_dot(const Matrix4x4 &m, uint32_t r, float x, float y, float z, float w)
+{
+    return m.m(r, 0) * x + m.m(r, 1) * y + m.m(r, 2) * z + m.m(r, 3) * w;
+}
+
+bool matches_product(const Matrix4x4 &a, const Matrix4x4 &b, const Matrix4x4 &p)
+{
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++)
+        {
+            float ref = row_dot(a, r, b.m(0, c), b.m(1, c), b.m(2, c), b.m(3, c));
+            if(std::fabs(p.m(r, c) - ref) > TOLERANCE) return false;
+        }
+    }
+    return true;
+}
+
+bool matches_column(const Matrix4x4 &m, float x, float y, float z, float w, const HPoint3 &p)
+{
+    return std::fabs(p.x - row_dot(m, 0, x, y, z, w)) <= TOLERANCE &&
+           std::fabs(p.y - row_dot(m, 1, x, y, z, w)) <= TOLERANCE &&
+           std::fabs(p.z - row_dot(m, 2, x, y, z, w)) <= TOLERANCE &&
+           std::fabs(p.w - row_dot(m, 3, x, y, z, w)) <= TOLERANCE;
+}
+
+} // namespace
+
+void test_matrix_product()
+{
+    logmsg("\nMatrix4x4 products\n");
+
+    Matrix4x4 a = sample_matrix(1.0f);
+    Matrix4x4 b = sample_matrix(-0.75f);
+    Matrix4x4 identity;
+    check("Matrix product matches the scalar product", matches_product(a, b, a * b));
+    check("Product is not commutative for the samples", !(a * b == b * a));
+    check("Identity is a left and right identity", identity * a == a && a * identity == a);
+
+    // *= reads both operands before writing, including a *= a
+    Matrix4x4 c = a;
+    c *= b;
+    Matrix4x4 square = a;
+    square *= square;
+    check("*= matches *", c == a * b);
+    check("Multiplying a matrix by itself in place", square == a * a);
+
+    // Points (w = 1), homogeneous points and vectors (w = 0)
+    HPoint3 hp = a * HPoint3(2.0f, -3.0f, 0.5f, 0.25f);
+    HPoint3 pp = a * Point3(2.0f, -3.0f, 0.5f);
+    Vector3 v = a * Vector3(2.0f, -3.0f, 0.5f);
+    check("HPoint3 transform matches the scalar product",
+          matches_column(a, 2.0f, -3.0f, 0.5f, 0.25f, hp));
+    check("Point3 transform uses w = 1", matches_column(a, 2.0f, -3.0f, 0.5f, 1.0f, pp));
+    check("Vector3 transform ignores the translation",
+          std::fabs(v.x - row_dot(a, 0, 2.0f, -3.0f, 0.5f, 0.0f)) <= TOLERANCE &&
+              std::fabs(v.y - row_dot(a, 1, 2.0f, -3.0f, 0.5f, 0.0f)) <= TOLERANCE &&
+              std::fabs(v.z - row_dot(a, 2, 2.0f, -3.0f, 0.5f, 0.0f)) <= TOLERANCE);
+
+    // Scale and translation set by element: exact in float
+    Matrix4x4 t;
+    t.m00() = 2.0f;
+    t.m11() = 4.0f;
+    t.m22() = 8.0f;
+    t.m03() = 1.0f;
+    t.m13() = 2.0f;
+    t.m23() = 3.0f;
+    HPoint3 moved = t * Point3(1.0f, 1.0f, 1.0f);
+    logmsg("Scale and translate map (1, 1, 1) to (%.1f, %.1f, %.1f, %.1f)", moved.x, moved.y,
+           moved.z, moved.w);
+    check("Affine transform is exact for small integers",
+          moved.x == 3.0f && moved.y == 6.0f && moved.z == 11.0f && moved.w == 1.0f);
+}
+
+} // namespace cg
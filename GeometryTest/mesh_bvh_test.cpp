@@ -0,0 +1,133 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+constexpr float FAR_T = 1.0e30f;
+
+// Hierarchy and face list give the same hit and distance
+bool same_hit(const Ray3                  &ray,
+              const std::vector<Point3>   &vertices,
+              const std::vector<uint16_t> &faces,
+              const MeshBVH               &bvh,
+              float                        t_min)
+{
+    RayMeshIntersectResult a = ray.intersect(vertices, faces, t_min);
+    RayMeshIntersectResult b = ray.intersect(bvh, t_min);
+    return a.intersects == b.intersects && a.distance == b.distance &&
+           ray.does_intersect_exist(vertices, faces, t_min) ==
+               ray.does_intersect_exist(bvh, t_min);
+}
+
+} // namespace
+
+void test_mesh_bvh()
+{
+    logmsg("\nMesh BVH\n");
+
+    // Empty mesh
+    std::vector<Point3>   vertices;
+    std::vector<uint16_t> faces;
+    MeshBVH               bvh(vertices, faces);
+    Ray3                  ray(Point3(0.0f, 0.0f, -5.0f), Vector3(0.0f, 0.0f, 1.0f));
+    check("Empty mesh has no triangles", bvh.triangle_count() == 0);
+    check("Ray misses an empty mesh",
+          !ray.intersect(bvh, FAR_T).intersects && !ray.does_intersect_exist(bvh, FAR_T));
+
+    // Cube [-1,1]^3 (12 triangles, counter-clockwise seen from outside)
+    vertices = {Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, -1.0f, -1.0f),
+                Point3(1.0f, 1.0f, -1.0f),   Point3(-1.0f, 1.0f, -1.0f),
+                Point3(-1.0f, -1.0f, 1.0f),  Point3(1.0f, -1.0f, 1.0f),
+                Point3(1.0f, 1.0f, 1.0f),    Point3(-1.0f, 1.0f, 1.0f)};
+    faces = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+             3, 6, 2, 3, 7, 6, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5};
+    bvh.build(vertices, faces);
+    logmsg("Cube: %zu triangles, %zu nodes", bvh.triangle_count(), bvh.node_count());
+
+    // Axis aligned rays (2 zero direction components) from each side
+    const Vector3 axes[6] = {Vector3(1.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f),
+                             Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f),
+                             Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f)};
+    bool axis_hits = true;
+    for(const auto &d : axes)
+    {
+        Ray3                   r(Point3(0.25f, 0.25f, 0.25f) - d * 5.0f, d);
+        RayMeshIntersectResult hit = r.intersect(bvh, FAR_T);
+        axis_hits = axis_hits && hit.intersects && same_hit(r, vertices, faces, bvh, FAR_T);
+        logmsg("Direction (%.0f, %.0f, %.0f) hits at %.2f", d.x, d.y, d.z, hit.distance);
+    }
+    check("Axis aligned rays hit the cube", axis_hits);
+
+    // Rays parallel to the y slab: inside it, on its boundary (the plane of
+    // the top face) and outside it
+    Ray3 inside(Point3(-5.0f, 0.5f, 0.0f), Vector3(1.0f, 0.0f, 0.0f));
+    Ray3 boundary(Point3(-5.0f, 1.0f, 0.5f), Vector3(1.0f, 0.0f, 0.0f));
+    Ray3 outside(Point3(-5.0f, 1.5f, 0.0f), Vector3(1.0f, 0.0f, 0.0f));
+    check("Ray parallel to a slab, inside it, hits", inside.intersect(bvh, FAR_T).intersects);
+    check("Ray on a slab boundary matches the face list",
+          same_hit(boundary, vertices, faces, bvh, FAR_T));
+    check("Ray parallel to a slab, outside it, misses",
+          !outside.intersect(bvh, FAR_T).intersects &&
+              same_hit(outside, vertices, faces, bvh, FAR_T));
+
+    // Origin inside the cube hits the exit face
+    Ray3 from_center(Point3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+    check("Ray from inside hits the far face at 1",
+          from_center.intersect(bvh, FAR_T).distance == 1.0f);
+
+    // Hits beyond t_min are not reported
+    check("Hit beyond t_min is ignored",
+          !ray.intersect(bvh, 3.5f).intersects && !ray.does_intersect_exist(bvh, 3.5f) &&
+              same_hit(ray, vertices, faces, bvh, 3.5f));
+
+    // Flat mesh in the z = 0 plane: its box has zero thickness in z
+    vertices = {Point3(0.0f, 0.0f, 0.0f), Point3(1.0f, 0.0f, 0.0f), Point3(1.0f, 1.0f, 0.0f),
+                Point3(0.0f, 1.0f, 0.0f)};
+    faces = {0, 1, 2, 0, 2, 3};
+    bvh.build(vertices, faces);
+    Ray3 down(Point3(0.5f, 0.25f, 2.0f), Vector3(0.0f, 0.0f, -1.0f));
+    Ray3 in_plane(Point3(-1.0f, 0.5f, 0.0f), Vector3(1.0f, 0.0f, 0.0f));
+    check("Ray hits a flat mesh", down.intersect(bvh, FAR_T).distance == 2.0f);
+    check("Ray in the plane of a flat mesh matches the face list",
+          same_hit(in_plane, vertices, faces, bvh, FAR_T));
+
+    // Random triangles against random rays
+    Random random(7);
+    vertices.clear();
+    faces.clear();
+    for(uint16_t i = 0; i < 600; i++)
+    {
+        Point3 c = random_point3(random, 0.0f, 10.0f);
+        vertices.push_back(c);
+        vertices.push_back(c + random_vector3(random, -1.0f, 1.0f));
+        vertices.push_back(c + random_vector3(random, -1.0f, 1.0f));
+        faces.push_back(static_cast<uint16_t>(3 * i));
+        faces.push_back(static_cast<uint16_t>(3 * i + 1));
+        faces.push_back(static_cast<uint16_t>(3 * i + 2));
+    }
+    bvh.build(vertices, faces);
+    bool     match = true;
+    uint32_t hit_count = 0;
+    for(uint32_t i = 0; i < 500; i++)
+    {
+        // Origins on the z = -5 plane, towards points among the triangles
+        Point2                 xy = random_point2(random, -5.0f, 15.0f);
+        Point3                 o(xy.x, xy.y, -5.0f);
+        Ray3                   r(o, random_point3(random, 0.0f, 10.0f) - o, true);
+        RayMeshIntersectResult a = r.intersect(vertices, faces, FAR_T);
+        RayMeshIntersectResult b = r.intersect(bvh, FAR_T);
+        match = match && a.intersects == b.intersects && a.distance == b.distance &&
+                a.face_index == b.face_index && same_hit(r, vertices, faces, bvh, FAR_T);
+        if(a.intersects) hit_count++;
+    }
+    logmsg("Random triangles: %zu nodes, %u of 500 rays hit", bvh.node_count(), hit_count);
+    check("Random rays match the face list", match);
+}
+
+} // namespace cg
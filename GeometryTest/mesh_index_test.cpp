@@ -0,0 +1,108 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+constexpr float FAR_T = 1.0e30f;
+
+// Results are identical
+bool same_result(const RayMeshIntersectResult &a, const RayMeshIntersectResult &b)
+{
+    return a.intersects == b.intersects && a.distance == b.distance &&
+           a.barycentric_u == b.barycentric_u && a.barycentric_v == b.barycentric_v &&
+           a.face_index == b.face_index;
+}
+
+} // namespace
+
+void test_mesh_indices()
+{
+    logmsg("\nMesh index types\n");
+
+    // Random triangles with 16 and 32-bit copies of the face list and a
+    // vertex and normal copy of the vertex list
+    Random                       random(99);
+    std::vector<Point3>          vertices;
+    std::vector<VertexAndNormal> vertex_normals;
+    std::vector<uint16_t>        faces16;
+    std::vector<uint32_t>        faces32;
+    for(uint32_t i = 0; i < 900; i++)
+    {
+        Point3 c = random_point3(random, 0.0f, 10.0f);
+        vertices.push_back(c);
+        vertices.push_back(c + random_vector3(random, -1.0f, 1.0f));
+        vertices.push_back(c + random_vector3(random, -1.0f, 1.0f));
+    }
+    for(uint32_t i = 0; i < vertices.size(); i++)
+    {
+        vertex_normals.push_back(VertexAndNormal(vertices[i]));
+        faces16.push_back(static_cast<uint16_t>(i));
+        faces32.push_back(i);
+    }
+    MeshBVH bvh16(vertices, faces16);
+    MeshBVH bvh32(vertices, faces32);
+    MeshBVH bvh_vn(vertex_normals, faces32);
+
+    bool match = true;
+    for(uint32_t i = 0; i < 300; i++)
+    {
+        Point2 xy = random_point2(random, -5.0f, 15.0f);
+        Point3 o(xy.x, xy.y, -5.0f);
+        Ray3   r(o, random_point3(random, 0.0f, 10.0f) - o, true);
+
+        RayMeshIntersectResult a = r.intersect(vertices, faces16, FAR_T);
+        match = match && same_result(a, r.intersect(vertices, faces32, FAR_T)) &&
+                same_result(a, r.intersect(vertex_normals, faces16, FAR_T)) &&
+                same_result(a, r.intersect(vertex_normals, faces32, FAR_T)) &&
+                same_result(a, r.intersect(bvh16, FAR_T)) &&
+                same_result(a, r.intersect(bvh32, FAR_T)) &&
+                same_result(a, r.intersect(bvh_vn, FAR_T));
+        bool exists = r.does_intersect_exist(vertices, faces16, FAR_T);
+        match = match && exists == a.intersects &&
+                exists == r.does_intersect_exist(vertices, faces32, FAR_T) &&
+                exists == r.does_intersect_exist(vertex_normals, faces32, FAR_T) &&
+                exists == r.does_intersect_exist(bvh32, FAR_T);
+    }
+    check("16 and 32-bit indices give the same results", match);
+
+    // Span over the first 100 triangles (no copy) matches a copy of them
+    Span<const Point3>     first_vertices(vertices.data(), 300);
+    Span<const uint32_t>   first_faces(faces32.data(), 300);
+    std::vector<uint32_t>  first_copy(faces32.begin(), faces32.begin() + 300);
+    Point3                 centroid((vertices[0].x + vertices[1].x + vertices[2].x) / 3.0f,
+                                    (vertices[0].y + vertices[1].y + vertices[2].y) / 3.0f, -20.0f);
+    Ray3                   up(centroid, Vector3(0.0f, 0.0f, 1.0f));
+    RayMeshIntersectResult part = up.intersect(first_vertices, first_faces, FAR_T);
+    check("Span over part of a mesh matches a copy",
+          part.intersects && part.face_index < 100 &&
+              same_result(part, up.intersect(vertices, first_copy, FAR_T)));
+
+    // A triangle whose vertices are past the 16-bit index range
+    vertices.assign(70000, Point3(100.0f, 100.0f, 100.0f));
+    vertices[65536] = Point3(-1.0f, -1.0f, 0.0f);
+    vertices[65537] = Point3(1.0f, -1.0f, 0.0f);
+    vertices[69999] = Point3(0.0f, 1.0f, 0.0f);
+    faces32 = {0, 1, 2, 65536, 65537, 69999};
+    MeshBVH                large(vertices, faces32);
+    Ray3                   down(Point3(0.0f, 0.0f, 5.0f), Vector3(0.0f, 0.0f, -1.0f));
+    RayMeshIntersectResult hit = down.intersect(vertices, faces32, FAR_T);
+    logmsg("Vertex indices above 65535: hit %d at %.2f, face %u", hit.intersects ? 1 : 0,
+           hit.distance, hit.face_index);
+    check("Face with 32-bit vertex indices is hit", hit.intersects && hit.face_index == 1);
+    check("Hierarchy over 32-bit indices matches",
+          same_result(hit, down.intersect(large, FAR_T)));
+
+    // Empty lists
+    std::vector<uint32_t> no_faces;
+    check("Empty face list has no hits",
+          !down.intersect(vertices, no_faces, FAR_T).intersects &&
+              !down.does_intersect_exist(vertices, no_faces, FAR_T));
+}
+
+} // namespace cg
@@ -0,0 +1,105 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Number of elements: 2 SIMD blocks of 4 and a tail of 3
+constexpr size_t COUNT = 11;
+
+bool aligned(const float *p) { return reinterpret_cast<uintptr_t>(p) % SIMD_ALIGNMENT == 0; }
+
+bool same(const Point3 &a, const Point3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+bool same(const Vector3 &a, const Vector3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+} // namespace
+
+void test_point_arrays()
+{
+    logmsg("\nStructure-of-arrays containers\n");
+
+    std::vector<Point3>  points;
+    std::vector<Vector3> vectors;
+    std::vector<Point2>  points2;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        float f = static_cast<float>(i);
+        points.push_back(Point3(f, -2.0f * f, 0.5f * f + 1.0f));
+        vectors.push_back(Vector3(1.0f - f, 0.25f * f, -f));
+        points2.push_back(Point2(3.0f * f, 1.0f - f));
+    }
+
+    // AoS -> SoA -> AoS
+    Point3Array         soa(points);
+    std::vector<Point3> back;
+    soa.copy_to(back);
+    bool round_trip = back.size() == COUNT;
+    for(size_t i = 0; round_trip && i < COUNT; i++) round_trip = same(back[i], points[i]);
+    check("Point3Array round trip", round_trip);
+    check("Coordinates are stored in separate arrays",
+          soa.x()[4] == 4.0f && soa.y()[4] == -8.0f && soa.z()[4] == 3.0f);
+    check("Coordinate arrays are SIMD aligned",
+          aligned(soa.x()) && aligned(soa.y()) && aligned(soa.z()));
+
+    Point2Array         soa2;
+    std::vector<Point2> back2(COUNT);
+    soa2.assign(points2.data(), COUNT);
+    soa2.copy_to(back2.data());
+    check("Point2Array round trip", soa2.size() == COUNT && back2[10].x == 30.0f &&
+                                        back2[10].y == -9.0f && aligned(soa2.y()));
+
+    // Element access and growth
+    soa.set(2, Point3(7.0f, 8.0f, 9.0f));
+    soa.push_back(Point3(-1.0f, -2.0f, -3.0f));
+    check("get returns what set stored", same(soa.get(2), Point3(7.0f, 8.0f, 9.0f)));
+    check("push_back appends",
+          soa.size() == COUNT + 1 && same(soa.get(COUNT), Point3(-1.0f, -2.0f, -3.0f)));
+    soa.resize(3);
+    check("resize keeps the leading elements", soa.size() == 3 && same(soa.get(0), points[0]));
+    soa.clear();
+    check("clear empties the array", soa.empty() && soa.size() == 0);
+
+    // Interleaved writes leave the other floats in each vertex untouched
+    Point3Array        three(points);
+    std::vector<float> vbo(COUNT * 5, -1.0f);
+    three.write_interleaved(vbo.data(), 5);
+    check("write_interleaved places xyz at the stride",
+          vbo[5 * 6] == 6.0f && vbo[5 * 6 + 1] == -12.0f && vbo[5 * 6 + 2] == 4.0f &&
+              vbo[5 * 6 + 3] == -1.0f && vbo[5 * 6 + 4] == -1.0f);
+
+    // SoA transforms match the array-of-structs transforms
+    const float rows[4][4] = {{0.5f, -0.25f, 0.75f, 1.0f},
+                              {0.125f, 1.5f, -0.5f, 2.0f},
+                              {-0.75f, 0.25f, 1.0f, -3.0f},
+                              {0.0f, 0.0f, 0.125f, 1.0f}};
+    Matrix4x4   m;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++) m.m(r, c) = rows[r][c];
+    }
+    std::vector<Point3>  aos_points(COUNT);
+    std::vector<Vector3> aos_vectors(COUNT);
+    m.transform_points(points.data(), aos_points.data(), COUNT);
+    m.transform_vectors(vectors.data(), aos_vectors.data(), COUNT);
+
+    Point3Array  soa_points;
+    Vector3Array soa_vectors(vectors);
+    m.transform_points(three, soa_points);
+    m.transform_vectors(soa_vectors, soa_vectors); // In place
+    bool transforms_match = soa_points.size() == COUNT && soa_vectors.size() == COUNT;
+    for(size_t i = 0; transforms_match && i < COUNT; i++)
+    {
+        transforms_match = same(soa_points.get(i), aos_points[i]) &&
+                           same(soa_vectors.get(i), aos_vectors[i]);
+    }
+    check("SoA transforms match the AoS transforms", transforms_match);
+}
+
+} // namespace cg
@@ -0,0 +1,86 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+namespace
+{
+
+int sign(double x) { return (x > 0.0) ? 1 : ((x < 0.0) ? -1 : 0); }
+
+} // namespace
+
+void test_predicates()
+{
+    logmsg("\nOrientation and incircle predicates\n");
+
+    // Simple cases (float points)
+    Point2 a(0.0f, 0.0f);
+    Point2 b(4.0f, 0.0f);
+    Point2 c(0.0f, 3.0f);
+    check("Counter-clockwise is positive", orient2d(a, b, c) > 0.0);
+    check("Clockwise is negative", orient2d(a, c, b) < 0.0);
+    check("Collinear is zero", orient2d(a, b, Point2(-7.5f, 0.0f)) == 0.0);
+    check("Repeated point is zero", orient2d(a, a, c) == 0.0);
+
+    // Points near the line y = x, 2^-53 apart (the spacing of doubles near
+    // 0.5): p = (0.5 + i u, 0.5 + j u), q = (12, 12), r = (24, 24). Exactly,
+    // orient2d(p, q, r) = -12 (px - py), so its sign is the sign of j - i. A
+    // plain double determinant gets many of these wrong.
+    const double u = std::ldexp(1.0, -53);
+    uint32_t     wrong = 0;
+    uint32_t     inconsistent = 0;
+    for(int32_t i = 0; i < 128; i++)
+    {
+        for(int32_t j = 0; j < 128; j++)
+        {
+            double px = 0.5 + i * u;
+            double py = 0.5 + j * u;
+            int    s = sign(orient2d(px, py, 12.0, 12.0, 24.0, 24.0));
+            int    expected = (j > i) - (j < i);
+            if(s != expected) wrong++;
+
+            // Exact signs are invariant under cyclic order and flip when 2
+            // points are swapped
+            if(sign(orient2d(12.0, 12.0, 24.0, 24.0, px, py)) != s ||
+               sign(orient2d(24.0, 24.0, px, py, 12.0, 12.0)) != s ||
+               sign(orient2d(12.0, 12.0, px, py, 24.0, 24.0)) != -s)
+                inconsistent++;
+        }
+    }
+    check("orient2d signs near a line are exact", wrong == 0);
+    check("orient2d signs are consistent under permutation", inconsistent == 0);
+    check("orient2d agrees with orient2d_exact",
+          sign(orient2d(0.5 + u, 0.5, 12.0, 12.0, 24.0, 24.0)) ==
+              sign(orient2d_exact(0.5 + u, 0.5, 12.0, 12.0, 24.0, 24.0)));
+
+    // Points exactly on the circle of radius 5 (integer coordinates),
+    // counter-clockwise
+    const double cx[3] = {5.0, -4.0, 0.0};
+    const double cy[3] = {0.0, 3.0, -5.0};
+    auto         in_circle = [&](double x, double y)
+    { return incircle(cx[0], cy[0], cx[1], cy[1], cx[2], cy[2], x, y); };
+    check("Center is inside the circle", in_circle(0.0, 0.0) > 0.0);
+    check("Far point is outside the circle", in_circle(6.0, 0.0) < 0.0);
+    check("Cocircular point is zero", in_circle(3.0, 4.0) == 0.0 && in_circle(-3.0, -4.0) == 0.0);
+    check("Clockwise order flips the sign",
+          incircle(cx[0], cy[0], cx[2], cy[2], cx[1], cy[1], 0.0, 0.0) < 0.0);
+
+    // Points within a few ulps of (-5, 0) on the circle: inside when x > -5
+    const double ulp = std::ldexp(1.0, -50); // Spacing of doubles in [4, 8)
+    wrong = 0;
+    for(int32_t k = -64; k <= 64; k++)
+    {
+        int expected = (k > 0) - (k < 0);
+        if(sign(in_circle(-5.0 + k * ulp, 0.0)) != expected) wrong++;
+    }
+    check("incircle signs near the circle are exact", wrong == 0);
+    check("incircle agrees with incircle_exact",
+          sign(in_circle(-5.0 + ulp, 0.0)) ==
+              sign(incircle_exact(cx[0], cy[0], cx[1], cy[1], cx[2], cy[2], -5.0 + ulp, 0.0)));
+}
+
+} // namespace cg
@@ -0,0 +1,146 @@
+#include "geometry/geometry.hpp"
+#include "scene/transform_node.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+namespace
+{
+
+// Largest element difference allowed between equivalent matrices
+constexpr float TOLERANCE = 1.0e-5f;
+
+float difference(const Matrix4x4 &a, const Matrix4x4 &b)
+{
+    float err = 0.0f;
+    for(uint32_t r = 0; r < 4; r++)
+    {
+        for(uint32_t c = 0; c < 4; c++) err = std::fmax(err, std::fabs(a.m(r, c) - b.m(r, c)));
+    }
+    return err;
+}
+
+bool close(const Vector3 &a, const Vector3 &b)
+{
+    return std::fabs(a.x - b.x) < TOLERANCE && std::fabs(a.y - b.y) < TOLERANCE &&
+           std::fabs(a.z - b.z) < TOLERANCE;
+}
+
+bool close(const Point3 &a, const Point3 &b)
+{
+    return std::fabs(a.x - b.x) < TOLERANCE && std::fabs(a.y - b.y) < TOLERANCE &&
+           std::fabs(a.z - b.z) < TOLERANCE;
+}
+
+// Largest deviation of the upper 3x3 from orthonormal columns
+float orthonormal_error(const Matrix4x4 &m)
+{
+    float err = 0.0f;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            float d = m.m(0, i) * m.m(0, j) + m.m(1, i) * m.m(1, j) + m.m(2, i) * m.m(2, j);
+            err = std::fmax(err, std::fabs(d - ((i == j) ? 1.0f : 0.0f)));
+        }
+    }
+    return err;
+}
+
+} // namespace
+
+void test_quaternion()
+{
+    logmsg("\nQuaternions and dual quaternions\n");
+
+    // Axis-angle rotations against the matrix rotation
+    Vector3    axis_a(1.0f, 2.0f, -0.5f);
+    Vector3    axis_b(0.0f, -1.0f, 1.0f);
+    Quaternion qa = Quaternion::from_axis_angle(35.0f, axis_a);
+    Quaternion qb = Quaternion::from_axis_angle(-120.0f, axis_b);
+    Matrix4x4  ma;
+    Matrix4x4  mb;
+    ma.rotate(35.0f, axis_a.x, axis_a.y, axis_a.z);
+    mb.rotate(-120.0f, axis_b.x, axis_b.y, axis_b.z);
+    check("Axis-angle quaternion matches Matrix4x4::rotate",
+          difference(qa.get_matrix(), ma) < TOLERANCE && std::fabs(qa.norm() - 1.0f) < TOLERANCE);
+    Vector3 v(3.0f, -1.0f, 2.0f);
+    check("Quaternion rotate matches the matrix", close(qa.rotate(v), ma * v));
+
+    // Composition: qa * qb applies qb first, like ma * mb
+    check("Quaternion product matches the matrix product",
+          difference((qa * qb).get_matrix(), ma * mb) < TOLERANCE);
+    Quaternion qc = qa;
+    qc *= qb;
+    check("*= matches *", qc == qa * qb);
+    Quaternion round_trip = qa * qa.get_inverse();
+    check("q * inverse(q) is the identity rotation",
+          std::fabs(round_trip.w - 1.0f) < TOLERANCE && std::fabs(round_trip.x) < TOLERANCE &&
+              std::fabs(round_trip.y) < TOLERANCE && std::fabs(round_trip.z) < TOLERANCE);
+    check("Quaternion from a matrix gives the same rotation",
+          std::fabs(std::fabs(Quaternion(mb).dot(qb)) - 1.0f) < TOLERANCE);
+
+    // Dual quaternions against rigid body matrices (rotation, then translation)
+    Vector3   ta(1.0f, -2.0f, 4.0f);
+    Vector3   tb(-3.0f, 0.5f, 2.0f);
+    Matrix4x4 ra;
+    Matrix4x4 rb;
+    ra.translate(ta.x, ta.y, ta.z);
+    ra.rotate(35.0f, axis_a.x, axis_a.y, axis_a.z);
+    rb.translate(tb.x, tb.y, tb.z);
+    rb.rotate(-120.0f, axis_b.x, axis_b.y, axis_b.z);
+    DualQuaternion da(qa, ta);
+    DualQuaternion db(qb, tb);
+    Point3         p(0.5f, 1.5f, -2.0f);
+    check("Dual quaternion matrix matches translate * rotate",
+          difference(da.get_matrix(), ra) < TOLERANCE);
+    check("Dual quaternion transforms points like the matrix",
+          close(da.transform(p), Point3(ra * p)) && close(da.get_translation(), ta));
+    check("Dual quaternion product matches the matrix product",
+          difference((da * db).get_matrix(), ra * rb) < TOLERANCE);
+    check("Dual quaternion inverse undoes the transform",
+          close(da.get_inverse().transform(da.transform(p)), p));
+    check("Dual quaternion from a rigid matrix round trips",
+          difference(DualQuaternion(rb).get_matrix(), rb) < TOLERANCE);
+
+    // TransformNode composes rotations as quaternions; its matrix matches
+    // the same operations applied to a Matrix4x4, including a rotation after
+    // a non-uniform scale
+    TransformNode node;
+    Matrix4x4     expected;
+    node.translate(2.0f, 0.0f, -1.0f);
+    expected.translate(2.0f, 0.0f, -1.0f);
+    node.rotate(35.0f, axis_a);
+    expected.rotate(35.0f, axis_a.x, axis_a.y, axis_a.z);
+    node.scale(2.0f, 2.0f, 2.0f);
+    expected.scale(2.0f, 2.0f, 2.0f);
+    node.rotate_y(50.0f);
+    expected.rotate_y(50.0f);
+    node.translate(1.0f, 1.0f, 0.0f);
+    expected.translate(1.0f, 1.0f, 0.0f);
+    check("TransformNode matches Matrix4x4 operations",
+          difference(node.get_matrix(), expected) < TOLERANCE);
+    node.scale(1.0f, 3.0f, 0.5f);
+    expected.scale(1.0f, 3.0f, 0.5f);
+    node.rotate(qb);
+    expected.rotate(-120.0f, axis_b.x, axis_b.y, axis_b.z);
+    node.translate(0.0f, -2.0f, 1.0f);
+    expected.translate(0.0f, -2.0f, 1.0f);
+    check("Rotation after a non-uniform scale",
+          difference(node.get_matrix(), expected) < 4.0f * TOLERANCE);
+
+    // Many small rotations stay a rotation (no drift into scale or shear)
+    TransformNode spinner;
+    for(int32_t i = 0; i < 3600; i++)
+    {
+        spinner.rotate_x(0.1f);
+        spinner.rotate_z(0.1f);
+    }
+    check("Incremental rotations stay orthonormal",
+          orthonormal_error(spinner.get_matrix()) < TOLERANCE);
+}
+
+} // namespace cg
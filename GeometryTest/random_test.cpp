@@ -0,0 +1,121 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+bool in_unit_interval(const std::vector<float> &values)
+{
+    for(float v : values)
+    {
+        if(!(v >= 0.0f && v < 1.0f)) return false;
+    }
+    return true;
+}
+
+float mean(const std::vector<float> &values)
+{
+    double sum = 0.0;
+    for(float v : values) sum += v;
+    return static_cast<float>(sum / values.size());
+}
+
+} // namespace
+
+void test_random()
+{
+    logmsg("\nRandom number generator\n");
+
+    // The same seed and stream give the same sequence
+    Random   a(12345);
+    Random   b(12345);
+    Random   other_stream(12345, 1);
+    Random   other_seed(12346);
+    uint32_t first[3];
+    bool     same_sequence = true;
+    bool     streams_differ = false;
+    bool     seeds_differ = false;
+    for(int32_t i = 0; i < 64; i++)
+    {
+        uint32_t x = a.next_u32();
+        if(i < 3) first[i] = x;
+        same_sequence = same_sequence && x == b.next_u32();
+        streams_differ = streams_differ || x != other_stream.next_u32();
+        seeds_differ = seeds_differ || x != other_seed.next_u32();
+    }
+    logmsg("Seed 12345 starts %08x %08x %08x", first[0], first[1], first[2]);
+    check("Same seed gives the same sequence", same_sequence);
+    check("Different streams give different sequences", streams_differ);
+    check("Different seeds give different sequences", seeds_differ);
+    a.seed(12345);
+    check("Re-seeding restarts the sequence", a.next_u32() == first[0]);
+
+    // Floats are in [0, 1) and [lo, hi)
+    Random             r(7);
+    std::vector<float> values(1000);
+    bool               in_range = true;
+    for(float &v : values) v = r.next_float();
+    for(int32_t i = 0; i < 1000; i++)
+    {
+        float u = r.uniform(-2.0f, 3.0f);
+        in_range = in_range && u >= -2.0f && u < 3.0f;
+    }
+    check("next_float is in [0, 1)", in_unit_interval(values));
+    check("uniform is in [lo, hi)", in_range);
+    logmsg("Mean of 1000 floats: %.3f", mean(values));
+
+    // fill_uniform: the SIMD lanes (16 or more values) and the scalar tail,
+    // repeatable per seed
+    std::vector<float> filled(1003);
+    std::vector<float> again(1003);
+    Random(99).fill_uniform(filled);
+    Random(99).fill_uniform(again);
+    check("fill_uniform is in [0, 1)", in_unit_interval(filled));
+    check("fill_uniform is repeatable", filled == again);
+    check("fill_uniform fills the tail",
+          filled[1000] != filled[1001] && filled[1001] != filled[1002]);
+    logmsg("Mean of 1003 filled floats: %.3f", mean(filled));
+
+    // Short fills use the scalar generator
+    std::vector<float> short_fill(5);
+    Random             s(99);
+    Random(99).fill_uniform(short_fill);
+    bool matches_scalar = true;
+    for(float v : short_fill) matches_scalar = matches_scalar && v == s.next_float();
+    check("Short fill_uniform matches next_float", matches_scalar);
+
+    // Disk and sphere samples stay inside their bounds
+    std::vector<Point2> disk(500);
+    std::vector<Point3> ball(500);
+    Random              shapes(3);
+    shapes.fill_in_disk(disk.data(), disk.size(), Point2(1.0f, -1.0f), 2.0f);
+    shapes.fill_in_sphere(ball.data(), ball.size(), Point3(0.0f, 5.0f, 0.0f), 0.5f);
+    bool in_disk = true;
+    bool in_ball = true;
+    for(const Point2 &p : disk)
+    {
+        float dx = p.x - 1.0f;
+        float dy = p.y + 1.0f;
+        in_disk = in_disk && dx * dx + dy * dy <= 4.0f * (1.0f + EPSILON);
+    }
+    for(const Point3 &p : ball)
+    {
+        float dy = p.y - 5.0f;
+        in_ball = in_ball && p.x * p.x + dy * dy + p.z * p.z <= 0.25f * (1.0f + EPSILON);
+    }
+    check("fill_in_disk points are inside the disk", in_disk);
+    check("fill_in_sphere points are inside the sphere", in_ball);
+
+    // The per-thread generator can be re-seeded for reproducible runs
+    seed_thread_random(5, 2);
+    float t0 = rand_0_1();
+    seed_thread_random(5, 2);
+    check("seed_thread_random makes rand_0_1 repeatable", rand_0_1() == t0);
+}
+
+} // namespace cg
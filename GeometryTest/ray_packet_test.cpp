@@ -0,0 +1,139 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Relative tolerance for distances. The packet kernels may round differently
+// from the single ray code (e.g. fused multiply-adds).
+constexpr float TOLERANCE = 1.0e-5f;
+
+bool close(float a, float b)
+{
+    return std::fabs(a - b) <= TOLERANCE * std::fmax(1.0f, std::fmax(std::fabs(a), std::fabs(b)));
+}
+
+// Lane results of a packet against the single ray results
+template <uint32_t N, typename Object>
+bool matches_single(const Ray3Packet<N> &packet, const Object &object)
+{
+    RayPacketObjectIntersectResult<N> result = packet.intersect(object);
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        bool                     active = (packet.active >> lane) & 1;
+        RayObjectIntersectResult single = packet.get(lane).intersect(object);
+        bool                     hit = (result.mask >> lane) & 1;
+        if(hit != (active && single.intersects)) return false;
+        if(hit ? !close(result.distance[lane], single.distance) : result.distance[lane] != 0.0f)
+            return false;
+    }
+    return true;
+}
+
+template <uint32_t N>
+bool matches_single(const Ray3Packet<N> &packet,
+                    const Point3         &v0,
+                    const Point3         &v1,
+                    const Point3         &v2)
+{
+    RayPacketTriangleIntersectResult<N> result = packet.intersect(v0, v1, v2);
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        bool                       active = (packet.active >> lane) & 1;
+        RayTriangleIntersectResult single = packet.get(lane).intersect(v0, v1, v2);
+        bool                       hit = (result.mask >> lane) & 1;
+        if(hit != (active && single.intersects)) return false;
+        if(hit && !(close(result.distance[lane], single.distance) &&
+                    close(result.barycentric_u[lane], single.barycentric_u) &&
+                    close(result.barycentric_v[lane], single.barycentric_v)))
+            return false;
+    }
+    return true;
+}
+
+// Rays from a box around the origin towards points near the origin, so
+// about half of them hit the test objects
+std::vector<Ray3> random_rays(Random &random, size_t count)
+{
+    std::vector<Ray3> rays;
+    for(size_t i = 0; i < count; i++)
+    {
+        Point3 o = random_point3(random, -6.0f, 6.0f);
+        Point3 target = random_point3(random, -1.5f, 1.5f);
+        rays.push_back(Ray3(o, target - o, true));
+    }
+    return rays;
+}
+
+// Checks every packet of width N over the rays against a box, a sphere and a
+// triangle
+template <uint32_t N>
+bool packets_match(const std::vector<Ray3> &rays)
+{
+    AABB           box(Point3(-1.0f, -0.5f, -1.0f), Point3(1.0f, 0.5f, 1.0f));
+    BoundingSphere sphere(Point3(0.25f, 0.0f, -0.25f), 1.0f);
+    Point3         v0(-1.0f, -1.0f, 0.0f);
+    Point3         v1(1.0f, -1.0f, 0.5f);
+    Point3         v2(0.0f, 1.0f, 0.0f);
+    for(size_t i = 0; i + N <= rays.size(); i += N)
+    {
+        Ray3Packet<N> packet(&rays[i], N);
+        if(!matches_single(packet, box) || !matches_single(packet, sphere) ||
+           !matches_single(packet, v0, v1, v2))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void test_ray_packets()
+{
+    logmsg("\nRay packets\n");
+
+    Random            random(15);
+    std::vector<Ray3> rays = random_rays(random, 256);
+    check("4-ray packets match single rays", packets_match<4>(rays));
+    check("8-ray packets match single rays", packets_match<8>(rays));
+
+    // set and get round trip, partial packets leave the other lanes inactive
+    Ray3Packet4 partial(rays.data(), 3);
+    Ray3        lane2 = partial.get(2);
+    check("Partial packet activates count lanes", partial.active == 0x7);
+    check("get returns the ray stored in a lane",
+          lane2.o.x == rays[2].o.x && lane2.o.y == rays[2].o.y && lane2.o.z == rays[2].o.z &&
+              lane2.d.x == rays[2].d.x && lane2.d.y == rays[2].d.y && lane2.d.z == rays[2].d.z);
+    partial.set(3, Ray3(Point3(0.0f, 0.0f, -5.0f), Vector3(0.0f, 0.0f, 1.0f)));
+    check("set activates the lane", partial.active == Ray3Packet4::ALL_LANES);
+    AABB box(Point3(-1.0f, -1.0f, -1.0f), Point3(1.0f, 1.0f, 1.0f));
+    check("Partial packet matches single rays", matches_single(partial, box));
+
+    // Axis aligned rays (zero direction components, infinite inverses):
+    // inside a slab, on its boundary and outside it
+    Ray3 slab_rays[8] = {Ray3(Point3(-5.0f, 0.5f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)),
+                         Ray3(Point3(-5.0f, 1.0f, 0.5f), Vector3(1.0f, 0.0f, 0.0f)),
+                         Ray3(Point3(-5.0f, 1.5f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)),
+                         Ray3(Point3(0.0f, -5.0f, -1.5f), Vector3(0.0f, 1.0f, 0.0f)),
+                         Ray3(Point3(0.5f, 0.5f, 5.0f), Vector3(0.0f, 0.0f, -1.0f)),
+                         Ray3(Point3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f)),
+                         Ray3(Point3(3.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)),
+                         Ray3(Point3(-1.0f, -5.0f, -1.0f), Vector3(0.0f, 1.0f, 0.0f))};
+    Ray3Packet8                       slab_packet(slab_rays, 8);
+    RayPacketObjectIntersectResult<8> slab_hits = slab_packet.intersect(box);
+    logmsg("Axis aligned packet against the unit box: hit mask %02x", slab_hits.mask);
+    check("Axis aligned packet matches single rays", matches_single(slab_packet, box));
+    check("Ray inside a slab hits, outside misses",
+          (slab_hits.mask & 0x1) != 0 && (slab_hits.mask & 0x4) == 0);
+
+    // No active lanes: nothing is reported
+    Ray3Packet4 empty;
+    check("Empty packet reports no hits", empty.active == 0 && empty.intersect(box).mask == 0);
+}
+
+} // namespace cg
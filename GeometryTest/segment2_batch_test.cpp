@@ -0,0 +1,100 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Hits of the batch kernel equal LineSegment2::intersect over every edge
+bool matches_scalar(const LineSegment2              &query,
+                    const std::vector<LineSegment2> &edges,
+                    const std::vector<Segment2Hit>  &hits)
+{
+    size_t n = 0;
+    for(uint32_t i = 0; i < edges.size(); i++)
+    {
+        Segment2IntersectionResult r = query.intersect(edges[i]);
+        if(!r.intersects) continue;
+        if(n >= hits.size()) return false;
+        const Segment2Hit &hit = hits[n++];
+        if(hit.edge_index != i || hit.t != r.t || !(hit.point == r.intersect_point))
+            return false;
+    }
+    return n == hits.size();
+}
+
+} // namespace
+
+void test_segment2_batch()
+{
+    logmsg("\nBatched segment intersection\n");
+
+    // 7 edges (not a multiple of the SIMD width): the sides of the square
+    // [0,4]x[0,4] and degenerate cases along the query y = 2
+    std::vector<LineSegment2> edges = {
+        LineSegment2(Point2(0.0f, 0.0f), Point2(4.0f, 0.0f)), // Bottom, misses
+        LineSegment2(Point2(4.0f, 0.0f), Point2(4.0f, 4.0f)), // Right, crosses
+        LineSegment2(Point2(4.0f, 4.0f), Point2(0.0f, 4.0f)), // Top, misses
+        LineSegment2(Point2(0.0f, 4.0f), Point2(0.0f, 0.0f)), // Left, crosses
+        LineSegment2(Point2(1.0f, 2.0f), Point2(3.0f, 2.0f)), // Collinear overlap
+        LineSegment2(Point2(2.0f, 2.0f), Point2(2.0f, 2.0f)), // Zero length on the query
+        LineSegment2(Point2(5.0f, 0.0f), Point2(5.0f, 2.0f))  // Touches the query end
+    };
+    Segment2Table             table(edges);
+    LineSegment2              query(Point2(-1.0f, 2.0f), Point2(5.0f, 2.0f));
+    std::vector<Segment2Hit> hits;
+    size_t                    n = intersect_segments(query, table, hits);
+    for(const auto &hit : hits)
+    {
+        logmsg("Edge %u hit at t = %.4f (%.2f, %.2f)", hit.edge_index, hit.t, hit.point.x,
+               hit.point.y);
+    }
+    check("3 hits, collinear and zero length edges skipped", n == 3 && hits.size() == 3);
+    check("Hits match LineSegment2::intersect", matches_scalar(query, edges, hits));
+    check("Touching end point has t = 1", n == 3 && hits[2].edge_index == 6 && hits[2].t == 1.0f);
+
+    // Zero length query on an edge
+    LineSegment2 point_query(Point2(4.0f, 2.0f), Point2(4.0f, 2.0f));
+    hits.clear();
+    check("Zero length query has no hits", intersect_segments(point_query, table, hits) == 0);
+
+    // Query parallel to the bottom edge and below it
+    LineSegment2 below(Point2(-1.0f, -1.0f), Point2(5.0f, -1.0f));
+    hits.clear();
+    check("Parallel query below the square has no hits",
+          intersect_segments(below, table, hits) == 0);
+
+    // Several queries: hits ordered by query, then by edge
+    LineSegment2 vertical(Point2(2.0f, -1.0f), Point2(2.0f, 5.0f));
+    LineSegment2 queries[3] = {query, point_query, vertical};
+    hits.clear();
+    n = intersect_segments(queries, 3, table, hits);
+    bool ordered = n == hits.size();
+    for(size_t i = 1; i < hits.size(); i++)
+    {
+        ordered = ordered && (hits[i - 1].query_index < hits[i].query_index ||
+                              (hits[i - 1].query_index == hits[i].query_index &&
+                               hits[i - 1].edge_index < hits[i].edge_index));
+    }
+    logmsg("3 queries: %zu hits", n);
+    check("Multiple queries give 3 + 0 + 3 hits", n == 6);
+    check("Hits ordered by query then edge", ordered);
+
+    // Subset of the table, in index list order
+    uint32_t indices[3] = {6, 0, 3};
+    hits.clear();
+    n = intersect_segments(query, table, indices, 3, hits);
+    check("Index list hits follow the list order",
+          n == 2 && hits[0].edge_index == 6 && hits[1].edge_index == 3);
+
+    // Empty table
+    Segment2Table empty;
+    hits.clear();
+    check("Empty table has no hits", intersect_segments(query, empty, hits) == 0 && hits.empty());
+}
+
+} // namespace cg
@@ -0,0 +1,144 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+constexpr float CLIP_TOLERANCE = 1.0e-5f;
+
+bool points_close(const Point2 &p, const Point2 &q)
+{
+    return std::abs(p.x - q.x) <= CLIP_TOLERANCE && std::abs(p.y - q.y) <= CLIP_TOLERANCE;
+}
+
+// Batch results equal a per-segment clip (up to rounding of clipped points)
+template <typename Clip>
+bool matches_single(const std::vector<LineSegment2> &segments,
+                    const std::vector<LineSegment2> &clipped,
+                    const std::vector<uint32_t>     &sources,
+                    Clip                           &&clip)
+{
+    size_t n = 0;
+    for(uint32_t i = 0; i < segments.size(); i++)
+    {
+        Segment2ClipResult r = clip(segments[i]);
+        if(!r.clipped) continue;
+        if(n >= clipped.size() || sources[n] != i) return false;
+        if(!points_close(clipped[n].a, r.clip_segment.a) ||
+           !points_close(clipped[n].b, r.clip_segment.b))
+            return false;
+        n++;
+    }
+    return n == clipped.size() && n == sources.size();
+}
+
+void log_clipped(const std::vector<LineSegment2> &clipped, const std::vector<uint32_t> &sources)
+{
+    for(size_t i = 0; i < clipped.size(); i++)
+    {
+        logmsg("Segment %u: (%.2f, %.2f) to (%.2f, %.2f)", sources[i], clipped[i].a.x,
+               clipped[i].a.y, clipped[i].b.x, clipped[i].b.y);
+    }
+}
+
+} // namespace
+
+void test_segment2_clip()
+{
+    logmsg("\nSegment clipping\n");
+
+    std::vector<LineSegment2> clipped;
+    std::vector<uint32_t>     sources;
+
+    // Empty input
+    CRectangle r = {0.0f, 10.0f, 0.0f, 5.0f};
+    check("Empty input clips to nothing",
+          clip_segments_to_rectangle(nullptr, 0, r, clipped, &sources) == 0 && clipped.empty());
+
+    // Inside, outside one side, crossing, missing a corner, on an edge, zero
+    // length inside and outside, vertical crossing
+    std::vector<LineSegment2> segments = {
+        LineSegment2(Point2(1.0f, 1.0f), Point2(9.0f, 4.0f)),
+        LineSegment2(Point2(-5.0f, 1.0f), Point2(-1.0f, 4.0f)),
+        LineSegment2(Point2(-5.0f, 2.0f), Point2(15.0f, 2.0f)),
+        LineSegment2(Point2(-1.0f, 4.0f), Point2(1.0f, 7.0f)),
+        LineSegment2(Point2(0.0f, 0.0f), Point2(10.0f, 0.0f)),
+        LineSegment2(Point2(3.0f, 3.0f), Point2(3.0f, 3.0f)),
+        LineSegment2(Point2(-3.0f, 3.0f), Point2(-3.0f, 3.0f)),
+        LineSegment2(Point2(5.0f, -10.0f), Point2(5.0f, 10.0f))};
+    size_t n = clip_segments_to_rectangle(segments.data(), segments.size(), r, clipped, &sources);
+    log_clipped(clipped, sources);
+    check("Rectangle keeps 5 of 8 segments", n == 5);
+    check("Inside segment is copied exactly",
+          n > 0 && sources[0] == 0 && clipped[0].a == segments[0].a &&
+              clipped[0].b == segments[0].b);
+    check("Rectangle results match clip_to_rectangle",
+          matches_single(segments, clipped, sources,
+                         [&](const LineSegment2 &s) { return s.clip_to_rectangle(r); }));
+
+    // Counter-clockwise hexagon
+    std::vector<Point2> hexagon = {Point2(2.0f, 0.0f),   Point2(1.0f, 1.5f),
+                                   Point2(-1.0f, 1.5f),  Point2(-2.0f, 0.0f),
+                                   Point2(-1.0f, -1.5f), Point2(1.0f, -1.5f)};
+    segments = {
+        LineSegment2(Point2(-0.5f, 0.0f), Point2(0.5f, 0.5f)),  // Inside
+        LineSegment2(Point2(-5.0f, 0.0f), Point2(5.0f, 0.0f)),  // Crosses 2 vertices
+        LineSegment2(Point2(-3.0f, 1.5f), Point2(3.0f, 1.5f)),  // Along the top edge
+        LineSegment2(Point2(-3.0f, 2.0f), Point2(3.0f, 2.0f)),  // Parallel to the top, outside
+        LineSegment2(Point2(0.0f, 0.0f), Point2(0.0f, 0.0f)),   // Zero length inside
+        LineSegment2(Point2(0.0f, 5.0f), Point2(0.0f, 5.0f)),   // Zero length outside
+        LineSegment2(Point2(0.0f, -5.0f), Point2(0.0f, 5.0f)),  // Vertical crossing
+        LineSegment2(Point2(2.5f, -3.0f), Point2(4.0f, 3.0f))}; // Outside the box
+    clipped.clear();
+    sources.clear();
+    n = clip_segments_to_polygon(segments.data(), segments.size(), hexagon, clipped, &sources);
+    log_clipped(clipped, sources);
+    bool parallel_rejected = true;
+    for(uint32_t s : sources) parallel_rejected = parallel_rejected && s != 3;
+    check("Segment parallel to an edge and outside it is rejected", parallel_rejected);
+    check("Polygon keeps 5 of 8 segments", n == 5);
+
+    // clip_to_polygon keeps segments parallel to an edge and outside it
+    // (documented difference), including a zero length segment outside, which
+    // is parallel to every edge. Compare without those 2.
+    std::vector<LineSegment2> others;
+    for(uint32_t i = 0; i < segments.size(); i++)
+    {
+        if(i != 3 && i != 5) others.push_back(segments[i]);
+    }
+    clipped.clear();
+    sources.clear();
+    clip_segments_to_polygon(others.data(), others.size(), hexagon, clipped, &sources);
+    check("Polygon results match clip_to_polygon",
+          matches_single(others, clipped, sources,
+                         [&](const LineSegment2 &s) { return s.clip_to_polygon(hexagon); }));
+
+    // Random segments against both clip regions
+    Random random(31);
+    segments.resize(203);
+    for(auto &s : segments)
+    {
+        Point2 a = random_point2(random, -4.0f, 12.0f);
+        s = LineSegment2(a, a + random_vector2(random, -6.0f, 6.0f));
+    }
+    clipped.clear();
+    sources.clear();
+    clip_segments_to_rectangle(segments.data(), segments.size(), r, clipped, &sources);
+    check("Random segments match clip_to_rectangle",
+          matches_single(segments, clipped, sources,
+                         [&](const LineSegment2 &s) { return s.clip_to_rectangle(r); }));
+    clipped.clear();
+    sources.clear();
+    clip_segments_to_polygon(segments.data(), segments.size(), hexagon, clipped, &sources);
+    check("Random segments match clip_to_polygon",
+          matches_single(segments, clipped, sources,
+                         [&](const LineSegment2 &s) { return s.clip_to_polygon(hexagon); }));
+}
+
+} // namespace cg
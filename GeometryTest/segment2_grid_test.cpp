@@ -0,0 +1,104 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Grid hits equal the batch kernel over the whole segment table
+bool matches_table(Segment2Grid &grid, const LineSegment2 &query)
+{
+    std::vector<Segment2Hit> expected;
+    std::vector<Segment2Hit> hits;
+    intersect_segments(query, grid.get_segments(), expected);
+    grid.intersect(query, hits);
+    if(hits.size() != expected.size()) return false;
+    for(size_t i = 0; i < hits.size(); i++)
+    {
+        if(hits[i].edge_index != expected[i].edge_index || hits[i].t != expected[i].t)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void test_segment2_grid()
+{
+    logmsg("\nSegment grid\n");
+
+    // Empty grid
+    Segment2Grid          grid(1.0f);
+    std::vector<uint32_t> candidates;
+    LineSegment2          query(Point2(-1.0f, 2.0f), Point2(5.0f, 2.0f));
+    grid.get_candidates(query, candidates);
+    check("Empty grid has no candidates", candidates.empty() && grid.cell_count() == 0);
+
+    // Segments on cell boundaries (integer coordinates), a collinear overlap
+    // with the query, a zero length segment and a long diagonal
+    grid.add(LineSegment2(Point2(0.0f, 0.0f), Point2(4.0f, 0.0f)));
+    grid.add(LineSegment2(Point2(4.0f, 0.0f), Point2(4.0f, 4.0f)));
+    grid.add(LineSegment2(Point2(4.0f, 4.0f), Point2(0.0f, 4.0f)));
+    grid.add(LineSegment2(Point2(0.0f, 4.0f), Point2(0.0f, 0.0f)));
+    grid.add(LineSegment2(Point2(1.0f, 2.0f), Point2(3.0f, 2.0f)));
+    uint32_t point = grid.add(LineSegment2(Point2(2.0f, 2.0f), Point2(2.0f, 2.0f)));
+    grid.add(LineSegment2(Point2(-8.0f, -8.0f), Point2(8.0f, 8.0f)));
+    logmsg("%zu segments in %zu cells", grid.size(), grid.cell_count());
+    // The diagonal's bounding box alone covers 256 cells
+    check("Diagonal is binned along its walk, not its bounding box", grid.cell_count() < 128);
+
+    grid.get_candidates(query, candidates);
+    bool has_point = false;
+    for(uint32_t c : candidates) has_point = has_point || c == point;
+    check("Zero length segment on the query is a candidate", has_point);
+    check("Query along a cell boundary matches the table", matches_table(grid, query));
+    check("Vertical query on a cell boundary matches the table",
+          matches_table(grid, LineSegment2(Point2(2.0f, -1.0f), Point2(2.0f, 5.0f))));
+    check("Zero length query matches the table",
+          matches_table(grid, LineSegment2(Point2(4.0f, 2.0f), Point2(4.0f, 2.0f))));
+
+    // A segment crossing more cells than are binned is still found
+    uint32_t long_index = grid.add(LineSegment2(Point2(-1.0e5f, 0.5f), Point2(1.0e5f, 0.5f)));
+    std::vector<Segment2Hit> hits;
+    grid.intersect(LineSegment2(Point2(2.5f, 0.0f), Point2(2.5f, 1.0f)), hits);
+    bool found = false;
+    for(const auto &hit : hits) found = found || hit.edge_index == long_index;
+    check("Segment too long to bin is found by a short query", found);
+    check("Query too long to walk matches the table",
+          matches_table(grid, LineSegment2(Point2(-1.0e5f, -1.0f), Point2(1.0e5f, 1.0f))));
+
+    // Random segments against random queries, before and after re-binning
+    Random                    random(12345);
+    std::vector<LineSegment2> segments(500);
+    for(auto &s : segments)
+    {
+        Point2 a = random_point2(random, 0.0f, 50.0f);
+        s = LineSegment2(a, a + random_vector2(random, -3.0f, 3.0f));
+    }
+    grid.clear();
+    check("Clear removes all segments", grid.size() == 0 && grid.cell_count() == 0);
+    grid.add(segments);
+    bool match = true;
+    for(uint32_t i = 0; i < 100; i++)
+    {
+        Point2 a = random_point2(random, 0.0f, 50.0f);
+        Point2 b = random_point2(random, 0.0f, 50.0f);
+        match = match && matches_table(grid, LineSegment2(a, b));
+    }
+    check("Random queries match the table", match);
+    grid.set_cell_size(0.25f);
+    match = true;
+    for(uint32_t i = 0; i < 100; i++)
+    {
+        Point2 a = random_point2(random, 0.0f, 50.0f);
+        Point2 b = random_point2(random, 0.0f, 50.0f);
+        match = match && matches_table(grid, LineSegment2(a, b));
+    }
+    check("Random queries match the table after set_cell_size", match);
+}
+
+} // namespace cg
@@ -0,0 +1,118 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Point p, collinear with segment s, lies within its bounding box
+bool on_segment(const LineSegment2 &s, const Point2 &p)
+{
+    return p.x >= std::min(s.a.x, s.b.x) && p.x <= std::max(s.a.x, s.b.x) &&
+           p.y >= std::min(s.a.y, s.b.y) && p.y <= std::max(s.a.y, s.b.y);
+}
+
+// Closed segments s and t share a point (exact, including collinear overlap)
+bool segments_touch(const LineSegment2 &s, const LineSegment2 &t)
+{
+    double o1 = orient2d(s.a, s.b, t.a);
+    double o2 = orient2d(s.a, s.b, t.b);
+    double o3 = orient2d(t.a, t.b, s.a);
+    double o4 = orient2d(t.a, t.b, s.b);
+    if(((o1 > 0.0 && o2 < 0.0) || (o1 < 0.0 && o2 > 0.0)) &&
+       ((o3 > 0.0 && o4 < 0.0) || (o3 < 0.0 && o4 > 0.0)))
+        return true;
+    return (o1 == 0.0 && on_segment(s, t.a)) || (o2 == 0.0 && on_segment(s, t.b)) ||
+           (o3 == 0.0 && on_segment(t, s.a)) || (o4 == 0.0 && on_segment(t, s.b));
+}
+
+// Sweep pairs equal the pairs found by testing all n^2 pairs
+bool matches_all_pairs(const std::vector<LineSegment2>     &segments,
+                       const std::vector<Segment2Crossing> &crossings)
+{
+    size_t n = 0;
+    for(uint32_t i = 0; i < segments.size(); i++)
+    {
+        for(uint32_t j = i + 1; j < segments.size(); j++)
+        {
+            if(!segments_touch(segments[i], segments[j])) continue;
+            if(n >= crossings.size() || crossings[n].first != i || crossings[n].second != j)
+                return false;
+            n++;
+        }
+    }
+    return n == crossings.size();
+}
+
+} // namespace
+
+void test_segment2_sweep()
+{
+    logmsg("\nSegment sweep\n");
+
+    // Empty input
+    std::vector<LineSegment2>     segments;
+    std::vector<Segment2Crossing> crossings(1);
+    find_all_intersections(segments, crossings);
+    check("Empty input has no crossings", crossings.empty());
+
+    // Degenerate cases
+    segments = {
+        LineSegment2(Point2(0.0f, 0.0f), Point2(4.0f, 4.0f)), // 0: diagonals crossing at (2,2)
+        LineSegment2(Point2(0.0f, 4.0f), Point2(4.0f, 0.0f)), // 1
+        LineSegment2(Point2(2.0f, 0.0f), Point2(2.0f, 4.0f)), // 2: vertical through (2,2)
+        LineSegment2(Point2(2.0f, 2.0f), Point2(2.0f, 2.0f)), // 3: zero length at (2,2)
+        LineSegment2(Point2(5.0f, 1.0f), Point2(8.0f, 1.0f)), // 4: collinear overlapping pair
+        LineSegment2(Point2(6.0f, 1.0f), Point2(9.0f, 1.0f)), // 5
+        LineSegment2(Point2(9.0f, 1.0f), Point2(9.0f, 3.0f)), // 6: touches 5 at an end point
+        LineSegment2(Point2(5.0f, 3.0f), Point2(8.0f, 3.0f)), // 7: parallel to 4, apart
+        LineSegment2(Point2(6.0f, 3.0f), Point2(7.0f, 3.0f)), // 8: inside 7
+        LineSegment2(Point2(0.0f, 4.0f), Point2(4.0f, 0.0f))  // 9: duplicate of 1
+    };
+    find_all_intersections(segments, crossings);
+    for(const auto &c : crossings)
+    {
+        logmsg("Segments %u and %u meet at (%.2f, %.2f)", c.first, c.second, c.point.x,
+               c.point.y);
+    }
+    check("Degenerate cases match all pairs", matches_all_pairs(segments, crossings));
+
+    bool overlap_point = false;
+    for(const auto &c : crossings)
+    {
+        if(c.first == 4 && c.second == 5) overlap_point = c.point == Point2(6.0f, 1.0f);
+    }
+    check("Collinear overlap reports its leftmost point", overlap_point);
+
+    // Segments on a small integer lattice: many shared end points, collinear
+    // overlaps, vertical and zero length segments
+    Random random(2024);
+    segments.resize(300);
+    for(auto &s : segments)
+    {
+        Point2 a = random_point2(random, 0.0f, 16.0f);
+        Point2 b = random_point2(random, 0.0f, 16.0f);
+        s = LineSegment2(Point2(std::floor(a.x), std::floor(a.y)),
+                         Point2(std::floor(b.x), std::floor(b.y)));
+    }
+    find_all_intersections(segments, crossings);
+    logmsg("Lattice segments: %zu crossings", crossings.size());
+    check("Lattice segments match all pairs", matches_all_pairs(segments, crossings));
+
+    // General position
+    for(auto &s : segments)
+    {
+        Point2 a = random_point2(random, 0.0f, 100.0f);
+        s = LineSegment2(a, a + random_vector2(random, -10.0f, 10.0f));
+    }
+    find_all_intersections(segments, crossings);
+    check("Random segments match all pairs", matches_all_pairs(segments, crossings));
+}
+
+} // namespace cg
@@ -0,0 +1,72 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    test_check.hpp
+//	Purpose: Check and random input helpers shared by the geometry
+//	         algorithm tests.
+//============================================================================
+
+#ifndef __GEOMETRY_TEST_TEST_CHECK_HPP__
+#define __GEOMETRY_TEST_TEST_CHECK_HPP__
+
+#include "geometry/geometry.hpp"
+
+#include <cstdint>
+
+namespace cg
+{
+
+// Number of checks that failed
+extern uint32_t g_check_failures;
+
+/**
+ * Logs the outcome of a check and counts it if it failed. The log is
+ * compared with a solution log, so a check that fails shows as a difference.
+ * @param  name  Description of the check.
+ * @param  ok    True if the check passed.
+ */
+void check(const char *name, bool ok);
+
+// declare logging function
+void logmsg(const char *message, ...);
+
+// Random points and vectors with components in [lo, hi]. The components are
+// drawn in x, y, z order (the order of constructor arguments is unspecified),
+// so the inputs and the logs are the same with every compiler.
+
+inline Point2 random_point2(Random &random, float lo, float hi)
+{
+    float x = random.uniform(lo, hi);
+    float y = random.uniform(lo, hi);
+    return Point2(x, y);
+}
+
+inline Vector2 random_vector2(Random &random, float lo, float hi)
+{
+    float x = random.uniform(lo, hi);
+    float y = random.uniform(lo, hi);
+    return Vector2(x, y);
+}
+
+inline Point3 random_point3(Random &random, float lo, float hi)
+{
+    float x = random.uniform(lo, hi);
+    float y = random.uniform(lo, hi);
+    float z = random.uniform(lo, hi);
+    return Point3(x, y, z);
+}
+
+inline Vector3 random_vector3(Random &random, float lo, float hi)
+{
+    float x = random.uniform(lo, hi);
+    float y = random.uniform(lo, hi);
+    float z = random.uniform(lo, hi);
+    return Vector3(x, y, z);
+}
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,112 @@
+#include "geometry/geometry.hpp"
+#include "test_check.hpp"
+
+#include <vector>
+
+namespace cg
+{
+
+namespace
+{
+
+// Number of vectors: 2 SIMD blocks of 4 and a tail of 3
+constexpr size_t COUNT = 11;
+
+bool same(const Vector3 &a, const Vector3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+// Deterministic vectors with a mix of lengths. Vector 1 is zero, vector 2 is
+// shorter than EPSILON and vector 5 is unit length.
+std::vector<Vector3> sample_vectors(float scale)
+{
+    std::vector<Vector3> v;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        float f = static_cast<float>(i);
+        v.push_back(Vector3(scale * (f - 4.0f), 0.5f * f * scale + 1.0f, 3.0f - f));
+    }
+    v[1] = Vector3(0.0f, 0.0f, 0.0f);
+    v[2] = Vector3(EPSILON * 0.25f, 0.0f, 0.0f);
+    v[5] = Vector3(0.0f, 1.0f, 0.0f);
+    return v;
+}
+
+} // namespace
+
+void test_vector_kernels()
+{
+    logmsg("\nVector3 batch kernels\n");
+
+    std::vector<Vector3> a = sample_vectors(1.0f);
+    std::vector<Vector3> b = sample_vectors(-0.75f);
+
+    // Normalize: same results as Vector3::normalize, including the vectors
+    // it leaves unchanged
+    std::vector<Vector3> normalized = a;
+    normalize_all(normalized.data(), COUNT);
+    bool normalize_match = true;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        Vector3 expected = a[i];
+        expected.normalize();
+        normalize_match = normalize_match && same(normalized[i], expected);
+    }
+    check("normalize_all matches Vector3::normalize", normalize_match);
+    check("Zero and tiny vectors are left unchanged",
+          same(normalized[1], a[1]) && same(normalized[2], a[2]));
+    check("Unit vector is left unchanged", same(normalized[5], a[5]));
+
+    // Dot, cross and reflect against the Vector3 operations
+    std::vector<float>   dots(COUNT);
+    std::vector<Vector3> crosses(COUNT);
+    std::vector<Vector3> reflected(COUNT);
+    dot_many(a.data(), b.data(), dots.data(), COUNT);
+    cross_many(a.data(), b.data(), crosses.data(), COUNT);
+    reflect_many(a.data(), normalized.data(), reflected.data(), COUNT);
+    bool dot_match = true;
+    bool cross_match = true;
+    bool reflect_match = true;
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        dot_match = dot_match && dots[i] == a[i].dot(b[i]);
+        cross_match = cross_match && same(crosses[i], a[i].cross(b[i]));
+        reflect_match = reflect_match && same(reflected[i], a[i].reflect(normalized[i]));
+    }
+    check("dot_many matches Vector3::dot", dot_match);
+    check("cross_many matches Vector3::cross", cross_match);
+    check("reflect_many matches Vector3::reflect", reflect_match);
+
+    // Destination aliasing a source
+    std::vector<Vector3> in_place = a;
+    cross_many(in_place.data(), b.data(), in_place.data(), COUNT);
+    bool in_place_match = true;
+    for(size_t i = 0; i < COUNT; i++)
+        in_place_match = in_place_match && same(in_place[i], crosses[i]);
+    check("cross_many into its first source", in_place_match);
+
+    // Counts below one SIMD block leave the rest untouched
+    std::vector<Vector3> partial = a;
+    normalize_all(partial.data(), 3);
+    check("Short normalize touches only count vectors",
+          same(partial[0], normalized[0]) && same(partial[3], a[3]));
+
+    // Structure-of-arrays versions match the array-of-structs versions
+    Vector3Array       soa_a(a);
+    Vector3Array       soa_b(b);
+    Vector3Array       soa_n(a);
+    Vector3Array       soa_cross;
+    Vector3Array       soa_reflect;
+    std::vector<float> soa_dots(COUNT);
+    normalize_all(soa_n);
+    dot_many(soa_a, soa_b, soa_dots.data());
+    cross_many(soa_a, soa_b, soa_cross);
+    reflect_many(soa_a, soa_n, soa_reflect);
+    bool soa_match = soa_cross.size() == COUNT && soa_reflect.size() == COUNT;
+    for(size_t i = 0; soa_match && i < COUNT; i++)
+    {
+        soa_match = same(soa_n.get(i), normalized[i]) && soa_dots[i] == dots[i] &&
+                    same(soa_cross.get(i), crosses[i]) && same(soa_reflect.get(i), reflected[i]);
+    }
+    check("SoA kernels match the AoS kernels", soa_match);
+}
+
+} // namespace cg
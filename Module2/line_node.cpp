@@ -5,7 +5,7 @@
 namespace cg
 {
 
-LineNode::LineNode(const Color4 &c)
+LineNode::LineNode(const Color4 &c, GLStateCache &gl_state) : gl_state_(&gl_state)
 {
     // Copy the color
     color_ = c;
@@ -17,8 +17,8 @@ LineNode::LineNode(const Color4 &c)
 
 LineNode::~LineNode()
 {
-    glDeleteBuffers(1, &vbo_);
-    glDeleteVertexArrays(1, &vao_);
+    gl_state_->delete_buffer(vbo_);
+    gl_state_->delete_vertex_array(vao_);
 }
 
 void LineNode::add(float x, float y, int32_t position_loc)
@@ -26,15 +26,15 @@ void LineNode::add(float x, float y, int32_t position_loc)
     vertex_list_.emplace_back(Point2(x, y));
 
     // Add the points to the VBO. Reloads entire VBO.
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_state_->bind_buffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER,
                  vertex_list_.size() * sizeof(Point2),
                  (GLvoid *)&vertex_list_[0],
                  GL_DYNAMIC_DRAW);
 
     // Update the VAO
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_state_->bind_vertex_array(vao_);
+    gl_state_->bind_buffer(GL_ARRAY_BUFFER, vbo_);
     glEnableVertexAttribArray(position_loc);
     glVertexAttribPointer(position_loc, 2, GL_FLOAT, GL_FALSE, 0, (void *)0);
 }
@@ -48,9 +48,8 @@ void LineNode::draw(SceneState &scene_state)
         glUniform4f(scene_state.color_loc, color_.r, color_.g, color_.b, color_.a);
 
         // Bind the VAO and draw the line
-        glBindVertexArray(vao_);
+        scene_state.gl_state.bind_vertex_array(vao_);
         glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(vertex_list_.size()));
-        glBindVertexArray(0);
         check_error("End of Lines:");
     }
 }
@@ -13,6 +13,7 @@
 #define __MODULE2_LINE_NODE_HPP__
 
 #include "scene/geometry_node.hpp"
+#include "scene/gl_state_cache.hpp"
 
 #include "geometry/point2.hpp"
 #include "scene/color4.hpp"
@@ -30,9 +31,10 @@ class LineNode : public GeometryNode
   public:
     /**
      * Constructor.
-     * @param  c     Color for the line.
+     * @param  c         Color for the line.
+     * @param  gl_state  GL state cache used to bind and delete the VBO and VAO.
      */
-    LineNode(const Color4 &c);
+    LineNode(const Color4 &c, GLStateCache &gl_state);
 
     /**
      * Destructor. Delete VBO and VAO.
@@ -55,6 +57,7 @@ class LineNode : public GeometryNode
 
   protected:
     Color4              color_;       // Color of the line
+    GLStateCache       *gl_state_;    // State cache for binds and deletes
     GLuint              vbo_;         // VBO
     GLuint              vao_;         // Vertex Array Object
     std::vector<Point2> vertex_list_; // Vertex list
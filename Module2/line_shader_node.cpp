@@ -19,6 +19,12 @@ bool LineShaderNode::get_locations()
         std::cout << "Error getting color location\n";
         return false;
     }
+    model_matrix_loc_ = glGetUniformLocation(shader_program_.get_program(), "model_matrix");
+    if(model_matrix_loc_ < 0)
+    {
+        std::cout << "Error getting model matrix location\n";
+        return false;
+    }
     position_loc_ = glGetAttribLocation(shader_program_.get_program(), "vtx_position");
     if(position_loc_ < 0)
     {
@@ -28,21 +34,20 @@ bool LineShaderNode::get_locations()
     return true;
 }
 
-void LineShaderNode::draw(SceneState &scene_state)
+void LineShaderNode::bind(SceneState &scene_state)
 {
     // Enable this program
-    shader_program_.use();
+    scene_state.gl_state.use_program(shader_program_.get_program());
 
     // Set scene state locations to ones needed for this program
     scene_state.ortho_matrix_loc = ortho_matrix_loc_;
+    scene_state.model_matrix_loc = model_matrix_loc_;
     scene_state.color_loc = color_loc_;
     scene_state.position_loc = position_loc_;
 
-    // Set the matrix
+    // Set the matrices
     glUniformMatrix4fv(ortho_matrix_loc_, 1, GL_FALSE, scene_state.ortho.data());
-
-    // Draw all children
-    SceneNode::draw(scene_state);
+    glUniformMatrix4fv(model_matrix_loc_, 1, GL_FALSE, scene_state.model_matrix.get());
 }
 
 int32_t LineShaderNode::get_position_loc() const { return position_loc_; }
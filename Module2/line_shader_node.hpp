@@ -32,11 +32,10 @@ class LineShaderNode : public ShaderNode
     bool get_locations() override;
 
     /**
-     * Draw method for this shader - enable the program and set up uniforms
-     * and vertex attribute locations
+     * Enable the program and set up uniforms and vertex attribute locations
      * @param  scene_state   Current scene state.
      */
-    void draw(SceneState &scene_state) override;
+    void bind(SceneState &scene_state) override;
 
     /**
      * Get the vertex position attribute location
@@ -47,6 +46,7 @@ class LineShaderNode : public ShaderNode
   protected:
     // Uniform and attribute locations
     GLint ortho_matrix_loc_;
+    GLint model_matrix_loc_;
     GLint color_loc_;
     GLint position_loc_;
 };
@@ -5,8 +5,9 @@ layout (location = 0) in vec2 vtx_position;
 
 // Uniform
 uniform mat4 ortho;
+uniform mat4 model_matrix;
 
 void main()
 {
-    gl_Position  = ortho * vec4(vtx_position, 0.0, 1.0);
+    gl_Position  = ortho * model_matrix * vec4(vtx_position, 0.0, 1.0);
 }
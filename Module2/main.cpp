@@ -47,12 +47,13 @@ void logmsg(const char *message, ...)
 
 } // namespace cg
 
+// Scene state (declared before the nodes, which delete their GL objects
+// through its state cache)
+cg::SceneState g_scene_state;
+
 // Root of the scene graph
 std::shared_ptr<cg::SceneNode> g_scene_root;
 
-// Scene state
-cg::SceneState g_scene_state;
-
 // PointNode - global so we can add points dynamically
 std::shared_ptr<cg::PointNode> g_points;
 
@@ -118,6 +119,8 @@ void display()
     // Clear the framebuffer
     glClear(GL_COLOR_BUFFER_BIT);
 
+    // Count this frame's avoided GL calls from zero
+    g_scene_state.gl_state.begin_frame();
     g_scene_root->draw(g_scene_state);
     cg::check_error("After Draw");
 
@@ -265,7 +268,8 @@ void create_scene()
         exit(-1);
     }
 
-    g_lines = std::make_shared<cg::LineNode>(cg::Color4(0.1f, 0.1f, 6.1f, 1.0f));
+    g_lines = std::make_shared<cg::LineNode>(cg::Color4(0.1f, 0.1f, 6.1f, 1.0f),
+                                            g_scene_state.gl_state);
 
     // Create the point shader node
     g_point_shader = std::make_shared<cg::PointShaderNode>();
@@ -278,7 +282,7 @@ void create_scene()
     }
 
     // Create the node that manages the points
-    g_points = std::make_shared<cg::PointNode>();
+    g_points = std::make_shared<cg::PointNode>(g_scene_state.gl_state);
 
     // Create scene graph
     g_scene_root = std::make_shared<cg::SceneNode>();
@@ -13,6 +13,7 @@
 #define __MODULE2_POINT_NODE_HPP__
 
 #include "scene/geometry_node.hpp"
+#include "scene/gl_state_cache.hpp"
 
 #include "geometry/point2.hpp"
 
@@ -29,8 +30,9 @@ class PointNode : public GeometryNode
   public:
     /**
      * Constructor.
+     * @param  gl_state  GL state cache used to bind and delete the VBO and VAO.
      */
-    PointNode();
+    PointNode(GLStateCache &gl_state);
 
     /**
      * Destructor
@@ -52,6 +54,7 @@ class PointNode : public GeometryNode
     void draw(SceneState &scene_state) override;
 
   protected:
+    GLStateCache       *gl_state_;    // State cache for binds and deletes
     GLuint              vbo_;         // VBO
     GLuint              vao_;         // Vertex Array Object
     std::vector<Point2> vertex_list_; // Vertex list
@@ -33,11 +33,10 @@ class PointShaderNode : public ShaderNode
     bool get_locations() override;
 
     /**
-     * Draw method for this shader - enable the program and set up uniforms
-     * and vertex attribute locations
+     * Enable the program and set up uniforms and vertex attribute locations
      * @param  scene_state   Current scene state.
      */
-    void draw(SceneState &scene_state) override;
+    void bind(SceneState &scene_state) override;
 
     /**
      * Get the vertex position attribute location
@@ -48,6 +47,7 @@ class PointShaderNode : public ShaderNode
   protected:
     // Uniform and attribute locations used by this shader
     GLint ortho_matrix_loc_;
+    GLint model_matrix_loc_;
     GLint position_loc_;
 };
 
@@ -5,9 +5,10 @@ layout (location = 0) in vec2 vtx_position;
 
 // Uniform
 uniform mat4 ortho_matrix;
+uniform mat4 model_matrix;
 
 void main()
 {
     gl_PointSize = 20.0; 
-    gl_Position  = ortho_matrix * vec4(vtx_position, 0.0, 1.0);
+    gl_Position  = ortho_matrix * model_matrix * vec4(vtx_position, 0.0, 1.0);
 }
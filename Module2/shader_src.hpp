@@ -6,9 +6,10 @@ const char *lines_vert =
 #version 410 core
 layout (location = 0) in vec2 vtx_position;
 uniform mat4 ortho;
+uniform mat4 model_matrix;
 void main()
 {
-    gl_Position  = ortho * vec4(vtx_position, 0.0, 1.0);
+    gl_Position  = ortho * model_matrix * vec4(vtx_position, 0.0, 1.0);
 }
 )";
 
@@ -28,9 +29,10 @@ const char *points_vert =
 #version 410 core
 layout (location = 0) in vec2 vtx_position;
 uniform mat4 ortho;
+uniform mat4 model_matrix;
 void main()
 {
-    gl_Position  = ortho * vec4(vtx_position, 0.0, 1.0);
+    gl_Position  = ortho * model_matrix * vec4(vtx_position, 0.0, 1.0);
 }
 )";
 
@@ -77,6 +77,13 @@ bool BasicShaderNode::get_locations()
     return false; 
   }
 
+  GLint model_loc = glGetUniformLocation(program, "model_matrix");
+  if(model_loc == -1)
+  {
+    std::cout << "BasicShaderNode: could not get model matrix uniform" << "\n";
+    return false;
+  }
+
   GLint color_loc = glGetUniformLocation(program, "color");
   if(color_loc == -1)
   {
@@ -87,34 +94,40 @@ bool BasicShaderNode::get_locations()
   std::cout << "BasicShaderNode: Found all shader locations:" << "\n";
   std::cout << "  position attribute: " << pos_loc << "\n";
   std::cout << "  ortho_matrix uniform: " << ortho_loc << "\n";
+  std::cout << "  model_matrix uniform: " << model_loc << "\n";
   std::cout << "  color uniform: " << color_loc << "\n";
 
   return true;
 }
 
-void BasicShaderNode::draw(SceneState& scene_state)
+void BasicShaderNode::bind(SceneState& scene_state)
 {
 
-  shader_program_.use();
-  cg::check_error("BasicShaderNode::draw - use shader");
-  cg::check_error("BasicShaderNode::draw");
+  scene_state.gl_state.use_program(shader_program_.get_program());
+  cg::check_error("BasicShaderNode::bind - use shader");
   // Update scene state with our locations (in case they're not set)
   GLuint program = shader_program_.get_program();
   scene_state.position_loc = glGetAttribLocation(program, "position");
   scene_state.ortho_matrix_loc = glGetUniformLocation(program, "ortho_matrix");
+  scene_state.model_matrix_loc = glGetUniformLocation(program, "model_matrix");
   scene_state.color_loc = glGetUniformLocation(program, "color");
 
   // Set the orthographic matrix uniform
   if (scene_state.ortho_matrix_loc != -1)
   {
       glUniformMatrix4fv(scene_state.ortho_matrix_loc, 1, GL_FALSE, scene_state.ortho.data());
-      cg::check_error("BasicShaderNode::draw - set ortho matrix");
+      cg::check_error("BasicShaderNode::bind - set ortho matrix");
+  }
+
+  // Set the model matrix of the enclosing transforms (render queues set it
+  // again per packet)
+  if (scene_state.model_matrix_loc != -1)
+  {
+      glUniformMatrix4fv(scene_state.model_matrix_loc, 1, GL_FALSE, scene_state.model_matrix.get());
+      cg::check_error("BasicShaderNode::bind - set model matrix");
   }
 
-  // Draw all children with this shader active
-  SceneNode::draw(scene_state);
-  
-  cg::check_error("BasicShaderNode::draw - end");
+  cg::check_error("BasicShaderNode::bind - end");
 }
 
 }
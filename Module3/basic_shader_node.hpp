@@ -39,10 +39,10 @@ public:
     virtual bool get_locations() override;
 
     /**
-     * Draw method - activates the shader and sets up uniforms.
+     * Bind method - activates the shader and sets up uniforms.
      * @param scene_state Current scene state containing matrices and uniform locations
      */
-    virtual void draw(SceneState& scene_state) override;
+    virtual void bind(SceneState& scene_state) override;
 };
 
 } // namespace cg
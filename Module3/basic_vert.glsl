@@ -3,11 +3,13 @@
 // Vertex attribute - 2D position
 layout(location = 0) in vec2 position;
 
-// Uniform - orthographic projection matrix
+// Uniforms - orthographic projection matrix and model matrix
 uniform mat4 ortho_matrix;
+uniform mat4 model_matrix;
 
 void main()
 {
-    // Transform the 2D position to clip space using orthographic projection
-    gl_Position = ortho_matrix * vec4(position, 0.0, 1.0);
+    // Transform the 2D position to clip space using the model matrix and
+    // the orthographic projection
+    gl_Position = ortho_matrix * model_matrix * vec4(position, 0.0, 1.0);
 }
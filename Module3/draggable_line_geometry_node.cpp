@@ -11,7 +11,7 @@ constexpr float DraggableLineGeometryNode::END_COLOR[4];
 
 DraggableLineGeometryNode::DraggableLineGeometryNode(const Point2& start_point)
     : start_point_(start_point), end_point_(start_point), // Initialize end point same as start
-      vao_(0), vertex_buffer_(0)
+      gl_state_(nullptr), vao_(0), vertex_buffer_(0)
 {
     node_type_ = SceneNodeType::GEOMETRY;
     std::cout << "DraggableLineGeometryNode: Created with start point (" 
@@ -23,8 +23,9 @@ DraggableLineGeometryNode::~DraggableLineGeometryNode()
     destroy();
 }
 
-bool DraggableLineGeometryNode::create()
+bool DraggableLineGeometryNode::create(GLStateCache& gl_state)
 {
+    gl_state_ = &gl_state;
     std::cout << "DraggableLineGeometryNode: Creating OpenGL resources..." << "\n";
     
     // Generate OpenGL objects
@@ -42,7 +43,7 @@ bool DraggableLineGeometryNode::create()
     std::cout << "Generated VAO: " << vao_ << ", VBO: " << vertex_buffer_ << "\n";
     
     // Bind VAO first
-    glBindVertexArray(vao_);
+    gl_state.bind_vertex_array(vao_);
     cg::check_error("glBindVertexArray");
     
     // Setup vertex data and attributes
@@ -50,9 +51,10 @@ bool DraggableLineGeometryNode::create()
     setup_vertex_attributes();
     
     // Unbind VAO
-    glBindVertexArray(0);
+    gl_state.bind_vertex_array(0);
     
     std::cout << "DraggableLineGeometryNode: Created successfully!" << "\n";
+    scene_changed();
     return true;
 }
 
@@ -73,7 +75,7 @@ void DraggableLineGeometryNode::setup_vertex_data()
               << ") Color: (" << vertices[1].r << ", " << vertices[1].g << ", " << vertices[1].b << ", " << vertices[1].a << ")" << "\n";
     
     // Bind VBO and upload data
-    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    gl_state_->bind_buffer(GL_ARRAY_BUFFER, vertex_buffer_);
     cg::check_error("glBindBuffer");
     
     // Allocate buffer with initial data
@@ -103,6 +105,8 @@ void DraggableLineGeometryNode::setup_vertex_attributes()
 void DraggableLineGeometryNode::update_end_point(const Point2& end_point)
 {
     end_point_ = end_point;
+    if (vertex_buffer_ == 0)
+        return; // Not created yet
     
     // Create updated end vertex data
     LineVertex end_vertex = {
@@ -110,17 +114,13 @@ void DraggableLineGeometryNode::update_end_point(const Point2& end_point)
         END_COLOR[0], END_COLOR[1], END_COLOR[2], END_COLOR[3]
     };
     
-    // Bind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    // Bind the VBO (skipped by the state cache while it stays bound)
+    gl_state_->bind_buffer(GL_ARRAY_BUFFER, vertex_buffer_);
     
     // Efficiently update only the end vertex using glBufferSubData
     // Offset = sizeof(LineVertex) to skip the first vertex
     glBufferSubData(GL_ARRAY_BUFFER, sizeof(LineVertex), sizeof(LineVertex), &end_vertex);
     cg::check_error("glBufferSubData - update end point");
-    
-    // Unbind buffer
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    
 }
 
 void DraggableLineGeometryNode::draw(SceneState& scene_state)
@@ -136,34 +136,40 @@ void DraggableLineGeometryNode::draw(SceneState& scene_state)
     return;
   }
   // Bind VAO and draw the line
-  glBindVertexArray(vao_);
+  scene_state.gl_state.bind_vertex_array(vao_);
   cg::check_error("DraggableLineGeometryNode::draw - bind VAO");
   
   // Draw the line using GL_LINES primitive
   glDrawArrays(GL_LINES, 0, VERTICES_PER_LINE);
   cg::check_error("DraggableLineGeometryNode::draw - glDrawArrays");
   
-  // Unbind VAO
-  glBindVertexArray(0);
-  cg::check_error("DraggableLineGeometryNode::draw - unbind VAO");
-  
   // Call base class to draw any children (though lines typically have none)
   SceneNode::draw(scene_state);
 }
 
+void DraggableLineGeometryNode::compile(RenderQueue& queue)
+{
+  if(vao_ != 0 && visible_)
+  {
+    queue.add_draw(vao_, GL_LINES, VERTICES_PER_LINE);
+  }
+  compile_children(queue);
+}
+
 void DraggableLineGeometryNode::destroy()
 {
     if(vao_ != 0)
     {
-        glDeleteVertexArrays(1, &vao_);
+        gl_state_->delete_vertex_array(vao_);
         vao_ = 0;
     }
     
     if(vertex_buffer_ != 0)
     {
-        glDeleteBuffers(1, &vertex_buffer_);
+        gl_state_->delete_buffer(vertex_buffer_);
         vertex_buffer_ = 0;
     }
+    scene_changed();
     
     std::cout << "DraggableLineGeometryNode: OpenGL resources cleaned up" << "\n";
 }
@@ -172,6 +178,8 @@ void DraggableLineGeometryNode::reset_line(const Point2& start_point, const Poin
 {
     start_point_ = start_point;
     end_point_ = end_point;
+    if (vertex_buffer_ == 0)
+        return; // Not created yet
     
     // Update both vertices in the buffer
     LineVertex vertices[VERTICES_PER_LINE] = {
@@ -182,9 +190,8 @@ void DraggableLineGeometryNode::reset_line(const Point2& start_point, const Poin
     };
     
     // Bind VBO and update entire buffer
-    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    gl_state_->bind_buffer(GL_ARRAY_BUFFER, vertex_buffer_);
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     
     cg::check_error("DraggableLineGeometryNode::reset_line");
 }
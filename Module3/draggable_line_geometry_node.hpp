@@ -2,6 +2,7 @@
 #define __SCENE_DRAGGABLE_LINE_GEOMETRY_NODE_HPP__
 
 #include "scene/geometry_node.hpp"
+#include "scene/gl_state_cache.hpp"
 #include "geometry/point2.hpp"
 
 namespace cg 
@@ -23,9 +24,11 @@ public:
 
     /**
      * Create the OpenGL buffers and initialize line geometry
+     * @param gl_state GL state cache used to bind the buffers in this and
+     *        later updates
      * @return Returns true if successful
      */
-    virtual bool create();
+    virtual bool create(GLStateCache& gl_state);
 
     /**
      * Draw the draggable line
@@ -33,6 +36,12 @@ public:
      */
     virtual void draw(SceneState& scene_state) override;
 
+    /**
+     * Compile the line into a single draw (nothing while hidden)
+     * @param queue Render queue being compiled
+     */
+    virtual void compile(RenderQueue& queue) override;
+
     /**
      * Clean up OpenGL resources
      */
@@ -67,7 +76,11 @@ public:
      * Set visibility of the line
      * @param visible True to show, false to hide
      */
-    void set_visible(bool visible) { visible_ = visible; }
+    void set_visible(bool visible)
+    {
+        if(visible != visible_) scene_changed();
+        visible_ = visible;
+    }
     
     /**
      * Check if line is visible
@@ -80,6 +93,7 @@ private:
     Point2 end_point_;
     
     // OpenGL buffer objects
+    GLStateCache* gl_state_; // Cache the buffers were created with
     GLuint vao_;           // Vertex Array Object
     GLuint vertex_buffer_; // Single VBO for interleaved position and color data
     
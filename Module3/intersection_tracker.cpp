@@ -6,14 +6,26 @@
 namespace cg
 {
 
+namespace
+{
+
+// Below this many edges, scanning the whole edge table beats walking the
+// grid cells (GeometryBenchmark, 6-gons: 64 ns vs 294 ns per query at 3
+// n-gons, break-even between 30 and 100 n-gons)
+constexpr size_t GRID_MIN_EDGES = 256;
+
+} // namespace
+
 IntersectionTracker::IntersectionTracker()
-    : point_shader_(nullptr), intersection_points_(nullptr)
+    : point_shader_(nullptr), intersection_points_(nullptr), gl_state_(nullptr),
+      edge_length_sum_(0.0f), edge_count_(0)
 {
     std::cout << "IntersectionTracker: Created" << "\n";
 }
 
 bool IntersectionTracker::initialize(std::shared_ptr<PointShaderNode> point_shader,
-                                   const std::vector<std::shared_ptr<NGonGeometryNode>>& ngons)
+                                   const std::vector<std::shared_ptr<NGonGeometryNode>>& ngons,
+                                   GLStateCache& gl_state)
 {
     if (!point_shader) {
         std::cout << "IntersectionTracker: Error - null point shader" << "\n";
@@ -21,9 +33,10 @@ bool IntersectionTracker::initialize(std::shared_ptr<PointShaderNode> point_shad
     }
     
     point_shader_ = point_shader;
+    gl_state_ = &gl_state;
     
     // Create Module 2 point node for intersection points
-    intersection_points_ = std::make_shared<PointNode>();
+    intersection_points_ = std::make_shared<PointNode>(*gl_state_);
     
     // Add to point shader as a scene node (PointNode inherits from SceneNode)
     point_shader_->add_child(intersection_points_);
@@ -35,19 +48,7 @@ bool IntersectionTracker::initialize(std::shared_ptr<PointShaderNode> point_shad
             continue;
         }
         
-        NGonInfo info;
-        info.ngon = ngons[i];
-        info.point_size = 28.0f + (i * 4.0f); // Vary size: 28, 32, 36, etc.
-        
-        // Cache the edges
-        ngons[i]->get_perimeter_edges(info.edges);
-        
-        ngon_info_.push_back(info);
-        
-        std::cout << "IntersectionTracker: Registered '" << ngons[i]->get_name() 
-                  << "' with " << info.edges.size() << " edges, color (" 
-                  << info.intersection_color.r << ", " << info.intersection_color.g 
-                  << ", " << info.intersection_color.b << "), size " << info.point_size << "\n";
+        add_ngon(ngons[i]);
     }
     
     std::cout << "IntersectionTracker: Initialized successfully with " 
@@ -55,6 +56,43 @@ bool IntersectionTracker::initialize(std::shared_ptr<PointShaderNode> point_shad
     return true;
 }
 
+bool IntersectionTracker::add_ngon(std::shared_ptr<NGonGeometryNode> ngon)
+{
+    if (!ngon)
+        return false;
+    
+    NGonInfo info;
+    info.ngon = ngon;
+    info.point_size = 28.0f + (ngon_info_.size() * 4.0f); // Vary size: 28, 32, 36, etc.
+    
+    // Cache the edges
+    ngon->get_perimeter_edges(info.edges);
+    
+    // Size the grid cells from the edges of all n-gons: about two edge
+    // lengths, so an edge touches only a few cells and a cell holds only a
+    // few edges. The grid is re-binned only when the average edge length
+    // moves more than a factor of 2 away from the current cell size.
+    for (const auto& edge : info.edges)
+        edge_length_sum_ += (edge.b - edge.a).norm();
+    edge_count_ += info.edges.size();
+    if (edge_count_ > 0) {
+        float cell_size = 2.0f * edge_length_sum_ / static_cast<float>(edge_count_);
+        float current = edge_grid_.get_cell_size();
+        if (cell_size > EPSILON &&
+            (edge_grid_.size() == 0 || cell_size > 2.0f * current || cell_size < 0.5f * current))
+            edge_grid_.set_cell_size(cell_size);
+    }
+    edge_grid_.add(info.edges);
+    
+    ngon_info_.push_back(info);
+    
+    std::cout << "IntersectionTracker: Registered '" << ngon->get_name() 
+              << "' with " << info.edges.size() << " edges, color (" 
+              << info.intersection_color.r << ", " << info.intersection_color.g 
+              << ", " << info.intersection_color.b << "), size " << info.point_size << "\n";
+    return true;
+}
+
 void IntersectionTracker::update_intersections(const Point2& line_start, const Point2& line_end)
 {
     LineSegment2 line(line_start, line_end);
@@ -73,7 +111,7 @@ void IntersectionTracker::clear_intersections()
         point_shader_->destroy(); // This clears all children
         
         // Recreate a fresh PointNode
-        intersection_points_ = std::make_shared<PointNode>();
+        intersection_points_ = std::make_shared<PointNode>(*gl_state_);
         point_shader_->add_child(intersection_points_);
         
         current_intersections_.clear();
@@ -88,38 +126,24 @@ void IntersectionTracker::calculate_and_update_intersections(const LineSegment2&
   // Always clear first to remove old points
   clear_intersections();
   
-  size_t total_intersections = 0;
-    
-  // Test against each n-gon
-  for (size_t ngon_idx = 0; ngon_idx < ngon_info_.size(); ++ngon_idx) 
+  // Test only the edges in the grid cells the line crosses, or every edge
+  // when there are too few for the grid to pay off. Either way hits come
+  // back in n-gon then edge order.
+  hits_.clear();
+  if (edge_grid_.size() < GRID_MIN_EDGES)
+    intersect_segments(line, edge_grid_.get_segments(), hits_);
+  else
+    edge_grid_.intersect(line, hits_);
+  
+  for (const auto& hit : hits_) 
   {
-    const auto& ngon_info = ngon_info_[ngon_idx];
-    size_t ngon_intersections = 0;
-     
-    // Test against each edge of this n-gon
-    for (size_t edge_idx = 0; edge_idx < ngon_info.edges.size(); ++edge_idx) 
-    {
-      const auto& edge = ngon_info.edges[edge_idx];
-         
-      Segment2IntersectionResult result = line.intersect(edge);
+    // Add intersection point to the SAME PointNode
+    intersection_points_->add(hit.point.x, 
+                              hit.point.y, 
+                              point_shader_->get_position_loc());
          
-      if (result.intersects) 
-      {
-        // Add intersection point to the SAME PointNode
-        intersection_points_->add(result.intersect_point.x, 
-                                  result.intersect_point.y, 
-                                  point_shader_->get_position_loc());
-             
-        // Track the point for our own counting
-        current_intersections_.push_back(result.intersect_point);
-             
-        ngon_intersections++;
-        total_intersections++;
-             
-
-      }
-    }
-     
+    // Track the point for our own counting
+    current_intersections_.push_back(hit.point);
   }
 }
 
@@ -3,7 +3,9 @@
 
 #include "ngon_geometry_node.hpp"
 #include "geometry/segment2.hpp"
+#include "geometry/segment2_grid.hpp"
 #include "scene/color4.hpp"
+#include "scene/gl_state_cache.hpp"
 #include <vector>
 #include <memory>
 
@@ -28,10 +30,21 @@ public:
      * Initialize with Module 2 point shader and register n-gons
      * @param point_shader Module 2 point shader node
      * @param ngons Vector of n-gon geometry nodes to test against
+     * @param gl_state GL state cache used by the intersection point node
      * @return True if initialization successful
      */
     bool initialize(std::shared_ptr<PointShaderNode> point_shader,
-                   const std::vector<std::shared_ptr<NGonGeometryNode>>& ngons);
+                   const std::vector<std::shared_ptr<NGonGeometryNode>>& ngons,
+                   GLStateCache& gl_state);
+    
+    /**
+     * Register one more n-gon. Its edges are added to the edge grid, which
+     * is rebuilt only if they change the average edge length by more than a
+     * factor of 2.
+     * @param ngon N-gon geometry node to test against
+     * @return True if the n-gon was registered
+     */
+    bool add_ngon(std::shared_ptr<NGonGeometryNode> ngon);
     
     /**
      * Update intersections for the current draggable line
@@ -61,7 +74,12 @@ private:
     // Use Module 2 point shader and node
     std::shared_ptr<PointShaderNode> point_shader_;
     std::shared_ptr<PointNode> intersection_points_;
+    GLStateCache* gl_state_;                     // Cache the point nodes bind through
     std::vector<NGonInfo> ngon_info_;
+    Segment2Grid edge_grid_;                     // Edges of all n-gons, in registration order
+    std::vector<Segment2Hit> hits_;              // Scratch list reused for each update
+    float edge_length_sum_;                      // Total length of the registered edges
+    size_t edge_count_;                          // Number of registered edges
     std::vector<Point2> current_intersections_;  // Track current intersection points
     
     void calculate_and_update_intersections(const LineSegment2& line);
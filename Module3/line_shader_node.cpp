@@ -88,51 +88,71 @@ bool LineShaderNode::get_locations()
         return false;
     }
 
+    // Get model matrix uniform location
+    GLint model_loc = glGetUniformLocation(program, "model_matrix");
+    if(model_loc == -1)
+    {
+        std::cout << "LineShaderNode: Could not find 'model_matrix' uniform" << "\n";
+        return false;
+    }
+
     std::cout << "LineShaderNode: Found all shader locations:" << "\n";
     std::cout << "  position attribute: " << pos_loc << "\n";
     std::cout << "  color attribute: " << color_attr_loc_ << "\n";
     std::cout << "  ortho_matrix uniform: " << ortho_loc << "\n";
+    std::cout << "  model_matrix uniform: " << model_loc << "\n";
 
     return true;
 }
 
-void LineShaderNode::draw(SceneState& scene_state)
+void LineShaderNode::bind(SceneState& scene_state)
 {
     // Activate the shader program
-    shader_program_.use();
-    cg::check_error("LineShaderNode::draw - use shader");
+    GLStateCache& gl = scene_state.gl_state;
+    gl.use_program(shader_program_.get_program());
+    cg::check_error("LineShaderNode::bind - use shader");
 
     // Update scene state with our locations
     GLuint program = shader_program_.get_program();
     scene_state.position_loc = glGetAttribLocation(program, "position");
     scene_state.ortho_matrix_loc = glGetUniformLocation(program, "ortho_matrix");
+    scene_state.model_matrix_loc = glGetUniformLocation(program, "model_matrix");
     scene_state.color_loc = glGetUniformLocation(program, "color");
 
     // Set the orthographic matrix uniform
     if (scene_state.ortho_matrix_loc != -1)
     {
         glUniformMatrix4fv(scene_state.ortho_matrix_loc, 1, GL_FALSE, scene_state.ortho.data());
-        cg::check_error("LineShaderNode::draw - set ortho matrix");
+        cg::check_error("LineShaderNode::bind - set ortho matrix");
+    }
+
+    // Set the model matrix of the enclosing transforms (render queues set it
+    // again per packet)
+    if (scene_state.model_matrix_loc != -1)
+    {
+        glUniformMatrix4fv(
+            scene_state.model_matrix_loc, 1, GL_FALSE, scene_state.model_matrix.get());
+        cg::check_error("LineShaderNode::bind - set model matrix");
     }
 
     // Set line width for smooth, thick lines
-    glLineWidth(4.0f);
-    cg::check_error("LineShaderNode::draw - set line width");
+    gl.line_width(4.0f);
+    cg::check_error("LineShaderNode::bind - set line width");
 
     // Enable line smoothing for better quality (if supported)
-    if (glIsEnabled(GL_LINE_SMOOTH) == GL_FALSE) {
-        glEnable(GL_LINE_SMOOTH);
+    if (!gl.is_enabled(GL_LINE_SMOOTH)) {
+        gl.enable(GL_LINE_SMOOTH);
         glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
-        cg::check_error("LineShaderNode::draw - enable line smoothing");
+        cg::check_error("LineShaderNode::bind - enable line smoothing");
     }
 
-    // Draw all children with this shader active
-    SceneNode::draw(scene_state);
-    
+    cg::check_error("LineShaderNode::bind - end");
+}
+
+void LineShaderNode::unbind(SceneState& scene_state)
+{
     // Reset line width to default
-    glLineWidth(1.0f);
-    
-    cg::check_error("LineShaderNode::draw - end");
+    scene_state.gl_state.line_width(1.0f);
 }
 
 } // namespace cg
@@ -34,10 +34,16 @@ public:
     virtual bool get_locations() override;
 
     /**
-     * Draw method - activates the shader, sets up uniforms, and configures line width.
+     * Bind method - activates the shader, sets up uniforms, and configures line width.
      * @param scene_state Current scene state containing matrices and uniform locations
      */
-    virtual void draw(SceneState& scene_state) override;
+    virtual void bind(SceneState& scene_state) override;
+
+    /**
+     * Unbind method - resets the line width.
+     * @param scene_state Current scene state
+     */
+    virtual void unbind(SceneState& scene_state) override;
 
 private:
     GLint color_attr_loc_;  // Location of the color vertex attribute
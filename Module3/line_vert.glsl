@@ -4,8 +4,9 @@
 layout(location = 0) in vec2 position;
 layout(location = 1) in vec4 color;
 
-// Uniform - orthographic projection matrix
+// Uniforms - orthographic projection matrix and model matrix
 uniform mat4 ortho_matrix;
+uniform mat4 model_matrix;
 
 // Output to fragment shader
 out vec4 vertex_color;
@@ -15,6 +16,7 @@ void main()
     // Pass the per-vertex color to fragment shader for interpolation
     vertex_color = color;
     
-    // Transform the 2D position to clip space using orthographic projection
-    gl_Position = ortho_matrix * vec4(position, 0.0, 1.0);
+    // Transform the 2D position to clip space using the model matrix and
+    // the orthographic projection
+    gl_Position = ortho_matrix * model_matrix * vec4(position, 0.0, 1.0);
 }
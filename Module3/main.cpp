@@ -63,15 +63,19 @@ constexpr int32_t DRAWS_PER_SECOND = 30;
 constexpr int32_t DRAW_INTERVAL_MILLIS =
     static_cast<int32_t>(1000.0 / static_cast<double>(DRAWS_PER_SECOND));
 
-cg::Matrix4x4 g_inverse_projection;  // Inverse transformation matrix
+cg::Matrix3x2 g_inverse_projection;  // Inverse transformation matrix (2-D)
 int32_t g_window_width = 800;        // Current window dimensions
 int32_t g_window_height = 800;
 
+// Scene state (declared before the nodes, which delete their GL objects
+// through its state cache)
+cg::SceneState g_scene_state;
+
 // Root of the scene graph
 std::shared_ptr<cg::SceneNode> g_scene_root;
 
-// Scene state
-cg::SceneState g_scene_state;
+// Scene graph compiled into draw packets (recompiled when the graph changes)
+cg::RenderQueue g_render_queue;
 
 // Line shader node for draggable lines
 std::shared_ptr<cg::LineShaderNode> g_line_shader_node;
@@ -149,31 +153,13 @@ void reshape(int32_t width, int32_t height)
     std::cout << "Ranges: width=" << width_range << ", height=" << height_range 
               << ", depth=" << depth_range << "\n";
 
-    // Fill the array with zeros first
-    std::fill(g_scene_state.ortho.begin(), g_scene_state.ortho.end(), 0.0f);
-
     // Set the orthographic projection values (column-major order for OpenGL)
-    g_scene_state.ortho[0] = 2.0f / width_range;                              // m[0][0] - X scaling
-    g_scene_state.ortho[5] = 2.0f / height_range;                             // m[1][1] - Y scaling  
-    g_scene_state.ortho[10] = -2.0f / depth_range;                            // m[2][2] - Z scaling
-    g_scene_state.ortho[12] = -(right + left) / width_range;                  // m[0][3] - X translation
-    g_scene_state.ortho[13] = -(top + bottom) / height_range;                 // m[1][3] - Y translation
-    g_scene_state.ortho[14] = -(far_plane + near_plane) / depth_range;        // m[2][3] - Z translation
-    g_scene_state.ortho[15] = 1.0f;                                           // m[3][3] - W component
+    cg::Matrix4x4 ortho = cg::Matrix4x4::ortho(left, right, bottom, top, near_plane, far_plane);
+    std::copy(ortho.get(), ortho.get() + 16, g_scene_state.ortho.begin());
   
-    //initialize to identity
-    g_inverse_projection.set_identity();
-
-    //inverse scaling 
-    g_inverse_projection.m00() = width_range / 2.0f;
-    g_inverse_projection.m11() = height_range / 2.0f;
-    g_inverse_projection.m22() = -depth_range / 2.0f;
-    g_inverse_projection.m33() = 1.0f; 
-    
-    //inverse translation 
-    g_inverse_projection.m03() = (right + left) / 2.0f;
-    g_inverse_projection.m13() = (top + bottom) / 2.0f;
-    g_inverse_projection.m23() = -(far_plane + near_plane) / 2.0f;
+    // Inverse projection (NDC to world) for mouse picking. Picking is 2-D so
+    // only the x, y part of the projection is inverted.
+    g_inverse_projection = cg::Matrix3x2::ortho(left, right, bottom, top).get_inverse();
 
     g_window_width = width;
     g_window_height = height;
@@ -189,8 +175,8 @@ void reshape(int32_t width, int32_t height)
     std::cout << "Inverse matrix components:" << "\n";
     std::cout << "  Inv Scale X: " << g_inverse_projection.m00() << "\n";
     std::cout << "  Inv Scale Y: " << g_inverse_projection.m11() << "\n";
-    std::cout << "  Inv Trans X: " << g_inverse_projection.m03() << "\n";
-    std::cout << "  Inv Trans Y: " << g_inverse_projection.m13() << "\n";
+    std::cout << "  Inv Trans X: " << g_inverse_projection.m02() << "\n";
+    std::cout << "  Inv Trans Y: " << g_inverse_projection.m12() << "\n";
     std::cout << "=== RESHAPE COMPLETE ===" << "\n";
 
 }
@@ -204,16 +190,8 @@ cg::Point2 screen_to_world(float screen_x, float screen_y)
     float ndc_x = (2.0f * screen_x) / static_cast<float>(g_window_width) - 1.0f;
     float ndc_y = 1.0f - (2.0f * screen_y) / static_cast<float>(g_window_height); // Flip Y
     
-    // Convert NDC to world coordinates using the implemented HPoint3 operator
-    cg::Point3 ndc_point(ndc_x, ndc_y, 0.0f); // Z=0 for 2D, W=1 for point
-    
-    // Use the newly implemented Matrix4x4::operator*(const HPoint3&)
-    cg::HPoint3 world_hpoint = g_inverse_projection * ndc_point;
-    
-    // Convert back to Cartesian coordinates
-    cg::Point3 world_point = world_hpoint.to_cartesian();
-    
-    return cg::Point2(world_point.x, world_point.y);
+    // Convert NDC to world coordinates
+    return g_inverse_projection * cg::Point2(ndc_x, ndc_y);
 }
 
 /**
@@ -225,7 +203,10 @@ void display(void)
     // Clear the framebuffer
     glClear(GL_COLOR_BUFFER_BIT);
     
-    g_scene_root->draw(g_scene_state);
+    // Count this frame's avoided GL calls from zero
+    g_scene_state.gl_state.begin_frame();
+    g_render_queue.update(*g_scene_root);
+    g_render_queue.submit(g_scene_state);
     cg::check_error("After Draw");
     
     // Swap buffers
@@ -270,14 +251,19 @@ bool handle_key_event(const SDL_Event &event)
             case SDLK_M:
                 if (upper_case) {
                     // Enable MSAA
-                    glEnable(GL_MULTISAMPLE);
+                    g_scene_state.gl_state.enable(GL_MULTISAMPLE);
                     std::cout << "MSAA enabled" << "\n";
                 } else {
                     // Disable MSAA
-                    glDisable(GL_MULTISAMPLE);
+                    g_scene_state.gl_state.disable(GL_MULTISAMPLE);
                     std::cout << "MSAA disabled" << "\n";
                 }
                 break;
+            case SDLK_G:
+                // GL calls the state cache issued and skipped in the last frame
+                std::cout << "GL state calls issued: " << g_scene_state.gl_state.get_calls_issued()
+                          << ", avoided: " << g_scene_state.gl_state.get_calls_avoided() << "\n";
+                break;
             default: 
                 break;
         }
@@ -419,7 +405,7 @@ void create_scene()
   std::shared_ptr<cg::NGonGeometryNode> circle_geometry = std::make_shared<cg::NGonGeometryNode>(cg::Point2(0.0f, 0.0f), 32, 4.5f);
   circle_geometry->set_name("CircleGeometry");
 
-  if(!circle_geometry->create())
+  if(!circle_geometry->create(g_scene_state.gl_state))
   {
     std::cerr << "Failed to create circle geometry" << "\n";
     return;
@@ -442,7 +428,7 @@ void create_scene()
   std::shared_ptr<cg::NGonGeometryNode> hexagon_geometry = std::make_shared<cg::NGonGeometryNode>(cg::Point2(-2.0f, -2.0f), 6, 3.0f);
   hexagon_geometry->set_name("HexagonGeometry");
 
-  if(!hexagon_geometry->create())
+  if(!hexagon_geometry->create(g_scene_state.gl_state))
   {
     std::cerr << "Failed to create hexagon geometry" << "\n";
     return;
@@ -463,7 +449,7 @@ void create_scene()
   std::shared_ptr<cg::NGonGeometryNode> octagon_geometry = std::make_shared<cg::NGonGeometryNode>(cg::Point2(2.5f, 2.5f), 8, 2.0f);
   octagon_geometry->set_name("OctagonGeometry");
 
-  if(!octagon_geometry->create())
+  if(!octagon_geometry->create(g_scene_state.gl_state))
   {
     std::cerr << "Failed to create octagon geometry" << "\n";
     return;
@@ -486,7 +472,7 @@ void create_scene()
   else 
   {
     g_current_line = std::make_shared<cg::DraggableLineGeometryNode>(cg::Point2(0.0f, 0.0f));
-    if(!g_current_line->create())
+    if(!g_current_line->create(g_scene_state.gl_state))
     {
       std::cerr << "Failed to make draggable line node!" << "\n";
       return;
@@ -516,7 +502,7 @@ void create_scene()
     
     // Initialize intersection tracker with point shader and n-gons
     g_intersection_tracker = std::make_shared<cg::IntersectionTracker>();
-    if (!g_intersection_tracker->initialize(g_point_shader_node, g_ngons)) {
+    if (!g_intersection_tracker->initialize(g_point_shader_node, g_ngons, g_scene_state.gl_state)) {
       std::cerr << "Failed to initialize intersection tracker" << "\n";
       g_intersection_tracker.reset();
     } else {
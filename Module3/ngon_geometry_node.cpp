@@ -10,7 +10,7 @@ namespace cg
 
 NGonGeometryNode::NGonGeometryNode(const Point2& center, int num_sides, float radius)
     : center_(center), num_sides_(num_sides), radius_(radius),
-      vao_(0), vertex_buffer_(0), index_buffer_(0),
+      gl_state_(nullptr), vao_(0), vertex_buffer_(0), index_buffer_(0),
       vertex_count_(0), index_count_(0)
 {
     // Ensure minimum of 3 sides
@@ -27,8 +27,10 @@ NGonGeometryNode::~NGonGeometryNode()
   destroy();
 }
 
-bool NGonGeometryNode::create()
+bool NGonGeometryNode::create(GLStateCache& gl_state)
 {
+  gl_state_ = &gl_state;
+
   // Generate vertex and index data 
   std::vector<float> vertices;
   std::vector<unsigned int> indices;
@@ -61,11 +63,11 @@ bool NGonGeometryNode::create()
   glGenBuffers(1, &index_buffer_);
 
   // Bind VAO first
-  glBindVertexArray(vao_);
+  gl_state.bind_vertex_array(vao_);
   cg::check_error("glBindVertexArray");
 
   // Upload vertex data
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  gl_state.bind_buffer(GL_ARRAY_BUFFER, vertex_buffer_);
   cg::check_error("glBindBuffer vertex");
   
   glBufferData(GL_ARRAY_BUFFER, 
@@ -75,7 +77,7 @@ bool NGonGeometryNode::create()
   cg::check_error("glBufferData vertex");
 
   // Upload index data 
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_);
+  gl_state.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_);
   cg::check_error("glBindBuffer index");
   
   glBufferData(GL_ELEMENT_ARRAY_BUFFER,
@@ -92,7 +94,7 @@ bool NGonGeometryNode::create()
   cg::check_error("glEnableVertexAttribArray");
 
   // Unbind VAO (good practice)
-  glBindVertexArray(0);
+  gl_state.bind_vertex_array(0);
   
   // Verify the setup worked
   GLint max_vertex_attribs;
@@ -102,6 +104,7 @@ bool NGonGeometryNode::create()
   cg::check_error("NGonGeometryNode::create - end");
   
   std::cout << "NGonGeometryNode::create completed successfully" << "\n";
+  scene_changed();
   return true;
 }
 
@@ -113,63 +116,49 @@ void NGonGeometryNode::draw(SceneState& scene_state)
         return;
     }
 
-    
-    // Verify the current shader program
-    GLint current_program;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &current_program);
-    
-    // Check if vertex attribute 0 is enabled
-    GLint vertex_attrib_enabled;
-    glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &vertex_attrib_enabled);
-    
-    // Bind VAO and draw
-    glBindVertexArray(vao_);
+    // Bind VAO and draw (the state cache skips the bind if already bound)
+    scene_state.gl_state.bind_vertex_array(vao_);
     cg::check_error("NGonGeometryNode::draw - bind VAO");
     
-    // Verify VAO is bound
-    GLint bound_vao;
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &bound_vao);
-    
-    // Check if depth testing might be interfering
-    GLboolean depth_test_enabled = glIsEnabled(GL_DEPTH_TEST);
-    
     // Draw the elements
     glDrawElements(GL_TRIANGLES, index_count_, GL_UNSIGNED_INT, 0);
     cg::check_error("NGonGeometryNode::draw - glDrawElements");
-    
-    // Re-enable depth test if it was enabled
-    if (depth_test_enabled) {
-        glEnable(GL_DEPTH_TEST);
-    }
-    
-    glBindVertexArray(0);
-    cg::check_error("NGonGeometryNode::draw - unbind VAO");
 
     SceneNode::draw(scene_state);
 }
 
+void NGonGeometryNode::compile(RenderQueue& queue)
+{
+  if(vao_ != 0)
+  {
+    queue.add_draw(vao_, GL_TRIANGLES, index_count_, GL_UNSIGNED_INT);
+  }
+  compile_children(queue);
+}
+
 void NGonGeometryNode::destroy()
 {
   if(vao_ != 0)
   {
-    glDeleteVertexArrays(1, &vao_);
+    gl_state_->delete_vertex_array(vao_);
     vao_ = 0;
   }
   
   if(vertex_buffer_ != 0)
   {
-    glDeleteBuffers(1, &vertex_buffer_);
+    gl_state_->delete_buffer(vertex_buffer_);
     vertex_buffer_ = 0;
   }
 
   if(index_buffer_ != 0)
   {
-    glDeleteBuffers(1, &index_buffer_);
+    gl_state_->delete_buffer(index_buffer_);
     index_buffer_ = 0;
   }
 
   vertex_count_ = 0;
   index_count_ = 0;
+  scene_changed();
 }
 
 void NGonGeometryNode::generate_vertices(std::vector<float>& vertices, std::vector<unsigned int>& indices)
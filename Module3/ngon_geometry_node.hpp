@@ -2,6 +2,7 @@
 #define __SCENE_NGON_GEOMETRY_NODE_HPP__
 
 #include "scene/geometry_node.hpp"
+#include "scene/gl_state_cache.hpp"
 #include "geometry/point2.hpp"
 #include <vector>
 #include "geometry/segment2.hpp"
@@ -21,9 +22,10 @@ public:
   //create method 
   /**
    * Create the OpenGL buffers and generate geometry
+   * @param gl_state GL state cache used to bind and later delete the buffers
    * @return Returns true if successful
    */
-  virtual bool create();
+  virtual bool create(GLStateCache& gl_state);
 
   /**
    * Draw the n-gon
@@ -31,6 +33,12 @@ public:
    */
   virtual void draw(SceneState& scene_state) override;
 
+  /**
+   * Compile the n-gon into a single indexed draw
+   * @param queue Render queue being compiled
+   */
+  virtual void compile(RenderQueue& queue) override;
+
   /**
    * Clean up OpenGL resources
    */
@@ -66,6 +74,7 @@ private:
   float radius_;
   
   // OpenGL buffer objects
+  GLStateCache* gl_state_; // Cache the buffers were created with
   GLuint vao_;           // Vertex Array Object
   GLuint vertex_buffer_; // Vertex Buffer Object
   GLuint index_buffer_;  // Element Buffer Object (for indices)
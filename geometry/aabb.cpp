@@ -1,53 +1,139 @@
 #include "geometry/aabb.hpp"
 
 #include "geometry/geometry.hpp"
+#include "geometry/parallel.hpp"
+#include "geometry/simd.hpp"
+
+#include <algorithm>
+#include <limits>
 
 namespace cg
 {
 
-// NOTE - this is not required until 605.767!
-
-AABB::AABB()
+namespace
 {
-    // Complete in 605.767
-}
 
-AABB::AABB(const Point3 &min, const Point3 &max)
+// Smallest number of vertices worth a thread when creating a box
+constexpr size_t MIN_PARALLEL_VERTICES = 1 << 16;
+
+// Bounds of count points
+AABB bounds_of(const Point3 *points, size_t count)
 {
-    // Complete in 605.767
+    AABB   box;
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    if(count >= 4)
+    {
+        // Two groups of 4 points per iteration to overlap the min/max chains
+        __m128 lo_x = _mm_set1_ps(box.min_corner.x);
+        __m128 lo_y = lo_x;
+        __m128 lo_z = lo_x;
+        __m128 hi_x = _mm_set1_ps(box.max_corner.x);
+        __m128 hi_y = hi_x;
+        __m128 hi_z = hi_x;
+        __m128 lo_x2 = lo_x, lo_y2 = lo_x, lo_z2 = lo_x;
+        __m128 hi_x2 = hi_x, hi_y2 = hi_x, hi_z2 = hi_x;
+        __m128 x, y, z;
+        for(; i + 8 <= count; i += 8)
+        {
+            simd::load_xyz4(&points[i].x, x, y, z);
+            lo_x = _mm_min_ps(lo_x, x);
+            lo_y = _mm_min_ps(lo_y, y);
+            lo_z = _mm_min_ps(lo_z, z);
+            hi_x = _mm_max_ps(hi_x, x);
+            hi_y = _mm_max_ps(hi_y, y);
+            hi_z = _mm_max_ps(hi_z, z);
+            simd::load_xyz4(&points[i + 4].x, x, y, z);
+            lo_x2 = _mm_min_ps(lo_x2, x);
+            lo_y2 = _mm_min_ps(lo_y2, y);
+            lo_z2 = _mm_min_ps(lo_z2, z);
+            hi_x2 = _mm_max_ps(hi_x2, x);
+            hi_y2 = _mm_max_ps(hi_y2, y);
+            hi_z2 = _mm_max_ps(hi_z2, z);
+        }
+        for(; i + 4 <= count; i += 4)
+        {
+            simd::load_xyz4(&points[i].x, x, y, z);
+            lo_x = _mm_min_ps(lo_x, x);
+            lo_y = _mm_min_ps(lo_y, y);
+            lo_z = _mm_min_ps(lo_z, z);
+            hi_x = _mm_max_ps(hi_x, x);
+            hi_y = _mm_max_ps(hi_y, y);
+            hi_z = _mm_max_ps(hi_z, z);
+        }
+        box.min_corner.x = simd::horizontal_min(_mm_min_ps(lo_x, lo_x2));
+        box.min_corner.y = simd::horizontal_min(_mm_min_ps(lo_y, lo_y2));
+        box.min_corner.z = simd::horizontal_min(_mm_min_ps(lo_z, lo_z2));
+        box.max_corner.x = simd::horizontal_max(_mm_max_ps(hi_x, hi_x2));
+        box.max_corner.y = simd::horizontal_max(_mm_max_ps(hi_y, hi_y2));
+        box.max_corner.z = simd::horizontal_max(_mm_max_ps(hi_z, hi_z2));
+    }
+#endif
+    for(; i < count; i++)
+    {
+        const Point3 &p = points[i];
+        box.min_corner.x = std::min(box.min_corner.x, p.x);
+        box.min_corner.y = std::min(box.min_corner.y, p.y);
+        box.min_corner.z = std::min(box.min_corner.z, p.z);
+        box.max_corner.x = std::max(box.max_corner.x, p.x);
+        box.max_corner.y = std::max(box.max_corner.y, p.y);
+        box.max_corner.z = std::max(box.max_corner.z, p.z);
+    }
+    return box;
 }
 
-AABB::AABB(const std::vector<Point3> &vertex_list)
+} // namespace
+
+// NOTE - this is not required until 605.767!
+
+AABB::AABB() :
+    min_corner{std::numeric_limits<float>::max(),
+               std::numeric_limits<float>::max(),
+               std::numeric_limits<float>::max()},
+    max_corner{-std::numeric_limits<float>::max(),
+               -std::numeric_limits<float>::max(),
+               -std::numeric_limits<float>::max()}
 {
-    // Complete in 605.767
 }
 
-void AABB::create(const std::vector<Point3> &vertex_list)
+AABB::AABB(const Point3 &min, const Point3 &max) : min_corner(min), max_corner(max) {}
+
+AABB::AABB(Span<const Point3> vertex_list) { create(vertex_list); }
+
+void AABB::create(Span<const Point3> vertex_list)
 {
-    // Complete in 605.767
+    const Point3 *points = vertex_list.data();
+    *this = parallel_reduce(
+        vertex_list.size(),
+        MIN_PARALLEL_VERTICES,
+        AABB(),
+        [points](size_t begin, size_t end) { return bounds_of(points + begin, end - begin); },
+        [](AABB a, const AABB &b)
+        {
+            a.merge(b);
+            return a;
+        });
 }
 
 void AABB::update(const Point3 &min, const Point3 &max)
 {
-    // Complete in 605.767
+    min_corner = min;
+    max_corner = max;
 }
 
 void AABB::merge(const AABB &box)
 {
-    // Complete in 605.767
+    min_corner.x = std::min(min_corner.x, box.min_corner.x);
+    min_corner.y = std::min(min_corner.y, box.min_corner.y);
+    min_corner.z = std::min(min_corner.z, box.min_corner.z);
+    max_corner.x = std::max(max_corner.x, box.max_corner.x);
+    max_corner.y = std::max(max_corner.y, box.max_corner.y);
+    max_corner.z = std::max(max_corner.z, box.max_corner.z);
 }
 
-Point3 AABB::min_pt() const
-{
-    // Complete in 605.767
-    return Point3();
-}
+Point3 AABB::min_pt() const { return min_corner; }
 
-Point3 AABB::max_pt() const
-{
-    // Complete in 605.767
-    return Point3();
-}
+Point3 AABB::max_pt() const { return max_corner; }
 
 void compute_center()
 {
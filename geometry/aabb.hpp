@@ -12,8 +12,9 @@
 #define __GEOMETRY_AABB_HPP__
 
 #include "geometry/point3.hpp"
+#include "geometry/span.hpp"
 
-#include <vector>
+#include <type_traits>
 
 namespace cg
 {
@@ -23,8 +24,12 @@ namespace cg
  */
 struct AABB
 {
+    Point3 min_corner; // Minimum x,y,z
+    Point3 max_corner; // Maximum x,y,z
+
     /**
-     * Default constructor.
+     * Default constructor. Creates an empty box (min > max) that any merge
+     * replaces.
      */
     AABB();
 
@@ -36,16 +41,18 @@ struct AABB
     AABB(const Point3 &min, const Point3 &max);
 
     /**
-     * Construct an AABB given a vertex list.
+     * Construct an AABB given a vertex list. See create.
      * @param  vertex_list  Vertex list.
      */
-    AABB(const std::vector<Point3> &vertex_list);
+    AABB(Span<const Point3> vertex_list);
 
     /**
-     * Creates an AABB given a vertex list.
+     * Creates an AABB given a vertex list. Uses SIMD min/max, and splits
+     * large lists across threads (the partial boxes are combined with merge).
+     * An empty list gives an empty box.
      * @param  vertex_list  Vertex list.
      */
-    void create(const std::vector<Point3> &vertex_list);
+    void create(Span<const Point3> vertex_list);
 
     /**
      * Updates the AABB given new minimum and maximum points.
@@ -55,7 +62,8 @@ struct AABB
     void update(const Point3 &min, const Point3 &max);
 
     /**
-     * Merge this bbox with another another. Update this box.
+     * Merge this bbox with another another. Update this box. Merging with an
+     * empty box leaves this box unchanged.
      * @param  box  Other box to merge.
      */
     void merge(const AABB &box);
@@ -78,6 +86,10 @@ struct AABB
     void compute_center();
 };
 
+static_assert(std::is_trivially_copyable<AABB>::value, "AABB must be trivially copyable");
+static_assert(std::is_standard_layout<AABB>::value, "AABB must be standard layout");
+static_assert(sizeof(AABB) == 6 * sizeof(float), "AABB must be 6 packed floats");
+
 } // namespace cg
 
 #endif
@@ -0,0 +1,70 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    aligned_allocator.hpp
+//	Purpose: Allocator for std::vector storage aligned for SIMD loads.
+//============================================================================
+
+#ifndef __GEOMETRY_ALIGNED_ALLOCATOR_HPP__
+#define __GEOMETRY_ALIGNED_ALLOCATOR_HPP__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace cg
+{
+
+// Alignment (bytes) of SIMD friendly storage. Large enough for AVX loads.
+constexpr size_t SIMD_ALIGNMENT = 32;
+
+/**
+ * Allocator that returns storage aligned to the specified number of bytes.
+ */
+template <typename T, size_t Alignment = SIMD_ALIGNMENT>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept
+    {
+    }
+
+    T *allocate(size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T *p, size_t) noexcept { ::operator delete(p, std::align_val_t(Alignment)); }
+};
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &)
+{
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &)
+{
+    return false;
+}
+
+// Vector of floats with SIMD aligned storage
+using AlignedFloatVector = std::vector<float, AlignedAllocator<float>>;
+
+} // namespace cg
+
+#endif
@@ -1,24 +1,258 @@
 #include "geometry/bounding_sphere.hpp"
 
 #include "geometry/geometry.hpp"
+#include "geometry/parallel.hpp"
+#include "geometry/simd.hpp"
+
+#include <cmath>
+#include <limits>
 
 namespace cg
 {
 
-BoundingSphere::BoundingSphere() : center{0.0f, 0.0f, 0.0f}, radius(1.0f) {}
+namespace
+{
+
+// Smallest number of vertices worth a thread when fitting a sphere
+constexpr size_t MIN_PARALLEL_VERTICES = 1 << 16;
+
+// Directions searched for extreme points: the 3 axes and the 4 cube
+// diagonals (not normalized, which does not change the extreme points)
+constexpr uint32_t DIRECTION_COUNT = 7;
+
+inline void project(const Point3 &p, float *d)
+{
+    float xy = p.x + p.y;
+    float xmy = p.x - p.y;
+    d[0] = p.x;
+    d[1] = p.y;
+    d[2] = p.z;
+    d[3] = xy + p.z;
+    d[4] = xy - p.z;
+    d[5] = xmy + p.z;
+    d[6] = xmy - p.z;
+}
+
+// Smallest and largest projection along each direction and the index of the
+// point with it. Ties go to the lower index so the result does not depend on
+// how the list was split.
+struct Extremes
+{
+    float    lo[DIRECTION_COUNT];
+    float    hi[DIRECTION_COUNT];
+    uint32_t lo_index[DIRECTION_COUNT];
+    uint32_t hi_index[DIRECTION_COUNT];
+
+    Extremes()
+    {
+        for(uint32_t k = 0; k < DIRECTION_COUNT; k++)
+        {
+            lo[k] = std::numeric_limits<float>::max();
+            hi[k] = -std::numeric_limits<float>::max();
+            lo_index[k] = 0;
+            hi_index[k] = 0;
+        }
+    }
+
+    void add(uint32_t k, float lo_value, uint32_t lo_i, float hi_value, uint32_t hi_i)
+    {
+        if(lo_value < lo[k] || (lo_value == lo[k] && lo_i < lo_index[k]))
+        {
+            lo[k] = lo_value;
+            lo_index[k] = lo_i;
+        }
+        if(hi_value > hi[k] || (hi_value == hi[k] && hi_i < hi_index[k]))
+        {
+            hi[k] = hi_value;
+            hi_index[k] = hi_i;
+        }
+    }
+
+    void merge(const Extremes &e)
+    {
+        for(uint32_t k = 0; k < DIRECTION_COUNT; k++)
+            add(k, e.lo[k], e.lo_index[k], e.hi[k], e.hi_index[k]);
+    }
+};
+
+Extremes find_extremes(const Point3 *points, size_t begin, size_t end)
+{
+    Extremes e;
+    float    d[DIRECTION_COUNT];
+    size_t   i = begin;
+#if defined(CG_SIMD_SSE)
+    // Compare 4 points at a time against the current extremes. New extremes
+    // become rare after the first few points, so updates take a scalar path.
+    __m128 lo[DIRECTION_COUNT], hi[DIRECTION_COUNT];
+    for(uint32_t k = 0; k < DIRECTION_COUNT; k++)
+    {
+        lo[k] = _mm_set1_ps(e.lo[k]);
+        hi[k] = _mm_set1_ps(e.hi[k]);
+    }
+    for(; i + 4 <= end; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&points[i].x, x, y, z);
+        __m128 xy = _mm_add_ps(x, y);
+        __m128 xmy = _mm_sub_ps(x, y);
+        __m128 p[DIRECTION_COUNT] = {x,
+                                     y,
+                                     z,
+                                     _mm_add_ps(xy, z),
+                                     _mm_sub_ps(xy, z),
+                                     _mm_add_ps(xmy, z),
+                                     _mm_sub_ps(xmy, z)};
+        __m128 outside = _mm_setzero_ps();
+        for(uint32_t k = 0; k < DIRECTION_COUNT; k++)
+        {
+            outside = _mm_or_ps(outside,
+                                _mm_or_ps(_mm_cmplt_ps(p[k], lo[k]), _mm_cmpgt_ps(p[k], hi[k])));
+        }
+        if(_mm_movemask_ps(outside) == 0) continue;
+
+        for(size_t j = i; j < i + 4; j++)
+        {
+            project(points[j], d);
+            uint32_t index = static_cast<uint32_t>(j);
+            for(uint32_t k = 0; k < DIRECTION_COUNT; k++) e.add(k, d[k], index, d[k], index);
+        }
+        for(uint32_t k = 0; k < DIRECTION_COUNT; k++)
+        {
+            lo[k] = _mm_set1_ps(e.lo[k]);
+            hi[k] = _mm_set1_ps(e.hi[k]);
+        }
+    }
+#endif
+    for(; i < end; i++)
+    {
+        project(points[i], d);
+        uint32_t index = static_cast<uint32_t>(i);
+        for(uint32_t k = 0; k < DIRECTION_COUNT; k++) e.add(k, d[k], index, d[k], index);
+    }
+    return e;
+}
 
-BoundingSphere::BoundingSphere(const BoundingSphere &s) : center(s.center), radius(s.radius) {}
+// Initial sphere through the most distant pair of extreme points
+BoundingSphere seed_sphere(const Point3 *points, const Extremes &e)
+{
+    uint32_t best = 0;
+    float    best_d2 = -1.0f;
+    for(uint32_t k = 0; k < DIRECTION_COUNT; k++)
+    {
+        float d2 = (points[e.hi_index[k]] - points[e.lo_index[k]]).norm_squared();
+        if(d2 > best_d2)
+        {
+            best = k;
+            best_d2 = d2;
+        }
+    }
+    const Point3 &a = points[e.lo_index[best]];
+    const Point3 &b = points[e.hi_index[best]];
+    return BoundingSphere(Point3(0.5f * (a.x + b.x), 0.5f * (a.y + b.y), 0.5f * (a.z + b.z)),
+                          0.5f * std::sqrt(best_d2));
+}
+
+// Grows a sphere to contain a point (Ritter). The new sphere touches the
+// point and the far side of the old sphere.
+inline void grow_to(BoundingSphere &s, const Point3 &p)
+{
+    Vector3 d = p - s.center;
+    float   d2 = d.norm_squared();
+    if(d2 <= s.radius * s.radius) return;
+
+    float dist = std::sqrt(d2);
+    float radius = 0.5f * (s.radius + dist);
+    s.center = s.center + d * ((radius - s.radius) / dist);
+    s.radius = radius;
+}
+
+BoundingSphere grow_sphere(BoundingSphere s, const Point3 *points, size_t begin, size_t end)
+{
+    size_t i = begin;
+#if defined(CG_SIMD_SSE)
+    // Test 4 points at a time. Most points are inside the seed sphere, so
+    // only the few outside take the scalar path.
+    __m128 cx = _mm_set1_ps(s.center.x);
+    __m128 cy = _mm_set1_ps(s.center.y);
+    __m128 cz = _mm_set1_ps(s.center.z);
+    __m128 r2 = _mm_set1_ps(s.radius * s.radius);
+    for(; i + 4 <= end; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&points[i].x, x, y, z);
+        __m128 dx = _mm_sub_ps(x, cx);
+        __m128 dy = _mm_sub_ps(y, cy);
+        __m128 dz = _mm_sub_ps(z, cz);
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                               _mm_mul_ps(dz, dz));
+        int32_t mask = _mm_movemask_ps(_mm_cmpgt_ps(d2, r2));
+        if(mask == 0) continue;
+
+        for(int32_t lane = 0; lane < 4; lane++)
+        {
+            if((mask & (1 << lane)) != 0) grow_to(s, points[i + lane]);
+        }
+        cx = _mm_set1_ps(s.center.x);
+        cy = _mm_set1_ps(s.center.y);
+        cz = _mm_set1_ps(s.center.z);
+        r2 = _mm_set1_ps(s.radius * s.radius);
+    }
+#endif
+    for(; i < end; i++) grow_to(s, points[i]);
+    return s;
+}
+
+} // namespace
+
+BoundingSphere::BoundingSphere() : center{0.0f, 0.0f, 0.0f}, radius(1.0f) {}
 
 BoundingSphere::BoundingSphere(const Point3 &c, float r) : center(c), radius(r) {}
 
-BoundingSphere::BoundingSphere(std::vector<Point3> &vertex_list)
+BoundingSphere::BoundingSphere(Span<const Point3> vertex_list) :
+    center{0.0f, 0.0f, 0.0f},
+    radius(0.0f)
 {
-    // Complete in 605.767
+    if(vertex_list.empty()) return;
+
+    const Point3 *points = vertex_list.data();
+    size_t        count = vertex_list.size();
+    Extremes      extremes = parallel_reduce(
+        count,
+        MIN_PARALLEL_VERTICES,
+        Extremes(),
+        [points](size_t begin, size_t end) { return find_extremes(points, begin, end); },
+        [](Extremes a, const Extremes &b)
+        {
+            a.merge(b);
+            return a;
+        });
+
+    BoundingSphere seed = seed_sphere(points, extremes);
+    *this = parallel_reduce(
+        count,
+        MIN_PARALLEL_VERTICES,
+        seed,
+        [points, seed](size_t begin, size_t end) { return grow_sphere(seed, points, begin, end); },
+        [](BoundingSphere a, const BoundingSphere &b) { return a.merge_with(b); });
 }
 
 BoundingSphere &BoundingSphere::merge_with(const BoundingSphere &s2)
 {
-    // Complete in 605.767
+    Vector3 d = s2.center - center;
+    float   dist = d.norm();
+
+    // One sphere contains the other
+    if(dist + s2.radius <= radius) return *this;
+    if(dist + radius <= s2.radius)
+    {
+        *this = s2;
+        return *this;
+    }
+
+    // The new sphere touches the far sides of both spheres
+    float r = 0.5f * (dist + radius + s2.radius);
+    center = center + d * ((r - radius) / dist);
+    radius = r;
     return *this;
 }
 
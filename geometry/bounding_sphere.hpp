@@ -13,8 +13,9 @@
 #define __GEOMETRY_BOUNDING_SPHERE_HPP__
 
 #include "geometry/point3.hpp"
+#include "geometry/span.hpp"
 
-#include <vector>
+#include <type_traits>
 
 namespace cg
 {
@@ -32,12 +33,6 @@ struct BoundingSphere
      */
     BoundingSphere();
 
-    /**
-     * Copy constructor
-     * @param   s   Sphere to copy.
-     */
-    BoundingSphere(const BoundingSphere &s);
-
     /**
      * Constructor given a center point and radius.
      * @param  c  Center point.
@@ -46,10 +41,17 @@ struct BoundingSphere
     BoundingSphere(const Point3 &c, float r);
 
     /**
-     * Construct a sphere given a vertex list. Method by Ritter.
+     * Construct a sphere given a vertex list. Method by Ritter, seeded with
+     * the most distant pair of extreme points along 7 directions (the axes
+     * and the 4 cube diagonals, as in EPOS-14) rather than the axes only.
+     * Both passes use SIMD and split large lists across threads: each thread
+     * grows the seed sphere over its part of the list and the spheres are
+     * combined with merge_with. The result can differ slightly with the
+     * number of threads. An empty list gives a zero radius sphere at the
+     * origin.
      * @param  vertex_list  Vertex list to surround with the sphere.
      */
-    BoundingSphere(std::vector<Point3> &vertex_list);
+    BoundingSphere(Span<const Point3> vertex_list);
 
     /**
      * Merge this bounding sphere with another to create the smallest sphere
@@ -68,6 +70,13 @@ struct BoundingSphere
     BoundingSphere merge(const BoundingSphere &s2) const;
 };
 
+static_assert(std::is_trivially_copyable<BoundingSphere>::value,
+              "BoundingSphere must be trivially copyable");
+static_assert(std::is_standard_layout<BoundingSphere>::value,
+              "BoundingSphere must be standard layout");
+static_assert(sizeof(BoundingSphere) == 4 * sizeof(float),
+              "BoundingSphere must be 4 packed floats");
+
 } // namespace cg
 
 #endif
@@ -0,0 +1,49 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    constants.hpp
+//	Purpose: Math constants and angle conversions shared by the geometry
+//           types. Kept separate from geometry.hpp so the individual value
+//           type headers can use them in their inline definitions.
+//============================================================================
+
+#ifndef __GEOMETRY_CONSTANTS_HPP__
+#define __GEOMETRY_CONSTANTS_HPP__
+
+namespace cg
+{
+
+#ifndef CG_MATH_CONSTANTS
+#define CG_MATH_CONSTANTS
+#define CG_PI 3.141592653589793115997963468544185161590576171875
+#define CG_PHI 1.6180339887498948482072100296669248109537875279784202576
+#define CG_PHI_INV 0.6180339887498948482072100296669248109537875279784202576
+#endif
+
+constexpr float PI = static_cast<float>(CG_PI);
+constexpr float PHI = static_cast<float>(CG_PHI);
+constexpr float PHI_INV = static_cast<float>(CG_PHI_INV);
+constexpr float EPSILON = 0.000001f;
+constexpr float RADIANS_PER_DEGREE = static_cast<float>(180.0 / CG_PI);
+constexpr float DEGREES_PER_RADIAN = static_cast<float>(CG_PI / 180.0);
+
+/**
+ * Degrees to radians conversion
+ * @param   d   Angle in degrees.
+ * @return  Returns the angle in radians.
+ */
+constexpr float degrees_to_radians(float d) { return d * DEGREES_PER_RADIAN; }
+
+/**
+ * Radians to degrees conversion
+ * @param   r   Angle in radians.
+ * @return  Returns the angle in degrees.
+ */
+constexpr float radians_to_degrees(float r) { return r * RADIANS_PER_DEGREE; }
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,63 @@
+#include "geometry/dual_quaternion.hpp"
+
+namespace cg
+{
+
+DualQuaternion::DualQuaternion(const Quaternion &rotation, const Vector3 &translation) :
+    real(rotation),
+    dual(Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation * 0.5f)
+{
+}
+
+DualQuaternion::DualQuaternion(const Matrix4x4 &m) :
+    DualQuaternion(Quaternion(m), Vector3(m.m03(), m.m13(), m.m23()))
+{
+}
+
+DualQuaternion &DualQuaternion::normalize()
+{
+    float n = real.norm();
+    if(n > EPSILON)
+    {
+        float inv = 1.0f / n;
+        real = real * inv;
+        dual = dual * inv;
+
+        // Remove any drift that makes the dual part non-orthogonal to the real
+        // part (a unit dual quaternion has real.dot(dual) == 0)
+        dual = dual + real * -real.dot(dual);
+    }
+    return *this;
+}
+
+Vector3 DualQuaternion::get_translation() const
+{
+    Quaternion t = dual * real.conjugate();
+    return Vector3(2.0f * t.x, 2.0f * t.y, 2.0f * t.z);
+}
+
+Point3 DualQuaternion::transform(const Point3 &p) const
+{
+    Vector3 v = real.rotate(Vector3(p)) + get_translation();
+    return Point3(v.x, v.y, v.z);
+}
+
+Matrix4x4 DualQuaternion::get_matrix() const
+{
+    Matrix4x4 m = real.get_matrix();
+    Vector3   t = get_translation();
+    m.m03() = t.x;
+    m.m13() = t.y;
+    m.m23() = t.z;
+    return m;
+}
+
+DualQuaternion nlerp(const DualQuaternion &a, const DualQuaternion &b, float t)
+{
+    // Blend along the shorter arc (q and -q are the same transform)
+    float          s = (a.real.dot(b.real) < 0.0f) ? -t : t;
+    DualQuaternion r(a.real * (1.0f - t) + b.real * s, a.dual * (1.0f - t) + b.dual * s);
+    return r.normalize();
+}
+
+} // namespace cg
@@ -0,0 +1,180 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    dual_quaternion.hpp
+//	Purpose: Dual quaternion class for representing rigid body transforms.
+//============================================================================
+
+#ifndef __GEOMETRY_DUAL_QUATERNION_HPP__
+#define __GEOMETRY_DUAL_QUATERNION_HPP__
+
+#include "geometry/matrix.hpp"
+#include "geometry/point3.hpp"
+#include "geometry/quaternion.hpp"
+#include "geometry/simd.hpp"
+#include "geometry/vector3.hpp"
+
+#include <type_traits>
+
+namespace cg
+{
+
+/**
+ * Dual quaternion real + dual e (e^2 = 0). Unit dual quaternions represent
+ * rigid body transforms (rotation followed by translation) in 8 floats
+ * instead of a 4x4 matrix. The product a * b applies b first, then a.
+ */
+struct DualQuaternion
+{
+    Quaternion real; // Rotation
+    Quaternion dual; // 0.5 * translation * rotation
+
+    /**
+     * Default constructor. Sets the identity transform.
+     */
+    constexpr DualQuaternion();
+
+    /**
+     * Constructor given the real and dual parts.
+     * @param   r   Real part.
+     * @param   d   Dual part.
+     */
+    constexpr DualQuaternion(const Quaternion &r, const Quaternion &d);
+
+    /**
+     * Constructor from a rotation followed by a translation.
+     * @param   rotation     Unit rotation quaternion.
+     * @param   translation  Translation applied after the rotation.
+     */
+    DualQuaternion(const Quaternion &rotation, const Vector3 &translation);
+
+    /**
+     * Constructor from a rigid body matrix (rotation and translation only).
+     * @param   m   Rigid body matrix.
+     */
+    explicit DualQuaternion(const Matrix4x4 &m);
+
+    /**
+     * Composes transforms. The result applies q first, then the current
+     * transform.
+     * @param   q   Dual quaternion to right-multiply by.
+     * @return  Returns the product.
+     */
+    DualQuaternion operator*(const DualQuaternion &q) const;
+
+    /**
+     * Right-multiplies the current dual quaternion by q.
+     * @param   q   Dual quaternion to right-multiply by.
+     * @return  Returns the address of the current dual quaternion.
+     */
+    DualQuaternion &operator*=(const DualQuaternion &q);
+
+    /**
+     * Scales the dual quaternion so the real part has unit length.
+     * @return  Returns the address of the current dual quaternion.
+     */
+    DualQuaternion &normalize();
+
+    /**
+     * Gets the inverse of a unit dual quaternion (the inverse rigid body
+     * transform).
+     * @return  Returns the inverse.
+     */
+    constexpr DualQuaternion get_inverse() const;
+
+    /**
+     * Gets the rotation part.
+     * @return  Returns the rotation quaternion.
+     */
+    constexpr Quaternion get_rotation() const;
+
+    /**
+     * Gets the translation part.
+     * @return  Returns the translation (applied after the rotation).
+     */
+    Vector3 get_translation() const;
+
+    /**
+     * Transforms a point (rotation then translation).
+     * @param   p   Point to transform.
+     * @return  Returns the transformed point.
+     */
+    Point3 transform(const Point3 &p) const;
+
+    /**
+     * Transforms a vector (rotation only).
+     * @param   v   Vector to transform.
+     * @return  Returns the transformed vector.
+     */
+    constexpr Vector3 transform(const Vector3 &v) const;
+
+    /**
+     * Gets the rigid body matrix for the (unit) dual quaternion.
+     * @return  Returns the matrix.
+     */
+    Matrix4x4 get_matrix() const;
+};
+
+static_assert(std::is_trivially_copyable<DualQuaternion>::value,
+              "DualQuaternion must be trivially copyable");
+static_assert(std::is_standard_layout<DualQuaternion>::value,
+              "DualQuaternion must be standard layout");
+static_assert(sizeof(DualQuaternion) == 8 * sizeof(float),
+              "DualQuaternion must be 8 packed floats");
+
+/**
+ * Normalized linear interpolation (dual quaternion linear blending) between
+ * unit dual quaternions along the shorter arc.
+ * @param   a   Transform at t = 0.
+ * @param   b   Transform at t = 1.
+ * @param   t   Interpolation parameter (0 to 1).
+ * @return  Returns the interpolated unit dual quaternion.
+ */
+DualQuaternion nlerp(const DualQuaternion &a, const DualQuaternion &b, float t);
+
+constexpr DualQuaternion::DualQuaternion() : real(), dual(0.0f, 0.0f, 0.0f, 0.0f) {}
+
+constexpr DualQuaternion::DualQuaternion(const Quaternion &r, const Quaternion &d) :
+    real(r),
+    dual(d)
+{
+}
+
+inline DualQuaternion DualQuaternion::operator*(const DualQuaternion &q) const
+{
+#if defined(CG_SIMD_SSE)
+    __m128         ar = _mm_loadu_ps(&real.x);
+    __m128         ad = _mm_loadu_ps(&dual.x);
+    __m128         br = _mm_loadu_ps(&q.real.x);
+    __m128         bd = _mm_loadu_ps(&q.dual.x);
+    DualQuaternion r;
+    _mm_storeu_ps(&r.real.x, simd::quaternion_multiply(ar, br));
+    _mm_storeu_ps(&r.dual.x,
+                  _mm_add_ps(simd::quaternion_multiply(ar, bd), simd::quaternion_multiply(ad, br)));
+    return r;
+#else
+    return DualQuaternion(real * q.real, real * q.dual + dual * q.real);
+#endif
+}
+
+inline DualQuaternion &DualQuaternion::operator*=(const DualQuaternion &q)
+{
+    *this = *this * q;
+    return *this;
+}
+
+constexpr DualQuaternion DualQuaternion::get_inverse() const
+{
+    return DualQuaternion(real.conjugate(), dual.conjugate());
+}
+
+constexpr Quaternion DualQuaternion::get_rotation() const { return real; }
+
+constexpr Vector3 DualQuaternion::transform(const Vector3 &v) const { return real.rotate(v); }
+
+} // namespace cg
+
+#endif
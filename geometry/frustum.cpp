@@ -0,0 +1,410 @@
+#include "geometry/frustum.hpp"
+
+#include "geometry/simd.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+namespace
+{
+
+// Half extent radius of a box (center c, half extents e) along a plane
+// normal: the largest distance from the center to a box corner.
+inline float box_radius(const Plane &p, float ex, float ey, float ez)
+{
+    return std::abs(p.a) * ex + std::abs(p.b) * ey + std::abs(p.c) * ez;
+}
+
+/**
+ * Classifies a volume against the planes. distance(plane, dist, radius)
+ * gives the signed distance of the volume center and the volume's radius
+ * along the plane normal. The hinted plane is tested first, and the hint is
+ * set to the plane that rejects the volume.
+ */
+template <typename Distance>
+CullResult classify_planes(const std::array<Plane, Frustum::PLANE_COUNT> &planes,
+                           const Distance                                &distance,
+                           uint8_t                                       &plane_hint)
+{
+    float dist, radius;
+    distance(planes[plane_hint], dist, radius);
+    if(dist < -radius) return CullResult::OUTSIDE;
+    bool intersecting = dist < radius;
+    for(uint32_t k = 0; k < Frustum::PLANE_COUNT; k++)
+    {
+        if(k == plane_hint) continue;
+        distance(planes[k], dist, radius);
+        if(dist < -radius)
+        {
+            plane_hint = static_cast<uint8_t>(k);
+            return CullResult::OUTSIDE;
+        }
+        if(dist < radius) intersecting = true;
+    }
+    return intersecting ? CullResult::INTERSECTING : CullResult::INSIDE;
+}
+
+#if defined(CG_SIMD_SSE)
+// Plane coefficients in 4 lanes
+struct PlaneLanes
+{
+    __m128 a, b, c, d;
+};
+
+inline PlaneLanes broadcast(const Plane &p)
+{
+    return {_mm_set1_ps(p.a), _mm_set1_ps(p.b), _mm_set1_ps(p.c), _mm_set1_ps(p.d)};
+}
+
+// Lane i gets plane hints[i]
+inline PlaneLanes gather(const std::array<Plane, Frustum::PLANE_COUNT> &planes,
+                         const uint8_t                                 *hints)
+{
+    const Plane &p0 = planes[hints[0]];
+    const Plane &p1 = planes[hints[1]];
+    const Plane &p2 = planes[hints[2]];
+    const Plane &p3 = planes[hints[3]];
+    return {_mm_setr_ps(p0.a, p1.a, p2.a, p3.a),
+            _mm_setr_ps(p0.b, p1.b, p2.b, p3.b),
+            _mm_setr_ps(p0.c, p1.c, p2.c, p3.c),
+            _mm_setr_ps(p0.d, p1.d, p2.d, p3.d)};
+}
+
+inline __m128 abs4(__m128 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+
+// Signed center distance, same operations as Plane::solve
+inline __m128 solve4(const PlaneLanes &p, __m128 x, __m128 y, __m128 z)
+{
+    return _mm_sub_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(p.a, x), _mm_mul_ps(p.b, y)), _mm_mul_ps(p.c, z)), p.d);
+}
+
+// 4 boxes of a table
+struct BoxLanes
+{
+    __m128 cx, cy, cz, ex, ey, ez;
+
+    BoxLanes(const AABBTable &t, size_t i) :
+        cx(_mm_load_ps(t.cx() + i)),
+        cy(_mm_load_ps(t.cy() + i)),
+        cz(_mm_load_ps(t.cz() + i)),
+        ex(_mm_load_ps(t.ex() + i)),
+        ey(_mm_load_ps(t.ey() + i)),
+        ez(_mm_load_ps(t.ez() + i))
+    {
+    }
+
+    void distance(const PlaneLanes &p, __m128 &dist, __m128 &radius) const
+    {
+        dist = solve4(p, cx, cy, cz);
+        radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs4(p.a), ex), _mm_mul_ps(abs4(p.b), ey)),
+                            _mm_mul_ps(abs4(p.c), ez));
+    }
+};
+
+// 4 spheres of a table
+struct SphereLanes
+{
+    __m128 cx, cy, cz, r;
+
+    SphereLanes(const BoundingSphereTable &t, size_t i) :
+        cx(_mm_load_ps(t.cx() + i)),
+        cy(_mm_load_ps(t.cy() + i)),
+        cz(_mm_load_ps(t.cz() + i)),
+        r(_mm_load_ps(t.r() + i))
+    {
+    }
+
+    void distance(const PlaneLanes &p, __m128 &dist, __m128 &radius) const
+    {
+        dist = solve4(p, cx, cy, cz);
+        radius = r;
+    }
+};
+
+/**
+ * Classifies 4 volumes. Same results and hint updates as classify_planes:
+ * the hinted planes are tested first (one per lane), then every plane in
+ * order for the lanes they did not reject.
+ */
+template <typename Lanes>
+void classify_lanes(const std::array<Plane, Frustum::PLANE_COUNT> &planes,
+                    const Lanes                                   &v,
+                    CullResult                                    *results,
+                    uint8_t                                       *hints)
+{
+    __m128 dist, radius;
+    v.distance(gather(planes, hints), dist, radius);
+    __m128 outside = _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), radius));
+    if(_mm_movemask_ps(outside) == 0xF)
+    {
+        for(int32_t lane = 0; lane < 4; lane++) results[lane] = CullResult::OUTSIDE;
+        return;
+    }
+
+    // Rejecting plane per lane (as a float)
+    __m128 reject = _mm_setr_ps(hints[0], hints[1], hints[2], hints[3]);
+    __m128 intersecting = _mm_setzero_ps();
+    for(uint32_t k = 0; k < Frustum::PLANE_COUNT; k++)
+    {
+        v.distance(broadcast(planes[k]), dist, radius);
+        __m128 out = _mm_andnot_ps(outside,
+                                   _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), radius)));
+        reject = _mm_or_ps(_mm_and_ps(out, _mm_set1_ps(static_cast<float>(k))),
+                           _mm_andnot_ps(out, reject));
+        outside = _mm_or_ps(outside, out);
+        intersecting = _mm_or_ps(intersecting, _mm_cmplt_ps(dist, radius));
+        if(_mm_movemask_ps(outside) == 0xF) break;
+    }
+
+    int32_t           out_mask = _mm_movemask_ps(outside);
+    int32_t           intersect_mask = _mm_movemask_ps(intersecting);
+    alignas(16) float reject4[4];
+    _mm_store_ps(reject4, reject);
+    for(int32_t lane = 0; lane < 4; lane++)
+    {
+        if((out_mask & (1 << lane)) != 0)
+        {
+            results[lane] = CullResult::OUTSIDE;
+            hints[lane] = static_cast<uint8_t>(reject4[lane]);
+        }
+        else if((intersect_mask & (1 << lane)) != 0) { results[lane] = CullResult::INTERSECTING; }
+        else { results[lane] = CullResult::INSIDE; }
+    }
+}
+#endif
+
+// Sizes the result and hint lists for a batch. Without a hint list the
+// scratch hints (all 0) are used.
+uint8_t *prepare_batch(size_t                   count,
+                       std::vector<CullResult> &results,
+                       std::vector<uint8_t>    *plane_hints,
+                       std::vector<uint8_t>    &scratch)
+{
+    results.resize(count);
+    std::vector<uint8_t> &hints = plane_hints != nullptr ? *plane_hints : scratch;
+    if(plane_hints == nullptr || hints.size() != count) hints.assign(count, 0);
+    return hints.data();
+}
+
+} // namespace
+
+size_t AABBTable::size() const { return cx_.size(); }
+
+void AABBTable::reserve(size_t n)
+{
+    cx_.reserve(n);
+    cy_.reserve(n);
+    cz_.reserve(n);
+    ex_.reserve(n);
+    ey_.reserve(n);
+    ez_.reserve(n);
+}
+
+void AABBTable::clear()
+{
+    cx_.clear();
+    cy_.clear();
+    cz_.clear();
+    ex_.clear();
+    ey_.clear();
+    ez_.clear();
+}
+
+void AABBTable::push_back(const AABB &box)
+{
+    cx_.push_back(0.0f);
+    cy_.push_back(0.0f);
+    cz_.push_back(0.0f);
+    ex_.push_back(0.0f);
+    ey_.push_back(0.0f);
+    ez_.push_back(0.0f);
+    set(size() - 1, box);
+}
+
+void AABBTable::set(size_t i, const AABB &box)
+{
+    cx_[i] = 0.5f * (box.min_corner.x + box.max_corner.x);
+    cy_[i] = 0.5f * (box.min_corner.y + box.max_corner.y);
+    cz_[i] = 0.5f * (box.min_corner.z + box.max_corner.z);
+    ex_[i] = 0.5f * (box.max_corner.x - box.min_corner.x);
+    ey_[i] = 0.5f * (box.max_corner.y - box.min_corner.y);
+    ez_[i] = 0.5f * (box.max_corner.z - box.min_corner.z);
+}
+
+const float *AABBTable::cx() const { return cx_.data(); }
+
+const float *AABBTable::cy() const { return cy_.data(); }
+
+const float *AABBTable::cz() const { return cz_.data(); }
+
+const float *AABBTable::ex() const { return ex_.data(); }
+
+const float *AABBTable::ey() const { return ey_.data(); }
+
+const float *AABBTable::ez() const { return ez_.data(); }
+
+size_t BoundingSphereTable::size() const { return cx_.size(); }
+
+void BoundingSphereTable::reserve(size_t n)
+{
+    cx_.reserve(n);
+    cy_.reserve(n);
+    cz_.reserve(n);
+    r_.reserve(n);
+}
+
+void BoundingSphereTable::clear()
+{
+    cx_.clear();
+    cy_.clear();
+    cz_.clear();
+    r_.clear();
+}
+
+void BoundingSphereTable::push_back(const BoundingSphere &sphere)
+{
+    cx_.push_back(sphere.center.x);
+    cy_.push_back(sphere.center.y);
+    cz_.push_back(sphere.center.z);
+    r_.push_back(sphere.radius);
+}
+
+void BoundingSphereTable::set(size_t i, const BoundingSphere &sphere)
+{
+    cx_[i] = sphere.center.x;
+    cy_[i] = sphere.center.y;
+    cz_[i] = sphere.center.z;
+    r_[i] = sphere.radius;
+}
+
+const float *BoundingSphereTable::cx() const { return cx_.data(); }
+
+const float *BoundingSphereTable::cy() const { return cy_.data(); }
+
+const float *BoundingSphereTable::cz() const { return cz_.data(); }
+
+const float *BoundingSphereTable::r() const { return r_.data(); }
+
+Frustum::Frustum() { set(Matrix4x4()); }
+
+Frustum::Frustum(const Matrix4x4 &m) { set(m); }
+
+void Frustum::set(const Matrix4x4 &m)
+{
+    // A point is inside when -w <= x, y, z <= w in clip space, i.e.
+    // (row3 +- row_i) . p >= 0. Plane stores a x + b y + c z - d.
+    auto plane_from = [](float a, float b, float c, float d)
+    {
+        Plane p;
+        p.a = a;
+        p.b = b;
+        p.c = c;
+        p.d = -d;
+        p.normalize();
+        return p;
+    };
+    planes_[LEFT] = plane_from(
+        m.m30() + m.m00(), m.m31() + m.m01(), m.m32() + m.m02(), m.m33() + m.m03());
+    planes_[RIGHT] = plane_from(
+        m.m30() - m.m00(), m.m31() - m.m01(), m.m32() - m.m02(), m.m33() - m.m03());
+    planes_[BOTTOM] = plane_from(
+        m.m30() + m.m10(), m.m31() + m.m11(), m.m32() + m.m12(), m.m33() + m.m13());
+    planes_[TOP] = plane_from(
+        m.m30() - m.m10(), m.m31() - m.m11(), m.m32() - m.m12(), m.m33() - m.m13());
+    planes_[NEAR_PLANE] = plane_from(
+        m.m30() + m.m20(), m.m31() + m.m21(), m.m32() + m.m22(), m.m33() + m.m23());
+    planes_[FAR_PLANE] = plane_from(
+        m.m30() - m.m20(), m.m31() - m.m21(), m.m32() - m.m22(), m.m33() - m.m23());
+}
+
+const Plane &Frustum::plane(uint32_t i) const { return planes_[i]; }
+
+CullResult Frustum::classify(const AABB &box) const
+{
+    uint8_t plane_hint = 0;
+    return classify(box, plane_hint);
+}
+
+CullResult Frustum::classify(const AABB &box, uint8_t &plane_hint) const
+{
+    Point3 center(0.5f * (box.min_corner.x + box.max_corner.x),
+                  0.5f * (box.min_corner.y + box.max_corner.y),
+                  0.5f * (box.min_corner.z + box.max_corner.z));
+    float  ex = 0.5f * (box.max_corner.x - box.min_corner.x);
+    float  ey = 0.5f * (box.max_corner.y - box.min_corner.y);
+    float  ez = 0.5f * (box.max_corner.z - box.min_corner.z);
+    auto   distance = [&](const Plane &p, float &dist, float &radius)
+    {
+        dist = p.solve(center);
+        radius = box_radius(p, ex, ey, ez);
+    };
+    return classify_planes(planes_, distance, plane_hint);
+}
+
+CullResult Frustum::classify(const BoundingSphere &sphere) const
+{
+    uint8_t plane_hint = 0;
+    return classify(sphere, plane_hint);
+}
+
+CullResult Frustum::classify(const BoundingSphere &sphere, uint8_t &plane_hint) const
+{
+    auto distance = [&](const Plane &p, float &dist, float &radius)
+    {
+        dist = p.solve(sphere.center);
+        radius = sphere.radius;
+    };
+    return classify_planes(planes_, distance, plane_hint);
+}
+
+void Frustum::classify(const AABBTable         &boxes,
+                       std::vector<CullResult> &results,
+                       std::vector<uint8_t>    *plane_hints) const
+{
+    std::vector<uint8_t> scratch;
+    size_t               count = boxes.size();
+    uint8_t             *hints = prepare_batch(count, results, plane_hints, scratch);
+    size_t               i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+        classify_lanes(planes_, BoxLanes(boxes, i), &results[i], hints + i);
+#endif
+    for(; i < count; i++)
+    {
+        float ex = boxes.ex()[i];
+        float ey = boxes.ey()[i];
+        float ez = boxes.ez()[i];
+        Point3 center(boxes.cx()[i], boxes.cy()[i], boxes.cz()[i]);
+        auto   distance = [&](const Plane &p, float &dist, float &radius)
+        {
+            dist = p.solve(center);
+            radius = box_radius(p, ex, ey, ez);
+        };
+        results[i] = classify_planes(planes_, distance, hints[i]);
+    }
+}
+
+void Frustum::classify(const BoundingSphereTable &spheres,
+                       std::vector<CullResult>   &results,
+                       std::vector<uint8_t>      *plane_hints) const
+{
+    std::vector<uint8_t> scratch;
+    size_t               count = spheres.size();
+    uint8_t             *hints = prepare_batch(count, results, plane_hints, scratch);
+    size_t               i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+        classify_lanes(planes_, SphereLanes(spheres, i), &results[i], hints + i);
+#endif
+    for(; i < count; i++)
+    {
+        BoundingSphere sphere(Point3(spheres.cx()[i], spheres.cy()[i], spheres.cz()[i]),
+                              spheres.r()[i]);
+        results[i] = classify(sphere, hints[i]);
+    }
+}
+
+} // namespace cg
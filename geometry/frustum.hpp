@@ -0,0 +1,246 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    frustum.hpp
+//	Purpose: View frustum planes and culling tests for bounding volumes,
+//           including structure-of-arrays batch tests.
+//============================================================================
+
+#ifndef __GEOMETRY_FRUSTUM_HPP__
+#define __GEOMETRY_FRUSTUM_HPP__
+
+#include "geometry/aabb.hpp"
+#include "geometry/aligned_allocator.hpp"
+#include "geometry/bounding_sphere.hpp"
+#include "geometry/matrix.hpp"
+#include "geometry/plane.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Result of a frustum test.
+ */
+enum class CullResult : uint8_t
+{
+    OUTSIDE,      // Entirely outside (can be skipped)
+    INTERSECTING, // Crosses at least one plane
+    INSIDE        // Entirely inside
+};
+
+/**
+ * Structure-of-arrays table of axis aligned boxes, stored as centers and half
+ * extents in SIMD aligned arrays so batch tests can process 4 boxes per step.
+ */
+class AABBTable
+{
+  public:
+    /**
+     * Get the number of boxes.
+     * @return  Returns the number of boxes.
+     */
+    size_t size() const;
+
+    /**
+     * Reserve storage for n boxes.
+     * @param  n  Number of boxes.
+     */
+    void reserve(size_t n);
+
+    /**
+     * Remove all boxes.
+     */
+    void clear();
+
+    /**
+     * Append a box.
+     * @param  box  Box to append.
+     */
+    void push_back(const AABB &box);
+
+    /**
+     * Replace a box.
+     * @param  i    Index of the box.
+     * @param  box  New box.
+     */
+    void set(size_t i, const AABB &box);
+
+    // Centers and half extents (SIMD aligned)
+    const float *cx() const;
+    const float *cy() const;
+    const float *cz() const;
+    const float *ex() const;
+    const float *ey() const;
+    const float *ez() const;
+
+  private:
+    AlignedFloatVector cx_, cy_, cz_;
+    AlignedFloatVector ex_, ey_, ez_;
+};
+
+/**
+ * Structure-of-arrays table of bounding spheres in SIMD aligned arrays so
+ * batch tests can process 4 spheres per step.
+ */
+class BoundingSphereTable
+{
+  public:
+    /**
+     * Get the number of spheres.
+     * @return  Returns the number of spheres.
+     */
+    size_t size() const;
+
+    /**
+     * Reserve storage for n spheres.
+     * @param  n  Number of spheres.
+     */
+    void reserve(size_t n);
+
+    /**
+     * Remove all spheres.
+     */
+    void clear();
+
+    /**
+     * Append a sphere.
+     * @param  sphere  Sphere to append.
+     */
+    void push_back(const BoundingSphere &sphere);
+
+    /**
+     * Replace a sphere.
+     * @param  i       Index of the sphere.
+     * @param  sphere  New sphere.
+     */
+    void set(size_t i, const BoundingSphere &sphere);
+
+    // Centers and radii (SIMD aligned)
+    const float *cx() const;
+    const float *cy() const;
+    const float *cz() const;
+    const float *r() const;
+
+  private:
+    AlignedFloatVector cx_, cy_, cz_, r_;
+};
+
+/**
+ * View frustum: 6 planes with unit normals pointing into the frustum, so
+ * Plane::solve gives the signed distance (positive inside).
+ *
+ * Tests can use plane coherency (Assarsson and Moller): a plane hint per
+ * bounding volume remembers the plane that rejected it last, and that plane
+ * is tested first on the next call. Objects that stay outside from frame to
+ * frame are then rejected with a single plane test. Hints start at 0 and
+ * are updated by the tests.
+ */
+class Frustum
+{
+  public:
+    // Plane indices
+    static constexpr uint32_t LEFT = 0;
+    static constexpr uint32_t RIGHT = 1;
+    static constexpr uint32_t BOTTOM = 2;
+    static constexpr uint32_t TOP = 3;
+    static constexpr uint32_t NEAR_PLANE = 4;
+    static constexpr uint32_t FAR_PLANE = 5;
+    static constexpr uint32_t PLANE_COUNT = 6;
+
+    /**
+     * Default constructor. Uses the identity matrix (the OpenGL clip cube).
+     */
+    Frustum();
+
+    /**
+     * Constructor given a view-projection matrix. See set.
+     * @param  m  View-projection (or model-view-projection) matrix.
+     */
+    explicit Frustum(const Matrix4x4 &m);
+
+    /**
+     * Extracts the planes from a view-projection matrix (Gribb and Hartmann)
+     * for OpenGL clip space (-w <= x, y, z <= w). The planes are in the
+     * space the matrix transforms from: world space for projection * view,
+     * object space for projection * view * model.
+     * @param  m  View-projection (or model-view-projection) matrix.
+     */
+    void set(const Matrix4x4 &m);
+
+    /**
+     * Get a plane.
+     * @param  i  Plane index (LEFT to FAR_PLANE).
+     * @return  Returns the plane.
+     */
+    const Plane &plane(uint32_t i) const;
+
+    /**
+     * Classifies a box against the frustum. Boxes near a frustum corner can
+     * be reported INTERSECTING while outside (the test is conservative).
+     * @param  box  Box to test.
+     * @return  Returns whether the box is outside, intersecting or inside.
+     */
+    CullResult classify(const AABB &box) const;
+
+    /**
+     * Classifies a box against the frustum, testing the hinted plane first.
+     * @param  box         Box to test.
+     * @param  plane_hint  Plane that rejected the box last (updated).
+     * @return  Returns whether the box is outside, intersecting or inside.
+     */
+    CullResult classify(const AABB &box, uint8_t &plane_hint) const;
+
+    /**
+     * Classifies a sphere against the frustum. Conservative like the box test.
+     * @param  sphere  Sphere to test.
+     * @return  Returns whether the sphere is outside, intersecting or inside.
+     */
+    CullResult classify(const BoundingSphere &sphere) const;
+
+    /**
+     * Classifies a sphere against the frustum, testing the hinted plane first.
+     * @param  sphere      Sphere to test.
+     * @param  plane_hint  Plane that rejected the sphere last (updated).
+     * @return  Returns whether the sphere is outside, intersecting or inside.
+     */
+    CullResult classify(const BoundingSphere &sphere, uint8_t &plane_hint) const;
+
+    /**
+     * Classifies every box in a table (4 per step with SSE). Same results
+     * as the single box test.
+     * @param  boxes        Boxes to test.
+     * @param  results      Result per box (resized to the table size).
+     * @param  plane_hints  Plane hint per box, kept between calls (resized
+     *                      and reset to 0 if the size differs), or nullptr.
+     */
+    void classify(const AABBTable         &boxes,
+                  std::vector<CullResult> &results,
+                  std::vector<uint8_t>    *plane_hints = nullptr) const;
+
+    /**
+     * Classifies every sphere in a table (4 per step with SSE). Same results
+     * as the single sphere test.
+     * @param  spheres      Spheres to test.
+     * @param  results      Result per sphere (resized to the table size).
+     * @param  plane_hints  Plane hint per sphere, kept between calls (resized
+     *                      and reset to 0 if the size differs), or nullptr.
+     */
+    void classify(const BoundingSphereTable &spheres,
+                  std::vector<CullResult>   &results,
+                  std::vector<uint8_t>      *plane_hints = nullptr) const;
+
+  private:
+    std::array<Plane, PLANE_COUNT> planes_;
+};
+
+} // namespace cg
+
+#endif
@@ -1,24 +1,35 @@
 #include "geometry/geometry.hpp"
 
+#include "geometry/simd.hpp"
+
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 namespace cg
 {
 
-float degrees_to_radians(float d) { return d * DEGREES_PER_RADIAN; }
-
-float radians_to_degrees(float r) { return r * RADIANS_PER_DEGREE; }
-
-float rand_0_1() { return (float)std::rand() / (float)RAND_MAX; }
+float rand_0_1() { return thread_random().next_float(); }
 
 float fast_inv_sqrt(float x)
 {
-    float xhalf = 0.5f * x;
-    int   i = *(int *)&x;              // get bits for floating value
-    i = 0x5f3759df - (i >> 1);         // give initial guess y0
-    x = *(float *)&i;                  // convert bits back to float
-    return x * (1.5f - xhalf * x * x); // newton step
-    // x *= 1.5f - xhalf*x*x;     // repeating step increases accuracy
+    // The Newton step would turn the estimate for 0 (inf) into NaN
+    if(x == 0.0f) return std::numeric_limits<float>::infinity();
+
+#if defined(CG_SIMD_SSE)
+    // Hardware reciprocal square root estimate
+    float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+    // Quake III initial guess. memcpy avoids the aliasing violation of
+    // reading the float through an int pointer.
+    int32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5f3759df - (i >> 1);
+    float r;
+    std::memcpy(&r, &i, sizeof(r));
+#endif
+    return r * (1.5f - 0.5f * x * r * r); // newton step
 }
 
 } // namespace cg
@@ -12,8 +12,11 @@
 #ifndef __GEOMETRY_HPOINT2_HPP__
 #define __GEOMETRY_HPOINT2_HPP__
 
+#include "geometry/constants.hpp"
 #include "geometry/point2.hpp"
 
+#include <type_traits>
+
 namespace cg
 {
 
@@ -29,7 +32,7 @@ struct HPoint2
     /**
      * Default constructor
      */
-    HPoint2();
+    constexpr HPoint2();
 
     /**
      * Constructor with initial values for x,y,w.
@@ -37,15 +40,38 @@ struct HPoint2
      * @param   iy   y coordinate position.
      * @param   iw   Homogeneous factor
      */
-    HPoint2(float ix, float iy, float iw);
+    constexpr HPoint2(float ix, float iy, float iw);
 
     /**
      * Convert to a cartesian representation.
      * @return  Returns the cartesian representation of this point.
      */
-    Point2 to_cartesian() const;
+    constexpr Point2 to_cartesian() const;
 };
 
+static_assert(std::is_trivially_copyable<HPoint2>::value, "HPoint2 must be trivially copyable");
+static_assert(std::is_standard_layout<HPoint2>::value, "HPoint2 must be standard layout");
+static_assert(sizeof(HPoint2) == 3 * sizeof(float), "HPoint2 must be 3 packed floats");
+
+constexpr HPoint2::HPoint2() : x(0.0f), y(0.0f), w(1.0f) {}
+
+constexpr HPoint2::HPoint2(float ix, float iy, float iw) : x(ix), y(iy), w(iw) {}
+
+constexpr Point2 HPoint2::to_cartesian() const
+{
+    if(w == 1.0f) { return Point2(x, y); }
+    else
+    {
+        // Perform division through by w
+        float d = (w > EPSILON || w < -EPSILON) ? (1.0f / w) : 1.0f;
+        return Point2(x * d, y * d);
+    }
+}
+
+// Point2 operations involving HPoint2
+
+constexpr Point2::Point2(const HPoint2 &p) : Point2(p.to_cartesian()) {}
+
 } // namespace cg
 
 #endif
@@ -12,8 +12,11 @@
 #ifndef __GEOMETRY_HPOINT3_HPP__
 #define __GEOMETRY_HPOINT3_HPP__
 
+#include "geometry/constants.hpp"
 #include "geometry/point3.hpp"
 
+#include <type_traits>
+
 namespace cg
 {
 
@@ -30,7 +33,7 @@ struct HPoint3
     /**
      * Default constructor
      */
-    HPoint3();
+    constexpr HPoint3();
 
     /**
      * Constructor with initial values for x,y,z,w.
@@ -39,15 +42,38 @@ struct HPoint3
      * @param   iz   z coordinate position.
      * @param   iw   Homogeneous factor
      */
-    HPoint3(float ix, float iy, float iz, float iw);
+    constexpr HPoint3(float ix, float iy, float iz, float iw);
 
     /**
      * Convert to a cartesian representation
      * @return  Returns the cartesian representation of this point.
      */
-    Point3 to_cartesian() const;
+    constexpr Point3 to_cartesian() const;
 };
 
+static_assert(std::is_trivially_copyable<HPoint3>::value, "HPoint3 must be trivially copyable");
+static_assert(std::is_standard_layout<HPoint3>::value, "HPoint3 must be standard layout");
+static_assert(sizeof(HPoint3) == 4 * sizeof(float), "HPoint3 must be 4 packed floats");
+
+constexpr HPoint3::HPoint3() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+
+constexpr HPoint3::HPoint3(float ix, float iy, float iz, float iw) : x(ix), y(iy), z(iz), w(iw) {}
+
+constexpr Point3 HPoint3::to_cartesian() const
+{
+    if(w == 1.0f) { return Point3(x, y, z); }
+    else
+    {
+        // Perform division through by w
+        float d = (w > EPSILON || w < -EPSILON) ? (1.0f / w) : 1.0f;
+        return Point3(x * d, y * d, z * d);
+    }
+}
+
+// Point3 operations involving HPoint3
+
+constexpr Point3::Point3(const HPoint3 &p) : Point3(p.to_cartesian()) {}
+
 } // namespace cg
 
 #endif
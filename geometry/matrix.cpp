@@ -1,172 +1,392 @@
 #include "geometry/matrix.hpp"
 
 #include "geometry/geometry.hpp"
+#include "geometry/quaternion.hpp"
+#include "geometry/simd.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace cg
 {
 
-Matrix4x4::Matrix4x4() { set_identity(); }
-
-void Matrix4x4::set_identity()
-{
-    a_[0] = 1.0f;
-    a_[4] = 0.0f;
-    a_[8] = 0.0f;
-    a_[12] = 0.0f;
-    a_[1] = 0.0f;
-    a_[5] = 1.0f;
-    a_[9] = 0.0f;
-    a_[13] = 0.0f;
-    a_[2] = 0.0f;
-    a_[6] = 0.0f;
-    a_[10] = 1.0f;
-    a_[14] = 0.0f;
-    a_[3] = 0.0f;
-    a_[7] = 0.0f;
-    a_[11] = 0.0f;
-    a_[15] = 1.0f;
-}
-
-Matrix4x4::Matrix4x4(const Matrix4x4 &n)
-{
-    m00() = n.m00();
-    m01() = n.m01();
-    m02() = n.m02();
-    m03() = n.m03();
-    m10() = n.m10();
-    m11() = n.m11();
-    m12() = n.m12();
-    m13() = n.m13();
-    m20() = n.m20();
-    m21() = n.m21();
-    m22() = n.m22();
-    m23() = n.m23();
-    m30() = n.m30();
-    m31() = n.m31();
-    m32() = n.m32();
-    m33() = n.m33();
-}
-
-Matrix4x4 &Matrix4x4::operator=(const Matrix4x4 &n)
-{
-    m00() = n.m00();
-    m01() = n.m01();
-    m02() = n.m02();
-    m03() = n.m03();
-    m10() = n.m10();
-    m11() = n.m11();
-    m12() = n.m12();
-    m13() = n.m13();
-    m20() = n.m20();
-    m21() = n.m21();
-    m22() = n.m22();
-    m23() = n.m23();
-    m30() = n.m30();
-    m31() = n.m31();
-    m32() = n.m32();
-    m33() = n.m33();
-    return *this;
+namespace
+{
+// The kernels below work directly on column-major element arrays. Each output
+// element is accumulated in the same order as the reference scalar product
+// (a(i,0)*b(0,j) + a(i,1)*b(1,j) + a(i,2)*b(2,j) + a(i,3)*b(3,j)) so the SIMD
+// and scalar paths give bit-identical results (no FMA contraction is used).
+
+// r = a * b. All arrays hold 16 column-major elements. r may alias a or b.
+void multiply_columns(const float *a, const float *b, float *r)
+{
+#if defined(CG_SIMD_AVX)
+    // Two result columns per iteration. Each 128-bit lane holds one column.
+    __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a));
+    __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 4));
+    __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 8));
+    __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 12));
+    __m256 b01 = _mm256_loadu_ps(b);
+    __m256 b23 = _mm256_loadu_ps(b + 8);
+
+    __m256 r01 = _mm256_mul_ps(c0, _mm256_shuffle_ps(b01, b01, 0x00));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(c1, _mm256_shuffle_ps(b01, b01, 0x55)));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(c2, _mm256_shuffle_ps(b01, b01, 0xAA)));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(c3, _mm256_shuffle_ps(b01, b01, 0xFF)));
+
+    __m256 r23 = _mm256_mul_ps(c0, _mm256_shuffle_ps(b23, b23, 0x00));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(c1, _mm256_shuffle_ps(b23, b23, 0x55)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(c2, _mm256_shuffle_ps(b23, b23, 0xAA)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(c3, _mm256_shuffle_ps(b23, b23, 0xFF)));
+
+    _mm256_storeu_ps(r, r01);
+    _mm256_storeu_ps(r + 8, r23);
+#elif defined(CG_SIMD_SSE)
+    __m128 c0 = _mm_loadu_ps(a);
+    __m128 c1 = _mm_loadu_ps(a + 4);
+    __m128 c2 = _mm_loadu_ps(a + 8);
+    __m128 c3 = _mm_loadu_ps(a + 12);
+    __m128 col[4];
+    for(int32_t j = 0; j < 4; j++)
+    {
+        const float *bj = b + 4 * j;
+        __m128       t = _mm_mul_ps(c0, _mm_set1_ps(bj[0]));
+        t = _mm_add_ps(t, _mm_mul_ps(c1, _mm_set1_ps(bj[1])));
+        t = _mm_add_ps(t, _mm_mul_ps(c2, _mm_set1_ps(bj[2])));
+        t = _mm_add_ps(t, _mm_mul_ps(c3, _mm_set1_ps(bj[3])));
+        col[j] = t;
+    }
+    for(int32_t j = 0; j < 4; j++) _mm_storeu_ps(r + 4 * j, col[j]);
+#else
+    float t[16];
+    for(int32_t j = 0; j < 4; j++)
+    {
+        const float *bj = b + 4 * j;
+        for(int32_t i = 0; i < 4; i++)
+        {
+            t[4 * j + i] = a[i] * bj[0] + a[4 + i] * bj[1] + a[8 + i] * bj[2] + a[12 + i] * bj[3];
+        }
+    }
+    for(int32_t i = 0; i < 16; i++) r[i] = t[i];
+#endif
 }
 
-bool Matrix4x4::operator==(const Matrix4x4 &n) const
+// r = a * (x, y, z, w)
+void transform_column(const float *a, float x, float y, float z, float w, float *r)
 {
-    return (m00() == n.m00() && m01() == n.m01() && m02() == n.m02() && m03() == n.m03() &&
-            m10() == n.m10() && m11() == n.m11() && m12() == n.m12() && m13() == n.m13() &&
-            m20() == n.m20() && m21() == n.m21() && m22() == n.m22() && m23() == n.m23() &&
-            m30() == n.m30() && m31() == n.m31() && m32() == n.m32() && m33() == n.m33());
+#if defined(CG_SIMD_SSE)
+    __m128 t = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(x));
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(a + 4), _mm_set1_ps(y)));
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(a + 8), _mm_set1_ps(z)));
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(a + 12), _mm_set1_ps(w)));
+    _mm_storeu_ps(r, t);
+#else
+    for(int32_t i = 0; i < 4; i++) r[i] = a[i] * x + a[4 + i] * y + a[8 + i] * z + a[12 + i] * w;
+#endif
 }
 
-void Matrix4x4::set(const float *m)
+// r = a * (x, y, z, 0). Only r[0..2] are meaningful.
+void transform_direction(const float *a, float x, float y, float z, float *r)
 {
-    for(size_t i = 0; i < 16; i++) a_[i] = m[i];
+#if defined(CG_SIMD_SSE)
+    __m128 t = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(x));
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(a + 4), _mm_set1_ps(y)));
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(a + 8), _mm_set1_ps(z)));
+    _mm_storeu_ps(r, t);
+#else
+    for(int32_t i = 0; i < 3; i++) r[i] = a[i] * x + a[4 + i] * y + a[8 + i] * z;
+#endif
 }
 
-const float *Matrix4x4::get() const { return a_.data(); }
+#if defined(CG_SIMD_SSE)
+// Rows of the matrix broadcast for the SoA transforms.
+struct BroadcastMatrix
+{
+    __m128 m[16];
 
-// Read-only access functions
-float Matrix4x4::m00() const { return a_[0]; }
-float Matrix4x4::m01() const { return a_[4]; }
-float Matrix4x4::m02() const { return a_[8]; }
-float Matrix4x4::m03() const { return a_[12]; }
-float Matrix4x4::m10() const { return a_[1]; }
-float Matrix4x4::m11() const { return a_[5]; }
-float Matrix4x4::m12() const { return a_[9]; }
-float Matrix4x4::m13() const { return a_[13]; }
-float Matrix4x4::m20() const { return a_[2]; }
-float Matrix4x4::m21() const { return a_[6]; }
-float Matrix4x4::m22() const { return a_[10]; }
-float Matrix4x4::m23() const { return a_[14]; }
-float Matrix4x4::m30() const { return a_[3]; }
-float Matrix4x4::m31() const { return a_[7]; }
-float Matrix4x4::m32() const { return a_[11]; }
-float Matrix4x4::m33() const { return a_[15]; }
+    explicit BroadcastMatrix(const float *a)
+    {
+        for(int32_t i = 0; i < 16; i++) m[i] = _mm_set1_ps(a[i]);
+    }
 
-// Read-write access functions
-float &Matrix4x4::m00() { return a_[0]; }
-float &Matrix4x4::m01() { return a_[4]; }
-float &Matrix4x4::m02() { return a_[8]; }
-float &Matrix4x4::m03() { return a_[12]; }
-float &Matrix4x4::m10() { return a_[1]; }
-float &Matrix4x4::m11() { return a_[5]; }
-float &Matrix4x4::m12() { return a_[9]; }
-float &Matrix4x4::m13() { return a_[13]; }
-float &Matrix4x4::m20() { return a_[2]; }
-float &Matrix4x4::m21() { return a_[6]; }
-float &Matrix4x4::m22() { return a_[10]; }
-float &Matrix4x4::m23() { return a_[14]; }
-float &Matrix4x4::m30() { return a_[3]; }
-float &Matrix4x4::m31() { return a_[7]; }
-float &Matrix4x4::m32() { return a_[11]; }
-float &Matrix4x4::m33() { return a_[15]; }
+    // Row i of the matrix applied to (x, y, z, 1). Same operation order as
+    // transform_column so results match the single point transform.
+    __m128 point_row(int32_t i, __m128 x, __m128 y, __m128 z) const
+    {
+        __m128 t = _mm_mul_ps(m[i], x);
+        t = _mm_add_ps(t, _mm_mul_ps(m[4 + i], y));
+        t = _mm_add_ps(t, _mm_mul_ps(m[8 + i], z));
+        return _mm_add_ps(t, _mm_mul_ps(m[12 + i], _mm_set1_ps(1.0f)));
+    }
 
-float Matrix4x4::m(uint32_t row, uint32_t col) const
+    // Row i of the matrix applied to (x, y, z, 0).
+    __m128 vector_row(int32_t i, __m128 x, __m128 y, __m128 z) const
+    {
+        __m128 t = _mm_mul_ps(m[i], x);
+        t = _mm_add_ps(t, _mm_mul_ps(m[4 + i], y));
+        return _mm_add_ps(t, _mm_mul_ps(m[8 + i], z));
+    }
+};
+#endif
+
+#if defined(CG_SIMD_SSE)
+// 2x2 matrix helpers for the block inverse. A 2x2 matrix is held in one
+// register as (m00, m01, m10, m11).
+#define CG_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// a * b
+inline __m128 mat2_mul(__m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_mul_ps(a, CG_SWIZZLE(b, 0, 3, 0, 3)),
+                      _mm_mul_ps(CG_SWIZZLE(a, 1, 0, 3, 2), CG_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// adj(a) * b
+inline __m128 mat2_adj_mul(__m128 a, __m128 b)
 {
-    return (row < 4 && col < 4) ? a_[col * 4 + row] : 0.0f;
+    return _mm_sub_ps(_mm_mul_ps(CG_SWIZZLE(a, 3, 3, 0, 0), b),
+                      _mm_mul_ps(CG_SWIZZLE(a, 1, 1, 2, 2), CG_SWIZZLE(b, 2, 3, 0, 1)));
 }
 
-float &Matrix4x4::m(uint32_t row, uint32_t col)
+// a * adj(b)
+inline __m128 mat2_mul_adj(__m128 a, __m128 b)
 {
-    return (row < 4 && col < 4) ? a_[col * 4 + row] : a_[0];
+    return _mm_sub_ps(_mm_mul_ps(a, CG_SWIZZLE(b, 3, 0, 3, 0)),
+                      _mm_mul_ps(CG_SWIZZLE(a, 1, 0, 3, 2), CG_SWIZZLE(b, 2, 1, 2, 1)));
 }
+#endif
+
+// r = inverse(a) using cofactors (Cramer's rule). Returns false if a is
+// singular, in which case r is left unchanged. r may alias a.
+bool invert_columns(const float *a, float *r)
+{
+#if defined(CG_SIMD_SSE)
+    // Treat the 4 columns as the rows of the transpose. The block inverse
+    // below then produces rows of inverse(transpose(a)), which are the
+    // columns of inverse(a).
+    __m128 c0 = _mm_loadu_ps(a);
+    __m128 c1 = _mm_loadu_ps(a + 4);
+    __m128 c2 = _mm_loadu_ps(a + 8);
+    __m128 c3 = _mm_loadu_ps(a + 12);
+
+    // 2x2 sub-matrices | A B |
+    //                  | C D |
+    __m128 ma = _mm_movelh_ps(c0, c1);
+    __m128 mb = _mm_movehl_ps(c1, c0);
+    __m128 mc = _mm_movelh_ps(c2, c3);
+    __m128 md = _mm_movehl_ps(c3, c2);
+
+    // Determinants of the sub-matrices (|A| |B| |C| |D|)
+    __m128 det_sub =
+        _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)),
+                              _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+                   _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)),
+                              _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+    __m128 det_a = CG_SWIZZLE(det_sub, 0, 0, 0, 0);
+    __m128 det_b = CG_SWIZZLE(det_sub, 1, 1, 1, 1);
+    __m128 det_c = CG_SWIZZLE(det_sub, 2, 2, 2, 2);
+    __m128 det_d = CG_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+    // Adjugates of the inverse blocks | X Y |
+    //                                 | Z W |
+    __m128 d_c = mat2_adj_mul(md, mc);
+    __m128 a_b = mat2_adj_mul(ma, mb);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, ma), mat2_mul(mb, d_c));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, md), mat2_mul(mc, a_b));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, mc), mat2_mul_adj(md, a_b));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, mb), mat2_mul_adj(ma, d_c));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 tr = _mm_mul_ps(a_b, CG_SWIZZLE(d_c, 0, 2, 1, 3));
+    tr = _mm_add_ps(tr, CG_SWIZZLE(tr, 2, 3, 0, 1));
+    tr = _mm_add_ps(tr, CG_SWIZZLE(tr, 1, 0, 3, 2));
+    __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+    if(_mm_cvtss_f32(det) == 0.0f) return false;
+
+    __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    x = _mm_mul_ps(x, inv_det);
+    y = _mm_mul_ps(y, inv_det);
+    z = _mm_mul_ps(z, inv_det);
+    w = _mm_mul_ps(w, inv_det);
+
+    // Apply the adjugate swizzle and store
+    _mm_storeu_ps(r, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(r + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(r + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(r + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+    return true;
+#else
+    // Element (row, col) is a[col * 4 + row]
+    float a00 = a[0], a01 = a[4], a02 = a[8], a03 = a[12];
+    float a10 = a[1], a11 = a[5], a12 = a[9], a13 = a[13];
+    float a20 = a[2], a21 = a[6], a22 = a[10], a23 = a[14];
+    float a30 = a[3], a31 = a[7], a32 = a[11], a33 = a[15];
+
+    // 2x2 minors of the top two rows (s) and the bottom two rows (c)
+    float s0 = a00 * a11 - a10 * a01;
+    float s1 = a00 * a12 - a10 * a02;
+    float s2 = a00 * a13 - a10 * a03;
+    float s3 = a01 * a12 - a11 * a02;
+    float s4 = a01 * a13 - a11 * a03;
+    float s5 = a02 * a13 - a12 * a03;
+    float c0 = a20 * a31 - a30 * a21;
+    float c1 = a20 * a32 - a30 * a22;
+    float c2 = a20 * a33 - a30 * a23;
+    float c3 = a21 * a32 - a31 * a22;
+    float c4 = a21 * a33 - a31 * a23;
+    float c5 = a22 * a33 - a32 * a23;
+
+    float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if(det == 0.0f) return false;
+    float d = 1.0f / det;
+
+    float t[16];
+    t[0] = (a11 * c5 - a12 * c4 + a13 * c3) * d;
+    t[4] = (-a01 * c5 + a02 * c4 - a03 * c3) * d;
+    t[8] = (a31 * s5 - a32 * s4 + a33 * s3) * d;
+    t[12] = (-a21 * s5 + a22 * s4 - a23 * s3) * d;
+    t[1] = (-a10 * c5 + a12 * c2 - a13 * c1) * d;
+    t[5] = (a00 * c5 - a02 * c2 + a03 * c1) * d;
+    t[9] = (-a30 * s5 + a32 * s2 - a33 * s1) * d;
+    t[13] = (a20 * s5 - a22 * s2 + a23 * s1) * d;
+    t[2] = (a10 * c4 - a11 * c2 + a13 * c0) * d;
+    t[6] = (-a00 * c4 + a01 * c2 - a03 * c0) * d;
+    t[10] = (a30 * s4 - a31 * s2 + a33 * s0) * d;
+    t[14] = (-a20 * s4 + a21 * s2 - a23 * s0) * d;
+    t[3] = (-a10 * c3 + a11 * c1 - a12 * c0) * d;
+    t[7] = (a00 * c3 - a01 * c1 + a02 * c0) * d;
+    t[11] = (-a30 * s3 + a31 * s1 - a32 * s0) * d;
+    t[15] = (a20 * s3 - a21 * s1 + a22 * s0) * d;
+    for(int32_t i = 0; i < 16; i++) r[i] = t[i];
+    return true;
+#endif
+}
+
+#if defined(CG_SIMD_SSE)
+// Cross product of the x, y, z lanes. The w lane of the result is 0.
+inline __m128 cross3(__m128 a, __m128 b)
+{
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, CG_SWIZZLE(b, 1, 2, 0, 3)),
+                          _mm_mul_ps(CG_SWIZZLE(a, 1, 2, 0, 3), b));
+    return CG_SWIZZLE(c, 1, 2, 0, 3);
+}
+#endif
+
+// r = inverse(a) where the bottom row of a is [0 0 0 1]. The upper 3x3 (L) is
+// inverted with cross products of its columns and the translation is
+// -inverse(L) * t. Returns false if L is singular. r may alias a.
+bool invert_affine_columns(const float *a, float *r)
+{
+#if defined(CG_SIMD_SSE)
+    const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    __m128       l0 = _mm_and_ps(_mm_loadu_ps(a), xyz_mask);
+    __m128       l1 = _mm_and_ps(_mm_loadu_ps(a + 4), xyz_mask);
+    __m128       l2 = _mm_and_ps(_mm_loadu_ps(a + 8), xyz_mask);
+    __m128       t = _mm_loadu_ps(a + 12);
+
+    // Rows of inverse(L) are the cross products of the columns over |L|
+    __m128 r0 = cross3(l1, l2);
+    __m128 r1 = cross3(l2, l0);
+    __m128 r2 = cross3(l0, l1);
+    __m128 p = _mm_mul_ps(l0, r0);
+    float  det = _mm_cvtss_f32(
+        _mm_add_ss(_mm_add_ss(p, CG_SWIZZLE(p, 1, 1, 1, 1)), CG_SWIZZLE(p, 2, 2, 2, 2)));
+    if(det == 0.0f) return false;
+    __m128 d = _mm_set1_ps(1.0f / det);
+    r0 = _mm_mul_ps(r0, d);
+    r1 = _mm_mul_ps(r1, d);
+    r2 = _mm_mul_ps(r2, d);
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    // Columns 0-2 now hold inverse(L) with w = 0
+    __m128 nt = _mm_mul_ps(r0, CG_SWIZZLE(t, 0, 0, 0, 0));
+    nt = _mm_add_ps(nt, _mm_mul_ps(r1, CG_SWIZZLE(t, 1, 1, 1, 1)));
+    nt = _mm_add_ps(nt, _mm_mul_ps(r2, CG_SWIZZLE(t, 2, 2, 2, 2)));
+    _mm_storeu_ps(r, r0);
+    _mm_storeu_ps(r + 4, r1);
+    _mm_storeu_ps(r + 8, r2);
+    _mm_storeu_ps(r + 12, _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), nt));
+    return true;
+#else
+    // Columns of L and the translation
+    Vector3 l0(a[0], a[1], a[2]);
+    Vector3 l1(a[4], a[5], a[6]);
+    Vector3 l2(a[8], a[9], a[10]);
+    Vector3 t(a[12], a[13], a[14]);
+
+    // Rows of inverse(L) are the cross products of the columns over |L|
+    Vector3 r0 = l1.cross(l2);
+    Vector3 r1 = l2.cross(l0);
+    Vector3 r2 = l0.cross(l1);
+    float   det = l0.dot(r0);
+    if(det == 0.0f) return false;
+    float d = 1.0f / det;
+    r0 *= d;
+    r1 *= d;
+    r2 *= d;
+
+    // Columns of inverse(L) then the translation
+    float c[3][3] = {{r0.x, r1.x, r2.x}, {r0.y, r1.y, r2.y}, {r0.z, r1.z, r2.z}};
+    for(int32_t j = 0; j < 3; j++)
+    {
+        r[4 * j] = c[j][0];
+        r[4 * j + 1] = c[j][1];
+        r[4 * j + 2] = c[j][2];
+        r[4 * j + 3] = 0.0f;
+    }
+    for(int32_t i = 0; i < 3; i++)
+        r[12 + i] = 0.0f - (r[i] * t.x + r[4 + i] * t.y + r[8 + i] * t.z);
+    r[15] = 1.0f;
+    return true;
+#endif
+}
+
+// r = inverse(a) where the upper 3x3 of a is a rotation (orthonormal) and the
+// bottom row is [0 0 0 1]: the rotation is transposed and the translation is
+// -transpose(R) * t. r may alias a.
+void invert_rigid_columns(const float *a, float *r)
+{
+#if defined(CG_SIMD_SSE)
+    const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    __m128       c0 = _mm_loadu_ps(a);
+    __m128       c1 = _mm_loadu_ps(a + 4);
+    __m128       c2 = _mm_loadu_ps(a + 8);
+    __m128       c3 = _mm_loadu_ps(a + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    // c0-c2 now hold the rows of R with the translation in w
+    __m128 nt = _mm_mul_ps(c0, CG_SWIZZLE(c0, 3, 3, 3, 3));
+    nt = _mm_add_ps(nt, _mm_mul_ps(c1, CG_SWIZZLE(c1, 3, 3, 3, 3)));
+    nt = _mm_add_ps(nt, _mm_mul_ps(c2, CG_SWIZZLE(c2, 3, 3, 3, 3)));
+    _mm_storeu_ps(r, _mm_and_ps(c0, xyz_mask));
+    _mm_storeu_ps(r + 4, _mm_and_ps(c1, xyz_mask));
+    _mm_storeu_ps(r + 8, _mm_and_ps(c2, xyz_mask));
+    _mm_storeu_ps(r + 12,
+                  _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), _mm_and_ps(nt, xyz_mask)));
+#else
+    float t[16];
+    for(int32_t c = 0; c < 3; c++)
+    {
+        for(int32_t i = 0; i < 3; i++) t[c * 4 + i] = a[i * 4 + c];
+        t[c * 4 + 3] = 0.0f;
+    }
+    for(int32_t i = 0; i < 3; i++)
+        t[12 + i] = 0.0f - (a[i * 4] * a[12] + a[i * 4 + 1] * a[13] + a[i * 4 + 2] * a[14]);
+    t[15] = 1.0f;
+    for(int32_t i = 0; i < 16; i++) r[i] = t[i];
+#endif
+}
+} // namespace
+
+static_assert(Matrix4x4::identity().m33() == 1.0f, "identity() must be usable at compile time");
+static_assert(Matrix4x4::translation(1.0f, 2.0f, 3.0f).m13() == 2.0f,
+              "translation() must be usable at compile time");
 
 Matrix4x4 Matrix4x4::operator*(const Matrix4x4 &n) const
 {
-    // Unroll the loop, do 1 row at a time.
     Matrix4x4 t;
-    float     a0 = m00();
-    float     a1 = m01();
-    float     a2 = m02();
-    float     a3 = m03();
-    t.m00() = a0 * n.m00() + a1 * n.m10() + a2 * n.m20() + a3 * n.m30();
-    t.m01() = a0 * n.m01() + a1 * n.m11() + a2 * n.m21() + a3 * n.m31();
-    t.m02() = a0 * n.m02() + a1 * n.m12() + a2 * n.m22() + a3 * n.m32();
-    t.m03() = a0 * n.m03() + a1 * n.m13() + a2 * n.m23() + a3 * n.m33();
-    a0 = m10();
-    a1 = m11();
-    a2 = m12();
-    a3 = m13();
-    t.m10() = a0 * n.m00() + a1 * n.m10() + a2 * n.m20() + a3 * n.m30();
-    t.m11() = a0 * n.m01() + a1 * n.m11() + a2 * n.m21() + a3 * n.m31();
-    t.m12() = a0 * n.m02() + a1 * n.m12() + a2 * n.m22() + a3 * n.m32();
-    t.m13() = a0 * n.m03() + a1 * n.m13() + a2 * n.m23() + a3 * n.m33();
-    a0 = m20();
-    a1 = m21();
-    a2 = m22();
-    a3 = m23();
-    t.m20() = a0 * n.m00() + a1 * n.m10() + a2 * n.m20() + a3 * n.m30();
-    t.m21() = a0 * n.m01() + a1 * n.m11() + a2 * n.m21() + a3 * n.m31();
-    t.m22() = a0 * n.m02() + a1 * n.m12() + a2 * n.m22() + a3 * n.m32();
-    t.m23() = a0 * n.m03() + a1 * n.m13() + a2 * n.m23() + a3 * n.m33();
-    a0 = m30();
-    a1 = m31();
-    a2 = m32();
-    a3 = m33();
-    t.m30() = a0 * n.m00() + a1 * n.m10() + a2 * n.m20() + a3 * n.m30();
-    t.m31() = a0 * n.m01() + a1 * n.m11() + a2 * n.m21() + a3 * n.m31();
-    t.m32() = a0 * n.m02() + a1 * n.m12() + a2 * n.m22() + a3 * n.m32();
-    t.m33() = a0 * n.m03() + a1 * n.m13() + a2 * n.m23() + a3 * n.m33();
+    multiply_columns(a_.data(), n.a_.data(), t.a_.data());
     return t;
 }
 
@@ -184,36 +404,201 @@ Matrix4x4 &Matrix4x4::operator*=(float s)
 
 HPoint3 Matrix4x4::operator*(const HPoint3 &v) const
 {
-    // Student to define - Module 4
-    return HPoint3(0.0f, 0.0f, 0.0f, 1.0f);
+    float r[4];
+    transform_column(a_.data(), v.x, v.y, v.z, v.w, r);
+    return HPoint3(r[0], r[1], r[2], r[3]);
 }
 
 HPoint3 Matrix4x4::operator*(const Point3 &v) const
 {
-  // Convert Point3 to homogeneous coordinates (w=1) and multiply
-  float x = v.x;
-  float y = v.y;
-  float z = v.z;
-  float w = 1.0f;  // Point has w=1
-  
-  float result_x = m00() * x + m01() * y + m02() * z + m03() * w;
-  float result_y = m10() * x + m11() * y + m12() * z + m13() * w;
-  float result_z = m20() * x + m21() * y + m22() * z + m23() * w;
-  float result_w = m30() * x + m31() * y + m32() * z + m33() * w;
-  
-  return HPoint3(result_x, result_y, result_z, result_w);
+    // Point has w = 1
+    float r[4];
+    transform_column(a_.data(), v.x, v.y, v.z, 1.0f, r);
+    return HPoint3(r[0], r[1], r[2], r[3]);
 }
 
 Vector3 Matrix4x4::operator*(const Vector3 &v) const
 {
-    // Student to define - Module 4
-    return Vector3(0.0f, 0.0f, 0.0f);
+    // Vector has w = 0: only the upper 3x3 is applied
+    float r[4];
+    transform_direction(a_.data(), v.x, v.y, v.z, r);
+    return Vector3(r[0], r[1], r[2]);
 }
 
 Ray3 Matrix4x4::operator*(const Ray3 &ray) const
 {
-    // Student to define - Module 4
-    return Ray3();
+    return Ray3(Point3(*this * ray.o), *this * ray.d);
+}
+
+BoundingSphere Matrix4x4::operator*(const BoundingSphere &sphere) const
+{
+    float sx = a_[0] * a_[0] + a_[1] * a_[1] + a_[2] * a_[2];
+    float sy = a_[4] * a_[4] + a_[5] * a_[5] + a_[6] * a_[6];
+    float sz = a_[8] * a_[8] + a_[9] * a_[9] + a_[10] * a_[10];
+    return BoundingSphere(Point3(*this * sphere.center),
+                          sphere.radius * std::sqrt(std::max(sx, std::max(sy, sz))));
+}
+
+void Matrix4x4::transform_points(const Point3 *src, HPoint3 *dst, size_t count) const
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    BroadcastMatrix m(a_.data());
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&src[i].x, x, y, z);
+        __m128 rx = m.point_row(0, x, y, z);
+        __m128 ry = m.point_row(1, x, y, z);
+        __m128 rz = m.point_row(2, x, y, z);
+        __m128 rw = m.point_row(3, x, y, z);
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+        _mm_storeu_ps(&dst[i].x, rx);
+        _mm_storeu_ps(&dst[i + 1].x, ry);
+        _mm_storeu_ps(&dst[i + 2].x, rz);
+        _mm_storeu_ps(&dst[i + 3].x, rw);
+    }
+#endif
+    for(; i < count; i++) dst[i] = *this * src[i];
+}
+
+void Matrix4x4::transform_points(const Point3 *src, Point3 *dst, size_t count) const
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    BroadcastMatrix m(a_.data());
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 eps = _mm_set1_ps(EPSILON);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&src[i].x, x, y, z);
+        __m128 rx = m.point_row(0, x, y, z);
+        __m128 ry = m.point_row(1, x, y, z);
+        __m128 rz = m.point_row(2, x, y, z);
+        __m128 rw = m.point_row(3, x, y, z);
+
+        // Divide through by w, matching HPoint3::to_cartesian: w values with
+        // magnitude <= EPSILON are not divided.
+        __m128 valid = _mm_cmpgt_ps(_mm_and_ps(rw, abs_mask), eps);
+        __m128 d = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(one, rw)), _mm_andnot_ps(valid, one));
+        simd::store_xyz4(&dst[i].x, _mm_mul_ps(rx, d), _mm_mul_ps(ry, d), _mm_mul_ps(rz, d));
+    }
+#endif
+    for(; i < count; i++) dst[i] = (*this * src[i]).to_cartesian();
+}
+
+void Matrix4x4::transform_vectors(const Vector3 *src, Vector3 *dst, size_t count) const
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    BroadcastMatrix m(a_.data());
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&src[i].x, x, y, z);
+        simd::store_xyz4(&dst[i].x,
+                   m.vector_row(0, x, y, z),
+                   m.vector_row(1, x, y, z),
+                   m.vector_row(2, x, y, z));
+    }
+#endif
+    for(; i < count; i++) dst[i] = *this * src[i];
+}
+
+void Matrix4x4::transform_points(const std::vector<Point3> &src, std::vector<HPoint3> &dst) const
+{
+    dst.resize(src.size());
+    transform_points(src.data(), dst.data(), src.size());
+}
+
+void Matrix4x4::transform_points(const std::vector<Point3> &src, std::vector<Point3> &dst) const
+{
+    dst.resize(src.size());
+    transform_points(src.data(), dst.data(), src.size());
+}
+
+void Matrix4x4::transform_vectors(const std::vector<Vector3> &src, std::vector<Vector3> &dst) const
+{
+    dst.resize(src.size());
+    transform_vectors(src.data(), dst.data(), src.size());
+}
+
+void Matrix4x4::transform_points(const Point3Array &src, Point3Array &dst) const
+{
+    size_t count = src.size();
+    dst.resize(count);
+    const float *sx = src.x();
+    const float *sy = src.y();
+    const float *sz = src.z();
+    float       *dx = dst.x();
+    float       *dy = dst.y();
+    float       *dz = dst.z();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    BroadcastMatrix m(a_.data());
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 eps = _mm_set1_ps(EPSILON);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_load_ps(sx + i);
+        __m128 y = _mm_load_ps(sy + i);
+        __m128 z = _mm_load_ps(sz + i);
+        __m128 rw = m.point_row(3, x, y, z);
+        __m128 valid = _mm_cmpgt_ps(_mm_and_ps(rw, abs_mask), eps);
+        __m128 d = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(one, rw)), _mm_andnot_ps(valid, one));
+        __m128 rx = _mm_mul_ps(m.point_row(0, x, y, z), d);
+        __m128 ry = _mm_mul_ps(m.point_row(1, x, y, z), d);
+        __m128 rz = _mm_mul_ps(m.point_row(2, x, y, z), d);
+        _mm_store_ps(dx + i, rx);
+        _mm_store_ps(dy + i, ry);
+        _mm_store_ps(dz + i, rz);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        Point3 p = (*this * Point3(sx[i], sy[i], sz[i])).to_cartesian();
+        dx[i] = p.x;
+        dy[i] = p.y;
+        dz[i] = p.z;
+    }
+}
+
+void Matrix4x4::transform_vectors(const Vector3Array &src, Vector3Array &dst) const
+{
+    size_t count = src.size();
+    dst.resize(count);
+    const float *sx = src.x();
+    const float *sy = src.y();
+    const float *sz = src.z();
+    float       *dx = dst.x();
+    float       *dy = dst.y();
+    float       *dz = dst.z();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    BroadcastMatrix m(a_.data());
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_load_ps(sx + i);
+        __m128 y = _mm_load_ps(sy + i);
+        __m128 z = _mm_load_ps(sz + i);
+        __m128 rx = m.vector_row(0, x, y, z);
+        __m128 ry = m.vector_row(1, x, y, z);
+        __m128 rz = m.vector_row(2, x, y, z);
+        _mm_store_ps(dx + i, rx);
+        _mm_store_ps(dy + i, ry);
+        _mm_store_ps(dz + i, rz);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        Vector3 v = *this * Vector3(sx[i], sy[i], sz[i]);
+        dx[i] = v.x;
+        dy[i] = v.y;
+        dz[i] = v.z;
+    }
 }
 
 Matrix4x4 &Matrix4x4::transpose()
@@ -246,101 +631,90 @@ Matrix4x4 Matrix4x4::get_transpose() const
 
 void Matrix4x4::translate(float x, float y, float z)
 {
-    // Student to define - Module 4
+    // Only the last column changes: col3 = x * col0 + y * col1 + z * col2 + col3
+    for(int32_t i = 0; i < 4; i++) a_[12 + i] += a_[i] * x + a_[4 + i] * y + a_[8 + i] * z;
 }
 
 void Matrix4x4::scale(float x, float y, float z)
 {
-    // Student to define - Module 4
+    // Scale the first 3 columns
+    for(int32_t i = 0; i < 4; i++)
+    {
+        a_[i] *= x;
+        a_[4 + i] *= y;
+        a_[8 + i] *= z;
+    }
 }
 
 void Matrix4x4::rotate(float angle, float x, float y, float z)
 {
-    // Student to define - Module 4
+    *this *= Quaternion::from_axis_angle(angle, Vector3(x, y, z)).get_matrix();
 }
 
 void Matrix4x4::rotate_x(float angle)
 {
-    // Student to define - Module 4
+    rotate_columns(1, 2, angle);
 }
 
 void Matrix4x4::rotate_y(float angle)
 {
-    // Student to define - Module 4
+    rotate_columns(2, 0, angle);
 }
 
 void Matrix4x4::rotate_z(float angle)
 {
-    // Student to define - Module 4
+    rotate_columns(0, 1, angle);
+}
+
+void Matrix4x4::rotate_columns(int32_t i, int32_t j, float angle)
+{
+    // Right-multiplying by a rotation in the plane of axes i and j only
+    // mixes columns i and j:
+    //   col_i' = c * col_i + s * col_j
+    //   col_j' = c * col_j - s * col_i
+    float radians = degrees_to_radians(angle);
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    for(int32_t k = 0; k < 4; k++)
+    {
+        float ci = a_[i * 4 + k];
+        float cj = a_[j * 4 + k];
+        a_[i * 4 + k] = c * ci + s * cj;
+        a_[j * 4 + k] = c * cj - s * ci;
+    }
 }
 
 Matrix4x4 Matrix4x4::get_inverse() const
 {
-    int32_t   j, k;
-    int32_t   ind;
-    float     v1, v2;
-    Matrix4x4 t = *this;
     Matrix4x4 b;
-    for(int32_t i = 0; i < 4; i++)
+    if(!invert_columns(a_.data(), b.a_.data()))
     {
-        // Find pivot
-        v1 = t.m(i, i);
-        ind = i;
-        for(j = i + 1; j < 4; j++)
-        {
-            if(std::abs(t.m(j, i)) > std::abs(v1))
-            {
-                ind = j;
-                v1 = t.m(j, i);
-            }
-        }
-
-        // Swap columns
-        if(ind != i)
-        {
-            for(j = 0; j < 4; j++)
-            {
-                v2 = b.m(i, j);
-                b.m(i, j) = b.m(ind, j);
-                b.m(ind, j) = v2;
-                v2 = t.m(i, j);
-                t.m(i, j) = t.m(ind, j);
-                t.m(ind, j) = v2;
-            }
-        }
-
         // The matrix is singular (has no inverse), set the inverse
         // to the identity matrix.
-        if(v1 == 0.0f)
-        {
-            extern void logmsg(const char *message, ...);
-            logmsg("InvertMatrix: Singular matrix");
-            b.set_identity();
-            return b;
-        }
-
-        for(j = 0; j < 4; j++)
-        {
-            t.m(i, j) /= v1;
-            b.m(i, j) /= v1;
-        }
+        extern void logmsg(const char *message, ...);
+        logmsg("InvertMatrix: Singular matrix");
+    }
+    return b;
+}
 
-        // Eliminate column
-        for(j = 0; j < 4; j++)
-        {
-            if(j == i) continue;
-
-            v1 = t.m(j, i);
-            for(k = 0; k < 4; k++)
-            {
-                t.m(j, k) -= t.m(i, k) * v1;
-                b.m(j, k) -= b.m(i, k) * v1;
-            }
-        }
+Matrix4x4 Matrix4x4::get_affine_inverse() const
+{
+    Matrix4x4 b;
+    if(!invert_affine_columns(a_.data(), b.a_.data()))
+    {
+        extern void logmsg(const char *message, ...);
+        logmsg("InvertMatrix: Singular matrix");
     }
     return b;
 }
 
+Matrix4x4 Matrix4x4::get_rigid_inverse() const
+{
+    Matrix4x4 b;
+    invert_rigid_columns(a_.data(), b.a_.data());
+    return b;
+}
+
 void Matrix4x4::log(const char *str) const
 {
     extern void logmsg(const char *message, ...);
@@ -11,13 +11,18 @@
 #ifndef __GEOMETRY_MATRIX_HPP__
 #define __GEOMETRY_MATRIX_HPP__
 
+#include "bounding_sphere.hpp"
 #include "hpoint3.hpp"
 #include "point3.hpp"
+#include "point_arrays.hpp"
 #include "ray3.hpp"
 #include "vector3.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+#include <vector>
 
 namespace cg
 {
@@ -31,81 +36,102 @@ class Matrix4x4
     /**
      * Constructor.  Sets the matrix to the identity matrix
      */
-    Matrix4x4();
+    constexpr Matrix4x4();
 
     /**
-     * Sets the matrix to the identity matrix.
+     * Constructor from an array of elements.
+     * @param  m  Elements of the matrix arranged in column order.
+     */
+    explicit constexpr Matrix4x4(const std::array<float, 16> &m);
+
+    /**
+     * Gets the identity matrix.
+     * @return  Returns the identity matrix.
      */
-    void set_identity();
+    static constexpr Matrix4x4 identity();
 
     /**
-     * Copy constructor
-     * @param  n  Matrix to copy
+     * Gets a translation matrix.
+     * @param   x   x translation
+     * @param   y   y translation
+     * @param   z   z translation
+     * @return  Returns the translation matrix.
      */
-    Matrix4x4(const Matrix4x4 &n);
+    static constexpr Matrix4x4 translation(float x, float y, float z);
 
     /**
-     * Assignment operator
-     * @param   n  Matrix to assign to this matrix
-     * @return  Returns the address of this matrix.
+     * Gets an orthographic projection matrix (same as glOrtho).
+     * @param   left        Left clipping plane
+     * @param   right       Right clipping plane
+     * @param   bottom      Bottom clipping plane
+     * @param   top         Top clipping plane
+     * @param   near_plane  Near clipping plane distance
+     * @param   far_plane   Far clipping plane distance
+     * @return  Returns the orthographic projection matrix.
+     */
+    static constexpr Matrix4x4
+        ortho(float left, float right, float bottom, float top, float near_plane, float far_plane);
+
+    /**
+     * Sets the matrix to the identity matrix.
      */
-    Matrix4x4 &operator=(const Matrix4x4 &n);
+    constexpr void set_identity();
 
     /**
      * Equality operator
      * @param   n  Matrix to test for equality with this matrix.
      * @return  Returns true if hte matrices are equal, false otherwise..
      */
-    bool operator==(const Matrix4x4 &n) const;
+    constexpr bool operator==(const Matrix4x4 &n) const;
 
     /**
      * Set the matrix to the values specified in the array.
      * @param  m  Array of float values to fill in this matrix. The
      *            elements are arranged in column order.
      */
-    void set(const float *m);
+    constexpr void set(const float *m);
 
     /**
      * Gets the matrix (can be passed to OpenGL - GLSL mat4)
      * @return   Returns the elements of this matrix in column order.
      */
-    const float *get() const;
+    constexpr const float *get() const;
 
     // Read-only access functions
-    float m00() const;
-    float m01() const;
-    float m02() const;
-    float m03() const;
-    float m10() const;
-    float m11() const;
-    float m12() const;
-    float m13() const;
-    float m20() const;
-    float m21() const;
-    float m22() const;
-    float m23() const;
-    float m30() const;
-    float m31() const;
-    float m32() const;
-    float m33() const;
+    constexpr float m00() const { return a_[0]; }
+    constexpr float m01() const { return a_[4]; }
+    constexpr float m02() const { return a_[8]; }
+    constexpr float m03() const { return a_[12]; }
+    constexpr float m10() const { return a_[1]; }
+    constexpr float m11() const { return a_[5]; }
+    constexpr float m12() const { return a_[9]; }
+    constexpr float m13() const { return a_[13]; }
+    constexpr float m20() const { return a_[2]; }
+    constexpr float m21() const { return a_[6]; }
+    constexpr float m22() const { return a_[10]; }
+    constexpr float m23() const { return a_[14]; }
+    constexpr float m30() const { return a_[3]; }
+    constexpr float m31() const { return a_[7]; }
+    constexpr float m32() const { return a_[11]; }
+    constexpr float m33() const { return a_[15]; }
 
     // Read-write access functions
-    float &m00();
-    float &m01();
-    float &m02();
-    float &m03();
-    float &m10();
-    float &m11();
-    float &m12();
-    float &m13();
-    float &m20();
-    float &m21();
-    float &m22();
-    float &m23();
-    float &m30();
-    float &m31();
-    float &m32();
-    float &m33();
+    constexpr float &m00() { return a_[0]; }
+    constexpr float &m01() { return a_[4]; }
+    constexpr float &m02() { return a_[8]; }
+    constexpr float &m03() { return a_[12]; }
+    constexpr float &m10() { return a_[1]; }
+    constexpr float &m11() { return a_[5]; }
+    constexpr float &m12() { return a_[9]; }
+    constexpr float &m13() { return a_[13]; }
+    constexpr float &m20() { return a_[2]; }
+    constexpr float &m21() { return a_[6]; }
+    constexpr float &m22() { return a_[10]; }
+    constexpr float &m23() { return a_[14]; }
+    constexpr float &m30() { return a_[3]; }
+    constexpr float &m31() { return a_[7]; }
+    constexpr float &m32() { return a_[11]; }
+    constexpr float &m33() { return a_[15]; }
 
     /**
      * Gets a matrix element given by row,column.
@@ -113,7 +139,7 @@ class Matrix4x4
      * @param  col   Matrix column
      * @return Returns the element at the specified row,col.
      */
-    float m(uint32_t row, uint32_t col) const;
+    constexpr float m(uint32_t row, uint32_t col) const;
 
     /**
      * Gets a matrix element given by row,column.
@@ -121,7 +147,7 @@ class Matrix4x4
      * @param  col   Matrix col (0-based)
      * @return Returns the address of the element at the specified row,col.
      */
-    float &m(uint32_t row, uint32_t col);
+    constexpr float &m(uint32_t row, uint32_t col);
 
     /**
      * Matrix multiplication.  Multiplies the current matrix by the matrix n
@@ -178,6 +204,84 @@ class Matrix4x4
      */
     Ray3 operator*(const Ray3 &ray) const;
 
+    /**
+     * Transforms a bounding sphere by the matrix (assumed affine). The
+     * radius is scaled by the largest axis scale, so the sphere still
+     * contains the transformed volume.
+     * @param   sphere  Sphere to transform
+     * @return  Returns the transformed sphere.
+     */
+    BoundingSphere operator*(const BoundingSphere &sphere) const;
+
+    // Batch transforms over contiguous arrays. These process 4 elements per
+    // iteration using SIMD and produce the same results as transforming each
+    // element with the operators above. Source and destination may be the
+    // same array when the element types match.
+
+    /**
+     * Transforms an array of points by the matrix. Assumes w = 1 for each point.
+     * @param   src    Points to transform.
+     * @param   dst    Transformed homogeneous points (must hold count elements).
+     * @param   count  Number of points.
+     */
+    void transform_points(const Point3 *src, HPoint3 *dst, size_t count) const;
+
+    /**
+     * Transforms an array of points by the matrix and divides through by w
+     * (same as converting each transformed HPoint3 to cartesian coordinates).
+     * @param   src    Points to transform.
+     * @param   dst    Transformed points (must hold count elements).
+     * @param   count  Number of points.
+     */
+    void transform_points(const Point3 *src, Point3 *dst, size_t count) const;
+
+    /**
+     * Transforms an array of vectors (normals or directions) by the upper 3x3
+     * portion of the matrix.
+     * @param   src    Vectors to transform.
+     * @param   dst    Transformed vectors (must hold count elements).
+     * @param   count  Number of vectors.
+     */
+    void transform_vectors(const Vector3 *src, Vector3 *dst, size_t count) const;
+
+    /**
+     * Transforms a list of points. The destination list is resized to match.
+     * @param   src   Points to transform.
+     * @param   dst   Transformed homogeneous points.
+     */
+    void transform_points(const std::vector<Point3> &src, std::vector<HPoint3> &dst) const;
+
+    /**
+     * Transforms a list of points and divides through by w. The destination
+     * list is resized to match.
+     * @param   src   Points to transform.
+     * @param   dst   Transformed points.
+     */
+    void transform_points(const std::vector<Point3> &src, std::vector<Point3> &dst) const;
+
+    /**
+     * Transforms a list of vectors. The destination list is resized to match.
+     * @param   src   Vectors to transform.
+     * @param   dst   Transformed vectors.
+     */
+    void transform_vectors(const std::vector<Vector3> &src, std::vector<Vector3> &dst) const;
+
+    /**
+     * Transforms structure-of-arrays points and divides through by w. The
+     * destination is resized to match and may be the source array.
+     * @param   src   Points to transform.
+     * @param   dst   Transformed points.
+     */
+    void transform_points(const Point3Array &src, Point3Array &dst) const;
+
+    /**
+     * Transforms structure-of-arrays vectors by the upper 3x3 portion of the
+     * matrix. The destination is resized to match and may be the source array.
+     * @param   src   Vectors to transform.
+     * @param   dst   Transformed vectors.
+     */
+    void transform_vectors(const Vector3Array &src, Vector3Array &dst) const;
+
     /**
      * Transposes the current matrix.
      * @return   Returns the address of the current matrix.
@@ -247,10 +351,31 @@ class Matrix4x4
 
     /**
      * Calculates the inverse of the current 4x4 matrix and returns it.
+     * Uses cofactors (SIMD when available). If the matrix is singular a
+     * message is logged and the identity matrix is returned.
      * @return  Returns the inverse of the current matrix.
      */
     Matrix4x4 get_inverse() const;
 
+    /**
+     * Calculates the inverse of an affine matrix (bottom row is [0 0 0 1])
+     * such as a modeling, view or orthographic projection matrix. Much
+     * cheaper than get_inverse. The bottom row is not checked. If the
+     * upper 3x3 is singular a message is logged and the identity matrix is
+     * returned.
+     * @return  Returns the inverse of the current matrix.
+     */
+    Matrix4x4 get_affine_inverse() const;
+
+    /**
+     * Calculates the inverse of a rigid body matrix: a rotation (orthonormal
+     * upper 3x3) followed by a translation, such as a camera view matrix.
+     * The rotation is transposed and the translation negated. No scaling or
+     * shear may be present (this is not checked).
+     * @return  Returns the inverse of the current matrix.
+     */
+    Matrix4x4 get_rigid_inverse() const;
+
     /**
      * Logs a message followed by the matrix.
      * @param   str   String to print to log file
@@ -260,8 +385,83 @@ class Matrix4x4
   private:
     // Elements of the matrix. Column order.
     std::array<float, 16> a_;
+
+    // Right-multiplies by a rotation (degrees) from axis i toward axis j.
+    void rotate_columns(int32_t i, int32_t j, float angle);
 };
 
+static_assert(std::is_trivially_copyable<Matrix4x4>::value, "Matrix4x4 must be trivially copyable");
+static_assert(std::is_standard_layout<Matrix4x4>::value, "Matrix4x4 must be standard layout");
+static_assert(sizeof(Matrix4x4) == 16 * sizeof(float), "Matrix4x4 must be 16 packed floats");
+
+// clang-format off
+constexpr Matrix4x4::Matrix4x4() :
+    a_{1.0f, 0.0f, 0.0f, 0.0f,
+       0.0f, 1.0f, 0.0f, 0.0f,
+       0.0f, 0.0f, 1.0f, 0.0f,
+       0.0f, 0.0f, 0.0f, 1.0f}
+{
+}
+// clang-format on
+
+constexpr Matrix4x4::Matrix4x4(const std::array<float, 16> &m) : a_(m) {}
+
+constexpr Matrix4x4 Matrix4x4::identity() { return Matrix4x4(); }
+
+// clang-format off
+constexpr Matrix4x4 Matrix4x4::translation(float x, float y, float z)
+{
+    return Matrix4x4({1.0f, 0.0f, 0.0f, 0.0f,
+                      0.0f, 1.0f, 0.0f, 0.0f,
+                      0.0f, 0.0f, 1.0f, 0.0f,
+                      x, y, z, 1.0f});
+}
+
+constexpr Matrix4x4 Matrix4x4::ortho(float left,
+                                     float right,
+                                     float bottom,
+                                     float top,
+                                     float near_plane,
+                                     float far_plane)
+{
+    return Matrix4x4({2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+                      0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+                      0.0f, 0.0f, -2.0f / (far_plane - near_plane), 0.0f,
+                      -(right + left) / (right - left),
+                      -(top + bottom) / (top - bottom),
+                      -(far_plane + near_plane) / (far_plane - near_plane),
+                      1.0f});
+}
+// clang-format on
+
+constexpr void Matrix4x4::set_identity() { *this = identity(); }
+
+constexpr bool Matrix4x4::operator==(const Matrix4x4 &n) const
+{
+    for(size_t i = 0; i < 16; i++)
+    {
+        if(a_[i] != n.a_[i]) return false;
+    }
+    return true;
+}
+
+constexpr void Matrix4x4::set(const float *m)
+{
+    for(size_t i = 0; i < 16; i++) a_[i] = m[i];
+}
+
+constexpr const float *Matrix4x4::get() const { return a_.data(); }
+
+constexpr float Matrix4x4::m(uint32_t row, uint32_t col) const
+{
+    return (row < 4 && col < 4) ? a_[col * 4 + row] : 0.0f;
+}
+
+constexpr float &Matrix4x4::m(uint32_t row, uint32_t col)
+{
+    return (row < 4 && col < 4) ? a_[col * 4 + row] : a_[0];
+}
+
 } // namespace cg
 
 #endif
@@ -0,0 +1,158 @@
+#include "geometry/matrix3x2.hpp"
+
+#include "geometry/geometry.hpp"
+#include "geometry/simd.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+static_assert(Matrix3x2::translation(1.0f, 2.0f) * Point2(1.0f, 1.0f) == Point2(2.0f, 3.0f),
+              "Matrix3x2 must be usable at compile time");
+
+Matrix3x2 Matrix3x2::rotation(float angle)
+{
+    float radians = degrees_to_radians(angle);
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    return Matrix3x2({c, s, -s, c, 0.0f, 0.0f});
+}
+
+Matrix3x2 Matrix3x2::get_inverse() const
+{
+    float det = determinant();
+    if(std::abs(det) < EPSILON)
+    {
+        // The matrix is singular (has no inverse), set the inverse
+        // to the identity matrix.
+        extern void logmsg(const char *message, ...);
+        logmsg("InvertMatrix: Singular matrix");
+        return Matrix3x2();
+    }
+
+    // Inverse of the 2x2 part, then translation t' = -inv(A) t
+    float     inv_det = 1.0f / det;
+    Matrix3x2 r;
+    r.m00() = m11() * inv_det;
+    r.m01() = -m01() * inv_det;
+    r.m10() = -m10() * inv_det;
+    r.m11() = m00() * inv_det;
+    r.m02() = -(r.m00() * m02() + r.m01() * m12());
+    r.m12() = -(r.m10() * m02() + r.m11() * m12());
+    return r;
+}
+
+void Matrix3x2::translate(float x, float y)
+{
+    m02() += m00() * x + m01() * y;
+    m12() += m10() * x + m11() * y;
+}
+
+void Matrix3x2::scale(float x, float y)
+{
+    m00() *= x;
+    m10() *= x;
+    m01() *= y;
+    m11() *= y;
+}
+
+void Matrix3x2::rotate(float angle)
+{
+    // Only the linear part changes:
+    //   col0' = c * col0 + s * col1
+    //   col1' = c * col1 - s * col0
+    float radians = degrees_to_radians(angle);
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    for(int32_t k = 0; k < 2; k++)
+    {
+        float c0 = a_[k];
+        float c1 = a_[2 + k];
+        a_[k] = c * c0 + s * c1;
+        a_[2 + k] = c * c1 - s * c0;
+    }
+}
+
+void Matrix3x2::transform_points(const Point2 *src, Point2 *dst, size_t count) const
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    const __m128 m00 = _mm_set1_ps(a_[0]);
+    const __m128 m10 = _mm_set1_ps(a_[1]);
+    const __m128 m01 = _mm_set1_ps(a_[2]);
+    const __m128 m11 = _mm_set1_ps(a_[3]);
+    const __m128 m02 = _mm_set1_ps(a_[4]);
+    const __m128 m12 = _mm_set1_ps(a_[5]);
+    for(; i + 4 <= count; i += 4)
+    {
+        // Same operation order as operator*(const Point2 &)
+        __m128 x, y;
+        simd::load_xy4(&src[i].x, x, y);
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), m02);
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), m12);
+        simd::store_xy4(&dst[i].x, rx, ry);
+    }
+#endif
+    for(; i < count; i++) dst[i] = *this * src[i];
+}
+
+void Matrix3x2::transform_vectors(const Vector2 *src, Vector2 *dst, size_t count) const
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    const __m128 m00 = _mm_set1_ps(a_[0]);
+    const __m128 m10 = _mm_set1_ps(a_[1]);
+    const __m128 m01 = _mm_set1_ps(a_[2]);
+    const __m128 m11 = _mm_set1_ps(a_[3]);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y;
+        simd::load_xy4(&src[i].x, x, y);
+        simd::store_xy4(&dst[i].x,
+                        _mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)),
+                        _mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)));
+    }
+#endif
+    for(; i < count; i++) dst[i] = *this * src[i];
+}
+
+void Matrix3x2::transform_points(const std::vector<Point2> &src, std::vector<Point2> &dst) const
+{
+    dst.resize(src.size());
+    transform_points(src.data(), dst.data(), src.size());
+}
+
+void Matrix3x2::transform_points(const Point2Array &src, Point2Array &dst) const
+{
+    size_t count = src.size();
+    dst.resize(count);
+    const float *sx = src.x();
+    const float *sy = src.y();
+    float       *dx = dst.x();
+    float       *dy = dst.y();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    const __m128 m00 = _mm_set1_ps(a_[0]);
+    const __m128 m10 = _mm_set1_ps(a_[1]);
+    const __m128 m01 = _mm_set1_ps(a_[2]);
+    const __m128 m11 = _mm_set1_ps(a_[3]);
+    const __m128 m02 = _mm_set1_ps(a_[4]);
+    const __m128 m12 = _mm_set1_ps(a_[5]);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_load_ps(sx + i);
+        __m128 y = _mm_load_ps(sy + i);
+        _mm_store_ps(dx + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), m02));
+        _mm_store_ps(dy + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), m12));
+    }
+#endif
+    for(; i < count; i++)
+    {
+        Point2 p = *this * Point2(sx[i], sy[i]);
+        dx[i] = p.x;
+        dy[i] = p.y;
+    }
+}
+
+} // namespace cg
@@ -0,0 +1,315 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    matrix3x2.hpp
+//	Purpose: 2D affine transformation matrix.
+//============================================================================
+
+#ifndef __GEOMETRY_MATRIX3X2_HPP__
+#define __GEOMETRY_MATRIX3X2_HPP__
+
+#include "geometry/matrix.hpp"
+#include "geometry/point2.hpp"
+#include "geometry/point_arrays.hpp"
+#include "geometry/vector2.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * 2D affine transformation. Holds the top two rows of a 3x3 homogeneous
+ * matrix (the bottom row is always 0 0 1):
+ *    | m00 m01 m02 |
+ *    | m10 m11 m12 |
+ * so x' = m00 x + m01 y + m02 and y' = m10 x + m11 y + m12. Uses 6 floats
+ * instead of 16 and roughly half the arithmetic of Matrix4x4 for 2D work.
+ * Expand to a 4x4 matrix (get_matrix4x4) only when uploading to a shader.
+ */
+class Matrix3x2
+{
+  public:
+    /**
+     * Constructor. Sets the matrix to the identity matrix.
+     */
+    constexpr Matrix3x2();
+
+    /**
+     * Constructor from an array of elements.
+     * @param  m  Elements arranged in column order (m00, m10, m01, m11, m02, m12).
+     */
+    explicit constexpr Matrix3x2(const std::array<float, 6> &m);
+
+    /**
+     * Gets the identity matrix.
+     * @return  Returns the identity matrix.
+     */
+    static constexpr Matrix3x2 identity();
+
+    /**
+     * Gets a translation matrix.
+     * @param   x   x translation
+     * @param   y   y translation
+     * @return  Returns the translation matrix.
+     */
+    static constexpr Matrix3x2 translation(float x, float y);
+
+    /**
+     * Gets a scaling matrix.
+     * @param   x   x scaling
+     * @param   y   y scaling
+     * @return  Returns the scaling matrix.
+     */
+    static constexpr Matrix3x2 scaling(float x, float y);
+
+    /**
+     * Gets a counterclockwise rotation matrix.
+     * @param   angle   Angle (degrees) for the rotation.
+     * @return  Returns the rotation matrix.
+     */
+    static Matrix3x2 rotation(float angle);
+
+    /**
+     * Gets a 2D orthographic projection (the x, y part of glOrtho).
+     * @param   left    Left clipping plane
+     * @param   right   Right clipping plane
+     * @param   bottom  Bottom clipping plane
+     * @param   top     Top clipping plane
+     * @return  Returns the orthographic projection matrix.
+     */
+    static constexpr Matrix3x2 ortho(float left, float right, float bottom, float top);
+
+    /**
+     * Sets the matrix to the identity matrix.
+     */
+    constexpr void set_identity();
+
+    /**
+     * Equality operator
+     * @param   n  Matrix to test for equality with this matrix.
+     * @return  Returns true if the matrices are equal, false otherwise.
+     */
+    constexpr bool operator==(const Matrix3x2 &n) const;
+
+    /**
+     * Gets the matrix elements.
+     * @return   Returns the elements of this matrix in column order.
+     */
+    constexpr const float *get() const;
+
+    // Read-only access functions
+    constexpr float m00() const { return a_[0]; }
+    constexpr float m01() const { return a_[2]; }
+    constexpr float m02() const { return a_[4]; }
+    constexpr float m10() const { return a_[1]; }
+    constexpr float m11() const { return a_[3]; }
+    constexpr float m12() const { return a_[5]; }
+
+    // Read-write access functions
+    constexpr float &m00() { return a_[0]; }
+    constexpr float &m01() { return a_[2]; }
+    constexpr float &m02() { return a_[4]; }
+    constexpr float &m10() { return a_[1]; }
+    constexpr float &m11() { return a_[3]; }
+    constexpr float &m12() { return a_[5]; }
+
+    /**
+     * Matrix multiplication (composition). Multiplies the current matrix by
+     * the matrix n ( m' = m n ), so n is applied first.
+     * @param   n   Matrix to multiply the current matrix by
+     * @return  Returns the product of the current matrix and the supplied matrix.
+     */
+    constexpr Matrix3x2 operator*(const Matrix3x2 &n) const;
+
+    /**
+     * Matrix multiplication ( m = m n ).
+     * @param   n  Matrix to multiply the current matrix by
+     * @return  Returns the address of the current matrix.
+     */
+    constexpr Matrix3x2 &operator*=(const Matrix3x2 &n);
+
+    /**
+     * Transforms a point by the matrix.
+     * @param   p  2D point to transform.
+     * @return  Returns the transformed point.
+     */
+    constexpr Point2 operator*(const Point2 &p) const;
+
+    /**
+     * Transforms a vector by the matrix (no translation).
+     * @param   v  2D vector to transform.
+     * @return  Returns the transformed vector.
+     */
+    constexpr Vector2 operator*(const Vector2 &v) const;
+
+    /**
+     * Gets the determinant of the linear (2x2) part.
+     * @return  Returns the determinant.
+     */
+    constexpr float determinant() const;
+
+    /**
+     * Gets the inverse of the matrix. If the matrix is singular the identity
+     * matrix is returned.
+     * @return  Returns the inverse matrix.
+     */
+    Matrix3x2 get_inverse() const;
+
+    /**
+     * Applies a translation. Right-multiplies the current matrix.
+     * @param	x	   x translation
+     * @param	y	   y translation
+     */
+    void translate(float x, float y);
+
+    /**
+     * Applies a scaling. Right-multiplies the current matrix.
+     * @param	x	   x scaling
+     * @param	y	   y scaling
+     */
+    void scale(float x, float y);
+
+    /**
+     * Performs a counterclockwise rotation. Right-multiplies the current
+     * matrix.
+     * @param   angle    Angle (degrees) for the rotation.
+     */
+    void rotate(float angle);
+
+    /**
+     * Transforms an array of points by the matrix. src and dst may be the
+     * same array.
+     * @param   src    Points to transform.
+     * @param   dst    Transformed points (must hold count elements).
+     * @param   count  Number of points.
+     */
+    void transform_points(const Point2 *src, Point2 *dst, size_t count) const;
+
+    /**
+     * Transforms an array of vectors by the matrix (no translation). src and
+     * dst may be the same array.
+     * @param   src    Vectors to transform.
+     * @param   dst    Transformed vectors (must hold count elements).
+     * @param   count  Number of vectors.
+     */
+    void transform_vectors(const Vector2 *src, Vector2 *dst, size_t count) const;
+
+    /**
+     * Transforms a list of points. The destination list is resized to match.
+     * @param   src   Points to transform.
+     * @param   dst   Transformed points.
+     */
+    void transform_points(const std::vector<Point2> &src, std::vector<Point2> &dst) const;
+
+    /**
+     * Transforms structure-of-arrays points. The destination is resized to
+     * match and may be the source array.
+     * @param   src   Points to transform.
+     * @param   dst   Transformed points.
+     */
+    void transform_points(const Point2Array &src, Point2Array &dst) const;
+
+    /**
+     * Expands to a 4x4 matrix (z passes through unchanged) for use as a
+     * GLSL mat4 uniform.
+     * @return  Returns the equivalent 4x4 matrix.
+     */
+    constexpr Matrix4x4 get_matrix4x4() const;
+
+  private:
+    // Elements of the matrix. Column order.
+    std::array<float, 6> a_;
+};
+
+static_assert(std::is_trivially_copyable<Matrix3x2>::value, "Matrix3x2 must be trivially copyable");
+static_assert(std::is_standard_layout<Matrix3x2>::value, "Matrix3x2 must be standard layout");
+static_assert(sizeof(Matrix3x2) == 6 * sizeof(float), "Matrix3x2 must be 6 packed floats");
+
+constexpr Matrix3x2::Matrix3x2() : a_{1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f} {}
+
+constexpr Matrix3x2::Matrix3x2(const std::array<float, 6> &m) : a_(m) {}
+
+constexpr Matrix3x2 Matrix3x2::identity() { return Matrix3x2(); }
+
+constexpr Matrix3x2 Matrix3x2::translation(float x, float y)
+{
+    return Matrix3x2({1.0f, 0.0f, 0.0f, 1.0f, x, y});
+}
+
+constexpr Matrix3x2 Matrix3x2::scaling(float x, float y)
+{
+    return Matrix3x2({x, 0.0f, 0.0f, y, 0.0f, 0.0f});
+}
+
+constexpr Matrix3x2 Matrix3x2::ortho(float left, float right, float bottom, float top)
+{
+    return Matrix3x2({2.0f / (right - left),
+                      0.0f,
+                      0.0f,
+                      2.0f / (top - bottom),
+                      -(right + left) / (right - left),
+                      -(top + bottom) / (top - bottom)});
+}
+
+constexpr void Matrix3x2::set_identity() { *this = identity(); }
+
+constexpr bool Matrix3x2::operator==(const Matrix3x2 &n) const
+{
+    for(size_t i = 0; i < 6; i++)
+    {
+        if(a_[i] != n.a_[i]) return false;
+    }
+    return true;
+}
+
+constexpr const float *Matrix3x2::get() const { return a_.data(); }
+
+constexpr Matrix3x2 Matrix3x2::operator*(const Matrix3x2 &n) const
+{
+    return Matrix3x2({m00() * n.m00() + m01() * n.m10(),
+                      m10() * n.m00() + m11() * n.m10(),
+                      m00() * n.m01() + m01() * n.m11(),
+                      m10() * n.m01() + m11() * n.m11(),
+                      m00() * n.m02() + m01() * n.m12() + m02(),
+                      m10() * n.m02() + m11() * n.m12() + m12()});
+}
+
+constexpr Matrix3x2 &Matrix3x2::operator*=(const Matrix3x2 &n)
+{
+    *this = *this * n;
+    return *this;
+}
+
+constexpr Point2 Matrix3x2::operator*(const Point2 &p) const
+{
+    return Point2(m00() * p.x + m01() * p.y + m02(), m10() * p.x + m11() * p.y + m12());
+}
+
+constexpr Vector2 Matrix3x2::operator*(const Vector2 &v) const
+{
+    return Vector2(m00() * v.x + m01() * v.y, m10() * v.x + m11() * v.y);
+}
+
+constexpr float Matrix3x2::determinant() const { return m00() * m11() - m01() * m10(); }
+
+// clang-format off
+constexpr Matrix4x4 Matrix3x2::get_matrix4x4() const
+{
+    return Matrix4x4({m00(), m10(), 0.0f, 0.0f,
+                      m01(), m11(), 0.0f, 0.0f,
+                      0.0f,  0.0f,  1.0f, 0.0f,
+                      m02(), m12(), 0.0f, 1.0f});
+}
+// clang-format on
+
+} // namespace cg
+
+#endif
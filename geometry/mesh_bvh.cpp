@@ -0,0 +1,427 @@
+#include "geometry/mesh_bvh.hpp"
+
+#include "geometry/geometry.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace cg
+{
+
+namespace
+{
+
+// SAH cost of visiting a node relative to testing one triangle
+constexpr float TRAVERSAL_COST = 1.0f;
+
+// Below this depth nodes are split at the median, which bounds the depth
+// (and the traversal stack) for any input
+constexpr uint32_t MAX_SAH_DEPTH = 48;
+
+// Traversal stack size: enough for MAX_SAH_DEPTH levels plus 32 median levels
+constexpr uint32_t STACK_SIZE = 96;
+
+inline const Point3 &vertex_position(const Point3 &v) { return v; }
+
+inline const Point3 &vertex_position(const VertexAndNormal &v) { return v.vertex; }
+
+// Axis aligned bounds used while building
+struct Bounds
+{
+    float min[3];
+    float max[3];
+
+    Bounds()
+    {
+        for(int32_t k = 0; k < 3; k++)
+        {
+            min[k] = std::numeric_limits<float>::max();
+            max[k] = -std::numeric_limits<float>::max();
+        }
+    }
+
+    void grow(const float *p_min, const float *p_max)
+    {
+        for(int32_t k = 0; k < 3; k++)
+        {
+            min[k] = std::min(min[k], p_min[k]);
+            max[k] = std::max(max[k], p_max[k]);
+        }
+    }
+
+    void grow(const Bounds &b) { grow(b.min, b.max); }
+
+    // Half the surface area (the factor of 2 cancels in the SAH)
+    float half_area() const
+    {
+        float dx = max[0] - min[0];
+        float dy = max[1] - min[1];
+        float dz = max[2] - min[2];
+        return (dx < 0.0f) ? 0.0f : dx * dy + dy * dz + dz * dx;
+    }
+};
+
+// Per-triangle build data
+struct BuildTriangle
+{
+    Bounds bounds;
+    float  centroid[3];
+};
+
+struct Bin
+{
+    Bounds   bounds;
+    uint32_t count = 0;
+};
+
+// Node before flattening
+struct BuildNode
+{
+    Bounds   bounds;
+    uint32_t offset = 0;
+    uint16_t count = 0;
+    uint16_t axis = 0;
+};
+
+// Recursive binned SAH builder. Emits nodes in depth-first order and
+// reorders the triangle indices into leaf order.
+class BinnedSAHBuilder
+{
+  public:
+    BinnedSAHBuilder(const std::vector<BuildTriangle> &triangles, std::vector<uint32_t> &order) :
+        triangles_(triangles),
+        order_(order)
+    {
+    }
+
+    std::vector<BuildNode> &nodes() { return nodes_; }
+
+    uint32_t build(uint32_t begin, uint32_t end, uint32_t depth);
+
+  private:
+    const std::vector<BuildTriangle> &triangles_;
+    std::vector<uint32_t>            &order_;
+    std::vector<BuildNode>            nodes_;
+
+    uint32_t bin_of(uint32_t i, int32_t axis, float min, float scale) const
+    {
+        uint32_t b = static_cast<uint32_t>((triangles_[i].centroid[axis] - min) * scale);
+        return std::min(b, MeshBVH::BIN_COUNT - 1);
+    }
+
+    uint32_t make_leaf(uint32_t node, uint32_t begin, uint32_t end)
+    {
+        nodes_[node].offset = begin;
+        nodes_[node].count = static_cast<uint16_t>(end - begin);
+        return node;
+    }
+};
+
+uint32_t BinnedSAHBuilder::build(uint32_t begin, uint32_t end, uint32_t depth)
+{
+    uint32_t node = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    // Node bounds and centroid bounds
+    Bounds bounds;
+    Bounds centroid_bounds;
+    for(uint32_t i = begin; i < end; i++)
+    {
+        const BuildTriangle &t = triangles_[order_[i]];
+        bounds.grow(t.bounds);
+        centroid_bounds.grow(t.centroid, t.centroid);
+    }
+    nodes_[node].bounds = bounds;
+    uint32_t count = end - begin;
+    if(count <= 2) return make_leaf(node, begin, end);
+
+    // Evaluate the SAH at the bin boundaries of each axis
+    float    best_cost = std::numeric_limits<float>::max();
+    int32_t  best_axis = -1;
+    uint32_t best_split = 0;
+    for(int32_t axis = 0; axis < 3 && depth < MAX_SAH_DEPTH; axis++)
+    {
+        float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+        if(extent <= 0.0f) continue;
+
+        float scale = MeshBVH::BIN_COUNT / extent;
+        Bin   bins[MeshBVH::BIN_COUNT];
+        for(uint32_t i = begin; i < end; i++)
+        {
+            Bin &bin = bins[bin_of(order_[i], axis, centroid_bounds.min[axis], scale)];
+            bin.count++;
+            bin.bounds.grow(triangles_[order_[i]].bounds);
+        }
+
+        // Sweep from the right to get the cost of each right side, then
+        // from the left
+        float    right_cost[MeshBVH::BIN_COUNT];
+        Bounds   right;
+        uint32_t right_count = 0;
+        for(uint32_t b = MeshBVH::BIN_COUNT - 1; b > 0; b--)
+        {
+            right.grow(bins[b].bounds);
+            right_count += bins[b].count;
+            right_cost[b] = right.half_area() * right_count;
+        }
+        Bounds   left;
+        uint32_t left_count = 0;
+        for(uint32_t b = 0; b + 1 < MeshBVH::BIN_COUNT; b++)
+        {
+            left.grow(bins[b].bounds);
+            left_count += bins[b].count;
+            float cost = left.half_area() * left_count + right_cost[b + 1];
+            if(left_count > 0 && left_count < count && cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = b + 1;
+            }
+        }
+    }
+
+    uint32_t mid;
+    if(best_axis >= 0)
+    {
+        // Make a leaf if splitting costs more than testing every triangle
+        float area = bounds.half_area();
+        if(count <= MeshBVH::MAX_LEAF_SIZE &&
+           (area <= 0.0f || TRAVERSAL_COST + best_cost / area >= static_cast<float>(count)))
+            return make_leaf(node, begin, end);
+
+        float min = centroid_bounds.min[best_axis];
+        float scale = MeshBVH::BIN_COUNT / (centroid_bounds.max[best_axis] - min);
+        auto  split = std::partition(order_.begin() + begin,
+                                    order_.begin() + end,
+                                    [&](uint32_t i)
+                                    { return bin_of(i, best_axis, min, scale) < best_split; });
+        mid = static_cast<uint32_t>(split - order_.begin());
+        nodes_[node].axis = static_cast<uint16_t>(best_axis);
+    }
+    else
+    {
+        // All centroids coincide (or the depth limit was reached): split at
+        // the median along the longest centroid axis
+        if(count <= MeshBVH::MAX_LEAF_SIZE) return make_leaf(node, begin, end);
+
+        int32_t axis = 0;
+        for(int32_t k = 1; k < 3; k++)
+        {
+            if(centroid_bounds.max[k] - centroid_bounds.min[k] >
+               centroid_bounds.max[axis] - centroid_bounds.min[axis])
+                axis = k;
+        }
+        mid = begin + count / 2;
+        std::nth_element(order_.begin() + begin,
+                         order_.begin() + mid,
+                         order_.begin() + end,
+                         [&](uint32_t i, uint32_t j)
+                         { return triangles_[i].centroid[axis] < triangles_[j].centroid[axis]; });
+        nodes_[node].axis = static_cast<uint16_t>(axis);
+    }
+
+    build(begin, mid, depth + 1);
+    uint32_t second = build(mid, end, depth + 1);
+    nodes_[node].offset = second;
+    return node;
+}
+
+} // namespace
+
+MeshBVH::MeshBVH() {}
+
+MeshBVH::MeshBVH(Span<const Point3> vertex_list, Span<const uint16_t> face_list)
+{
+    build(vertex_list, face_list);
+}
+
+MeshBVH::MeshBVH(Span<const Point3> vertex_list, Span<const uint32_t> face_list)
+{
+    build(vertex_list, face_list);
+}
+
+MeshBVH::MeshBVH(Span<const VertexAndNormal> vertex_list, Span<const uint16_t> face_list)
+{
+    build(vertex_list, face_list);
+}
+
+MeshBVH::MeshBVH(Span<const VertexAndNormal> vertex_list, Span<const uint32_t> face_list)
+{
+    build(vertex_list, face_list);
+}
+
+void MeshBVH::build(Span<const Point3> vertex_list, Span<const uint16_t> face_list)
+{
+    build_from(vertex_list, face_list);
+}
+
+void MeshBVH::build(Span<const Point3> vertex_list, Span<const uint32_t> face_list)
+{
+    build_from(vertex_list, face_list);
+}
+
+void MeshBVH::build(Span<const VertexAndNormal> vertex_list, Span<const uint16_t> face_list)
+{
+    build_from(vertex_list, face_list);
+}
+
+void MeshBVH::build(Span<const VertexAndNormal> vertex_list, Span<const uint32_t> face_list)
+{
+    build_from(vertex_list, face_list);
+}
+
+template <typename Vertex, typename Index>
+void MeshBVH::build_from(Span<const Vertex> vertex_list, Span<const Index> face_list)
+{
+    nodes_.clear();
+    triangles_.clear();
+    face_index_.clear();
+
+    uint32_t count = static_cast<uint32_t>(face_list.size() / 3);
+    if(count == 0) return;
+
+    // Bounds and centroids of each triangle
+    std::vector<BuildTriangle> build_triangles(count);
+    std::vector<uint32_t>      order(count);
+    for(uint32_t i = 0; i < count; i++)
+    {
+        const Point3 &v0 = vertex_position(vertex_list[face_list[3 * i]]);
+        const Point3 &v1 = vertex_position(vertex_list[face_list[3 * i + 1]]);
+        const Point3 &v2 = vertex_position(vertex_list[face_list[3 * i + 2]]);
+        BuildTriangle &t = build_triangles[i];
+        t.bounds.grow(&v0.x, &v0.x);
+        t.bounds.grow(&v1.x, &v1.x);
+        t.bounds.grow(&v2.x, &v2.x);
+        for(int32_t k = 0; k < 3; k++) t.centroid[k] = 0.5f * (t.bounds.min[k] + t.bounds.max[k]);
+        order[i] = i;
+    }
+
+    BinnedSAHBuilder builder(build_triangles, order);
+    builder.build(0, count, 0);
+
+    // Flatten the nodes
+    const std::vector<BuildNode> &build_nodes = builder.nodes();
+    nodes_.resize(build_nodes.size());
+    for(size_t n = 0; n < nodes_.size(); n++)
+    {
+        Node &node = nodes_[n];
+        for(int32_t k = 0; k < 3; k++)
+        {
+            node.min[k] = build_nodes[n].bounds.min[k];
+            node.max[k] = build_nodes[n].bounds.max[k];
+        }
+        node.offset = build_nodes[n].offset;
+        node.count = build_nodes[n].count;
+        node.axis = build_nodes[n].axis;
+    }
+
+    // Copy the triangles in leaf order
+    triangles_.resize(count);
+    face_index_.resize(count);
+    for(uint32_t i = 0; i < count; i++)
+    {
+        uint32_t      f = order[i];
+        const Point3 &v0 = vertex_position(vertex_list[face_list[3 * f]]);
+        const Point3 &v1 = vertex_position(vertex_list[face_list[3 * f + 1]]);
+        const Point3 &v2 = vertex_position(vertex_list[face_list[3 * f + 2]]);
+        triangles_[i] = {v0, v1 - v0, v2 - v0};
+        face_index_[i] = f;
+    }
+}
+
+size_t MeshBVH::triangle_count() const { return triangles_.size(); }
+
+size_t MeshBVH::node_count() const { return nodes_.size(); }
+
+RayMeshIntersectResult MeshBVH::intersect(const Ray3 &ray, float t_min) const
+{
+    return traverse<false>(ray, t_min);
+}
+
+bool MeshBVH::does_intersect_exist(const Ray3 &ray, float t_min) const
+{
+    return traverse<true>(ray, t_min).intersects;
+}
+
+template <bool AnyHit>
+RayMeshIntersectResult MeshBVH::traverse(const Ray3 &ray, float t_min) const
+{
+    RayMeshIntersectResult result{false, t_min, 0.0f, 0.0f, 0};
+    if(nodes_.empty())
+    {
+        result.distance = 0.0f;
+        return result;
+    }
+
+    const float o[3] = {ray.o.x, ray.o.y, ray.o.z};
+    const float inv_d[3] = {1.0f / ray.d.x, 1.0f / ray.d.y, 1.0f / ray.d.z};
+
+    uint32_t stack[STACK_SIZE];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while(top > 0)
+    {
+        const Node &node = nodes_[stack[--top]];
+
+        // Slab test against the node bounds, limited to the nearest hit so
+        // far. NaN (0 * infinity) fails the comparisons and leaves the range
+        // unchanged.
+        float t_near = 0.0f;
+        float t_far = result.distance;
+        for(int32_t k = 0; k < 3; k++)
+        {
+            float t0 = (node.min[k] - o[k]) * inv_d[k];
+            float t1 = (node.max[k] - o[k]) * inv_d[k];
+            if(t0 > t1) std::swap(t0, t1);
+            if(t0 > t_near) t_near = t0;
+            if(t1 < t_far) t_far = t1;
+        }
+        if(t_near > t_far) continue;
+
+        if(node.count > 0)
+        {
+            // Same test (and results) as Ray3::intersect(v0, v1, v2)
+            for(uint32_t i = node.offset; i < node.offset + node.count; i++)
+            {
+                const Triangle &tri = triangles_[i];
+                Vector3         p = ray.d.cross(tri.e2);
+                float           det = tri.e1.dot(p);
+                if(det == 0.0f) continue;
+
+                float   inv_det = 1.0f / det;
+                Vector3 s = ray.o - tri.v0;
+                float   u = s.dot(p) * inv_det;
+                if(u < 0.0f || u > 1.0f) continue;
+
+                Vector3 q = s.cross(tri.e1);
+                float   v = ray.d.dot(q) * inv_det;
+                if(v < 0.0f || u + v > 1.0f) continue;
+
+                // Ties go to the lower face index, as in the linear scan
+                float t = tri.e2.dot(q) * inv_det;
+                if(t <= EPSILON) continue;
+                bool closer = t < result.distance;
+                bool tie = t == result.distance && result.intersects &&
+                           face_index_[i] < result.face_index;
+                if(closer || tie)
+                {
+                    result = {true, t, u, v, face_index_[i]};
+                    if(AnyHit) return result;
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first
+        uint32_t first = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+        uint32_t second = node.offset;
+        if(inv_d[node.axis] < 0.0f) std::swap(first, second);
+        stack[top++] = second;
+        stack[top++] = first;
+    }
+
+    if(!result.intersects) result.distance = 0.0f;
+    return result;
+}
+
+} // namespace cg
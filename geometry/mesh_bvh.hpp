@@ -0,0 +1,171 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    mesh_bvh.hpp
+//	Purpose: Bounding volume hierarchy over a triangle mesh for ray queries.
+//============================================================================
+
+#ifndef __GEOMETRY_MESH_BVH_HPP__
+#define __GEOMETRY_MESH_BVH_HPP__
+
+#include "geometry/point3.hpp"
+#include "geometry/ray3.hpp"
+#include "geometry/span.hpp"
+#include "geometry/types.hpp"
+#include "geometry/vector3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Bounding volume hierarchy over the triangles of an indexed mesh. Built
+ * top-down with the surface area heuristic evaluated over a fixed number of
+ * centroid bins (binned SAH), then stored as a flat depth-first node array:
+ * the first child of an interior node follows it directly and the node
+ * holds the index of the second. Triangles are copied into leaf order (with
+ * precomputed edges), so the hierarchy does not reference the source lists
+ * and a leaf's triangles are contiguous. Ray queries visit O(log n) nodes
+ * instead of testing every triangle. Meshes may use 16 or 32-bit indices.
+ */
+class MeshBVH
+{
+  public:
+    // Leaves hold at most this many triangles
+    static constexpr uint32_t MAX_LEAF_SIZE = 8;
+
+    // Number of centroid bins evaluated per axis when splitting
+    static constexpr uint32_t BIN_COUNT = 16;
+
+    /**
+     * Default constructor. Creates an empty hierarchy.
+     */
+    MeshBVH();
+
+    /**
+     * Constructor. Builds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    MeshBVH(Span<const Point3> vertex_list, Span<const uint16_t> face_list);
+
+    /**
+     * Constructor. Builds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    MeshBVH(Span<const Point3> vertex_list, Span<const uint32_t> face_list);
+
+    /**
+     * Constructor. Builds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    MeshBVH(Span<const VertexAndNormal> vertex_list, Span<const uint16_t> face_list);
+
+    /**
+     * Constructor. Builds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    MeshBVH(Span<const VertexAndNormal> vertex_list, Span<const uint32_t> face_list);
+
+    /**
+     * Rebuilds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    void build(Span<const Point3> vertex_list, Span<const uint16_t> face_list);
+
+    /**
+     * Rebuilds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    void build(Span<const Point3> vertex_list, Span<const uint32_t> face_list);
+
+    /**
+     * Rebuilds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    void build(Span<const VertexAndNormal> vertex_list, Span<const uint16_t> face_list);
+
+    /**
+     * Rebuilds the hierarchy for a mesh.
+     * @param  vertex_list  Vertex list of the triangle mesh.
+     * @param  face_list    Face index list (3 indices per triangle).
+     */
+    void build(Span<const VertexAndNormal> vertex_list, Span<const uint32_t> face_list);
+
+    /**
+     * Get the number of triangles.
+     * @return  Returns the number of triangles in the hierarchy.
+     */
+    size_t triangle_count() const;
+
+    /**
+     * Get the number of nodes.
+     * @return  Returns the number of nodes in the hierarchy.
+     */
+    size_t node_count() const;
+
+    /**
+     * Finds the nearest intersection of a ray with the mesh. Same result as
+     * Ray3::intersect(vertex_list, face_list, t_min).
+     * @param  ray    Ray to intersect.
+     * @param  t_min  Current minimum intersection (t) value along the ray.
+     * @return Returns whether or not there is an intersection, the distance
+     *         at which the intersection occurs (0.0 if no intersection),
+     *         the barycentric coordinates of intersection, and the face index.
+     */
+    RayMeshIntersectResult intersect(const Ray3 &ray, float t_min) const;
+
+    /**
+     * Does an intersection exist between a ray and the mesh prior to t_min.
+     * Stops at the first intersection found.
+     * @param  ray    Ray to intersect.
+     * @param  t_min  t value for intersection.
+     * @return Returns true if an intersection exists, false if not.
+     */
+    bool does_intersect_exist(const Ray3 &ray, float t_min) const;
+
+  private:
+    // Flattened node (32 bytes)
+    struct Node
+    {
+        float    min[3];
+        uint32_t offset; // Leaf: first triangle. Interior: second child.
+        float    max[3];
+        uint16_t count; // Number of triangles (0 for interior nodes)
+        uint16_t axis;  // Split axis of interior nodes
+    };
+
+    // Triangle in leaf order with precomputed edges
+    struct Triangle
+    {
+        Point3  v0;
+        Vector3 e1; // v1 - v0
+        Vector3 e2; // v2 - v0
+    };
+
+    std::vector<Node>     nodes_;
+    std::vector<Triangle> triangles_;
+    std::vector<uint32_t> face_index_; // Face index of each triangle
+
+    template <typename Vertex, typename Index>
+    void build_from(Span<const Vertex> vertex_list, Span<const Index> face_list);
+
+    template <bool AnyHit>
+    RayMeshIntersectResult traverse(const Ray3 &ray, float t_min) const;
+};
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,66 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    parallel.hpp
+//	Purpose: Parallel reduction over an index range using std::thread.
+//============================================================================
+
+#ifndef __GEOMETRY_PARALLEL_HPP__
+#define __GEOMETRY_PARALLEL_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Reduces the index range [0, count) in parallel. The range is split into
+ * one contiguous chunk per hardware thread (fewer if a chunk would hold less
+ * than min_chunk indices). Each chunk is reduced by map on its own thread
+ * (the calling thread takes the first chunk), then the chunk results are
+ * combined in order on the calling thread. Small ranges run on the calling
+ * thread only, without starting threads.
+ * @param  count      Number of indices.
+ * @param  min_chunk  Smallest number of indices worth a thread.
+ * @param  identity   Result for an empty range.
+ * @param  map        Reduces a chunk: T map(size_t begin, size_t end).
+ *                    Called concurrently, so it must not modify shared state.
+ * @param  combine    Combines 2 results: T combine(T a, const T &b).
+ * @return  Returns the combined result.
+ */
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(size_t         count,
+                  size_t         min_chunk,
+                  const T       &identity,
+                  const Map     &map,
+                  const Combine &combine)
+{
+    if(count == 0) return identity;
+
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    size_t chunks = std::min(threads, std::max<size_t>(count / std::max<size_t>(min_chunk, 1), 1));
+    if(chunks == 1) return map(0, count);
+
+    auto                     chunk_begin = [&](size_t c) { return count * c / chunks; };
+    std::vector<T>           partial(chunks, identity);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for(size_t c = 1; c < chunks; c++)
+        workers.emplace_back([&, c]() { partial[c] = map(chunk_begin(c), chunk_begin(c + 1)); });
+    partial[0] = map(0, chunk_begin(1));
+    for(auto &worker : workers) worker.join();
+
+    T result = partial[0];
+    for(size_t c = 1; c < chunks; c++) result = combine(result, partial[c]);
+    return result;
+}
+
+} // namespace cg
+
+#endif
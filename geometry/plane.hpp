@@ -14,6 +14,8 @@
 #include "geometry/point3.hpp"
 #include "geometry/vector3.hpp"
 
+#include <type_traits>
+
 namespace cg
 {
 
@@ -72,6 +74,10 @@ struct Plane
     Vector3 get_normal() const;
 };
 
+static_assert(std::is_trivially_copyable<Plane>::value, "Plane must be trivially copyable");
+static_assert(std::is_standard_layout<Plane>::value, "Plane must be standard layout");
+static_assert(sizeof(Plane) == 4 * sizeof(float), "Plane must be 4 packed floats");
+
 } // namespace cg
 
 #endif
@@ -12,6 +12,9 @@
 #ifndef __GEOMETRY_POINT2_HPP__
 #define __GEOMETRY_POINT2_HPP__
 
+#include "geometry/constants.hpp"
+
+#include <type_traits>
 #include <vector>
 
 namespace cg
@@ -32,47 +35,34 @@ struct Point2
     /**
      * Default constructor
      */
-    Point2();
+    constexpr Point2();
 
     /**
      * Constructor with initial values for x,y.
      * @param   ix   x coordinate position.
      * @param   iy   y coordinate position.
      */
-    Point2(float ix, float iy);
-
-    /**
-     * Copy constructor.
-     * @param   p   Point to copy to the new point.
-     */
-    Point2(const Point2 &p);
+    constexpr Point2(float ix, float iy);
 
     /**
      * Convert a homogeneous coordinate into a cartesian coordinate.
      * @param   p   Homogenous point
      */
-    Point2(const HPoint2 &p);
-
-    /**
-     * Assignment operator
-     * @param   p   Point to assign to this point.
-     * @return  Returns the address of this point.
-     */
-    Point2 &operator=(const Point2 &p);
+    constexpr Point2(const HPoint2 &p);
 
     /**
      * Set the coordinate components to the specified values.
      * @param   ix   x coordinate position.
      * @param   iy   y coordinate position.
      */
-    void set(float ix, float iy);
+    constexpr void set(float ix, float iy);
 
     /**
      * Equality operator.
      * @param   p  Point to compare to the current point.
      * @return  Returns true if two points are equal, false otherwise.
      */
-    bool operator==(const Point2 &p) const;
+    constexpr bool operator==(const Point2 &p) const;
 
     /**
      * Affine combination of this point with another point. 2 scalars are provided
@@ -81,14 +71,14 @@ struct Point2
      * @param  a1  Scalar for p1
      * @param  p1  Point 1
      */
-    Point2 affine_combination(float a0, float a1, const Point2 &p1) const;
+    constexpr Point2 affine_combination(float a0, float a1, const Point2 &p1) const;
 
     /**
      * Gets the midpoint on a line segment between this point and point p1.
      * @param  p1  Point
      * @return  Returns the midpoint between this point and p1.
      */
-    Point2 mid_point(const Point2 &p1) const;
+    constexpr Point2 mid_point(const Point2 &p1) const;
 
     /**
      * Test if point is inside polygon: Shoots a test ray along +x axis.
@@ -105,7 +95,7 @@ struct Point2
      * @return  Returns a new point: the result of the current point
      *          plus the specified vector.
      */
-    Point2 operator+(const Vector2 &v) const;
+    constexpr Point2 operator+(const Vector2 &v) const;
 
     /**
      * Subtract a vector from the current point.
@@ -113,16 +103,46 @@ struct Point2
      * @return  Returns a new point: the result of the current point
      *          minus the specified vector.
      */
-    Point2 operator-(const Vector2 &v) const;
+    constexpr Point2 operator-(const Vector2 &v) const;
 
     /**
      * Subtraction of a point from the current point.
      * @param   p to subtract from the current point.
      * @return  Returns a vector.
      */
-    Vector2 operator-(const Point2 &p) const;
+    constexpr Vector2 operator-(const Point2 &p) const;
 };
 
+static_assert(std::is_trivially_copyable<Point2>::value, "Point2 must be trivially copyable");
+static_assert(std::is_standard_layout<Point2>::value, "Point2 must be standard layout");
+static_assert(sizeof(Point2) == 2 * sizeof(float), "Point2 must be 2 packed floats");
+
+constexpr Point2::Point2() : x(0.0f), y(0.0f) {}
+
+constexpr Point2::Point2(float ix, float iy) : x(ix), y(iy) {}
+
+constexpr void Point2::set(float ix, float iy)
+{
+    x = ix;
+    y = iy;
+}
+
+constexpr bool Point2::operator==(const Point2 &p) const { return (x == p.x && y == p.y); }
+
+constexpr Point2 Point2::affine_combination(float a0, float a1, const Point2 &p1) const
+{
+    return Point2(a0 * x + a1 * p1.x, a0 * y + a1 * p1.y);
+}
+
+constexpr Point2 Point2::mid_point(const Point2 &p1) const
+{
+    return Point2(0.5f * x + 0.5f * p1.x, 0.5f * y + 0.5f * p1.y);
+}
+
 } // namespace cg
 
+// Point2 operations involving HPoint2 and Vector2 are defined in their headers
+#include "geometry/hpoint2.hpp"
+#include "geometry/vector2.hpp"
+
 #endif
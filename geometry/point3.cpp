@@ -7,41 +7,6 @@
 namespace cg
 {
 
-Point3::Point3() : x(0.0f), y(0.0f), z(0.0f) {}
-
-Point3::Point3(float ix, float iy, float iz) : x(ix), y(iy), z(iz) {}
-
-Point3::Point3(const Point3 &p) : x(p.x), y(p.y), z(p.z) {}
-
-Point3::Point3(const HPoint3 &p) { *this = p.to_cartesian(); }
-
-Point3 &Point3::operator=(const Point3 &p)
-{
-    x = p.x;
-    y = p.y;
-    z = p.z;
-    return *this;
-}
-
-void Point3::set(float ix, float iy, float iz)
-{
-    x = ix;
-    y = iy;
-    z = iz;
-}
-
-bool Point3::operator==(const Point3 &p) const { return (x == p.x && y == p.y && z == p.z); }
-
-Point3 Point3::affine_combination(float a0, float a1, const Point3 &p1) const
-{
-    return Point3(a0 * x + a1 * p1.x, a0 * y + a1 * p1.y, a0 * z + a1 * p1.z);
-}
-
-Point3 Point3::mid_point(const Point3 &p1) const
-{
-    return Point3(0.5f * x + 0.5f * p1.x, 0.5f * y + 0.5f * p1.y, 0.5f * z + 0.5f * p1.z);
-}
-
 bool Point3::is_in_polygon(const std::vector<Point3> &polygon, const Vector3 &n) const
 {
     if(std::abs(n.x) >= std::abs(n.y) && std::abs(n.x) >= std::abs(n.z))
@@ -51,12 +16,6 @@ bool Point3::is_in_polygon(const std::vector<Point3> &polygon, const Vector3 &n)
     else return is_in_polygon_XY(polygon); // Drop the z component
 }
 
-Point3 Point3::operator+(const Vector3 &v) const { return Point3(x + v.x, y + v.y, z + v.z); }
-
-Point3 Point3::operator-(const Vector3 &v) const { return Point3(x - v.x, y - v.y, z - v.z); }
-
-Vector3 Point3::operator-(const Point3 &p) const { return Vector3(x - p.x, y - p.y, z - p.z); }
-
 bool Point3::is_in_polygon_XY(const std::vector<Point3> &polygon) const
 {
     bool inside = false;
@@ -12,6 +12,9 @@
 #ifndef __GEOMETRY_POINT3_HPP__
 #define __GEOMETRY_POINT3_HPP__
 
+#include "geometry/constants.hpp"
+
+#include <type_traits>
 #include <vector>
 
 namespace cg
@@ -33,7 +36,7 @@ struct Point3
     /**
      * Default constructor
      */
-    Point3();
+    constexpr Point3();
 
     /**
      * Constructor with initial values for x,y,z.
@@ -41,26 +44,13 @@ struct Point3
      * @param   iy   y coordinate position.
      * @param   iz   z coordinate position.
      */
-    Point3(float ix, float iy, float iz);
-
-    /**
-     * Copy constructor.
-     * @param   p   Point to copy to the new point.
-     */
-    Point3(const Point3 &p);
+    constexpr Point3(float ix, float iy, float iz);
 
     /**
      * Convert a homogeneous coordinate into a cartesian coordinate.
      * @param   p   Homogenous point
      */
-    Point3(const HPoint3 &p);
-
-    /**
-     * Assignment operator
-     * @param   p   Point to assign to this point.
-     * @return   Returns the address of this point.
-     */
-    Point3 &operator=(const Point3 &p);
+    constexpr Point3(const HPoint3 &p);
 
     /**
      * Set the coordinate components to the specified values.
@@ -68,14 +58,14 @@ struct Point3
      * @param   iy   y coordinate position.
      * @param   iz   z coordinate position.
      */
-    void set(float ix, float iy, float iz);
+    constexpr void set(float ix, float iy, float iz);
 
     /**
      * Equality operator.
      * @param   p  Point to compare to the current point.
      * @return  Returns true if two points are equal, false otherwise.
      */
-    bool operator==(const Point3 &p) const;
+    constexpr bool operator==(const Point3 &p) const;
 
     /**
      * Affine combination of this point with another point. 2 scalars are provided
@@ -84,14 +74,14 @@ struct Point3
      * @param  a1  Scalar for p1
      * @param  p1  Point 1
      */
-    Point3 affine_combination(float a0, float a1, const Point3 &p1) const;
+    constexpr Point3 affine_combination(float a0, float a1, const Point3 &p1) const;
 
     /**
      * Gets the midpoint on a line segment between this point and point p1.
      * @param  p1  Point
      * @return  Returns the midpoint between this point and p1.
      */
-    Point3 mid_point(const Point3 &p1) const;
+    constexpr Point3 mid_point(const Point3 &p1) const;
 
     /**
      * Test if a point is inside a 3D polygon. Uses the normal to the
@@ -110,7 +100,7 @@ struct Point3
      * @return  Returns a new point: the result of the current point
      *          plus the specified vector.
      */
-    Point3 operator+(const Vector3 &v) const;
+    constexpr Point3 operator+(const Vector3 &v) const;
 
     /**
      * Subtract a vector from the current point.
@@ -118,14 +108,14 @@ struct Point3
      * @return  Returns a new point: the result of the current point
      *          minus the specified vector.
      */
-    Point3 operator-(const Vector3 &v) const;
+    constexpr Point3 operator-(const Vector3 &v) const;
 
     /**
      * Subtraction of a point from the current point.
      * @param   p to subtract from the current point.
      * @return  Returns a vector.
      */
-    Vector3 operator-(const Point3 &p) const;
+    constexpr Vector3 operator-(const Point3 &p) const;
 
   protected:
     // Test if point is inside polygon: drop the z component when making the
@@ -147,6 +137,40 @@ struct Point3
     bool is_in_polygon_YZ(const std::vector<Point3> &polygon) const;
 };
 
+static_assert(std::is_trivially_copyable<Point3>::value, "Point3 must be trivially copyable");
+static_assert(std::is_standard_layout<Point3>::value, "Point3 must be standard layout");
+static_assert(sizeof(Point3) == 3 * sizeof(float), "Point3 must be 3 packed floats");
+
+constexpr Point3::Point3() : x(0.0f), y(0.0f), z(0.0f) {}
+
+constexpr Point3::Point3(float ix, float iy, float iz) : x(ix), y(iy), z(iz) {}
+
+constexpr void Point3::set(float ix, float iy, float iz)
+{
+    x = ix;
+    y = iy;
+    z = iz;
+}
+
+constexpr bool Point3::operator==(const Point3 &p) const
+{
+    return (x == p.x && y == p.y && z == p.z);
+}
+
+constexpr Point3 Point3::affine_combination(float a0, float a1, const Point3 &p1) const
+{
+    return Point3(a0 * x + a1 * p1.x, a0 * y + a1 * p1.y, a0 * z + a1 * p1.z);
+}
+
+constexpr Point3 Point3::mid_point(const Point3 &p1) const
+{
+    return Point3(0.5f * x + 0.5f * p1.x, 0.5f * y + 0.5f * p1.y, 0.5f * z + 0.5f * p1.z);
+}
+
 } // namespace cg
 
+// Point3 operations involving HPoint3 and Vector3 are defined in their headers
+#include "geometry/hpoint3.hpp"
+#include "geometry/vector3.hpp"
+
 #endif
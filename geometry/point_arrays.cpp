@@ -0,0 +1,343 @@
+#include "geometry/point_arrays.hpp"
+
+#include "geometry/geometry.hpp"
+#include "geometry/simd.hpp"
+
+namespace cg
+{
+
+//------------------------------- SoAArray2 --------------------------------//
+
+template <typename T>
+SoAArray2<T>::SoAArray2()
+{
+}
+
+template <typename T>
+SoAArray2<T>::SoAArray2(const std::vector<T> &src)
+{
+    assign(src);
+}
+
+template <typename T>
+size_t SoAArray2<T>::size() const
+{
+    return x_.size();
+}
+
+template <typename T>
+bool SoAArray2<T>::empty() const
+{
+    return x_.empty();
+}
+
+template <typename T>
+void SoAArray2<T>::reserve(size_t n)
+{
+    x_.reserve(n);
+    y_.reserve(n);
+}
+
+template <typename T>
+void SoAArray2<T>::resize(size_t n)
+{
+    x_.resize(n, 0.0f);
+    y_.resize(n, 0.0f);
+}
+
+template <typename T>
+void SoAArray2<T>::clear()
+{
+    x_.clear();
+    y_.clear();
+}
+
+template <typename T>
+void SoAArray2<T>::push_back(const T &p)
+{
+    x_.push_back(p.x);
+    y_.push_back(p.y);
+}
+
+template <typename T>
+T SoAArray2<T>::get(size_t i) const
+{
+    return T(x_[i], y_[i]);
+}
+
+template <typename T>
+void SoAArray2<T>::set(size_t i, const T &p)
+{
+    x_[i] = p.x;
+    y_[i] = p.y;
+}
+
+template <typename T>
+float *SoAArray2<T>::x()
+{
+    return x_.data();
+}
+
+template <typename T>
+const float *SoAArray2<T>::x() const
+{
+    return x_.data();
+}
+
+template <typename T>
+float *SoAArray2<T>::y()
+{
+    return y_.data();
+}
+
+template <typename T>
+const float *SoAArray2<T>::y() const
+{
+    return y_.data();
+}
+
+template <typename T>
+void SoAArray2<T>::assign(const T *src, size_t count)
+{
+    x_.resize(count);
+    y_.resize(count);
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y;
+        simd::load_xy4(&src[i].x, x, y);
+        _mm_store_ps(&x_[i], x);
+        _mm_store_ps(&y_[i], y);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        x_[i] = src[i].x;
+        y_[i] = src[i].y;
+    }
+}
+
+template <typename T>
+void SoAArray2<T>::assign(const std::vector<T> &src)
+{
+    assign(src.data(), src.size());
+}
+
+template <typename T>
+void SoAArray2<T>::copy_to(T *dst) const
+{
+    write_interleaved(reinterpret_cast<float *>(dst), 2);
+}
+
+template <typename T>
+void SoAArray2<T>::copy_to(std::vector<T> &dst) const
+{
+    dst.resize(size());
+    copy_to(dst.data());
+}
+
+template <typename T>
+void SoAArray2<T>::write_interleaved(float *dst, size_t stride) const
+{
+    size_t count = size();
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    if(stride == 2)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            simd::store_xy4(dst + 2 * i, _mm_load_ps(&x_[i]), _mm_load_ps(&y_[i]));
+        }
+    }
+#endif
+    for(; i < count; i++)
+    {
+        dst[i * stride] = x_[i];
+        dst[i * stride + 1] = y_[i];
+    }
+}
+
+//------------------------------- SoAArray3 --------------------------------//
+
+template <typename T>
+SoAArray3<T>::SoAArray3()
+{
+}
+
+template <typename T>
+SoAArray3<T>::SoAArray3(const std::vector<T> &src)
+{
+    assign(src);
+}
+
+template <typename T>
+size_t SoAArray3<T>::size() const
+{
+    return x_.size();
+}
+
+template <typename T>
+bool SoAArray3<T>::empty() const
+{
+    return x_.empty();
+}
+
+template <typename T>
+void SoAArray3<T>::reserve(size_t n)
+{
+    x_.reserve(n);
+    y_.reserve(n);
+    z_.reserve(n);
+}
+
+template <typename T>
+void SoAArray3<T>::resize(size_t n)
+{
+    x_.resize(n, 0.0f);
+    y_.resize(n, 0.0f);
+    z_.resize(n, 0.0f);
+}
+
+template <typename T>
+void SoAArray3<T>::clear()
+{
+    x_.clear();
+    y_.clear();
+    z_.clear();
+}
+
+template <typename T>
+void SoAArray3<T>::push_back(const T &p)
+{
+    x_.push_back(p.x);
+    y_.push_back(p.y);
+    z_.push_back(p.z);
+}
+
+template <typename T>
+T SoAArray3<T>::get(size_t i) const
+{
+    return T(x_[i], y_[i], z_[i]);
+}
+
+template <typename T>
+void SoAArray3<T>::set(size_t i, const T &p)
+{
+    x_[i] = p.x;
+    y_[i] = p.y;
+    z_[i] = p.z;
+}
+
+template <typename T>
+float *SoAArray3<T>::x()
+{
+    return x_.data();
+}
+
+template <typename T>
+const float *SoAArray3<T>::x() const
+{
+    return x_.data();
+}
+
+template <typename T>
+float *SoAArray3<T>::y()
+{
+    return y_.data();
+}
+
+template <typename T>
+const float *SoAArray3<T>::y() const
+{
+    return y_.data();
+}
+
+template <typename T>
+float *SoAArray3<T>::z()
+{
+    return z_.data();
+}
+
+template <typename T>
+const float *SoAArray3<T>::z() const
+{
+    return z_.data();
+}
+
+template <typename T>
+void SoAArray3<T>::assign(const T *src, size_t count)
+{
+    x_.resize(count);
+    y_.resize(count);
+    z_.resize(count);
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&src[i].x, x, y, z);
+        _mm_store_ps(&x_[i], x);
+        _mm_store_ps(&y_[i], y);
+        _mm_store_ps(&z_[i], z);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        x_[i] = src[i].x;
+        y_[i] = src[i].y;
+        z_[i] = src[i].z;
+    }
+}
+
+template <typename T>
+void SoAArray3<T>::assign(const std::vector<T> &src)
+{
+    assign(src.data(), src.size());
+}
+
+template <typename T>
+void SoAArray3<T>::copy_to(T *dst) const
+{
+    write_interleaved(reinterpret_cast<float *>(dst), 3);
+}
+
+template <typename T>
+void SoAArray3<T>::copy_to(std::vector<T> &dst) const
+{
+    dst.resize(size());
+    copy_to(dst.data());
+}
+
+template <typename T>
+void SoAArray3<T>::write_interleaved(float *dst, size_t stride) const
+{
+    size_t count = size();
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    if(stride == 3)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            simd::store_xyz4(dst + 3 * i,
+                             _mm_load_ps(&x_[i]),
+                             _mm_load_ps(&y_[i]),
+                             _mm_load_ps(&z_[i]));
+        }
+    }
+#endif
+    for(; i < count; i++)
+    {
+        dst[i * stride] = x_[i];
+        dst[i * stride + 1] = y_[i];
+        dst[i * stride + 2] = z_[i];
+    }
+}
+
+// Explicit instantiations
+template class SoAArray2<Point2>;
+template class SoAArray2<Vector2>;
+template class SoAArray3<Point3>;
+template class SoAArray3<Vector3>;
+
+} // namespace cg
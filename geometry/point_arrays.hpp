@@ -0,0 +1,270 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    point_arrays.hpp
+//	Purpose: Structure-of-arrays containers for 2D and 3D points and vectors.
+//============================================================================
+
+#ifndef __GEOMETRY_POINT_ARRAYS_HPP__
+#define __GEOMETRY_POINT_ARRAYS_HPP__
+
+#include "geometry/aligned_allocator.hpp"
+#include "geometry/point2.hpp"
+#include "geometry/point3.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace cg
+{
+
+// Forward Declarations
+struct Vector2;
+struct Vector3;
+
+/**
+ * Structure-of-arrays storage for 2D points or vectors. Each coordinate is
+ * held in its own SIMD aligned array so batch passes can process 4 (or 8)
+ * consecutive elements with aligned loads. T is Point2 or Vector2.
+ */
+template <typename T>
+class SoAArray2
+{
+  public:
+    /**
+     * Default constructor. Creates an empty array.
+     */
+    SoAArray2();
+
+    /**
+     * Constructor from an array-of-structs list.
+     * @param  src  Elements to copy.
+     */
+    explicit SoAArray2(const std::vector<T> &src);
+
+    /**
+     * Get the number of elements.
+     * @return  Returns the number of elements.
+     */
+    size_t size() const;
+
+    /**
+     * Test whether the array is empty.
+     * @return  Returns true if there are no elements.
+     */
+    bool empty() const;
+
+    /**
+     * Reserve storage for n elements.
+     * @param  n  Number of elements.
+     */
+    void reserve(size_t n);
+
+    /**
+     * Resize to n elements. New elements are (0,0).
+     * @param  n  Number of elements.
+     */
+    void resize(size_t n);
+
+    /**
+     * Remove all elements.
+     */
+    void clear();
+
+    /**
+     * Append an element.
+     * @param  p  Element to append.
+     */
+    void push_back(const T &p);
+
+    /**
+     * Get an element.
+     * @param  i  Index of the element.
+     * @return  Returns element i.
+     */
+    T get(size_t i) const;
+
+    /**
+     * Set an element.
+     * @param  i  Index of the element.
+     * @param  p  New value.
+     */
+    void set(size_t i, const T &p);
+
+    // Coordinate arrays (SIMD aligned)
+    float       *x();
+    const float *x() const;
+    float       *y();
+    const float *y() const;
+
+    /**
+     * Replace the contents with an array-of-structs list (AoS -> SoA).
+     * @param  src    Elements to copy.
+     * @param  count  Number of elements.
+     */
+    void assign(const T *src, size_t count);
+
+    /**
+     * Replace the contents with an array-of-structs list (AoS -> SoA).
+     * @param  src  Elements to copy.
+     */
+    void assign(const std::vector<T> &src);
+
+    /**
+     * Copy the contents to an array-of-structs list (SoA -> AoS).
+     * @param  dst  Destination (must hold size() elements).
+     */
+    void copy_to(T *dst) const;
+
+    /**
+     * Copy the contents to an array-of-structs list (SoA -> AoS). The
+     * destination is resized to match.
+     * @param  dst  Destination list.
+     */
+    void copy_to(std::vector<T> &dst) const;
+
+    /**
+     * Write the coordinates interleaved into a vertex buffer, ready for
+     * glBufferData. Element i is written to dst[i * stride] (x) and
+     * dst[i * stride + 1] (y), so positions can be placed into a larger vertex
+     * layout. Other floats in each vertex are left untouched.
+     * @param  dst     Destination buffer (must hold size() * stride floats).
+     * @param  stride  Distance in floats between consecutive vertices (>= 2).
+     */
+    void write_interleaved(float *dst, size_t stride = 2) const;
+
+  private:
+    AlignedFloatVector x_;
+    AlignedFloatVector y_;
+};
+
+/**
+ * Structure-of-arrays storage for 3D points or vectors. Each coordinate is
+ * held in its own SIMD aligned array so batch passes can process 4 (or 8)
+ * consecutive elements with aligned loads. T is Point3 or Vector3.
+ */
+template <typename T>
+class SoAArray3
+{
+  public:
+    /**
+     * Default constructor. Creates an empty array.
+     */
+    SoAArray3();
+
+    /**
+     * Constructor from an array-of-structs list.
+     * @param  src  Elements to copy.
+     */
+    explicit SoAArray3(const std::vector<T> &src);
+
+    /**
+     * Get the number of elements.
+     * @return  Returns the number of elements.
+     */
+    size_t size() const;
+
+    /**
+     * Test whether the array is empty.
+     * @return  Returns true if there are no elements.
+     */
+    bool empty() const;
+
+    /**
+     * Reserve storage for n elements.
+     * @param  n  Number of elements.
+     */
+    void reserve(size_t n);
+
+    /**
+     * Resize to n elements. New elements are (0,0,0).
+     * @param  n  Number of elements.
+     */
+    void resize(size_t n);
+
+    /**
+     * Remove all elements.
+     */
+    void clear();
+
+    /**
+     * Append an element.
+     * @param  p  Element to append.
+     */
+    void push_back(const T &p);
+
+    /**
+     * Get an element.
+     * @param  i  Index of the element.
+     * @return  Returns element i.
+     */
+    T get(size_t i) const;
+
+    /**
+     * Set an element.
+     * @param  i  Index of the element.
+     * @param  p  New value.
+     */
+    void set(size_t i, const T &p);
+
+    // Coordinate arrays (SIMD aligned)
+    float       *x();
+    const float *x() const;
+    float       *y();
+    const float *y() const;
+    float       *z();
+    const float *z() const;
+
+    /**
+     * Replace the contents with an array-of-structs list (AoS -> SoA).
+     * @param  src    Elements to copy.
+     * @param  count  Number of elements.
+     */
+    void assign(const T *src, size_t count);
+
+    /**
+     * Replace the contents with an array-of-structs list (AoS -> SoA).
+     * @param  src  Elements to copy.
+     */
+    void assign(const std::vector<T> &src);
+
+    /**
+     * Copy the contents to an array-of-structs list (SoA -> AoS).
+     * @param  dst  Destination (must hold size() elements).
+     */
+    void copy_to(T *dst) const;
+
+    /**
+     * Copy the contents to an array-of-structs list (SoA -> AoS). The
+     * destination is resized to match.
+     * @param  dst  Destination list.
+     */
+    void copy_to(std::vector<T> &dst) const;
+
+    /**
+     * Write the coordinates interleaved into a vertex buffer, ready for
+     * glBufferData. Element i is written to dst[i * stride] .. dst[i * stride + 2]
+     * so positions (or normals) can be placed into a larger vertex layout.
+     * Other floats in each vertex are left untouched.
+     * @param  dst     Destination buffer (must hold size() * stride floats).
+     * @param  stride  Distance in floats between consecutive vertices (>= 3).
+     */
+    void write_interleaved(float *dst, size_t stride = 3) const;
+
+  private:
+    AlignedFloatVector x_;
+    AlignedFloatVector y_;
+    AlignedFloatVector z_;
+};
+
+using Point2Array = SoAArray2<Point2>;
+using Vector2Array = SoAArray2<Vector2>;
+using Point3Array = SoAArray3<Point3>;
+using Vector3Array = SoAArray3<Vector3>;
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,210 @@
+#include "geometry/predicates.hpp"
+
+#include <algorithm>
+
+namespace cg
+{
+
+namespace
+{
+
+// Expansion arithmetic (Shewchuk 1997). An expansion is a sum of doubles
+// stored in increasing order of magnitude with no overlapping bits, so it
+// represents a sum exactly and its largest component has the sign of the sum.
+// These rely on round-to-nearest and no fused multiply-add contraction (the
+// product uses std::fma when the target has FMA).
+
+// Largest factor and product lengths used by incircle_exact
+constexpr int32_t MAX_FACTOR = 16;
+constexpr int32_t MAX_PRODUCT = 2 * MAX_FACTOR * MAX_FACTOR;
+
+// 2^ceil(53 / 2) + 1, splits a double into 2 halves of 26 bits
+constexpr double SPLITTER = 134217729.0;
+
+// x + y = a + b exactly, for |a| >= |b|
+inline void fast_two_sum(double a, double b, double &x, double &y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+// x + y = a + b exactly
+inline void two_sum(double a, double b, double &x, double &y)
+{
+    x = a + b;
+    double b_virtual = x - a;
+    double a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// x + y = a - b exactly
+inline void two_diff(double a, double b, double &x, double &y)
+{
+    x = a - b;
+    double b_virtual = a - x;
+    double a_virtual = x + b_virtual;
+    y = (a - a_virtual) + (b_virtual - b);
+}
+
+// x + y = a * b exactly
+inline void two_product(double a, double b, double &x, double &y)
+{
+    x = a * b;
+#if defined(__FMA__)
+    y = std::fma(a, b, -x);
+#else
+    double c = SPLITTER * a;
+    double a_hi = c - (c - a);
+    double a_lo = a - a_hi;
+    c = SPLITTER * b;
+    double b_hi = c - (c - b);
+    double b_lo = b - b_hi;
+    double err = x - a_hi * b_hi;
+    err -= a_lo * b_hi;
+    err -= a_hi * b_lo;
+    y = a_lo * b_lo - err;
+#endif
+}
+
+// h = e + f with zero components removed. h needs elen + flen components.
+// Returns the length of h (at least 1).
+int32_t expansion_sum(int32_t elen, const double *e, int32_t flen, const double *f, double *h)
+{
+    int32_t ei = 0;
+    int32_t fi = 0;
+    int32_t hi = 0;
+    double  q, q_new, hh;
+
+    // Merge the components by magnitude
+    auto next = [&]()
+    {
+        if(fi == flen || (ei < elen && (f[fi] > e[ei]) == (f[fi] > -e[ei]))) return e[ei++];
+        return f[fi++];
+    };
+    q = next();
+    while(ei + fi < elen + flen)
+    {
+        two_sum(q, next(), q_new, hh);
+        q = q_new;
+        if(hh != 0.0) h[hi++] = hh;
+    }
+    if(q != 0.0 || hi == 0) h[hi++] = q;
+    return hi;
+}
+
+// h = e * b with zero components removed. h needs 2 * elen components.
+// Returns the length of h (at least 1).
+int32_t expansion_scale(int32_t elen, const double *e, double b, double *h)
+{
+    int32_t hi = 0;
+    double  q, hh;
+    two_product(e[0], b, q, hh);
+    if(hh != 0.0) h[hi++] = hh;
+    for(int32_t i = 1; i < elen; i++)
+    {
+        double product_hi, product_lo, sum;
+        two_product(e[i], b, product_hi, product_lo);
+        two_sum(q, product_lo, sum, hh);
+        if(hh != 0.0) h[hi++] = hh;
+        fast_two_sum(product_hi, sum, q, hh);
+        if(hh != 0.0) h[hi++] = hh;
+    }
+    if(q != 0.0 || hi == 0) h[hi++] = q;
+    return hi;
+}
+
+// h = e * f. h needs 2 * elen * flen components (elen, flen <= MAX_FACTOR).
+// Returns the length of h.
+int32_t expansion_product(int32_t elen, const double *e, int32_t flen, const double *f, double *h)
+{
+    double  term[2 * MAX_FACTOR];
+    double  sum[MAX_PRODUCT];
+    int32_t hlen = expansion_scale(elen, e, f[0], h);
+    for(int32_t i = 1; i < flen; i++)
+    {
+        int32_t tlen = expansion_scale(elen, e, f[i], term);
+        std::copy(h, h + hlen, sum);
+        hlen = expansion_sum(hlen, sum, tlen, term, h);
+    }
+    return hlen;
+}
+
+// h = e - f. h needs elen + flen components.
+int32_t expansion_diff(int32_t elen, const double *e, int32_t flen, const double *f, double *h)
+{
+    double neg[MAX_PRODUCT];
+    for(int32_t i = 0; i < flen; i++) neg[i] = -f[i];
+    return expansion_sum(elen, e, flen, neg, h);
+}
+
+// Exact difference a - b as a 2 component expansion
+struct Difference
+{
+    double c[2];
+
+    Difference(double a, double b) { two_diff(a, b, c[1], c[0]); }
+};
+
+// e * f - g * h for 2 component expansions. out needs 16 components.
+int32_t cross(const Difference &e,
+              const Difference &f,
+              const Difference &g,
+              const Difference &h,
+              double           *out)
+{
+    double  left[8], right[8];
+    int32_t llen = expansion_product(2, e.c, 2, f.c, left);
+    int32_t rlen = expansion_product(2, g.c, 2, h.c, right);
+    return expansion_diff(llen, left, rlen, right, out);
+}
+
+// x^2 + y^2 for 2 component expansions. out needs 16 components.
+int32_t lift(const Difference &x, const Difference &y, double *out)
+{
+    double  xx[8], yy[8];
+    int32_t xlen = expansion_product(2, x.c, 2, x.c, xx);
+    int32_t ylen = expansion_product(2, y.c, 2, y.c, yy);
+    return expansion_sum(xlen, xx, ylen, yy, out);
+}
+
+} // namespace
+
+double orient2d_exact(double ax, double ay, double bx, double by, double cx, double cy)
+{
+    Difference acx(ax, cx), acy(ay, cy), bcx(bx, cx), bcy(by, cy);
+    double     det[16];
+    int32_t    len = cross(acx, bcy, acy, bcx, det);
+    return det[len - 1];
+}
+
+double incircle_exact(double ax,
+                      double ay,
+                      double bx,
+                      double by,
+                      double cx,
+                      double cy,
+                      double dx,
+                      double dy)
+{
+    Difference adx(ax, dx), ady(ay, dy), bdx(bx, dx), bdy(by, dy), cdx(cx, dx), cdy(cy, dy);
+
+    // lift(a) * (b x c) + lift(b) * (c x a) + lift(c) * (a x b)
+    double  lift_a[16], lift_b[16], lift_c[16], bc[16], ca[16], ab[16];
+    int32_t la = lift(adx, ady, lift_a);
+    int32_t lb = lift(bdx, bdy, lift_b);
+    int32_t lc = lift(cdx, cdy, lift_c);
+    int32_t lbc = cross(bdx, cdy, cdx, bdy, bc);
+    int32_t lca = cross(cdx, ady, adx, cdy, ca);
+    int32_t lab = cross(adx, bdy, bdx, ady, ab);
+
+    double  ta[MAX_PRODUCT], tb[MAX_PRODUCT], tc[MAX_PRODUCT];
+    double  tab[2 * MAX_PRODUCT], det[3 * MAX_PRODUCT];
+    int32_t lta = expansion_product(la, lift_a, lbc, bc, ta);
+    int32_t ltb = expansion_product(lb, lift_b, lca, ca, tb);
+    int32_t ltc = expansion_product(lc, lift_c, lab, ab, tc);
+    int32_t ltab = expansion_sum(lta, ta, ltb, tb, tab);
+    int32_t len = expansion_sum(ltab, tab, ltc, tc, det);
+    return det[len - 1];
+}
+
+} // namespace cg
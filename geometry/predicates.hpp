@@ -0,0 +1,162 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    predicates.hpp
+//	Purpose: Robust 2D orientation and in-circle predicates (Shewchuk's
+//           adaptive predicates with a floating-point error bound filter).
+//============================================================================
+
+#ifndef __GEOMETRY_PREDICATES_HPP__
+#define __GEOMETRY_PREDICATES_HPP__
+
+#include "geometry/point2.hpp"
+
+#include <cmath>
+
+namespace cg
+{
+
+// Error bound factors of the filters for double precision (Shewchuk,
+// "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates", 1997). The same factors hold for any binary floating point
+// type with eps = 2^-(mantissa bits + 1), e.g. 2^-24 for float.
+constexpr double PREDICATE_EPSILON = 1.1102230246251565e-16; // 2^-53
+constexpr double ORIENT2D_ERROR_BOUND = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+constexpr double INCIRCLE_ERROR_BOUND = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+
+/**
+ * Orientation of 3 points. The sign is always exact: the determinant is
+ * evaluated in double precision, and only when the result is within the
+ * rounding error bound is it recomputed with exact arithmetic.
+ * @return  Returns a positive value if a, b, c are in counterclockwise
+ *          order, a negative value if clockwise and 0 if they are collinear.
+ *          The magnitude approximates twice the signed area of the triangle.
+ */
+double orient2d(double ax, double ay, double bx, double by, double cx, double cy);
+
+/**
+ * Orientation of 3 points. See orient2d above.
+ * @param  a  1st point.
+ * @param  b  2nd point.
+ * @param  c  3rd point.
+ * @return  Returns a positive value if a, b, c are in counterclockwise
+ *          order, a negative value if clockwise and 0 if they are collinear.
+ */
+double orient2d(const Point2 &a, const Point2 &b, const Point2 &c);
+
+/**
+ * In-circle test. The sign is always exact (filtered like orient2d).
+ * @return  Returns a positive value if d is inside the circle through a, b
+ *          and c, a negative value if outside and 0 if on the circle. a, b
+ *          and c must be in counterclockwise order (the sign flips
+ *          otherwise).
+ */
+double incircle(double ax,
+                double ay,
+                double bx,
+                double by,
+                double cx,
+                double cy,
+                double dx,
+                double dy);
+
+/**
+ * In-circle test. See incircle above.
+ * @param  a  1st point on the circle.
+ * @param  b  2nd point on the circle.
+ * @param  c  3rd point on the circle.
+ * @param  d  Point to test.
+ * @return  Returns a positive value if d is inside the circle through a, b
+ *          and c (counterclockwise), a negative value if outside and 0 if on
+ *          the circle.
+ */
+double incircle(const Point2 &a, const Point2 &b, const Point2 &c, const Point2 &d);
+
+/**
+ * Exact orientation (always uses expansion arithmetic). Used by orient2d
+ * when the filter cannot decide the sign.
+ * @return  Returns a value with the exact sign of the determinant.
+ */
+double orient2d_exact(double ax, double ay, double bx, double by, double cx, double cy);
+
+/**
+ * Exact in-circle test (always uses expansion arithmetic). Used by incircle
+ * when the filter cannot decide the sign.
+ * @return  Returns a value with the exact sign of the determinant.
+ */
+double incircle_exact(double ax,
+                      double ay,
+                      double bx,
+                      double by,
+                      double cx,
+                      double cy,
+                      double dx,
+                      double dy);
+
+// Filters are inline so the common case costs about as much as the plain
+// floating point determinant
+
+inline double orient2d(double ax, double ay, double bx, double by, double cx, double cy)
+{
+    double left = (ax - cx) * (by - cy);
+    double right = (ay - cy) * (bx - cx);
+    double det = left - right;
+
+    // One compare instead of Shewchuk's sign cases (terms of opposite sign
+    // pass it too). Exact zeros (both terms 0) pass as well.
+    if(std::abs(det) >= ORIENT2D_ERROR_BOUND * (std::abs(left) + std::abs(right))) return det;
+    return orient2d_exact(ax, ay, bx, by, cx, cy);
+}
+
+inline double orient2d(const Point2 &a, const Point2 &b, const Point2 &c)
+{
+    return orient2d(a.x, a.y, b.x, b.y, c.x, c.y);
+}
+
+inline double incircle(double ax,
+                       double ay,
+                       double bx,
+                       double by,
+                       double cx,
+                       double cy,
+                       double dx,
+                       double dy)
+{
+    double adx = ax - dx;
+    double bdx = bx - dx;
+    double cdx = cx - dx;
+    double ady = ay - dy;
+    double bdy = by - dy;
+    double cdy = cy - dy;
+
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double alift = adx * adx + ady * ady;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double blift = bdx * bdx + bdy * bdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+    double clift = cdx * cdx + cdy * cdy;
+
+    double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) +
+                 clift * (adxbdy - bdxady);
+    double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                       (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                       (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+    double bound = INCIRCLE_ERROR_BOUND * permanent;
+    if(det > bound || -det > bound) return det;
+    return incircle_exact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+inline double incircle(const Point2 &a, const Point2 &b, const Point2 &c, const Point2 &d)
+{
+    return incircle(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y);
+}
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,102 @@
+#include "geometry/quaternion.hpp"
+
+namespace cg
+{
+
+Quaternion::Quaternion(const Matrix4x4 &m)
+{
+    // Use the largest of w, x, y, z to compute the divisor so the result is
+    // stable for any rotation angle.
+    float trace = m.m00() + m.m11() + m.m22();
+    if(trace > 0.0f)
+    {
+        float s = 2.0f * std::sqrt(trace + 1.0f);
+        w = 0.25f * s;
+        x = (m.m21() - m.m12()) / s;
+        y = (m.m02() - m.m20()) / s;
+        z = (m.m10() - m.m01()) / s;
+    }
+    else if(m.m00() > m.m11() && m.m00() > m.m22())
+    {
+        float s = 2.0f * std::sqrt(1.0f + m.m00() - m.m11() - m.m22());
+        w = (m.m21() - m.m12()) / s;
+        x = 0.25f * s;
+        y = (m.m01() + m.m10()) / s;
+        z = (m.m02() + m.m20()) / s;
+    }
+    else if(m.m11() > m.m22())
+    {
+        float s = 2.0f * std::sqrt(1.0f + m.m11() - m.m00() - m.m22());
+        w = (m.m02() - m.m20()) / s;
+        x = (m.m01() + m.m10()) / s;
+        y = 0.25f * s;
+        z = (m.m12() + m.m21()) / s;
+    }
+    else
+    {
+        float s = 2.0f * std::sqrt(1.0f + m.m22() - m.m00() - m.m11());
+        w = (m.m10() - m.m01()) / s;
+        x = (m.m02() + m.m20()) / s;
+        y = (m.m12() + m.m21()) / s;
+        z = 0.25f * s;
+    }
+}
+
+Quaternion Quaternion::from_axis_angle(float angle, const Vector3 &axis)
+{
+    Vector3 u = axis;
+    float   n = u.norm();
+    if(n < EPSILON) { return Quaternion(); }
+
+    float half = degrees_to_radians(angle) * 0.5f;
+    float s = std::sin(half) / n;
+    return Quaternion(u.x * s, u.y * s, u.z * s, std::cos(half));
+}
+
+Matrix4x4 Quaternion::get_matrix() const
+{
+    float xx = x * x;
+    float yy = y * y;
+    float zz = z * z;
+    float xy = x * y;
+    float xz = x * z;
+    float yz = y * z;
+    float wx = w * x;
+    float wy = w * y;
+    float wz = w * z;
+
+    Matrix4x4 m;
+    m.m00() = 1.0f - 2.0f * (yy + zz);
+    m.m01() = 2.0f * (xy - wz);
+    m.m02() = 2.0f * (xz + wy);
+    m.m10() = 2.0f * (xy + wz);
+    m.m11() = 1.0f - 2.0f * (xx + zz);
+    m.m12() = 2.0f * (yz - wx);
+    m.m20() = 2.0f * (xz - wy);
+    m.m21() = 2.0f * (yz + wx);
+    m.m22() = 1.0f - 2.0f * (xx + yy);
+    return m;
+}
+
+Quaternion slerp(const Quaternion &a, const Quaternion &b, float t)
+{
+    // Flip b if needed to take the shorter arc (q and -q are the same rotation)
+    float      d = a.dot(b);
+    Quaternion c = (d < 0.0f) ? -b : b;
+    d = std::abs(d);
+
+    // Nearly parallel: sin(theta) approaches 0, so fall back to nlerp
+    if(d > 1.0f - 0.0005f) { return nlerp(a, c, t); }
+
+    float theta = std::acos(d);
+    float inv_sin = 1.0f / std::sin(theta);
+    return a * (std::sin((1.0f - t) * theta) * inv_sin) + c * (std::sin(t * theta) * inv_sin);
+}
+
+Quaternion nlerp(const Quaternion &a, const Quaternion &b, float t)
+{
+    Quaternion c = (a.dot(b) < 0.0f) ? -b : b;
+    return (a * (1.0f - t) + c * t).normalize();
+}
+
+} // namespace cg
@@ -0,0 +1,266 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    quaternion.hpp
+//	Purpose: Quaternion class for representing 3D rotations.
+//============================================================================
+
+#ifndef __GEOMETRY_QUATERNION_HPP__
+#define __GEOMETRY_QUATERNION_HPP__
+
+#include "geometry/constants.hpp"
+#include "geometry/matrix.hpp"
+#include "geometry/simd.hpp"
+#include "geometry/vector3.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+namespace cg
+{
+
+/**
+ * Quaternion x i + y j + z k + w. Unit quaternions represent rotations; the
+ * product a * b applies rotation b first, then rotation a (same order as
+ * matrix products). Components are stored x, y, z, w so a quaternion loads
+ * into one SIMD register.
+ */
+struct Quaternion
+{
+    float x;
+    float y;
+    float z;
+    float w;
+
+    /**
+     * Default constructor. Sets the quaternion to the identity rotation.
+     */
+    constexpr Quaternion();
+
+    /**
+     * Constructor given the 4 components.
+     * @param   ix   x (i) component.
+     * @param   iy   y (j) component.
+     * @param   iz   z (k) component.
+     * @param   iw   w (scalar) component.
+     */
+    constexpr Quaternion(float ix, float iy, float iz, float iw);
+
+    /**
+     * Constructor from the rotation portion (upper 3x3) of a matrix. The
+     * upper 3x3 must be a rotation (orthonormal, no scaling).
+     * @param   m   Rotation matrix.
+     */
+    explicit Quaternion(const Matrix4x4 &m);
+
+    /**
+     * Gets a rotation about an axis.
+     * @param   angle   Angle (degrees) for the counterclockwise rotation.
+     * @param   axis    Axis of rotation (need not be unit length).
+     * @return  Returns the rotation quaternion.
+     */
+    static Quaternion from_axis_angle(float angle, const Vector3 &axis);
+
+    /**
+     * Equality operator.
+     * @param   q   Quaternion to compare to the current quaternion.
+     * @return  Returns true if all components are equal.
+     */
+    constexpr bool operator==(const Quaternion &q) const;
+
+    /**
+     * Quaternion (Hamilton) product. The result applies q first, then the
+     * current rotation.
+     * @param   q   Quaternion to right-multiply by.
+     * @return  Returns the product.
+     */
+    Quaternion operator*(const Quaternion &q) const;
+
+    /**
+     * Right-multiplies the current quaternion by q.
+     * @param   q   Quaternion to right-multiply by.
+     * @return  Returns the address of the current quaternion.
+     */
+    Quaternion &operator*=(const Quaternion &q);
+
+    /**
+     * Scales all components.
+     * @param   s   Scalar to multiply by.
+     * @return  Returns the scaled quaternion.
+     */
+    constexpr Quaternion operator*(float s) const;
+
+    /**
+     * Component-wise addition.
+     * @param   q   Quaternion to add.
+     * @return  Returns the sum.
+     */
+    constexpr Quaternion operator+(const Quaternion &q) const;
+
+    /**
+     * Negation. -q represents the same rotation as q.
+     * @return  Returns the negated quaternion.
+     */
+    constexpr Quaternion operator-() const;
+
+    /**
+     * Computes the 4D dot product with another quaternion.
+     * @param   q   Quaternion.
+     * @return  Returns the dot product.
+     */
+    constexpr float dot(const Quaternion &q) const;
+
+    /**
+     * Computes the norm (length) of the quaternion.
+     * @return  Returns the norm.
+     */
+    float norm() const;
+
+    /**
+     * Scales the quaternion to unit length (if the norm is not 0).
+     * @return  Returns the address of the current quaternion.
+     */
+    Quaternion &normalize();
+
+    /**
+     * Gets the conjugate. For a unit quaternion this is the inverse rotation.
+     * @return  Returns the conjugate.
+     */
+    constexpr Quaternion conjugate() const;
+
+    /**
+     * Gets the inverse (conjugate divided by the squared norm).
+     * @return  Returns the inverse. Returns the identity if the norm is 0.
+     */
+    constexpr Quaternion get_inverse() const;
+
+    /**
+     * Rotates a vector by the (unit) quaternion.
+     * @param   v   Vector to rotate.
+     * @return  Returns the rotated vector.
+     */
+    constexpr Vector3 rotate(const Vector3 &v) const;
+
+    /**
+     * Gets the rotation matrix for the (unit) quaternion.
+     * @return  Returns the rotation matrix.
+     */
+    Matrix4x4 get_matrix() const;
+};
+
+static_assert(std::is_trivially_copyable<Quaternion>::value,
+              "Quaternion must be trivially copyable");
+static_assert(std::is_standard_layout<Quaternion>::value, "Quaternion must be standard layout");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be 4 packed floats");
+
+/**
+ * Spherical linear interpolation between unit quaternions along the shorter
+ * arc. Constant angular velocity in t.
+ * @param   a   Rotation at t = 0.
+ * @param   b   Rotation at t = 1.
+ * @param   t   Interpolation parameter (0 to 1).
+ * @return  Returns the interpolated unit quaternion.
+ */
+Quaternion slerp(const Quaternion &a, const Quaternion &b, float t);
+
+/**
+ * Normalized linear interpolation between unit quaternions along the shorter
+ * arc. Cheaper than slerp; angular velocity is not constant but the path is
+ * the same.
+ * @param   a   Rotation at t = 0.
+ * @param   b   Rotation at t = 1.
+ * @param   t   Interpolation parameter (0 to 1).
+ * @return  Returns the interpolated unit quaternion.
+ */
+Quaternion nlerp(const Quaternion &a, const Quaternion &b, float t);
+
+constexpr Quaternion::Quaternion() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+
+constexpr Quaternion::Quaternion(float ix, float iy, float iz, float iw) :
+    x(ix),
+    y(iy),
+    z(iz),
+    w(iw)
+{
+}
+
+constexpr bool Quaternion::operator==(const Quaternion &q) const
+{
+    return (x == q.x && y == q.y && z == q.z && w == q.w);
+}
+
+inline Quaternion Quaternion::operator*(const Quaternion &q) const
+{
+    Quaternion r;
+#if defined(CG_SIMD_SSE)
+    _mm_storeu_ps(&r.x, simd::quaternion_multiply(_mm_loadu_ps(&x), _mm_loadu_ps(&q.x)));
+#else
+    r.x = w * q.x + x * q.w + y * q.z - z * q.y;
+    r.y = w * q.y - x * q.z + y * q.w + z * q.x;
+    r.z = w * q.z + x * q.y - y * q.x + z * q.w;
+    r.w = w * q.w - x * q.x - y * q.y - z * q.z;
+#endif
+    return r;
+}
+
+inline Quaternion &Quaternion::operator*=(const Quaternion &q)
+{
+    *this = *this * q;
+    return *this;
+}
+
+constexpr Quaternion Quaternion::operator*(float s) const
+{
+    return Quaternion(x * s, y * s, z * s, w * s);
+}
+
+constexpr Quaternion Quaternion::operator+(const Quaternion &q) const
+{
+    return Quaternion(x + q.x, y + q.y, z + q.z, w + q.w);
+}
+
+constexpr Quaternion Quaternion::operator-() const { return Quaternion(-x, -y, -z, -w); }
+
+constexpr float Quaternion::dot(const Quaternion &q) const
+{
+    return (x * q.x + y * q.y + z * q.z + w * q.w);
+}
+
+inline float Quaternion::norm() const { return std::sqrt(dot(*this)); }
+
+inline Quaternion &Quaternion::normalize()
+{
+    float n = norm();
+    if(n > EPSILON && n != 1.0f)
+    {
+        float inv = 1.0f / n;
+        x *= inv;
+        y *= inv;
+        z *= inv;
+        w *= inv;
+    }
+    return *this;
+}
+
+constexpr Quaternion Quaternion::conjugate() const { return Quaternion(-x, -y, -z, w); }
+
+constexpr Quaternion Quaternion::get_inverse() const
+{
+    float n = dot(*this);
+    return (n != 0.0f) ? conjugate() * (1.0f / n) : Quaternion();
+}
+
+constexpr Vector3 Quaternion::rotate(const Vector3 &v) const
+{
+    // v' = v + 2w (q x v) + 2 q x (q x v), where q is the vector part
+    Vector3 q(x, y, z);
+    Vector3 t = q.cross(v) * 2.0f;
+    return v + t * w + q.cross(t);
+}
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,140 @@
+#include "geometry/random.hpp"
+
+#include "geometry/simd.hpp"
+
+#include <atomic>
+
+namespace cg
+{
+
+namespace
+{
+
+// splitmix64, used to expand a 64-bit seed into generator state
+uint64_t splitmix64(uint64_t &x)
+{
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Number of floats generated at a time by the rejection samplers
+constexpr size_t SAMPLE_BLOCK = 256;
+
+// Next stream index handed out to a thread's generator
+std::atomic<uint64_t> g_next_thread_stream{0};
+
+} // namespace
+
+Random::Random(uint64_t seed, uint64_t stream) { this->seed(seed, stream); }
+
+void Random::seed(uint64_t seed, uint64_t stream)
+{
+    // Mix the stream into the seed so nearby (seed, stream) pairs give
+    // unrelated states. splitmix64 never yields an all zero state here.
+    uint64_t x = seed ^ splitmix64(stream);
+    uint64_t a = splitmix64(x);
+    uint64_t b = splitmix64(x);
+    s_[0] = static_cast<uint32_t>(a);
+    s_[1] = static_cast<uint32_t>(a >> 32);
+    s_[2] = static_cast<uint32_t>(b);
+    s_[3] = static_cast<uint32_t>(b >> 32);
+    if((s_[0] | s_[1] | s_[2] | s_[3]) == 0) s_[0] = 1;
+}
+
+void Random::fill_uniform(float *dst, size_t count)
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    if(count >= 16)
+    {
+        // Four xoshiro128+ generators, one per lane, seeded from this one
+        uint32_t lanes[4][4];
+        for(uint32_t lane = 0; lane < 4; lane++)
+        {
+            // Separate statements so the high word is always the first draw
+            uint32_t hi = next_u32();
+            uint32_t lo = next_u32();
+            uint64_t x = (static_cast<uint64_t>(hi) << 32) | lo;
+            uint64_t a = splitmix64(x);
+            uint64_t b = splitmix64(x);
+            lanes[0][lane] = static_cast<uint32_t>(a) | 1; // never all zero
+            lanes[1][lane] = static_cast<uint32_t>(a >> 32);
+            lanes[2][lane] = static_cast<uint32_t>(b);
+            lanes[3][lane] = static_cast<uint32_t>(b >> 32);
+        }
+        __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes[0]));
+        __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes[1]));
+        __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes[2]));
+        __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes[3]));
+        const __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i result = _mm_add_epi32(s0, s3);
+            __m128i t = _mm_slli_epi32(s1, 9);
+            s2 = _mm_xor_si128(s2, s0);
+            s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2);
+            s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+            __m128 f = _mm_cvtepi32_ps(_mm_srli_epi32(result, 8));
+            _mm_storeu_ps(dst + i, _mm_mul_ps(f, scale));
+        }
+    }
+#endif
+    for(; i < count; i++) dst[i] = next_float();
+}
+
+void Random::fill_uniform(std::vector<float> &dst) { fill_uniform(dst.data(), dst.size()); }
+
+void Random::fill_in_disk(Point2 *dst, size_t count, const Point2 &center, float radius)
+{
+    // Rejection sampling from the enclosing square (accepts ~79%)
+    float  block[SAMPLE_BLOCK];
+    size_t n = 0;
+    while(n < count)
+    {
+        fill_uniform(block, SAMPLE_BLOCK);
+        for(size_t j = 0; j + 2 <= SAMPLE_BLOCK && n < count; j += 2)
+        {
+            float x = 2.0f * block[j] - 1.0f;
+            float y = 2.0f * block[j + 1] - 1.0f;
+            // Always write and only advance on accept: avoids a branch that
+            // mispredicts about 1 in 5 times
+            dst[n] = Point2(center.x + x * radius, center.y + y * radius);
+            n += (x * x + y * y <= 1.0f) ? 1 : 0;
+        }
+    }
+}
+
+void Random::fill_in_sphere(Point3 *dst, size_t count, const Point3 &center, float radius)
+{
+    // Rejection sampling from the enclosing cube (accepts ~52%)
+    float  block[SAMPLE_BLOCK - SAMPLE_BLOCK % 3];
+    size_t n = 0;
+    while(n < count)
+    {
+        fill_uniform(block, sizeof(block) / sizeof(float));
+        for(size_t j = 0; j + 3 <= sizeof(block) / sizeof(float) && n < count; j += 3)
+        {
+            float x = 2.0f * block[j] - 1.0f;
+            float y = 2.0f * block[j + 1] - 1.0f;
+            float z = 2.0f * block[j + 2] - 1.0f;
+            // Always write and only advance on accept (see fill_in_disk)
+            dst[n] = Point3(center.x + x * radius, center.y + y * radius, center.z + z * radius);
+            n += (x * x + y * y + z * z <= 1.0f) ? 1 : 0;
+        }
+    }
+}
+
+Random &thread_random()
+{
+    thread_local Random generator(Random::DEFAULT_SEED, g_next_thread_stream++);
+    return generator;
+}
+
+void seed_thread_random(uint64_t seed, uint64_t stream) { thread_random().seed(seed, stream); }
+
+} // namespace cg
@@ -0,0 +1,162 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    random.hpp
+//	Purpose: Fast, seedable pseudo-random number generator (xoshiro128+)
+//           with a per-thread instance and batch sampling helpers.
+//============================================================================
+
+#ifndef __GEOMETRY_RANDOM_HPP__
+#define __GEOMETRY_RANDOM_HPP__
+
+#include "geometry/point2.hpp"
+#include "geometry/point3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * xoshiro128+ pseudo-random number generator. 16 bytes of state, period
+ * 2^128 - 1, and a few integer operations per number. Not cryptographic.
+ * A generator is not thread-safe: give each thread (or each task) its own
+ * instance, e.g. thread_random() or Random(seed, task_index). The same seed
+ * and stream always produce the same sequence, so parallel work is
+ * reproducible when each task's stream comes from its task index rather than
+ * from the thread that happens to run it.
+ */
+class Random
+{
+  public:
+    // Seed used by default constructed generators
+    static constexpr uint64_t DEFAULT_SEED = 0x853c49e6748fea9bULL;
+
+    /**
+     * Constructor.
+     * @param  seed    Seed value.
+     * @param  stream  Stream index. Generators with the same seed and
+     *                 different streams produce independent sequences
+     *                 (use the thread or task index).
+     */
+    explicit Random(uint64_t seed = DEFAULT_SEED, uint64_t stream = 0);
+
+    /**
+     * Re-seeds the generator.
+     * @param  seed    Seed value.
+     * @param  stream  Stream index.
+     */
+    void seed(uint64_t seed, uint64_t stream = 0);
+
+    /**
+     * Gets the next 32 random bits.
+     * @return  Returns a uniformly distributed 32-bit value.
+     */
+    uint32_t next_u32();
+
+    /**
+     * Gets a random number in [0, 1).
+     * @return  Returns a uniformly distributed float with 24 random bits.
+     */
+    float next_float();
+
+    /**
+     * Gets a random number in [lo, hi).
+     * @param  lo  Lower bound.
+     * @param  hi  Upper bound.
+     * @return  Returns a uniformly distributed float.
+     */
+    float uniform(float lo, float hi);
+
+    /**
+     * Fills an array with random numbers in [0, 1). Large fills use 4
+     * generator lanes seeded from this generator (SSE), so the values differ
+     * from calling next_float() count times but are deterministic per seed.
+     * @param  dst    Destination.
+     * @param  count  Number of values.
+     */
+    void fill_uniform(float *dst, size_t count);
+
+    /**
+     * Fills a list with random numbers in [0, 1).
+     * @param  dst  Destination. All elements are overwritten.
+     */
+    void fill_uniform(std::vector<float> &dst);
+
+    /**
+     * Fills an array with points uniformly distributed in a disk.
+     * @param  dst     Destination.
+     * @param  count   Number of points.
+     * @param  center  Center of the disk.
+     * @param  radius  Radius of the disk.
+     */
+    void fill_in_disk(Point2       *dst,
+                      size_t        count,
+                      const Point2 &center = Point2(0.0f, 0.0f),
+                      float         radius = 1.0f);
+
+    /**
+     * Fills an array with points uniformly distributed in a sphere (ball).
+     * @param  dst     Destination.
+     * @param  count   Number of points.
+     * @param  center  Center of the sphere.
+     * @param  radius  Radius of the sphere.
+     */
+    void fill_in_sphere(Point3       *dst,
+                        size_t        count,
+                        const Point3 &center = Point3(0.0f, 0.0f, 0.0f),
+                        float         radius = 1.0f);
+
+  private:
+    uint32_t s_[4];
+};
+
+/**
+ * Gets the calling thread's generator. Each thread's generator is created on
+ * first use with Random::DEFAULT_SEED and a stream index assigned in order of
+ * first use. That order depends on thread scheduling, so only a program that
+ * draws from a single thread is reproducible without seeding. Work split
+ * across threads must seed from its own task index to be reproducible: call
+ * seed_thread_random(seed, task_index) at the start of each task, or use a
+ * local Random(seed, task_index).
+ * @return  Returns the generator owned by the calling thread.
+ */
+Random &thread_random();
+
+/**
+ * Re-seeds the calling thread's generator.
+ * @param  seed    Seed value.
+ * @param  stream  Stream index.
+ */
+void seed_thread_random(uint64_t seed, uint64_t stream = 0);
+
+inline uint32_t Random::next_u32()
+{
+    uint32_t result = s_[0] + s_[3];
+    uint32_t t = s_[1] << 9;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = (s_[3] << 11) | (s_[3] >> 21);
+    return result;
+}
+
+inline float Random::next_float()
+{
+    // The upper 24 bits are the best quality bits of xoshiro128+ and convert
+    // to float exactly
+    return static_cast<float>(next_u32() >> 8) * (1.0f / 16777216.0f);
+}
+
+inline float Random::uniform(float lo, float hi) { return lo + (hi - lo) * next_float(); }
+
+} // namespace cg
+
+#endif
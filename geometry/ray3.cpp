@@ -3,10 +3,49 @@
 #include "geometry/geometry.hpp"
 
 #include <cmath>
+#include <limits>
 
 namespace cg
 {
 
+namespace
+{
+
+inline const Point3 &vertex_position(const Point3 &v) { return v; }
+
+inline const Point3 &vertex_position(const VertexAndNormal &v) { return v.vertex; }
+
+// Linear scan over every triangle of a mesh. Keeps the nearest intersection
+// closer than t_min, or stops at the first one when any_hit is set.
+template <typename Vertex, typename Index>
+RayMeshIntersectResult intersect_mesh(const Ray3        &ray,
+                                      Span<const Vertex> vertex_list,
+                                      Span<const Index>  face_list,
+                                      float              t_min,
+                                      bool               any_hit)
+{
+    RayMeshIntersectResult result{false, t_min, 0.0f, 0.0f, 0};
+    size_t                 triangles = face_list.size() / 3;
+    for(size_t i = 0; i < triangles; i++)
+    {
+        const Point3 &v0 = vertex_position(vertex_list[face_list[3 * i]]);
+        const Point3 &v1 = vertex_position(vertex_list[face_list[3 * i + 1]]);
+        const Point3 &v2 = vertex_position(vertex_list[face_list[3 * i + 2]]);
+
+        RayTriangleIntersectResult hit = ray.intersect(v0, v1, v2);
+        if(hit.intersects && hit.distance < result.distance)
+        {
+            result = {true, hit.distance, hit.barycentric_u, hit.barycentric_v,
+                      static_cast<uint32_t>(i)};
+            if(any_hit) break;
+        }
+    }
+    if(!result.intersects) result.distance = 0.0f;
+    return result;
+}
+
+} // namespace
+
 Ray3::Ray3() : o{0.0f, 0.0f, 0.0f}, d{1.0f, 0.0f, 0.0f} {}
 
 Ray3::Ray3(const Point3 &p1, const Point3 &p2, bool normalize)
@@ -48,14 +87,47 @@ RayObjectIntersectResult Ray3::intersect(const Plane &p) const
 }
 RayObjectIntersectResult Ray3::intersect(const BoundingSphere &sphere) const
 {
-    // Student to define - Module 5
-    return {false, 0.0f};
+    // Distance along the ray to the point closest to the center (tca) and
+    // the squared distance from the center to the ray (d2)
+    Vector3 l = sphere.center - o;
+    float   tca = l.dot(d);
+    float   d2 = l.dot(l) - tca * tca;
+    float   r2 = sphere.radius * sphere.radius;
+    if(d2 > r2) { return {false, 0.0f}; }
+
+    // Entry and exit distances. If the origin is inside use the exit.
+    float thc = std::sqrt(r2 - d2);
+    float t0 = tca - thc;
+    float t1 = tca + thc;
+    if(t1 < 0.0f) { return {false, 0.0f}; }
+    return {true, (t0 >= 0.0f) ? t0 : t1};
 }
 
 RayObjectIntersectResult Ray3::intersect(const AABB &box) const
 {
-    // Required in 605.767
-    return {false, 0.0f};
+    // Slab method: intersect the parameter ranges between each pair of
+    // planes. A zero direction component gives infinite (or NaN, which the
+    // comparisons ignore) plane distances.
+    const float *o3 = &o.x;
+    const float *d3 = &d.x;
+    const float *lo = &box.min_corner.x;
+    const float *hi = &box.max_corner.x;
+    float        t_near = -std::numeric_limits<float>::infinity();
+    float        t_far = std::numeric_limits<float>::infinity();
+    for(int32_t k = 0; k < 3; k++)
+    {
+        float inv_d = 1.0f / d3[k];
+        float t0 = (lo[k] - o3[k]) * inv_d;
+        float t1 = (hi[k] - o3[k]) * inv_d;
+        float t_enter = (t0 > t1) ? t1 : t0;
+        float t_exit = (t0 > t1) ? t0 : t1;
+        if(t_enter > t_near) t_near = t_enter;
+        if(t_exit < t_far) t_far = t_exit;
+    }
+
+    // If the origin is inside use the exit
+    if(t_near > t_far || t_far < 0.0f) { return {false, 0.0f}; }
+    return {true, (t_near >= 0.0f) ? t_near : t_far};
 }
 
 RayObjectIntersectResult Ray3::intersect(const std::vector<Point3> &polygon,
@@ -68,38 +140,96 @@ RayObjectIntersectResult Ray3::intersect(const std::vector<Point3> &polygon,
 RayTriangleIntersectResult
     Ray3::intersect(const Point3 &v0, const Point3 &v1, const Point3 &v2) const
 {
-    // Required in 605.767
-    return {false, 0.0f, 0.0f, 0.0f};
+    // Moller-Trumbore: solve o + t d = v0 + u e1 + v e2 with Cramer's rule
+    Vector3 e1 = v1 - v0;
+    Vector3 e2 = v2 - v0;
+    Vector3 p = d.cross(e2);
+    float   det = e1.dot(p);
+    if(det == 0.0f) { return {false, 0.0f, 0.0f, 0.0f}; }
+
+    float   inv_det = 1.0f / det;
+    Vector3 s = o - v0;
+    float   u = s.dot(p) * inv_det;
+    if(u < 0.0f || u > 1.0f) { return {false, 0.0f, 0.0f, 0.0f}; }
+
+    Vector3 q = s.cross(e1);
+    float   v = d.dot(q) * inv_det;
+    if(v < 0.0f || u + v > 1.0f) { return {false, 0.0f, 0.0f, 0.0f}; }
+
+    float t = e2.dot(q) * inv_det;
+    if(t <= EPSILON) { return {false, 0.0f, 0.0f, 0.0f}; }
+    return {true, t, u, v};
 }
 
 bool Ray3::does_intersect_exist(const Point3 &v0, const Point3 &v1, const Point3 &v2) const
 {
-    // Required in 605.767
-    return false;
+    return intersect(v0, v1, v2).intersects;
 }
 
-RayMeshIntersectResult Ray3::intersect(const std::vector<Point3>   &vertex_list,
-                                       const std::vector<uint16_t> &face_list,
-                                       float                        t_min) const
+RayMeshIntersectResult Ray3::intersect(Span<const Point3>   vertex_list,
+                                       Span<const uint16_t> face_list,
+                                       float                t_min) const
 {
-    // Required in 605.767
-    return {false, 0.0f, 0.0f, 0.0f, 0};
+    return intersect_mesh(*this, vertex_list, face_list, t_min, false);
 }
 
-bool Ray3::does_intersect_exist(const std::vector<Point3>   &vertex_list,
-                                const std::vector<uint16_t> &face_list,
-                                float                        t_min) const
+RayMeshIntersectResult Ray3::intersect(Span<const Point3>   vertex_list,
+                                       Span<const uint32_t> face_list,
+                                       float                t_min) const
 {
-    // Required in 605.767
-    return false;
+    return intersect_mesh(*this, vertex_list, face_list, t_min, false);
 }
 
-bool Ray3::does_intersect_exist(const std::vector<VertexAndNormal> &vertex_list,
-                                const std::vector<uint16_t>        &face_list,
-                                float                               t_min) const
+RayMeshIntersectResult Ray3::intersect(Span<const VertexAndNormal> vertex_list,
+                                       Span<const uint16_t>        face_list,
+                                       float                       t_min) const
 {
-    // Required in 605.767
-    return false;
+    return intersect_mesh(*this, vertex_list, face_list, t_min, false);
+}
+
+RayMeshIntersectResult Ray3::intersect(Span<const VertexAndNormal> vertex_list,
+                                       Span<const uint32_t>        face_list,
+                                       float                       t_min) const
+{
+    return intersect_mesh(*this, vertex_list, face_list, t_min, false);
+}
+
+bool Ray3::does_intersect_exist(Span<const Point3>   vertex_list,
+                                Span<const uint16_t> face_list,
+                                float                t_min) const
+{
+    return intersect_mesh(*this, vertex_list, face_list, t_min, true).intersects;
+}
+
+bool Ray3::does_intersect_exist(Span<const Point3>   vertex_list,
+                                Span<const uint32_t> face_list,
+                                float                t_min) const
+{
+    return intersect_mesh(*this, vertex_list, face_list, t_min, true).intersects;
+}
+
+bool Ray3::does_intersect_exist(Span<const VertexAndNormal> vertex_list,
+                                Span<const uint16_t>        face_list,
+                                float                       t_min) const
+{
+    return intersect_mesh(*this, vertex_list, face_list, t_min, true).intersects;
+}
+
+bool Ray3::does_intersect_exist(Span<const VertexAndNormal> vertex_list,
+                                Span<const uint32_t>        face_list,
+                                float                       t_min) const
+{
+    return intersect_mesh(*this, vertex_list, face_list, t_min, true).intersects;
+}
+
+RayMeshIntersectResult Ray3::intersect(const MeshBVH &bvh, float t_min) const
+{
+    return bvh.intersect(*this, t_min);
+}
+
+bool Ray3::does_intersect_exist(const MeshBVH &bvh, float t_min) const
+{
+    return bvh.does_intersect_exist(*this, t_min);
 }
 
 } // namespace cg
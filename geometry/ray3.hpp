@@ -15,16 +15,19 @@
 #include "geometry/bounding_sphere.hpp"
 #include "geometry/plane.hpp"
 #include "geometry/point3.hpp"
+#include "geometry/span.hpp"
 #include "geometry/types.hpp"
 #include "geometry/vector3.hpp"
 
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 
 namespace cg
 {
 
 // Forward Declarations
+class MeshBVH;
 struct RayRefractionResult;
 struct RayObjectIntersectResult;
 struct RayTriangleIntersectResult;
@@ -154,44 +157,144 @@ struct Ray3
     /**
      * Calculates the intersect of a ray and a triangle mesh object.
      * Note that this returns the face index of the nearest intersection found as well
-     * as the barycentric coordinates of the intersection. This allows the triangle and
-     * its normal and texture coordinates to be recovered later.
+     * as the barycentric coordinates of intersection. This allows the triangle and
+     * its normal and texture coordinates to be recovered later. The lists are
+     * read in place (a std::vector converts to a Span), and no memory is
+     * allocated.
+     *
+     * Every face is tested, in linear time. These face list versions are
+     * kept for meshes that are queried only a few times, where building a
+     * MeshBVH costs more than it saves. Build a MeshBVH once for meshes that
+     * are queried repeatedly and use intersect(const MeshBVH&, float).
      * @param vertex_list Vertex list of the triangle mesh.
-     * @param face_list   Face index list.
+     * @param face_list   Face index list (3 indices per triangle).
      * @param t_min       Current minimum intersection (t) value along the ray.
      * @return Returns whether or not there is an intersection, the distance
      *         at which the intersection occurs (0.0 if no intersection),
      *         the barycentric coordinates of intersection, and the face index.
      */
-    RayMeshIntersectResult intersect(const std::vector<Point3>   &vertex_list,
-                                     const std::vector<uint16_t> &face_list,
-                                     float                        t_min) const;
+    RayMeshIntersectResult intersect(Span<const Point3>   vertex_list,
+                                     Span<const uint16_t> face_list,
+                                     float                t_min) const;
+
+    /**
+     * Calculates the intersect of a ray and a triangle mesh object with 32-bit
+     * indices (meshes with more than 65,535 vertices).
+     * @param vertex_list Vertex list of the triangle mesh.
+     * @param face_list   Face index list (3 indices per triangle).
+     * @param t_min       Current minimum intersection (t) value along the ray.
+     * @return Returns whether or not there is an intersection, the distance
+     *         at which the intersection occurs (0.0 if no intersection),
+     *         the barycentric coordinates of intersection, and the face index.
+     */
+    RayMeshIntersectResult intersect(Span<const Point3>   vertex_list,
+                                     Span<const uint32_t> face_list,
+                                     float                t_min) const;
+
+    /**
+     * Calculates the intersect of a ray and a triangle mesh object.
+     * @param vertex_list Vertex list of the triangle mesh.
+     * @param face_list   Face index list (3 indices per triangle).
+     * @param t_min       Current minimum intersection (t) value along the ray.
+     * @return Returns whether or not there is an intersection, the distance
+     *         at which the intersection occurs (0.0 if no intersection),
+     *         the barycentric coordinates of intersection, and the face index.
+     */
+    RayMeshIntersectResult intersect(Span<const VertexAndNormal> vertex_list,
+                                     Span<const uint16_t>        face_list,
+                                     float                       t_min) const;
+
+    /**
+     * Calculates the intersect of a ray and a triangle mesh object with 32-bit
+     * indices (meshes with more than 65,535 vertices).
+     * @param vertex_list Vertex list of the triangle mesh.
+     * @param face_list   Face index list (3 indices per triangle).
+     * @param t_min       Current minimum intersection (t) value along the ray.
+     * @return Returns whether or not there is an intersection, the distance
+     *         at which the intersection occurs (0.0 if no intersection),
+     *         the barycentric coordinates of intersection, and the face index.
+     */
+    RayMeshIntersectResult intersect(Span<const VertexAndNormal> vertex_list,
+                                     Span<const uint32_t>        face_list,
+                                     float                       t_min) const;
 
     /**
      * Does an intersection exist between ray and a triangle mesh. The intersection
      * must occur prior to t_min (intersection value t between 0 and t_min).
+     * Every face is tested (see intersect); use the MeshBVH version for
+     * meshes that are queried repeatedly.
+     * @param vertex_list Vertex list of the triangle mesh.
+     * @param face_list   Face index list (3 indices per triangle).
+     * @param t_min       t value for intersection.
+     * @return Returns true if an intersection exists, false if not.
+     */
+    bool does_intersect_exist(Span<const Point3>   vertex_list,
+                              Span<const uint16_t> face_list,
+                              float                t_min) const;
+
+    /**
+     * Does an intersection exist between ray and a triangle mesh with 32-bit
+     * indices. The intersection must occur prior to t_min.
      * @param vertex_list Vertex list of the triangle mesh.
-     * @param face_list   Face index list.
+     * @param face_list   Face index list (3 indices per triangle).
      * @param t_min       t value for intersection.
      * @return Returns true if an intersection exists, false if not.
      */
-    bool does_intersect_exist(const std::vector<Point3>   &vertex_list,
-                              const std::vector<uint16_t> &face_list,
-                              float                        t_min) const;
+    bool does_intersect_exist(Span<const Point3>   vertex_list,
+                              Span<const uint32_t> face_list,
+                              float                t_min) const;
 
     /**
      * Does an intersection exist between ray and a triangle mesh. The intersection
      * must occur prior to t_min (intersection value t between 0 and t_min).
      * @param vertex_list Vertex list of the triangle mesh.
-     * @param face_list   Face index list.
+     * @param face_list   Face index list (3 indices per triangle).
+     * @param t_min       t value for intersection.
+     * @return Returns true if an intersection exists, false if not.
+     */
+    bool does_intersect_exist(Span<const VertexAndNormal> vertex_list,
+                              Span<const uint16_t>        face_list,
+                              float                       t_min) const;
+
+    /**
+     * Does an intersection exist between ray and a triangle mesh with 32-bit
+     * indices. The intersection must occur prior to t_min.
+     * @param vertex_list Vertex list of the triangle mesh.
+     * @param face_list   Face index list (3 indices per triangle).
      * @param t_min       t value for intersection.
      * @return Returns true if an intersection exists, false if not.
      */
-    bool does_intersect_exist(const std::vector<VertexAndNormal> &vertex_list,
-                              const std::vector<uint16_t>        &face_list,
-                              float                               t_min) const;
+    bool does_intersect_exist(Span<const VertexAndNormal> vertex_list,
+                              Span<const uint32_t>        face_list,
+                              float                       t_min) const;
+
+    /**
+     * Calculates the intersect of a ray and a triangle mesh using the mesh's
+     * bounding volume hierarchy. Same result as the face list version, in
+     * logarithmic rather than linear time.
+     * @param bvh    Bounding volume hierarchy of the triangle mesh.
+     * @param t_min  Current minimum intersection (t) value along the ray.
+     * @return Returns whether or not there is an intersection, the distance
+     *         at which the intersection occurs (0.0 if no intersection),
+     *         the barycentric coordinates of intersection, and the face index.
+     */
+    RayMeshIntersectResult intersect(const MeshBVH &bvh, float t_min) const;
+
+    /**
+     * Does an intersection exist between ray and a triangle mesh, using the
+     * mesh's bounding volume hierarchy. The intersection must occur prior to
+     * t_min (intersection value t between 0 and t_min).
+     * @param bvh    Bounding volume hierarchy of the triangle mesh.
+     * @param t_min  t value for intersection.
+     * @return Returns true if an intersection exists, false if not.
+     */
+    bool does_intersect_exist(const MeshBVH &bvh, float t_min) const;
 };
 
+static_assert(std::is_trivially_copyable<Ray3>::value, "Ray3 must be trivially copyable");
+static_assert(std::is_standard_layout<Ray3>::value, "Ray3 must be standard layout");
+static_assert(sizeof(Ray3) == 6 * sizeof(float), "Ray3 must be 6 packed floats");
+
 struct RayRefractionResult
 {
     Ray3 refracted_ray;
@@ -0,0 +1,355 @@
+#include "geometry/ray_packet.hpp"
+
+#include "geometry/constants.hpp"
+#include "geometry/simd.hpp"
+
+#include <limits>
+
+namespace cg
+{
+
+namespace
+{
+
+#if defined(CG_SIMD_SSE)
+// Lane operations used by the packet kernels. Comparisons are ordered (false
+// when either operand is NaN) like the scalar operators, and min/max return
+// the second operand unless the first is strictly smaller/larger, like the
+// scalar ternaries in Ray3.
+struct Lanes4
+{
+    using V = __m128;
+
+    static V load(const float *p) { return _mm_load_ps(p); }
+    static void store(float *p, V a) { _mm_storeu_ps(p, a); }
+    static V set1(float s) { return _mm_set1_ps(s); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V min(V a, V b) { return _mm_min_ps(a, b); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+    static V lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V le(V a, V b) { return _mm_cmple_ps(a, b); }
+    static V gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+    static V ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static V eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+    static V bit_or(V a, V b) { return _mm_or_ps(a, b); }
+    static V select(V m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static uint32_t mask(V m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+};
+
+#if defined(CG_SIMD_AVX)
+struct Lanes8
+{
+    using V = __m256;
+
+    static V load(const float *p) { return _mm256_load_ps(p); }
+    static void store(float *p, V a) { _mm256_storeu_ps(p, a); }
+    static V set1(float s) { return _mm256_set1_ps(s); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static V lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V le(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static V gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static V ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static V eq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static V bit_or(V a, V b) { return _mm256_or_ps(a, b); }
+    static V select(V m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+    static uint32_t mask(V m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+};
+#else
+// 8 lanes as a pair of SSE registers
+struct Lanes8
+{
+    struct V
+    {
+        __m128 lo, hi;
+    };
+
+    static V load(const float *p) { return {_mm_load_ps(p), _mm_load_ps(p + 4)}; }
+    static void store(float *p, V a)
+    {
+        _mm_storeu_ps(p, a.lo);
+        _mm_storeu_ps(p + 4, a.hi);
+    }
+    static V set1(float s) { return {_mm_set1_ps(s), _mm_set1_ps(s)}; }
+    static V add(V a, V b) { return {Lanes4::add(a.lo, b.lo), Lanes4::add(a.hi, b.hi)}; }
+    static V sub(V a, V b) { return {Lanes4::sub(a.lo, b.lo), Lanes4::sub(a.hi, b.hi)}; }
+    static V mul(V a, V b) { return {Lanes4::mul(a.lo, b.lo), Lanes4::mul(a.hi, b.hi)}; }
+    static V div(V a, V b) { return {Lanes4::div(a.lo, b.lo), Lanes4::div(a.hi, b.hi)}; }
+    static V min(V a, V b) { return {Lanes4::min(a.lo, b.lo), Lanes4::min(a.hi, b.hi)}; }
+    static V max(V a, V b) { return {Lanes4::max(a.lo, b.lo), Lanes4::max(a.hi, b.hi)}; }
+    static V sqrt(V a) { return {Lanes4::sqrt(a.lo), Lanes4::sqrt(a.hi)}; }
+    static V lt(V a, V b) { return {Lanes4::lt(a.lo, b.lo), Lanes4::lt(a.hi, b.hi)}; }
+    static V le(V a, V b) { return {Lanes4::le(a.lo, b.lo), Lanes4::le(a.hi, b.hi)}; }
+    static V gt(V a, V b) { return {Lanes4::gt(a.lo, b.lo), Lanes4::gt(a.hi, b.hi)}; }
+    static V ge(V a, V b) { return {Lanes4::ge(a.lo, b.lo), Lanes4::ge(a.hi, b.hi)}; }
+    static V eq(V a, V b) { return {Lanes4::eq(a.lo, b.lo), Lanes4::eq(a.hi, b.hi)}; }
+    static V bit_or(V a, V b) { return {Lanes4::bit_or(a.lo, b.lo), Lanes4::bit_or(a.hi, b.hi)}; }
+    static V select(V m, V a, V b)
+    {
+        return {Lanes4::select(m.lo, a.lo, b.lo), Lanes4::select(m.hi, a.hi, b.hi)};
+    }
+    static uint32_t mask(V m) { return Lanes4::mask(m.lo) | (Lanes4::mask(m.hi) << 4); }
+};
+#endif
+
+template <uint32_t N>
+struct LanesFor;
+template <>
+struct LanesFor<4>
+{
+    using Type = Lanes4;
+};
+template <>
+struct LanesFor<8>
+{
+    using Type = Lanes8;
+};
+
+// Zeroes the distances of lanes outside the hit mask
+template <uint32_t N>
+void clear_misses(uint32_t mask, float *distance)
+{
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        if((mask & (1u << lane)) == 0) distance[lane] = 0.0f;
+    }
+}
+
+// The kernels below follow the operations of the matching Ray3 tests in the
+// same order, so each lane gives the scalar result. A lane hits when it is
+// active and none of the scalar miss conditions hold.
+
+template <typename L, uint32_t N>
+RayPacketObjectIntersectResult<N> intersect_box(const Ray3Packet<N> &rays, const AABB &box)
+{
+    using V = typename L::V;
+    const float *o3[3] = {rays.ox, rays.oy, rays.oz};
+    const float *inv_d3[3] = {rays.inv_dx, rays.inv_dy, rays.inv_dz};
+    const float *lo = &box.min_corner.x;
+    const float *hi = &box.max_corner.x;
+    V            t_near = L::set1(-std::numeric_limits<float>::infinity());
+    V            t_far = L::set1(std::numeric_limits<float>::infinity());
+    for(int32_t k = 0; k < 3; k++)
+    {
+        V o = L::load(o3[k]);
+        V inv_d = L::load(inv_d3[k]);
+        V t0 = L::mul(L::sub(L::set1(lo[k]), o), inv_d);
+        V t1 = L::mul(L::sub(L::set1(hi[k]), o), inv_d);
+        t_near = L::max(L::min(t1, t0), t_near);
+        t_far = L::min(L::max(t0, t1), t_far);
+    }
+
+    RayPacketObjectIntersectResult<N> result;
+    V                                 zero = L::set1(0.0f);
+    V                                 miss = L::bit_or(L::gt(t_near, t_far), L::lt(t_far, zero));
+    result.mask = rays.active & ~L::mask(miss);
+    if(result.mask == 0) return {0, {}};
+    L::store(result.distance, L::select(L::ge(t_near, zero), t_near, t_far));
+    clear_misses<N>(result.mask, result.distance);
+    return result;
+}
+
+template <typename L, uint32_t N>
+RayPacketObjectIntersectResult<N> intersect_sphere(const Ray3Packet<N>  &rays,
+                                                   const BoundingSphere &sphere)
+{
+    using V = typename L::V;
+    V        lx = L::sub(L::set1(sphere.center.x), L::load(rays.ox));
+    V        ly = L::sub(L::set1(sphere.center.y), L::load(rays.oy));
+    V        lz = L::sub(L::set1(sphere.center.z), L::load(rays.oz));
+    V        tca = L::add(L::add(L::mul(lx, L::load(rays.dx)), L::mul(ly, L::load(rays.dy))),
+                          L::mul(lz, L::load(rays.dz)));
+    V        l2 = L::add(L::add(L::mul(lx, lx), L::mul(ly, ly)), L::mul(lz, lz));
+    V        d2 = L::sub(l2, L::mul(tca, tca));
+    V        r2 = L::set1(sphere.radius * sphere.radius);
+    uint32_t live = rays.active & ~L::mask(L::gt(d2, r2));
+    if(live == 0) return {0, {}};
+
+    RayPacketObjectIntersectResult<N> result;
+    V                                 zero = L::set1(0.0f);
+    V                                 thc = L::sqrt(L::sub(r2, d2));
+    V                                 t0 = L::sub(tca, thc);
+    V                                 t1 = L::add(tca, thc);
+    result.mask = live & ~L::mask(L::lt(t1, zero));
+    if(result.mask == 0) return {0, {}};
+    L::store(result.distance, L::select(L::ge(t0, zero), t0, t1));
+    clear_misses<N>(result.mask, result.distance);
+    return result;
+}
+
+template <typename L, uint32_t N>
+RayPacketTriangleIntersectResult<N> intersect_triangle(const Ray3Packet<N> &rays,
+                                                       const Point3        &v0,
+                                                       const Point3        &v1,
+                                                       const Point3        &v2)
+{
+    using V = typename L::V;
+    const Vector3 e1 = v1 - v0;
+    const Vector3 e2 = v2 - v0;
+    const V       e1x = L::set1(e1.x), e1y = L::set1(e1.y), e1z = L::set1(e1.z);
+    const V       e2x = L::set1(e2.x), e2y = L::set1(e2.y), e2z = L::set1(e2.z);
+    const V       zero = L::set1(0.0f);
+    const V       one = L::set1(1.0f);
+
+    // p = d x e2, det = e1 . p
+    V dx = L::load(rays.dx), dy = L::load(rays.dy), dz = L::load(rays.dz);
+    V px = L::sub(L::mul(dy, e2z), L::mul(dz, e2y));
+    V py = L::sub(L::mul(dz, e2x), L::mul(dx, e2z));
+    V pz = L::sub(L::mul(dx, e2y), L::mul(dy, e2x));
+    V det = L::add(L::add(L::mul(e1x, px), L::mul(e1y, py)), L::mul(e1z, pz));
+    uint32_t live = rays.active & ~L::mask(L::eq(det, zero));
+    if(live == 0) return {0, {}, {}, {}};
+
+    // u = (s . p) / det with s = o - v0
+    V inv_det = L::div(one, det);
+    V sx = L::sub(L::load(rays.ox), L::set1(v0.x));
+    V sy = L::sub(L::load(rays.oy), L::set1(v0.y));
+    V sz = L::sub(L::load(rays.oz), L::set1(v0.z));
+    V u = L::mul(L::add(L::add(L::mul(sx, px), L::mul(sy, py)), L::mul(sz, pz)), inv_det);
+    live &= ~L::mask(L::bit_or(L::lt(u, zero), L::gt(u, one)));
+    if(live == 0) return {0, {}, {}, {}};
+
+    // v = (d . q) / det with q = s x e1
+    V qx = L::sub(L::mul(sy, e1z), L::mul(sz, e1y));
+    V qy = L::sub(L::mul(sz, e1x), L::mul(sx, e1z));
+    V qz = L::sub(L::mul(sx, e1y), L::mul(sy, e1x));
+    V v = L::mul(L::add(L::add(L::mul(dx, qx), L::mul(dy, qy)), L::mul(dz, qz)), inv_det);
+    live &= ~L::mask(L::bit_or(L::lt(v, zero), L::gt(L::add(u, v), one)));
+    if(live == 0) return {0, {}, {}, {}};
+
+    // t = (e2 . q) / det
+    V t = L::mul(L::add(L::add(L::mul(e2x, qx), L::mul(e2y, qy)), L::mul(e2z, qz)), inv_det);
+    live &= ~L::mask(L::le(t, L::set1(EPSILON)));
+    if(live == 0) return {0, {}, {}, {}};
+
+    RayPacketTriangleIntersectResult<N> result;
+    result.mask = live;
+    L::store(result.distance, t);
+    L::store(result.barycentric_u, u);
+    L::store(result.barycentric_v, v);
+    clear_misses<N>(live, result.distance);
+    clear_misses<N>(live, result.barycentric_u);
+    clear_misses<N>(live, result.barycentric_v);
+    return result;
+}
+#endif
+
+} // namespace
+
+template <uint32_t N>
+Ray3Packet<N>::Ray3Packet()
+{
+    // Inactive lanes hold a valid ray so the kernels do no invalid arithmetic
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        set(lane, Ray3());
+    }
+    active = 0;
+}
+
+template <uint32_t N>
+Ray3Packet<N>::Ray3Packet(const Ray3 *rays, uint32_t count) : Ray3Packet()
+{
+    for(uint32_t lane = 0; lane < count && lane < N; lane++)
+    {
+        set(lane, rays[lane]);
+    }
+}
+
+template <uint32_t N>
+void Ray3Packet<N>::set(uint32_t lane, const Ray3 &ray)
+{
+    ox[lane] = ray.o.x;
+    oy[lane] = ray.o.y;
+    oz[lane] = ray.o.z;
+    dx[lane] = ray.d.x;
+    dy[lane] = ray.d.y;
+    dz[lane] = ray.d.z;
+    inv_dx[lane] = 1.0f / ray.d.x;
+    inv_dy[lane] = 1.0f / ray.d.y;
+    inv_dz[lane] = 1.0f / ray.d.z;
+    active |= 1u << lane;
+}
+
+template <uint32_t N>
+Ray3 Ray3Packet<N>::get(uint32_t lane) const
+{
+    return Ray3(Point3(ox[lane], oy[lane], oz[lane]), Vector3(dx[lane], dy[lane], dz[lane]));
+}
+
+template <uint32_t N>
+RayPacketObjectIntersectResult<N> Ray3Packet<N>::intersect(const AABB &box) const
+{
+    if(active == 0) return {0, {}};
+#if defined(CG_SIMD_SSE)
+    return intersect_box<typename LanesFor<N>::Type>(*this, box);
+#else
+    RayPacketObjectIntersectResult<N> result = {0, {}};
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        if((active & (1u << lane)) == 0) continue;
+        RayObjectIntersectResult r = get(lane).intersect(box);
+        if(!r.intersects) continue; // Missed lanes keep distance 0, as in the SIMD path
+        result.mask |= 1u << lane;
+        result.distance[lane] = r.distance;
+    }
+    return result;
+#endif
+}
+
+template <uint32_t N>
+RayPacketObjectIntersectResult<N> Ray3Packet<N>::intersect(const BoundingSphere &sphere) const
+{
+    if(active == 0) return {0, {}};
+#if defined(CG_SIMD_SSE)
+    return intersect_sphere<typename LanesFor<N>::Type>(*this, sphere);
+#else
+    RayPacketObjectIntersectResult<N> result = {0, {}};
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        if((active & (1u << lane)) == 0) continue;
+        RayObjectIntersectResult r = get(lane).intersect(sphere);
+        if(!r.intersects) continue; // Missed lanes keep distance 0, as in the SIMD path
+        result.mask |= 1u << lane;
+        result.distance[lane] = r.distance;
+    }
+    return result;
+#endif
+}
+
+template <uint32_t N>
+RayPacketTriangleIntersectResult<N>
+    Ray3Packet<N>::intersect(const Point3 &v0, const Point3 &v1, const Point3 &v2) const
+{
+    if(active == 0) return {0, {}, {}, {}};
+#if defined(CG_SIMD_SSE)
+    return intersect_triangle<typename LanesFor<N>::Type>(*this, v0, v1, v2);
+#else
+    RayPacketTriangleIntersectResult<N> result = {0, {}, {}, {}};
+    for(uint32_t lane = 0; lane < N; lane++)
+    {
+        if((active & (1u << lane)) == 0) continue;
+        RayTriangleIntersectResult r = get(lane).intersect(v0, v1, v2);
+        if(!r.intersects) continue; // Missed lanes keep zeros, as in the SIMD path
+        result.mask |= 1u << lane;
+        result.distance[lane] = r.distance;
+        result.barycentric_u[lane] = r.barycentric_u;
+        result.barycentric_v[lane] = r.barycentric_v;
+    }
+    return result;
+#endif
+}
+
+template struct Ray3Packet<4>;
+template struct Ray3Packet<8>;
+
+} // namespace cg
@@ -0,0 +1,145 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    ray_packet.hpp
+//	Purpose: Packets of 4 or 8 rays in structure-of-arrays layout with SIMD
+//           intersection tests against boxes, spheres and triangles.
+//============================================================================
+
+#ifndef __GEOMETRY_RAY_PACKET_HPP__
+#define __GEOMETRY_RAY_PACKET_HPP__
+
+#include "geometry/aabb.hpp"
+#include "geometry/bounding_sphere.hpp"
+#include "geometry/point3.hpp"
+#include "geometry/ray3.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace cg
+{
+
+/**
+ * Result of a packet test against a box or sphere. Bit i of mask is set if
+ * lane i intersects. distance is valid for the lanes in the mask and 0 for
+ * the other lanes.
+ */
+template <uint32_t N>
+struct RayPacketObjectIntersectResult
+{
+    uint32_t mask;
+    float    distance[N];
+};
+
+/**
+ * Result of a packet test against a triangle. Bit i of mask is set if lane i
+ * intersects. distance and the barycentric coordinates are valid for the
+ * lanes in the mask and 0 for the other lanes.
+ */
+template <uint32_t N>
+struct RayPacketTriangleIntersectResult
+{
+    uint32_t mask;
+    float    distance[N];
+    float    barycentric_u[N];
+    float    barycentric_v[N];
+};
+
+/**
+ * Packet of N rays (N = 4 or 8) in structure-of-arrays layout. Each test
+ * runs all lanes at once with SSE (AVX for 8 lanes when available) and gives
+ * the same per-lane results as the matching Ray3 test. Only active lanes
+ * (set bits of active) are reported as hits, and a test returns as soon as
+ * no active lane can hit. Inverse directions are stored so repeated box
+ * tests (e.g. BVH traversal) do not divide.
+ */
+template <uint32_t N>
+struct alignas(4 * N) Ray3Packet
+{
+    static_assert(N == 4 || N == 8, "Ray packets are 4 or 8 lanes wide");
+
+    // Number of lanes
+    static constexpr uint32_t WIDTH = N;
+
+    // Mask with every lane set
+    static constexpr uint32_t ALL_LANES = (1u << N) - 1;
+
+    float    ox[N], oy[N], oz[N];             // Origins
+    float    dx[N], dy[N], dz[N];             // Directions
+    float    inv_dx[N], inv_dy[N], inv_dz[N]; // 1 / direction
+    uint32_t active;                          // Active lane mask
+
+    /**
+     * Default constructor. All lanes are inactive.
+     */
+    Ray3Packet();
+
+    /**
+     * Constructor from a list of rays. Lanes 0 to count - 1 are active.
+     * @param  rays   Rays to copy.
+     * @param  count  Number of rays (at most N).
+     */
+    Ray3Packet(const Ray3 *rays, uint32_t count);
+
+    /**
+     * Sets a lane and makes it active.
+     * @param  lane  Lane index (0 to N - 1).
+     * @param  ray   Ray for the lane.
+     */
+    void set(uint32_t lane, const Ray3 &ray);
+
+    /**
+     * Gets the ray in a lane.
+     * @param  lane  Lane index (0 to N - 1).
+     * @return  Returns the ray.
+     */
+    Ray3 get(uint32_t lane) const;
+
+    /**
+     * Intersection of the rays with an axis aligned bounding box. Same
+     * per-lane results as Ray3::intersect(const AABB &).
+     * @param  box  AABB to test intersection with
+     * @return Returns the lanes that intersect and their distances.
+     */
+    RayPacketObjectIntersectResult<N> intersect(const AABB &box) const;
+
+    /**
+     * Intersection of the rays with a sphere. Same per-lane results as
+     * Ray3::intersect(const BoundingSphere &) (directions should be unit
+     * length).
+     * @param  sphere  Sphere to test intersection with
+     * @return Returns the lanes that intersect and their distances.
+     */
+    RayPacketObjectIntersectResult<N> intersect(const BoundingSphere &sphere) const;
+
+    /**
+     * Intersection of the rays with a triangle (Moller-Trumbore). Same
+     * per-lane results as Ray3::intersect(v0, v1, v2).
+     * @param   v0  Vertex of the triangle
+     * @param   v1  Vertex of the triangle
+     * @param   v2  Vertex of the triangle
+     * @return Returns the lanes that intersect, their distances and the
+     *         barycentric coordinates of intersection.
+     */
+    RayPacketTriangleIntersectResult<N>
+        intersect(const Point3 &v0, const Point3 &v1, const Point3 &v2) const;
+};
+
+using Ray3Packet4 = Ray3Packet<4>;
+using Ray3Packet8 = Ray3Packet<8>;
+
+static_assert(std::is_trivially_copyable<Ray3Packet4>::value,
+              "Ray3Packet4 must be trivially copyable");
+static_assert(std::is_trivially_copyable<Ray3Packet8>::value,
+              "Ray3Packet8 must be trivially copyable");
+
+extern template struct Ray3Packet<4>;
+extern template struct Ray3Packet<8>;
+
+} // namespace cg
+
+#endif
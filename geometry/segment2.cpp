@@ -1,7 +1,9 @@
 #include "geometry/segment2.hpp"
 
 #include "geometry/geometry.hpp"
+#include "geometry/predicates.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace cg
@@ -56,29 +58,41 @@ Segment2PointDistanceResult LineSegment2::distance(const Point2 &p) const
 
 Segment2IntersectionResult LineSegment2::intersect(const LineSegment2 &segment) const
 {
-    // Construct vectors
-    Vector2 v = b - a;
-    Vector2 w = segment.b - segment.a;
-
-    // Set 2D perpendicular vector to w
-    Vector2 wp(w.y, -w.x);
-
-    // Check if denominator will be 0 (lines are parallel)
-    float wp_dot_v = wp.dot(v);
-    if(wp_dot_v == 0.0f) { return {false, Point2()}; }
-
-    // Solve for the parameter t. Early exit if no intersect.
-    Vector2 c = segment.a - a;
-    float   t = wp.dot(c) / wp_dot_v;
-    if(t < 0.0f || t > 1.0f) { return {false, Point2()}; }
+    // The segments intersect when the end points of each are not strictly
+    // on the same side of the other. The orientation signs are exact, so
+    // nearly parallel or touching segments get consistent answers.
+    double o1 = orient2d(a, b, segment.a);
+    double o2 = orient2d(a, b, segment.b);
+
+    // Parallel (or collinear) segments do not intersect
+    if((o1 > 0.0 && o2 > 0.0) || (o1 < 0.0 && o2 < 0.0) || (o1 == 0.0 && o2 == 0.0))
+    {
+        return {false, Point2(), 0.0f};
+    }
+    double o3 = orient2d(segment.a, segment.b, a);
+    double o4 = orient2d(segment.a, segment.b, b);
+    if((o3 > 0.0 && o4 > 0.0) || (o3 < 0.0 && o4 < 0.0)) { return {false, Point2(), 0.0f}; }
 
-    // Solve for the parameter u
-    Vector2 vp(v.y, -v.x);
-    float   u = vp.dot(c) / wp_dot_v;
-    if(u < 0.0f || u > 1.0f) { return {false, Point2()}; }
+    // Solve for the parameter t. End points on the other segment are
+    // returned exactly.
+    Vector2 v = b - a;
+    float   t;
+    if(o3 == 0.0) { t = 0.0f; }
+    else if(o4 == 0.0) { t = 1.0f; }
+    else
+    {
+        // Set 2D perpendicular vector to w. The orientations give t when
+        // the denominator rounds to 0.
+        Vector2 w = segment.b - segment.a;
+        Vector2 wp(w.y, -w.x);
+        float   wp_dot_v = wp.dot(v);
+        if(wp_dot_v != 0.0f) { t = wp.dot(segment.a - a) / wp_dot_v; }
+        else { t = static_cast<float>(o3 / (o3 - o4)); }
+        t = std::min(std::max(t, 0.0f), 1.0f);
+    }
 
     // An intersect occurs. Return 'true' and the intersect point.
-    return {true, a + v * t};
+    return {true, a + v * t, t};
 }
 
 Segment2ClipResult LineSegment2::clip_to_polygon(const std::vector<Point2> &poly) const
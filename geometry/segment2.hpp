@@ -13,6 +13,7 @@
 
 #include "geometry/point2.hpp"
 
+#include <type_traits>
 #include <vector>
 
 namespace cg
@@ -31,6 +32,11 @@ struct CRectangle
     float top;
 };
 
+static_assert(std::is_trivially_copyable<CRectangle>::value,
+              "CRectangle must be trivially copyable");
+static_assert(std::is_standard_layout<CRectangle>::value, "CRectangle must be standard layout");
+static_assert(sizeof(CRectangle) == 4 * sizeof(float), "CRectangle must be 4 packed floats");
+
 /**
  * Line segment in 2D. Data members are the 2 endpoints of the segment: a and b.
  */
@@ -64,10 +70,12 @@ struct LineSegment2
      * Determines if the current segment intersects the specified segment.
      * If an intersect occurs the intersect_pt is determined.  Note: the
      * case where the lines overlap is not considered. Consider any parallel
-     * line segment case to be no intersect (return false).
+     * line segment case to be no intersect (return false). The decision is
+     * exact (uses the orient2d predicate), including segments that touch at
+     * an end point.
      * @param  segment        Segment to determine intersection with.
      * @return Returns true if an intersection exists (false if not),
-     *         and the intersection point;
+     *         the intersection point and its parameter along this segment.
      */
     Segment2IntersectionResult intersect(const LineSegment2 &segment) const;
 
@@ -88,6 +96,11 @@ struct LineSegment2
     Segment2ClipResult clip_to_rectangle(const CRectangle &r) const;
 };
 
+static_assert(std::is_trivially_copyable<LineSegment2>::value,
+              "LineSegment2 must be trivially copyable");
+static_assert(std::is_standard_layout<LineSegment2>::value, "LineSegment2 must be standard layout");
+static_assert(sizeof(LineSegment2) == 4 * sizeof(float), "LineSegment2 must be 4 packed floats");
+
 struct Segment2PointDistanceResult
 {
     float  distance;
@@ -98,6 +111,7 @@ struct Segment2IntersectionResult
 {
     bool   intersects;
     Point2 intersect_point;
+    float  t; // Parameter of the point along the segment (0 to 1)
 };
 
 struct Segment2ClipResult
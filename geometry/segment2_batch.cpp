@@ -0,0 +1,186 @@
+#include "geometry/segment2_batch.hpp"
+
+#include "geometry/simd.hpp"
+
+namespace cg
+{
+
+namespace
+{
+
+#if defined(CG_SIMD_SSE)
+// orient2d error bound factor for float arithmetic (eps = 2^-24), rounded up
+constexpr float FLOAT_ORIENT_ERROR_BOUND = 2.4e-7f;
+
+// Orientation determinant ux vy - uy vx of 3 points, where u and v are the
+// differences of 2 of the points to the 3rd. Sets certain to the lanes where
+// the sign is exact despite rounding (Shewchuk's filter in float).
+inline __m128 orient4(__m128 ux, __m128 uy, __m128 vx, __m128 vy, __m128 &certain)
+{
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128       l = _mm_mul_ps(ux, vy);
+    __m128       r = _mm_mul_ps(uy, vx);
+    __m128       det = _mm_sub_ps(l, r);
+    __m128       bound = _mm_mul_ps(_mm_set1_ps(FLOAT_ORIENT_ERROR_BOUND),
+                                    _mm_add_ps(_mm_and_ps(l, abs_mask), _mm_and_ps(r, abs_mask)));
+    certain = _mm_cmpgt_ps(_mm_and_ps(det, abs_mask), bound);
+    return det;
+}
+
+// Lanes where 2 orientations are certain and have the same sign (the 2
+// points are strictly on the same side of the line)
+inline int32_t same_side(__m128 det1, __m128 certain1, __m128 det2, __m128 certain2)
+{
+    return _mm_movemask_ps(_mm_and_ps(certain1, certain2)) &
+           ~_mm_movemask_ps(_mm_xor_ps(det1, det2));
+}
+#endif
+
+// Tests the query against edge i and appends a hit
+inline void intersect_edge(const LineSegment2        &query,
+                           uint32_t                   query_index,
+                           const Segment2Table       &edges,
+                           size_t                     i,
+                           std::vector<Segment2Hit> &hits)
+{
+    Segment2IntersectionResult r = query.intersect(edges.get(i));
+    if(r.intersects)
+        hits.push_back({query_index, static_cast<uint32_t>(i), r.t, r.intersect_point});
+}
+
+size_t intersect_query(const LineSegment2        &query,
+                       uint32_t                   query_index,
+                       const Segment2Table       &edges,
+                       std::vector<Segment2Hit> &hits)
+{
+    const size_t count = edges.size();
+    const size_t first_hit = hits.size();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    const __m128 qax = _mm_set1_ps(query.a.x);
+    const __m128 qay = _mm_set1_ps(query.a.y);
+    const __m128 qbx = _mm_set1_ps(query.b.x);
+    const __m128 qby = _mm_set1_ps(query.b.y);
+    const __m128 vx = _mm_sub_ps(qbx, qax);
+    const __m128 vy = _mm_sub_ps(qby, qay);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 pax = _mm_load_ps(edges.ax() + i);
+        __m128 pay = _mm_load_ps(edges.ay() + i);
+        __m128 pbx = _mm_load_ps(edges.bx() + i);
+        __m128 pby = _mm_load_ps(edges.by() + i);
+
+        // Edges with both end points certainly on the same side of the
+        // query line (the common case) are rejected first. These are
+        // orient2d(query b, edge point, query a), which has the sign of
+        // orient2d(query a, query b, edge point).
+        __m128  c1, c2;
+        __m128  o1 = orient4(vx, vy, _mm_sub_ps(pax, qax), _mm_sub_ps(pay, qay), c1);
+        __m128  o2 = orient4(vx, vy, _mm_sub_ps(pbx, qax), _mm_sub_ps(pby, qay), c2);
+        int32_t miss = same_side(o1, c1, o2, c2);
+        if(miss == 0xF) continue;
+
+        // Then query end points on the same side of the edge line:
+        // orient2d(edge b, query point, edge a)
+        __m128 wx = _mm_sub_ps(pbx, pax);
+        __m128 wy = _mm_sub_ps(pby, pay);
+        __m128 c3, c4;
+        __m128 o3 = orient4(wx, wy, _mm_sub_ps(qax, pax), _mm_sub_ps(qay, pay), c3);
+        __m128 o4 = orient4(wx, wy, _mm_sub_ps(qbx, pax), _mm_sub_ps(qby, pay), c4);
+        miss |= same_side(o3, c3, o4, c4);
+        if(miss == 0xF) continue;
+
+        // Exact test of the remaining edges
+        for(int32_t lane = 0; lane < 4; lane++)
+        {
+            if((miss & (1 << lane)) == 0) intersect_edge(query, query_index, edges, i + lane, hits);
+        }
+    }
+#endif
+    for(; i < count; i++) intersect_edge(query, query_index, edges, i, hits);
+    return hits.size() - first_hit;
+}
+
+} // namespace
+
+Segment2Table::Segment2Table() {}
+
+Segment2Table::Segment2Table(const std::vector<LineSegment2> &segments) { append(segments); }
+
+size_t Segment2Table::size() const { return ax_.size(); }
+
+bool Segment2Table::empty() const { return ax_.empty(); }
+
+void Segment2Table::reserve(size_t n)
+{
+    ax_.reserve(n);
+    ay_.reserve(n);
+    bx_.reserve(n);
+    by_.reserve(n);
+}
+
+void Segment2Table::clear()
+{
+    ax_.clear();
+    ay_.clear();
+    bx_.clear();
+    by_.clear();
+}
+
+void Segment2Table::push_back(const LineSegment2 &segment)
+{
+    ax_.push_back(segment.a.x);
+    ay_.push_back(segment.a.y);
+    bx_.push_back(segment.b.x);
+    by_.push_back(segment.b.y);
+}
+
+void Segment2Table::append(const std::vector<LineSegment2> &segments)
+{
+    reserve(size() + segments.size());
+    for(const auto &segment : segments) push_back(segment);
+}
+
+LineSegment2 Segment2Table::get(size_t i) const
+{
+    return LineSegment2(Point2(ax_[i], ay_[i]), Point2(bx_[i], by_[i]));
+}
+
+const float *Segment2Table::ax() const { return ax_.data(); }
+
+const float *Segment2Table::ay() const { return ay_.data(); }
+
+const float *Segment2Table::bx() const { return bx_.data(); }
+
+const float *Segment2Table::by() const { return by_.data(); }
+
+size_t intersect_segments(const LineSegment2        &query,
+                          const Segment2Table       &edges,
+                          std::vector<Segment2Hit> &hits)
+{
+    return intersect_query(query, 0, edges, hits);
+}
+
+size_t intersect_segments(const LineSegment2        *queries,
+                          size_t                     query_count,
+                          const Segment2Table       &edges,
+                          std::vector<Segment2Hit> &hits)
+{
+    size_t n = 0;
+    for(size_t q = 0; q < query_count; q++)
+        n += intersect_query(queries[q], static_cast<uint32_t>(q), edges, hits);
+    return n;
+}
+
+size_t intersect_segments(const LineSegment2        &query,
+                          const Segment2Table       &edges,
+                          const uint32_t            *indices,
+                          size_t                     count,
+                          std::vector<Segment2Hit> &hits)
+{
+    const size_t first_hit = hits.size();
+    for(size_t k = 0; k < count; k++) intersect_edge(query, 0, edges, indices[k], hits);
+    return hits.size() - first_hit;
+}
+
+} // namespace cg
@@ -0,0 +1,164 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    segment2_batch.hpp
+//	Purpose: Structure-of-arrays segment table and batch 2D segment
+//           intersection (one or many query segments against many edges).
+//============================================================================
+
+#ifndef __GEOMETRY_SEGMENT2_BATCH_HPP__
+#define __GEOMETRY_SEGMENT2_BATCH_HPP__
+
+#include "geometry/aligned_allocator.hpp"
+#include "geometry/point2.hpp"
+#include "geometry/segment2.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Intersection found by the batch segment tests.
+ */
+struct Segment2Hit
+{
+    uint32_t query_index; // Index of the query segment
+    uint32_t edge_index;  // Index of the edge in the Segment2Table
+    float    t;           // Parameter along the query segment (0 to 1)
+    Point2   point;       // Intersection point
+};
+
+static_assert(std::is_trivially_copyable<Segment2Hit>::value,
+              "Segment2Hit must be trivially copyable");
+
+/**
+ * Structure-of-arrays table of 2D line segments (edges). Each segment is
+ * stored as its end points in SIMD aligned arrays so batch tests can process
+ * 4 edges per step.
+ */
+class Segment2Table
+{
+  public:
+    /**
+     * Default constructor. Creates an empty table.
+     */
+    Segment2Table();
+
+    /**
+     * Constructor from a list of segments.
+     * @param  segments  Segments to copy.
+     */
+    explicit Segment2Table(const std::vector<LineSegment2> &segments);
+
+    /**
+     * Get the number of segments.
+     * @return  Returns the number of segments.
+     */
+    size_t size() const;
+
+    /**
+     * Test whether the table is empty.
+     * @return  Returns true if there are no segments.
+     */
+    bool empty() const;
+
+    /**
+     * Reserve storage for n segments.
+     * @param  n  Number of segments.
+     */
+    void reserve(size_t n);
+
+    /**
+     * Remove all segments.
+     */
+    void clear();
+
+    /**
+     * Append a segment.
+     * @param  segment  Segment to append.
+     */
+    void push_back(const LineSegment2 &segment);
+
+    /**
+     * Append a list of segments.
+     * @param  segments  Segments to append.
+     */
+    void append(const std::vector<LineSegment2> &segments);
+
+    /**
+     * Get a segment.
+     * @param  i  Index of the segment.
+     * @return  Returns segment i.
+     */
+    LineSegment2 get(size_t i) const;
+
+    // Start and end points (SIMD aligned)
+    const float *ax() const;
+    const float *ay() const;
+    const float *bx() const;
+    const float *by() const;
+
+  private:
+    AlignedFloatVector ax_;
+    AlignedFloatVector ay_;
+    AlignedFloatVector bx_;
+    AlignedFloatVector by_;
+};
+
+/**
+ * Intersects a query segment with every segment in a table. Produces the same
+ * results as LineSegment2::intersect called as query.intersect(edge):
+ * parallel segments do not intersect. A filter rejects 4 edges per step with
+ * float orientation tests whose rounding error is bounded; only the edges it
+ * cannot reject are tested with LineSegment2::intersect. Hits are appended in
+ * edge order with query_index set to 0.
+ * @param  query  Query segment.
+ * @param  edges  Segments to test against.
+ * @param  hits   List the hits are appended to.
+ * @return  Returns the number of hits appended.
+ */
+size_t intersect_segments(const LineSegment2        &query,
+                          const Segment2Table       &edges,
+                          std::vector<Segment2Hit> &hits);
+
+/**
+ * Intersects several query segments with every segment in a table. Hits are
+ * appended ordered by query, then by edge.
+ * @param  queries      Query segments.
+ * @param  query_count  Number of query segments.
+ * @param  edges        Segments to test against.
+ * @param  hits         List the hits are appended to.
+ * @return  Returns the number of hits appended.
+ */
+size_t intersect_segments(const LineSegment2        *queries,
+                          size_t                     query_count,
+                          const Segment2Table       &edges,
+                          std::vector<Segment2Hit> &hits);
+
+/**
+ * Intersects a query segment with a subset of the segments in a table (e.g.
+ * candidates from a spatial index). Hits are appended in the order of the
+ * index list with query_index set to 0.
+ * @param  query    Query segment.
+ * @param  edges    Segment table.
+ * @param  indices  Indices of the segments to test.
+ * @param  count    Number of indices.
+ * @param  hits     List the hits are appended to.
+ * @return  Returns the number of hits appended.
+ */
+size_t intersect_segments(const LineSegment2        &query,
+                          const Segment2Table       &edges,
+                          const uint32_t            *indices,
+                          size_t                     count,
+                          std::vector<Segment2Hit> &hits);
+
+} // namespace cg
+
+#endif
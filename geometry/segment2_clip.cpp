@@ -0,0 +1,327 @@
+#include "geometry/segment2_clip.hpp"
+
+#include "geometry/geometry.hpp"
+#include "geometry/simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cg
+{
+
+namespace
+{
+
+// Outward edge normals and start points of a convex polygon, with the
+// polygon's bounding rectangle for trivial rejects
+struct ClipPolygon
+{
+    std::vector<float> nx, ny, px, py;
+    CRectangle         bounds;
+
+    explicit ClipPolygon(const std::vector<Point2> &poly)
+    {
+        bounds = {poly[0].x, poly[0].x, poly[0].y, poly[0].y};
+        auto pt1 = poly.end() - 1;
+        for(auto pt2 = poly.begin(); pt2 != poly.end(); pt1 = pt2, pt2++)
+        {
+            // Same normal as LineSegment2::clip_to_polygon (polygon is CCW)
+            nx.push_back(pt2->y - pt1->y);
+            ny.push_back(pt1->x - pt2->x);
+            px.push_back(pt1->x);
+            py.push_back(pt1->y);
+            bounds.left = std::min(bounds.left, pt2->x);
+            bounds.right = std::max(bounds.right, pt2->x);
+            bounds.bottom = std::min(bounds.bottom, pt2->y);
+            bounds.top = std::max(bounds.top, pt2->y);
+        }
+    }
+
+    size_t size() const { return nx.size(); }
+};
+
+// Both end points outside the same side of the rectangle
+inline bool trivial_reject(const LineSegment2 &s, const CRectangle &r)
+{
+    return (s.a.x < r.left && s.b.x < r.left) || (s.a.x > r.right && s.b.x > r.right) ||
+           (s.a.y < r.bottom && s.b.y < r.bottom) || (s.a.y > r.top && s.b.y > r.top);
+}
+
+// Both end points inside the rectangle
+inline bool trivial_accept(const LineSegment2 &s, const CRectangle &r)
+{
+    return s.a.x >= r.left && s.a.x <= r.right && s.a.y >= r.bottom && s.a.y <= r.top &&
+           s.b.x >= r.left && s.b.x <= r.right && s.b.y >= r.bottom && s.b.y <= r.top;
+}
+
+// Clips the parameter interval [t_in, t_out] to the half plane p t <= q.
+// The SIMD path uses the same operations.
+inline void clip_half_plane(float p, float q, float &t_in, float &t_out, bool &rejected)
+{
+    if(p == 0.0f)
+    {
+        if(q < 0.0f) rejected = true;
+        return;
+    }
+    float t = q / p;
+    if(p < 0.0f) t_in = (t > t_in) ? t : t_in;
+    else t_out = (t < t_out) ? t : t_out;
+}
+
+// Liang-Barsky clip of a segment that is not trivially accepted or rejected.
+// Returns true if part of the segment remains, with the parameter interval.
+inline bool clip_rectangle(const LineSegment2 &s, const CRectangle &r, float &t_in, float &t_out)
+{
+    float dx = s.b.x - s.a.x;
+    float dy = s.b.y - s.a.y;
+    bool  rejected = false;
+    t_in = 0.0f;
+    t_out = 1.0f;
+    clip_half_plane(-dx, s.a.x - r.left, t_in, t_out, rejected);
+    clip_half_plane(dx, r.right - s.a.x, t_in, t_out, rejected);
+    clip_half_plane(-dy, s.a.y - r.bottom, t_in, t_out, rejected);
+    clip_half_plane(dy, r.top - s.a.y, t_in, t_out, rejected);
+    return !rejected && t_in <= t_out;
+}
+
+// Cyrus-Beck clip of a segment against a convex polygon. Returns true if
+// part of the segment remains, with the parameter interval.
+inline bool clip_polygon(const LineSegment2 &s, const ClipPolygon &poly, float &t_in, float &t_out)
+{
+    t_in = 0.0f;
+    t_out = 1.0f;
+    if(trivial_reject(s, poly.bounds)) return false;
+
+    Vector2 c = s.b - s.a;
+    for(size_t k = 0; k < poly.size(); k++)
+    {
+        float n_dot_c = poly.nx[k] * c.x + poly.ny[k] * c.y;
+        float num = poly.nx[k] * (poly.px[k] - s.a.x) + poly.ny[k] * (poly.py[k] - s.a.y);
+
+        // Parallel: inside or outside the whole edge
+        if(std::abs(n_dot_c) < EPSILON)
+        {
+            if(num < 0.0f) return false;
+            continue;
+        }
+
+        float t = num / n_dot_c;
+        if(n_dot_c > 0.0f) t_out = (t < t_out) ? t : t_out;
+        else t_in = (t > t_in) ? t : t_in;
+        if(t_in > t_out) return false;
+    }
+    return true;
+}
+
+// Appends the part of a segment between t_in and t_out. End points that are
+// not clipped are copied.
+inline void emit(const LineSegment2        &s,
+                 float                      t_in,
+                 float                      t_out,
+                 size_t                     index,
+                 std::vector<LineSegment2> &clipped,
+                 std::vector<uint32_t>     *source_indices)
+{
+    Vector2 c = s.b - s.a;
+    clipped.emplace_back(t_in > 0.0f ? s.a + c * t_in : s.a, t_out < 1.0f ? s.a + c * t_out : s.b);
+    if(source_indices != nullptr) source_indices->push_back(static_cast<uint32_t>(index));
+}
+
+#if defined(CG_SIMD_SSE)
+// Loads 4 segments and transposes them into start and end coordinates
+inline void load_segments4(const LineSegment2 *s, __m128 &ax, __m128 &ay, __m128 &bx, __m128 &by)
+{
+    ax = _mm_loadu_ps(&s[0].a.x);
+    ay = _mm_loadu_ps(&s[1].a.x);
+    bx = _mm_loadu_ps(&s[2].a.x);
+    by = _mm_loadu_ps(&s[3].a.x);
+    _MM_TRANSPOSE4_PS(ax, ay, bx, by);
+}
+
+// Lanes with both end points outside the same side of the rectangle
+inline __m128 trivial_reject4(__m128 ax, __m128 ay, __m128 bx, __m128 by, const CRectangle &r)
+{
+    __m128 left = _mm_set1_ps(r.left);
+    __m128 right = _mm_set1_ps(r.right);
+    __m128 bottom = _mm_set1_ps(r.bottom);
+    __m128 top = _mm_set1_ps(r.top);
+    __m128 x = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(ax, left), _mm_cmplt_ps(bx, left)),
+                         _mm_and_ps(_mm_cmpgt_ps(ax, right), _mm_cmpgt_ps(bx, right)));
+    __m128 y = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(ay, bottom), _mm_cmplt_ps(by, bottom)),
+                         _mm_and_ps(_mm_cmpgt_ps(ay, top), _mm_cmpgt_ps(by, top)));
+    return _mm_or_ps(x, y);
+}
+
+// Lanes with both end points inside the rectangle
+inline __m128 trivial_accept4(__m128 ax, __m128 ay, __m128 bx, __m128 by, const CRectangle &r)
+{
+    __m128 left = _mm_set1_ps(r.left);
+    __m128 right = _mm_set1_ps(r.right);
+    __m128 bottom = _mm_set1_ps(r.bottom);
+    __m128 top = _mm_set1_ps(r.top);
+    __m128 x = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(ax, left), _mm_cmple_ps(ax, right)),
+                          _mm_and_ps(_mm_cmpge_ps(bx, left), _mm_cmple_ps(bx, right)));
+    __m128 y = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(ay, bottom), _mm_cmple_ps(ay, top)),
+                          _mm_and_ps(_mm_cmpge_ps(by, bottom), _mm_cmple_ps(by, top)));
+    return _mm_and_ps(x, y);
+}
+
+inline __m128 select4(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// 4 lane version of clip_half_plane. Lanes with p = 0 divide by 0, but the
+// quotient is not used for them.
+inline void clip_half_plane4(__m128 p, __m128 q, __m128 &t_in, __m128 &t_out, __m128 &rejected)
+{
+    __m128 zero = _mm_setzero_ps();
+    __m128 t = _mm_div_ps(q, p);
+    rejected = _mm_or_ps(rejected, _mm_and_ps(_mm_cmpeq_ps(p, zero), _mm_cmplt_ps(q, zero)));
+    t_in = select4(_mm_cmplt_ps(p, zero), _mm_max_ps(t, t_in), t_in);
+    t_out = select4(_mm_cmpgt_ps(p, zero), _mm_min_ps(t, t_out), t_out);
+}
+
+inline __m128 negate4(__m128 v) { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+#endif
+
+} // namespace
+
+size_t clip_segments_to_rectangle(const LineSegment2        *segments,
+                                  size_t                     count,
+                                  const CRectangle          &r,
+                                  std::vector<LineSegment2> &clipped,
+                                  std::vector<uint32_t>     *source_indices)
+{
+    const size_t first = clipped.size();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    alignas(16) float t_in4[4];
+    alignas(16) float t_out4[4];
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 ax, ay, bx, by;
+        load_segments4(segments + i, ax, ay, bx, by);
+        int32_t accept_mask = _mm_movemask_ps(trivial_accept4(ax, ay, bx, by, r));
+        int32_t reject_mask = _mm_movemask_ps(trivial_reject4(ax, ay, bx, by, r));
+
+        // Most segments of a large layer are entirely inside or outside
+        int32_t clip_mask = ~(accept_mask | reject_mask) & 0xF;
+        if(clip_mask != 0)
+        {
+            __m128 dx = _mm_sub_ps(bx, ax);
+            __m128 dy = _mm_sub_ps(by, ay);
+            __m128 t_in = _mm_setzero_ps();
+            __m128 t_out = _mm_set1_ps(1.0f);
+            __m128 rejected = _mm_setzero_ps();
+            clip_half_plane4(negate4(dx), _mm_sub_ps(ax, _mm_set1_ps(r.left)), t_in, t_out,
+                             rejected);
+            clip_half_plane4(dx, _mm_sub_ps(_mm_set1_ps(r.right), ax), t_in, t_out, rejected);
+            clip_half_plane4(negate4(dy), _mm_sub_ps(ay, _mm_set1_ps(r.bottom)), t_in, t_out,
+                             rejected);
+            clip_half_plane4(dy, _mm_sub_ps(_mm_set1_ps(r.top), ay), t_in, t_out, rejected);
+            __m128 keep = _mm_andnot_ps(rejected, _mm_cmple_ps(t_in, t_out));
+            clip_mask &= _mm_movemask_ps(keep);
+            _mm_store_ps(t_in4, t_in);
+            _mm_store_ps(t_out4, t_out);
+        }
+        if((accept_mask | clip_mask) == 0) continue;
+
+        for(int32_t lane = 0; lane < 4; lane++)
+        {
+            const LineSegment2 &s = segments[i + lane];
+            if((accept_mask & (1 << lane)) != 0)
+            {
+                clipped.push_back(s);
+                if(source_indices != nullptr)
+                    source_indices->push_back(static_cast<uint32_t>(i + lane));
+            }
+            else if((clip_mask & (1 << lane)) != 0)
+            {
+                emit(s, t_in4[lane], t_out4[lane], i + lane, clipped, source_indices);
+            }
+        }
+    }
+#endif
+    for(; i < count; i++)
+    {
+        const LineSegment2 &s = segments[i];
+        float               t_in, t_out;
+        if(trivial_accept(s, r)) emit(s, 0.0f, 1.0f, i, clipped, source_indices);
+        else if(!trivial_reject(s, r) && clip_rectangle(s, r, t_in, t_out))
+            emit(s, t_in, t_out, i, clipped, source_indices);
+    }
+    return clipped.size() - first;
+}
+
+size_t clip_segments_to_polygon(const LineSegment2        *segments,
+                                size_t                     count,
+                                const std::vector<Point2> &poly,
+                                std::vector<LineSegment2> &clipped,
+                                std::vector<uint32_t>     *source_indices)
+{
+    if(poly.empty()) return 0;
+
+    const ClipPolygon clip_poly(poly);
+    const size_t      first = clipped.size();
+    size_t            i = 0;
+#if defined(CG_SIMD_SSE)
+    const __m128      zero = _mm_setzero_ps();
+    const __m128      epsilon = _mm_set1_ps(EPSILON);
+    const __m128      abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    alignas(16) float t_in4[4];
+    alignas(16) float t_out4[4];
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 ax, ay, bx, by;
+        load_segments4(segments + i, ax, ay, bx, by);
+        __m128 rejected = trivial_reject4(ax, ay, bx, by, clip_poly.bounds);
+        if(_mm_movemask_ps(rejected) == 0xF) continue;
+
+        __m128 cx = _mm_sub_ps(bx, ax);
+        __m128 cy = _mm_sub_ps(by, ay);
+        __m128 t_in = zero;
+        __m128 t_out = _mm_set1_ps(1.0f);
+        for(size_t k = 0; k < clip_poly.size(); k++)
+        {
+            __m128 nx = _mm_set1_ps(clip_poly.nx[k]);
+            __m128 ny = _mm_set1_ps(clip_poly.ny[k]);
+            __m128 n_dot_c = _mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy));
+            __m128 num = _mm_add_ps(_mm_mul_ps(nx, _mm_sub_ps(_mm_set1_ps(clip_poly.px[k]), ax)),
+                                    _mm_mul_ps(ny, _mm_sub_ps(_mm_set1_ps(clip_poly.py[k]), ay)));
+            __m128 parallel = _mm_cmplt_ps(_mm_and_ps(n_dot_c, abs_mask), epsilon);
+            rejected = _mm_or_ps(rejected, _mm_and_ps(parallel, _mm_cmplt_ps(num, zero)));
+
+            __m128 t = _mm_div_ps(num, n_dot_c);
+            __m128 exiting = _mm_andnot_ps(parallel, _mm_cmpgt_ps(n_dot_c, zero));
+            __m128 entering = _mm_andnot_ps(parallel, _mm_cmple_ps(n_dot_c, zero));
+            t_out = select4(exiting, _mm_min_ps(t, t_out), t_out);
+            t_in = select4(entering, _mm_max_ps(t, t_in), t_in);
+            rejected = _mm_or_ps(rejected, _mm_cmpgt_ps(t_in, t_out));
+            if(_mm_movemask_ps(rejected) == 0xF) break;
+        }
+        int32_t keep_mask = ~_mm_movemask_ps(rejected) & 0xF;
+        if(keep_mask == 0) continue;
+
+        _mm_store_ps(t_in4, t_in);
+        _mm_store_ps(t_out4, t_out);
+        for(int32_t lane = 0; lane < 4; lane++)
+        {
+            if((keep_mask & (1 << lane)) != 0)
+            {
+                emit(segments[i + lane], t_in4[lane], t_out4[lane], i + lane, clipped,
+                     source_indices);
+            }
+        }
+    }
+#endif
+    for(; i < count; i++)
+    {
+        float t_in, t_out;
+        if(clip_polygon(segments[i], clip_poly, t_in, t_out))
+            emit(segments[i], t_in, t_out, i, clipped, source_indices);
+    }
+    return clipped.size() - first;
+}
+
+} // namespace cg
@@ -0,0 +1,70 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    segment2_clip.hpp
+//	Purpose: Batch 2D segment clipping against a rectangle or a convex
+//           polygon (Liang-Barsky, 4 segments per step with SSE).
+//============================================================================
+
+#ifndef __GEOMETRY_SEGMENT2_CLIP_HPP__
+#define __GEOMETRY_SEGMENT2_CLIP_HPP__
+
+#include "geometry/point2.hpp"
+#include "geometry/segment2.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Clips a list of segments to a rectangle. Segments with both end points
+ * inside are kept as is and segments with both end points outside the same
+ * side are rejected (Cohen-Sutherland outcodes), the rest are clipped with
+ * Liang-Barsky. End points that are not clipped are copied exactly. Clipped
+ * end points can differ from LineSegment2::clip_to_rectangle in the last
+ * bits. The surviving segments are appended in input order.
+ * @param  segments        Segments to clip.
+ * @param  count           Number of segments.
+ * @param  r               Clip rectangle.
+ * @param  clipped         List the clipped segments are appended to.
+ * @param  source_indices  If not nullptr, the index of the input segment of
+ *                         each clipped segment is appended to it.
+ * @return  Returns the number of segments appended.
+ */
+size_t clip_segments_to_rectangle(const LineSegment2        *segments,
+                                  size_t                     count,
+                                  const CRectangle          &r,
+                                  std::vector<LineSegment2> &clipped,
+                                  std::vector<uint32_t>     *source_indices = nullptr);
+
+/**
+ * Clips a list of segments to a convex polygon (Cyrus-Beck form of
+ * Liang-Barsky, the same edge tests as LineSegment2::clip_to_polygon).
+ * Segments with both end points outside the same side of the polygon's
+ * bounding rectangle are rejected first. Unlike clip_to_polygon, a segment
+ * parallel to an edge and outside it is rejected. End points that are not
+ * clipped are copied exactly. The surviving segments are appended in input
+ * order.
+ * @param  segments        Segments to clip.
+ * @param  count           Number of segments.
+ * @param  poly            A counter-clockwise oriented convex polygon.
+ * @param  clipped         List the clipped segments are appended to.
+ * @param  source_indices  If not nullptr, the index of the input segment of
+ *                         each clipped segment is appended to it.
+ * @return  Returns the number of segments appended.
+ */
+size_t clip_segments_to_polygon(const LineSegment2        *segments,
+                                size_t                     count,
+                                const std::vector<Point2> &poly,
+                                std::vector<LineSegment2> &clipped,
+                                std::vector<uint32_t>     *source_indices = nullptr);
+
+} // namespace cg
+
+#endif
@@ -0,0 +1,242 @@
+#include "geometry/segment2_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cg
+{
+
+namespace
+{
+
+// Segments are binned with the part of the segment in each cell it crosses
+// grown by this fraction of a cell, so a segment touching a cell boundary is
+// in the cells on both sides and a query walking either side finds it
+constexpr float CELL_MARGIN = 1.0e-3f;
+
+// Cell coordinates are clamped to this range to keep the float to integer
+// conversion defined for far away (or non-finite) coordinates
+constexpr float CELL_LIMIT = 1.0e9f;
+
+inline int32_t cell_coord(float v)
+{
+    if(!(v > -CELL_LIMIT)) return static_cast<int32_t>(-CELL_LIMIT);
+    if(v > CELL_LIMIT) return static_cast<int32_t>(CELL_LIMIT);
+    return static_cast<int32_t>(std::floor(v));
+}
+
+inline uint64_t cell_key(int32_t ix, int32_t iy)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) | static_cast<uint32_t>(iy);
+}
+
+// Segments crossing more cells than this are not binned: they are kept in a
+// list that every query includes. Queries crossing more cells than this
+// return all segments. This bounds the work and memory for very long
+// segments (coordinates far away from the others).
+constexpr uint64_t MAX_WALK_CELLS = 1 << 16;
+
+// Number of cells the DDA walk from f to g visits (both in cell units)
+inline uint64_t walk_length(float fx, float fy, float gx, float gy)
+{
+    return static_cast<uint64_t>(std::abs(static_cast<int64_t>(cell_coord(gx)) - cell_coord(fx))) +
+           static_cast<uint64_t>(std::abs(static_cast<int64_t>(cell_coord(gy)) - cell_coord(fy))) +
+           1;
+}
+
+// DDA (Amanatides and Woo) walk over the cells a segment from f to g (in
+// cell units) crosses. Calls visit(ix, iy, t0, t1) for each cell, where
+// [t0, t1] is the parameter range of the segment inside the cell. t_max is
+// the parameter at the next vertical or horizontal cell boundary, t_delta
+// the parameter change across a cell. The walk takes exactly one step per
+// boundary crossed.
+template <typename Visit>
+void walk_cells(float fx, float fy, float gx, float gy, Visit visit)
+{
+    int32_t ix = cell_coord(fx);
+    int32_t iy = cell_coord(fy);
+    int32_t ex = cell_coord(gx);
+    int32_t ey = cell_coord(gy);
+
+    const float inf = std::numeric_limits<float>::infinity();
+    float       dx = gx - fx;
+    float       dy = gy - fy;
+    int32_t     step_x = (ex > ix) ? 1 : -1;
+    int32_t     step_y = (ey > iy) ? 1 : -1;
+    float       t_delta_x = (dx != 0.0f) ? std::abs(1.0f / dx) : inf;
+    float       t_delta_y = (dy != 0.0f) ? std::abs(1.0f / dy) : inf;
+    float       t_max_x = (dx > 0.0f)   ? (static_cast<float>(ix) + 1.0f - fx) / dx
+                          : (dx < 0.0f) ? (fx - static_cast<float>(ix)) / -dx
+                                        : inf;
+    float       t_max_y = (dy > 0.0f)   ? (static_cast<float>(iy) + 1.0f - fy) / dy
+                          : (dy < 0.0f) ? (fy - static_cast<float>(iy)) / -dy
+                                        : inf;
+    uint64_t    steps = walk_length(fx, fy, gx, gy) - 1;
+    float       t = 0.0f;
+    for(uint64_t k = 0;; k++)
+    {
+        if(k == steps)
+        {
+            visit(ix, iy, t, 1.0f);
+            break;
+        }
+
+        // Rounding can leave one axis already at its end cell; finish along
+        // the other axis
+        if((t_max_x < t_max_y && ix != ex) || iy == ey)
+        {
+            float t_next = std::min(t_max_x, 1.0f);
+            visit(ix, iy, t, t_next);
+            t = t_next;
+            ix += step_x;
+            t_max_x += t_delta_x;
+        }
+        else
+        {
+            float t_next = std::min(t_max_y, 1.0f);
+            visit(ix, iy, t, t_next);
+            t = t_next;
+            iy += step_y;
+            t_max_y += t_delta_y;
+        }
+    }
+}
+
+} // namespace
+
+Segment2Grid::Segment2Grid(float cell_size) :
+    cell_size_(cell_size),
+    inv_cell_size_(1.0f / cell_size)
+{
+}
+
+float Segment2Grid::get_cell_size() const { return cell_size_; }
+
+void Segment2Grid::set_cell_size(float cell_size)
+{
+    cell_size_ = cell_size;
+    inv_cell_size_ = 1.0f / cell_size;
+    cells_.clear();
+    unbinned_.clear();
+    for(uint32_t i = 0; i < segments_.size(); i++) insert(i);
+}
+
+void Segment2Grid::clear()
+{
+    segments_.clear();
+    cells_.clear();
+    unbinned_.clear();
+}
+
+size_t Segment2Grid::size() const { return segments_.size(); }
+
+size_t Segment2Grid::cell_count() const { return cells_.size(); }
+
+uint32_t Segment2Grid::add(const LineSegment2 &segment)
+{
+    uint32_t i = static_cast<uint32_t>(segments_.size());
+    segments_.push_back(segment);
+    insert(i);
+    return i;
+}
+
+void Segment2Grid::add(const std::vector<LineSegment2> &segments)
+{
+    segments_.reserve(segments_.size() + segments.size());
+    for(const auto &segment : segments) add(segment);
+}
+
+const Segment2Table &Segment2Grid::get_segments() const { return segments_; }
+
+void Segment2Grid::insert(uint32_t i)
+{
+    float ax = segments_.ax()[i] * inv_cell_size_;
+    float ay = segments_.ay()[i] * inv_cell_size_;
+    float bx = segments_.bx()[i] * inv_cell_size_;
+    float by = segments_.by()[i] * inv_cell_size_;
+    if(walk_length(ax, ay, bx, by) > MAX_WALK_CELLS)
+    {
+        unbinned_.push_back(i);
+        return;
+    }
+
+    // Add the segment to the cells overlapped by the bounding box (grown by
+    // the margin) of its part in each cell the walk visits. Usually that is
+    // only the visited cell; a part near a boundary adds the neighbor too.
+    float dx = bx - ax;
+    float dy = by - ay;
+    walk_cells(ax,
+               ay,
+               bx,
+               by,
+               [&](int32_t, int32_t, float t0, float t1)
+               {
+                   float   px = ax + dx * t0;
+                   float   py = ay + dy * t0;
+                   float   qx = ax + dx * t1;
+                   float   qy = ay + dy * t1;
+                   int32_t x0 = cell_coord(std::min(px, qx) - CELL_MARGIN);
+                   int32_t x1 = cell_coord(std::max(px, qx) + CELL_MARGIN);
+                   int32_t y0 = cell_coord(std::min(py, qy) - CELL_MARGIN);
+                   int32_t y1 = cell_coord(std::max(py, qy) + CELL_MARGIN);
+                   for(int32_t cx = x0; cx <= x1; cx++)
+                   {
+                       for(int32_t cy = y0; cy <= y1; cy++)
+                       {
+                           // Consecutive parts share boundary cells
+                           std::vector<uint32_t> &cell = cells_[cell_key(cx, cy)];
+                           if(cell.empty() || cell.back() != i) cell.push_back(i);
+                       }
+                   }
+               });
+}
+
+void Segment2Grid::get_candidates(const LineSegment2    &query,
+                                  std::vector<uint32_t> &candidates) const
+{
+    candidates.clear();
+
+    // Query end points in cell units
+    float fx = query.a.x * inv_cell_size_;
+    float fy = query.a.y * inv_cell_size_;
+    float gx = query.b.x * inv_cell_size_;
+    float gy = query.b.y * inv_cell_size_;
+    if(walk_length(fx, fy, gx, gy) > MAX_WALK_CELLS)
+    {
+        // Walking the query costs more than testing every segment
+        candidates.resize(segments_.size());
+        for(uint32_t i = 0; i < segments_.size(); i++) candidates[i] = i;
+        return;
+    }
+
+    candidates = unbinned_;
+    if(!cells_.empty())
+    {
+        walk_cells(fx,
+                   fy,
+                   gx,
+                   gy,
+                   [&](int32_t ix, int32_t iy, float, float)
+                   {
+                       auto cell = cells_.find(cell_key(ix, iy));
+                       if(cell != cells_.end())
+                       {
+                           candidates.insert(
+                               candidates.end(), cell->second.begin(), cell->second.end());
+                       }
+                   });
+    }
+
+    // Segments spanning several cells appear more than once
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+size_t Segment2Grid::intersect(const LineSegment2 &query, std::vector<Segment2Hit> &hits)
+{
+    get_candidates(query, candidates_);
+    return intersect_segments(query, segments_, candidates_.data(), candidates_.size(), hits);
+}
+
+} // namespace cg
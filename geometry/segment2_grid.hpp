@@ -0,0 +1,132 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    segment2_grid.hpp
+//	Purpose: Uniform grid (spatial hash) over 2D line segments for fast
+//           segment intersection queries.
+//============================================================================
+
+#ifndef __GEOMETRY_SEGMENT2_GRID_HPP__
+#define __GEOMETRY_SEGMENT2_GRID_HPP__
+
+#include "geometry/segment2.hpp"
+#include "geometry/segment2_batch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Uniform grid of square cells over a set of 2D line segments. Only cells
+ * that hold segments are stored (hashed by cell coordinates), so the grid is
+ * unbounded and segments can be added at any time without a rebuild. Each
+ * segment is stored in the cells it crosses (DDA traversal, with a small
+ * margin around cell boundaries), so a long diagonal segment takes a number
+ * of cells proportional to its length, not to its bounding box area. A query
+ * walks the same way, so its cost depends on the query length and the local
+ * segment density, not on the total number of segments. Choose a cell size
+ * near the typical segment length.
+ *
+ * Segments crossing more than 65536 cells are not binned but tested by every
+ * query, and queries crossing more cells test every segment, so far away
+ * coordinates cost time proportional to the number of segments rather than
+ * to their length.
+ */
+class Segment2Grid
+{
+  public:
+    /**
+     * Constructor.
+     * @param  cell_size  Width and height of a grid cell (> 0).
+     */
+    explicit Segment2Grid(float cell_size = 1.0f);
+
+    /**
+     * Get the cell size.
+     * @return  Returns the width and height of a grid cell.
+     */
+    float get_cell_size() const;
+
+    /**
+     * Set the cell size. Re-bins all segments.
+     * @param  cell_size  Width and height of a grid cell (> 0).
+     */
+    void set_cell_size(float cell_size);
+
+    /**
+     * Remove all segments.
+     */
+    void clear();
+
+    /**
+     * Get the number of segments.
+     * @return  Returns the number of segments.
+     */
+    size_t size() const;
+
+    /**
+     * Get the number of non-empty cells.
+     * @return  Returns the number of cells holding at least one segment.
+     */
+    size_t cell_count() const;
+
+    /**
+     * Add a segment. Segments are numbered in the order they are added.
+     * @param  segment  Segment to add.
+     * @return  Returns the index of the segment.
+     */
+    uint32_t add(const LineSegment2 &segment);
+
+    /**
+     * Add a list of segments.
+     * @param  segments  Segments to add.
+     */
+    void add(const std::vector<LineSegment2> &segments);
+
+    /**
+     * Get the segments.
+     * @return  Returns the table of segments, in the order they were added.
+     */
+    const Segment2Table &get_segments() const;
+
+    /**
+     * Gets the indices of the segments stored in the cells a query segment
+     * crosses. Every segment the query can intersect is included.
+     * @param  query       Query segment.
+     * @param  candidates  Sorted, unique segment indices (overwritten).
+     */
+    void get_candidates(const LineSegment2 &query, std::vector<uint32_t> &candidates) const;
+
+    /**
+     * Intersects a query segment with the segments in the grid. Produces the
+     * same hits, in the same (segment index) order, as intersect_segments
+     * over the whole segment table. The candidate list is kept by the grid
+     * and reused, so repeated queries do not allocate.
+     * @param  query  Query segment.
+     * @param  hits   List the hits are appended to.
+     * @return  Returns the number of hits appended.
+     */
+    size_t intersect(const LineSegment2 &query, std::vector<Segment2Hit> &hits);
+
+  private:
+    float                                               cell_size_;
+    float                                               inv_cell_size_;
+    Segment2Table                                       segments_;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+    std::vector<uint32_t>                               unbinned_;   // Segments too long to bin
+    std::vector<uint32_t>                               candidates_; // Scratch list for intersect
+
+    // Adds segment i to the cells it crosses
+    void insert(uint32_t i);
+};
+
+} // namespace cg
+
+#endif
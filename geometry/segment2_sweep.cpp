@@ -0,0 +1,316 @@
+#include "geometry/segment2_sweep.hpp"
+
+#include "geometry/predicates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace cg
+{
+
+namespace
+{
+
+// Tolerance relative to the largest input coordinate
+constexpr double RELATIVE_TOLERANCE = 1.0e-9;
+
+// Segment with end points ordered left to right (then bottom to top)
+struct SweepSegment
+{
+    double ax, ay; // Left end point
+    double bx, by; // Right end point
+    double slope;  // dy / dx, infinity when vertical
+};
+
+inline bool point_less(double x0, double y0, double x1, double y1)
+{
+    return x0 < x1 || (x0 == x1 && y0 < y1);
+}
+
+/**
+ * Bentley-Ottmann sweep from left to right (de Berg et al., Computational
+ * Geometry, ch. 2). The status holds the segments crossing the sweep line
+ * ordered bottom to top just right of the current event point. At each event
+ * point p the segments through p are removed and re-inserted in their order
+ * after p, and only newly adjacent segments are tested for intersections
+ * right of p.
+ */
+class Sweep
+{
+  public:
+    explicit Sweep(const std::vector<LineSegment2> &segments);
+
+    void run(std::vector<Segment2Crossing> &crossings);
+
+  private:
+    // Event point data: segments starting at the point, and segments ending
+    // or (probably) crossing there
+    struct Event
+    {
+        std::vector<uint32_t> starts;
+        std::vector<uint32_t> others;
+    };
+    using EventKey = std::pair<double, double>;
+
+    // Marker used to search the status for the current event point
+    struct Probe
+    {
+    };
+
+    // Orders segments by y just right of the sweep point
+    struct StatusLess
+    {
+        using is_transparent = void;
+
+        const Sweep *sweep;
+
+        bool operator()(uint32_t a, uint32_t b) const;
+        bool operator()(uint32_t a, Probe) const;
+        bool operator()(Probe, uint32_t b) const;
+    };
+    using Status = std::set<uint32_t, StatusLess>;
+
+    std::vector<SweepSegment>     segments_;
+    std::map<EventKey, Event>     events_;
+    Status                        status_;
+    std::vector<Status::iterator> position_;
+    std::vector<char>             in_status_;
+    double                        tolerance_;
+    double                        sweep_x_;
+    double                        sweep_y_;
+
+    // Scratch lists reused for every event
+    std::vector<uint32_t> through_;
+    std::vector<uint32_t> inserted_;
+
+    // y of segment s on the sweep line. Vertical segments use the sweep
+    // point clamped to the segment.
+    double y_at(uint32_t s) const;
+
+    void handle_event(const EventKey &p, Event &event, std::vector<Segment2Crossing> &crossings);
+
+    // Adds an event if segments a and b cross right of the sweep point
+    void check_pair(uint32_t a, uint32_t b);
+};
+
+Sweep::Sweep(const std::vector<LineSegment2> &segments) :
+    status_(StatusLess{this}),
+    tolerance_(0.0),
+    sweep_x_(0.0),
+    sweep_y_(0.0)
+{
+    size_t n = segments.size();
+    segments_.resize(n);
+    position_.resize(n);
+    in_status_.assign(n, 0);
+
+    double extent = 1.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        double ax = segments[i].a.x;
+        double ay = segments[i].a.y;
+        double bx = segments[i].b.x;
+        double by = segments[i].b.y;
+        if(point_less(bx, by, ax, ay))
+        {
+            std::swap(ax, bx);
+            std::swap(ay, by);
+        }
+        double slope = (bx != ax) ? (by - ay) / (bx - ax) : std::numeric_limits<double>::infinity();
+        segments_[i] = {ax, ay, bx, by, slope};
+        extent = std::max({extent, std::abs(ax), std::abs(ay), std::abs(bx), std::abs(by)});
+
+        uint32_t s = static_cast<uint32_t>(i);
+        events_[EventKey(ax, ay)].starts.push_back(s);
+        if(ax != bx || ay != by) events_[EventKey(bx, by)].others.push_back(s);
+    }
+    tolerance_ = RELATIVE_TOLERANCE * extent;
+}
+
+double Sweep::y_at(uint32_t s) const
+{
+    const SweepSegment &g = segments_[s];
+    if(g.bx == g.ax) return std::min(std::max(sweep_y_, g.ay), g.by);
+    if(sweep_x_ == g.ax) return g.ay;
+    if(sweep_x_ == g.bx) return g.by;
+    return g.ay + (g.by - g.ay) * ((sweep_x_ - g.ax) / (g.bx - g.ax));
+}
+
+bool Sweep::StatusLess::operator()(uint32_t a, uint32_t b) const
+{
+    if(a == b) return false;
+
+    // Segments through the same point are ordered by slope (their order just
+    // right of the point). Overlapping collinear segments by index.
+    double ya = sweep->y_at(a);
+    double yb = sweep->y_at(b);
+    if(std::abs(ya - yb) > sweep->tolerance_) return ya < yb;
+    double sa = sweep->segments_[a].slope;
+    double sb = sweep->segments_[b].slope;
+    if(sa != sb) return sa < sb;
+    return a < b;
+}
+
+bool Sweep::StatusLess::operator()(uint32_t a, Probe) const
+{
+    return sweep->y_at(a) < sweep->sweep_y_ - sweep->tolerance_;
+}
+
+bool Sweep::StatusLess::operator()(Probe, uint32_t b) const
+{
+    return sweep->sweep_y_ + sweep->tolerance_ < sweep->y_at(b);
+}
+
+void Sweep::run(std::vector<Segment2Crossing> &crossings)
+{
+    crossings.clear();
+    while(!events_.empty())
+    {
+        auto     first = events_.begin();
+        EventKey p = first->first;
+        Event    event = std::move(first->second);
+        events_.erase(first);
+        handle_event(p, event, crossings);
+    }
+
+    // Overlapping collinear segments are reported at each end point of the
+    // overlap. Keep the first (leftmost) report of each pair.
+    auto pair_less = [](const Segment2Crossing &c0, const Segment2Crossing &c1)
+    { return c0.first < c1.first || (c0.first == c1.first && c0.second < c1.second); };
+    auto same_pair = [](const Segment2Crossing &c0, const Segment2Crossing &c1)
+    { return c0.first == c1.first && c0.second == c1.second; };
+    std::stable_sort(crossings.begin(), crossings.end(), pair_less);
+    crossings.erase(std::unique(crossings.begin(), crossings.end(), same_pair), crossings.end());
+}
+
+void Sweep::handle_event(const EventKey                &p,
+                         Event                         &event,
+                         std::vector<Segment2Crossing> &crossings)
+{
+    sweep_x_ = p.first;
+    sweep_y_ = p.second;
+
+    // Segments in the status that end at or pass through p: the ones that
+    // generated this event plus any found within the tolerance of p
+    through_.clear();
+    for(uint32_t s : event.others)
+    {
+        if(in_status_[s]) through_.push_back(s);
+    }
+    const StatusLess less = status_.key_comp();
+    for(auto it = status_.lower_bound(Probe{}); it != status_.end() && !less(Probe{}, *it); ++it)
+        through_.push_back(*it);
+    std::sort(through_.begin(), through_.end());
+    through_.erase(std::unique(through_.begin(), through_.end()), through_.end());
+
+    // Report every pair of segments meeting at p
+    through_.insert(through_.end(), event.starts.begin(), event.starts.end());
+    if(through_.size() > 1)
+    {
+        std::sort(through_.begin(), through_.end());
+        Point2 point(static_cast<float>(p.first), static_cast<float>(p.second));
+        for(size_t i = 0; i < through_.size(); i++)
+        {
+            for(size_t j = i + 1; j < through_.size(); j++)
+                crossings.push_back({through_[i], through_[j], point});
+        }
+    }
+
+    // Remove the segments through p, then re-insert those that continue
+    // past p along with the ones starting at p. The comparator now orders
+    // them by slope, which is their order just right of p.
+    inserted_.clear();
+    for(uint32_t s : through_)
+    {
+        const SweepSegment &g = segments_[s];
+        if(in_status_[s])
+        {
+            status_.erase(position_[s]);
+            in_status_[s] = 0;
+            if(g.bx != p.first || g.by != p.second) inserted_.push_back(s);
+        }
+        else if(g.ax == p.first && g.ay == p.second && (g.bx != g.ax || g.by != g.ay))
+        {
+            inserted_.push_back(s);
+        }
+    }
+    for(uint32_t s : inserted_)
+    {
+        position_[s] = status_.insert(s).first;
+        in_status_[s] = 1;
+    }
+
+    if(inserted_.empty())
+    {
+        // Segments below and above p become neighbors
+        auto above = status_.lower_bound(Probe{});
+        if(above != status_.end() && above != status_.begin())
+            check_pair(*std::prev(above), *above);
+        return;
+    }
+
+    // Test the lowest and highest re-inserted segments against their new
+    // neighbors
+    auto lowest = position_[inserted_[0]];
+    auto highest = lowest;
+    for(uint32_t s : inserted_)
+    {
+        if(less(s, *lowest)) lowest = position_[s];
+        if(less(*highest, s)) highest = position_[s];
+    }
+    if(lowest != status_.begin()) check_pair(*std::prev(lowest), *lowest);
+    auto next = std::next(highest);
+    if(next != status_.end()) check_pair(*highest, *next);
+}
+
+void Sweep::check_pair(uint32_t a, uint32_t b)
+{
+    const SweepSegment &g = segments_[a];
+    const SweepSegment &h = segments_[b];
+
+    // Exact orientations of each segment's end points relative to the other.
+    // Parallel (or collinear) segments do not create new events: collinear
+    // overlaps are found at the end point events
+    double o1 = orient2d(g.ax, g.ay, g.bx, g.by, h.ax, h.ay);
+    double o2 = orient2d(g.ax, g.ay, g.bx, g.by, h.bx, h.by);
+    if((o1 > 0.0 && o2 > 0.0) || (o1 < 0.0 && o2 < 0.0) || (o1 == 0.0 && o2 == 0.0)) return;
+    double o3 = orient2d(h.ax, h.ay, h.bx, h.by, g.ax, g.ay);
+    double o4 = orient2d(h.ax, h.ay, h.bx, h.by, g.bx, g.by);
+    if((o3 > 0.0 && o4 > 0.0) || (o3 < 0.0 && o4 < 0.0)) return;
+
+    // Snap to end points so touching segments share the end point event
+    double x, y;
+    if(o3 == 0.0) { x = g.ax, y = g.ay; }
+    else if(o4 == 0.0) { x = g.bx, y = g.by; }
+    else if(o1 == 0.0) { x = h.ax, y = h.ay; }
+    else if(o2 == 0.0) { x = h.bx, y = h.by; }
+    else
+    {
+        // o3 and o4 have opposite signs, so 0 < t < 1
+        double t = o3 / (o3 - o4);
+        x = g.ax + (g.bx - g.ax) * t;
+        y = g.ay + (g.by - g.ay) * t;
+    }
+
+    // Crossings at or left of the sweep point were handled already
+    if(!point_less(sweep_x_, sweep_y_, x, y)) return;
+
+    Event &event = events_[EventKey(x, y)];
+    event.others.push_back(a);
+    event.others.push_back(b);
+}
+
+} // namespace
+
+void find_all_intersections(const std::vector<LineSegment2> &segments,
+                            std::vector<Segment2Crossing>   &crossings)
+{
+    Sweep sweep(segments);
+    sweep.run(crossings);
+}
+
+} // namespace cg
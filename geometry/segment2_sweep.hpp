@@ -0,0 +1,58 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    segment2_sweep.hpp
+//	Purpose: All-pairs 2D segment intersection with a Bentley-Ottmann sweep.
+//============================================================================
+
+#ifndef __GEOMETRY_SEGMENT2_SWEEP_HPP__
+#define __GEOMETRY_SEGMENT2_SWEEP_HPP__
+
+#include "geometry/point2.hpp"
+#include "geometry/segment2.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Intersecting pair of segments found by find_all_intersections.
+ */
+struct Segment2Crossing
+{
+    uint32_t first;  // Index of the first segment (first < second)
+    uint32_t second; // Index of the second segment
+    Point2   point;  // An intersection point (for overlapping collinear
+                     // segments, the leftmost point of the overlap)
+};
+
+static_assert(std::is_trivially_copyable<Segment2Crossing>::value,
+              "Segment2Crossing must be trivially copyable");
+
+/**
+ * Finds every pair of intersecting segments with a Bentley-Ottmann sweep in
+ * O((n + k) log n) time for n segments and k intersection points, instead of
+ * testing all n^2 pairs. Handles the degenerate cases: segments that touch at
+ * end points, several segments through one point, vertical segments,
+ * zero length segments and overlapping collinear segments (each pair is
+ * reported once). Whether 2 segments cross is decided exactly with the
+ * orient2d predicate. The sweep order uses double precision, and points
+ * closer than a tolerance relative to the input extent (about 1e-9) are
+ * treated as touching.
+ * @param  segments   Segments to test.
+ * @param  crossings  Intersecting pairs, sorted by (first, second).
+ *                    Overwritten.
+ */
+void find_all_intersections(const std::vector<LineSegment2> &segments,
+                            std::vector<Segment2Crossing>   &crossings);
+
+} // namespace cg
+
+#endif
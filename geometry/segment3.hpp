@@ -14,6 +14,7 @@
 
 #include "geometry/point3.hpp"
 
+#include <type_traits>
 #include <vector>
 
 namespace cg
@@ -47,6 +48,11 @@ struct LineSegment3
     Segment3PointDistanceResult distance(const Point3 &p) const;
 };
 
+static_assert(std::is_trivially_copyable<LineSegment3>::value,
+              "LineSegment3 must be trivially copyable");
+static_assert(std::is_standard_layout<LineSegment3>::value, "LineSegment3 must be standard layout");
+static_assert(sizeof(LineSegment3) == 6 * sizeof(float), "LineSegment3 must be 6 packed floats");
+
 struct Segment3PointDistanceResult
 {
     float  distance;
@@ -0,0 +1,134 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    simd.hpp
+//	Purpose: Selects the SIMD instruction sets used by the geometry kernels.
+//           SSE2 is used whenever the target supports it (always true on
+//           x86-64). AVX is used when the compiler targets it (e.g. -mavx or
+//           -march=native, /arch:AVX on MSVC). Define CG_NO_SIMD to force the
+//           scalar fallback paths.
+//============================================================================
+
+#ifndef __GEOMETRY_SIMD_HPP__
+#define __GEOMETRY_SIMD_HPP__
+
+#if !defined(CG_NO_SIMD) &&                                                                        \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CG_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+#if defined(CG_SIMD_SSE) && defined(__AVX__)
+#define CG_SIMD_AVX 1
+#include <immintrin.h>
+#endif
+
+#if defined(CG_SIMD_SSE)
+namespace cg
+{
+namespace simd
+{
+
+/**
+ * Loads 4 consecutive 3-float elements (12 floats) and deinterleaves them
+ * into x, y and z registers.
+ */
+inline void load_xyz4(const float *p, __m128 &x, __m128 &y, __m128 &z)
+{
+    __m128 m0 = _mm_loadu_ps(p);     // x0 y0 z0 x1
+    __m128 m1 = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+    __m128 m2 = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+    __m128 t = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 1, 3, 2));
+    x = _mm_shuffle_ps(m0, t, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(m0, m1, _MM_SHUFFLE(0, 0, 1, 1)), t, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(
+        _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 1, 2, 2)), m2, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+/**
+ * Stores x, y and z registers as 4 consecutive 3-float elements. Writes
+ * exactly 12 floats.
+ */
+inline void store_xyz4(float *p, __m128 x, __m128 y, __m128 z)
+{
+    __m128 w = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    // Overlapping stores: each one writes a junk 4th float that the next
+    // store overwrites. The last element is written with 8 + 4 byte stores.
+    _mm_storeu_ps(p, x);
+    _mm_storeu_ps(p + 3, y);
+    _mm_storeu_ps(p + 6, z);
+    _mm_storel_pi(reinterpret_cast<__m64 *>(p + 9), w);
+    _mm_store_ss(p + 11, _mm_movehl_ps(w, w));
+}
+
+/**
+ * Loads 4 consecutive 2-float elements (8 floats) and deinterleaves them
+ * into x and y registers.
+ */
+inline void load_xy4(const float *p, __m128 &x, __m128 &y)
+{
+    __m128 m0 = _mm_loadu_ps(p);     // x0 y0 x1 y1
+    __m128 m1 = _mm_loadu_ps(p + 4); // x2 y2 x3 y3
+    x = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(2, 0, 2, 0));
+    y = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+/**
+ * Stores x and y registers as 4 consecutive 2-float elements.
+ */
+inline void store_xy4(float *p, __m128 x, __m128 y)
+{
+    _mm_storeu_ps(p, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(x, y));
+}
+
+/**
+ * Minimum of the 4 lanes of a register.
+ */
+inline float horizontal_min(__m128 a)
+{
+    a = _mm_min_ps(a, _mm_movehl_ps(a, a));
+    a = _mm_min_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(a);
+}
+
+/**
+ * Maximum of the 4 lanes of a register.
+ */
+inline float horizontal_max(__m128 a)
+{
+    a = _mm_max_ps(a, _mm_movehl_ps(a, a));
+    a = _mm_max_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(a);
+}
+
+/**
+ * Quaternion (Hamilton) product a * b with components stored x, y, z, w.
+ */
+inline __m128 quaternion_multiply(__m128 a, __m128 b)
+{
+    // a * b = aw * b + ax * (bw, -bz, by, -bx) + ay * (bz, bw, -bx, -by)
+    //       + az * (-by, bx, bw, -bz)
+    // Summed as a tree to shorten the dependency chain.
+    __m128 bx = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)),
+                           _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f));
+    __m128 by = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)),
+                           _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f));
+    __m128 bz = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)),
+                           _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+    __m128 t0 = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b),
+                           _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), bx));
+    __m128 t1 = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), by),
+                           _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), bz));
+    return _mm_add_ps(t0, t1);
+}
+
+} // namespace simd
+} // namespace cg
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    span.hpp
+//	Purpose: Non-owning view of a contiguous array.
+//============================================================================
+
+#ifndef __GEOMETRY_SPAN_HPP__
+#define __GEOMETRY_SPAN_HPP__
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace cg
+{
+
+/**
+ * Non-owning view of a contiguous array (the subset of C++20 std::span used
+ * by the geometry library). Lets an interface accept std::vector contents,
+ * plain arrays or memory-mapped buffers without copying. A std::vector
+ * converts implicitly. The viewed memory must outlive the span.
+ */
+template <typename T>
+class Span
+{
+  public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+
+    /**
+     * Default constructor. Creates an empty span.
+     */
+    constexpr Span() : data_(nullptr), size_(0) {}
+
+    /**
+     * Constructor given a pointer and an element count.
+     * @param  data  First element.
+     * @param  size  Number of elements.
+     */
+    constexpr Span(T *data, size_t size) : data_(data), size_(size) {}
+
+    /**
+     * Constructor from a vector.
+     * @param  v  Vector to view.
+     */
+    template <typename Allocator>
+    Span(std::vector<value_type, Allocator> &v) : data_(v.data()), size_(v.size())
+    {
+    }
+
+    /**
+     * Constructor from a const vector. Only for spans of const elements.
+     * @param  v  Vector to view.
+     */
+    template <typename Allocator,
+              typename U = T,
+              typename = typename std::enable_if<std::is_const<U>::value>::type>
+    Span(const std::vector<value_type, Allocator> &v) : data_(v.data()), size_(v.size())
+    {
+    }
+
+    /**
+     * Conversion from a span of non-const elements to a span of const elements.
+     * @param  other  Span to convert.
+     */
+    template <typename U,
+              typename = typename std::enable_if<std::is_same<const U, T>::value &&
+                                                 !std::is_same<U, T>::value>::type>
+    constexpr Span(const Span<U> &other) : data_(other.data()), size_(other.size())
+    {
+    }
+
+    constexpr T     *data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool   empty() const { return size_ == 0; }
+    constexpr T     &operator[](size_t i) const { return data_[i]; }
+    constexpr T     *begin() const { return data_; }
+    constexpr T     *end() const { return data_ + size_; }
+
+  private:
+    T     *data_;
+    size_t size_;
+};
+
+} // namespace cg
+
+#endif
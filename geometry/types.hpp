@@ -15,6 +15,8 @@
 #include "geometry/point3.hpp"
 #include "geometry/vector3.hpp"
 
+#include <type_traits>
+
 namespace cg
 {
 
@@ -31,6 +33,13 @@ struct VertexAndNormal
     VertexAndNormal(const Point3 &v);
 };
 
+static_assert(std::is_trivially_copyable<VertexAndNormal>::value,
+              "VertexAndNormal must be trivially copyable");
+static_assert(std::is_standard_layout<VertexAndNormal>::value,
+              "VertexAndNormal must be standard layout");
+static_assert(sizeof(VertexAndNormal) == 6 * sizeof(float),
+              "VertexAndNormal must be 6 packed floats");
+
 } // namespace cg
 
 #endif
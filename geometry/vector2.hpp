@@ -12,8 +12,12 @@
 #ifndef __GEOMETRY_VECTOR2_HPP__
 #define __GEOMETRY_VECTOR2_HPP__
 
+#include "geometry/constants.hpp"
 #include "geometry/point2.hpp"
 
+#include <cmath>
+#include <type_traits>
+
 namespace cg
 {
 
@@ -28,62 +32,49 @@ struct Vector2
     /**
      * Default constructor
      */
-    Vector2();
+    constexpr Vector2();
 
     /**
      * Constructor given a point.  Essentially a vector from the
      * origin to the point.
      * @param   p  Point.
      */
-    Vector2(const Point2 &p);
+    constexpr Vector2(const Point2 &p);
 
     /**
      * Constructor given 3 components of the vector.
      * @param   ix   x component of the vector.
      * @param   iy   y component of the vector.
      */
-    Vector2(float ix, float iy);
+    constexpr Vector2(float ix, float iy);
 
     /**
      * Constructor from one point to another.
      * @param   from  Point at origin of the vector.
      * @param   to    Point at end of vector
      */
-    Vector2(const Point2 &from, const Point2 &to);
-
-    /**
-     * Copy constructor.
-     * @param   w  Vector to copy to the new vector.
-     */
-    Vector2(const Vector2 &w);
-
-    /**
-     * Assignment operator
-     * @param   w  Vector to copy to the current vector.
-     * @return  Returns the address of the current vector.
-     */
-    Vector2 &operator=(const Vector2 &w);
+    constexpr Vector2(const Point2 &from, const Point2 &to);
 
     /**
      * Set the current vector to the specified components.
      * @param   ix   x component of the vector.
      * @param   iy   y component of the vector.
      */
-    void set(float ix, float iy);
+    constexpr void set(float ix, float iy);
 
     /**
      * Set the vector components to those of a point.  Essentially a
      * vector from the origin to the point.
      * @param   p  Point.
      */
-    void set(const Point2 &p);
+    constexpr void set(const Point2 &p);
 
     /**
      * Set the current vector to be from one point to another.
      * @param   from  Point at origin of the vector.
      * @param   to    Point at end of vector
      */
-    void set(const Point2 &from, const Point2 &to);
+    constexpr void set(const Point2 &from, const Point2 &to);
 
     /**
      * Creates a new vector that is the current vector plus the
@@ -91,14 +82,14 @@ struct Vector2
      * @param   w  Vector to add to the current vector.
      * @return   Returns the resulting vector.
      */
-    Vector2 operator+(const Vector2 &w) const;
+    constexpr Vector2 operator+(const Vector2 &w) const;
 
     /**
      * Adds vector w to the current vector.
      * @param   w  Vector to add to the current vector.
      * @return  Returns the address of the current vector.
      */
-    Vector2 &operator+=(const Vector2 &w);
+    constexpr Vector2 &operator+=(const Vector2 &w);
 
     /**
      * Creates a new vector that is the current vector minus the
@@ -106,14 +97,14 @@ struct Vector2
      * @param   w  Vector to subtract from the current vector.
      * @return   Returns the resulting vector.
      */
-    Vector2 operator-(const Vector2 &w) const;
+    constexpr Vector2 operator-(const Vector2 &w) const;
 
     /**
      * Subtracts vector w from the current vector.
      * @param   w  Vector to subtract from the current vector.
      * @return  Returns the address of the current vector.
      */
-    Vector2 &operator-=(const Vector2 &w);
+    constexpr Vector2 &operator-=(const Vector2 &w);
 
     /**
      * Creates a new vector that is the current vector multiplied
@@ -121,14 +112,14 @@ struct Vector2
      * @param   scalar   Scalar to muliply the vector with.
      * @return  Returns the resulting vector
      */
-    Vector2 operator*(float scalar) const;
+    constexpr Vector2 operator*(float scalar) const;
 
     /**
      * Multiplies the current vector by a scalar
      * @param   scalar   Scalar to muliply the vector with.
      * @return  Returns the address of the current vector.
      */
-    Vector2 &operator*=(float scalar);
+    constexpr Vector2 &operator*=(float scalar);
 
     /**
      * Equality operator.
@@ -136,7 +127,7 @@ struct Vector2
      * @return  Returns true if vector w equals the current vector,
      *          false otherwise.
      */
-    bool operator==(const Vector2 &w) const;
+    constexpr bool operator==(const Vector2 &w) const;
 
     /**
      * Computes the dot product of the current vector with the
@@ -144,7 +135,7 @@ struct Vector2
      * @param   w  Vector
      * @return  Returns the dot product (a scalar).
      */
-    float dot(const Vector2 &w) const;
+    constexpr float dot(const Vector2 &w) const;
 
     /**
      * Computes the 2D cross product of current vector with w0.
@@ -152,14 +143,14 @@ struct Vector2
      * @return  Returns the magnitude of the resulting vector (which is
      *          along the z axis)
      */
-    float cross(const Vector2 &w) const;
+    constexpr float cross(const Vector2 &w) const;
 
     /**
      * Get a perpendicular vector to this vector.
      * @param  clockwise  If true get the clockwise oriented perpendicular.
      *                    If false (default) get the counter-clockwise oriented perpendicular.
      */
-    Vector2 get_perpendicular(bool clockwise = false) const;
+    constexpr Vector2 get_perpendicular(bool clockwise = false) const;
 
     /**
      * Computes the norm (length) of the current vector.
@@ -172,7 +163,7 @@ struct Vector2
      * (Useful when absolute distance is not required)
      * @return  Returns the length squared of the vector.
      */
-    float norm_squared() const;
+    constexpr float norm_squared() const;
 
     /**
      * Normalizes the vector.
@@ -186,7 +177,7 @@ struct Vector2
      * @param   w  Vector to determine component along.
      * @return  Returns the component of the current vector along w.
      */
-    float component(const Vector2 &w) const;
+    constexpr float component(const Vector2 &w) const;
 
     /**
      * Creates a new vector that is the projection of the current
@@ -194,7 +185,7 @@ struct Vector2
      * @param   w  Vector to determine projection along.
      * @return  Returns the new vector.
      */
-    Vector2 projection(const Vector2 &w) const;
+    constexpr Vector2 projection(const Vector2 &w) const;
 
     /**
      * Calculates the angle (radians) between the current vector and
@@ -212,13 +203,130 @@ struct Vector2
      * @param   normal   unit length normal to the vector where reflection occurs
      * @return  Returns the reflected vector
      */
-    Vector2 reflect(const Vector2 &normal) const;
+    constexpr Vector2 reflect(const Vector2 &normal) const;
 };
 
+static_assert(std::is_trivially_copyable<Vector2>::value, "Vector2 must be trivially copyable");
+static_assert(std::is_standard_layout<Vector2>::value, "Vector2 must be standard layout");
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be 2 packed floats");
+
 /**
  * Overloading: allows float * Vector2
  */
-Vector2 operator*(float s, const Vector2 &v);
+constexpr Vector2 operator*(float s, const Vector2 &v);
+
+
+constexpr Vector2::Vector2() : x(0.0f), y(0.0f) {}
+
+constexpr Vector2::Vector2(const Point2 &p) : x(p.x), y(p.y) {}
+
+constexpr Vector2::Vector2(float ix, float iy) : x(ix), y(iy) {}
+
+constexpr Vector2::Vector2(const Point2 &from, const Point2 &to) :
+    x(to.x - from.x), y(to.y - from.y)
+{
+}
+
+constexpr void Vector2::set(float ix, float iy)
+{
+    x = ix;
+    y = iy;
+}
+
+constexpr void Vector2::set(const Point2 &p)
+{
+    x = p.x;
+    y = p.y;
+}
+
+constexpr void Vector2::set(const Point2 &from, const Point2 &to)
+{
+    x = to.x - from.x;
+    y = to.y - from.y;
+}
+
+constexpr Vector2 Vector2::operator+(const Vector2 &w) const { return Vector2(x + w.x, y + w.y); }
+
+constexpr Vector2 &Vector2::operator+=(const Vector2 &w)
+{
+    x += w.x;
+    y += w.y;
+    return *this;
+}
+
+constexpr Vector2 Vector2::operator-(const Vector2 &w) const { return Vector2(x - w.x, y - w.y); }
+
+constexpr Vector2 &Vector2::operator-=(const Vector2 &w)
+{
+    x -= w.x;
+    y -= w.y;
+    return *this;
+}
+
+constexpr Vector2 Vector2::operator*(float scalar) const { return Vector2(x * scalar, y * scalar); }
+
+constexpr Vector2 &Vector2::operator*=(float scalar)
+{
+    x *= scalar;
+    y *= scalar;
+    return *this;
+}
+
+constexpr bool Vector2::operator==(const Vector2 &w) const { return (x == w.x && y == w.y); }
+
+constexpr float Vector2::dot(const Vector2 &w) const { return (x * w.x + y * w.y); }
+
+constexpr float Vector2::cross(const Vector2 &w) const { return (x * w.y - y * w.x); }
+
+constexpr Vector2 Vector2::get_perpendicular(bool clockwise) const
+{
+    return (clockwise) ? Vector2(y, -x) : Vector2(-y, x);
+}
+
+inline float Vector2::norm() const { return std::sqrt(norm_squared()); }
+
+constexpr float Vector2::norm_squared() const { return dot(*this); }
+
+inline Vector2 &Vector2::normalize()
+{
+    // Normalize the vector if the norm is not 0 or 1
+    float n = norm();
+    if(n > EPSILON && n != 1.0f)
+    {
+        x /= n;
+        y /= n;
+    }
+    return *this;
+}
+
+constexpr float Vector2::component(const Vector2 &w) const
+{
+    float n = w.dot(w);
+    return (n != 0.0f) ? (dot(w) / n) : 0.0f;
+}
+
+constexpr Vector2 Vector2::projection(const Vector2 &w) const { return w * component(w); }
+
+inline float Vector2::angle_between(const Vector2 &w) const
+{
+    return std::acos(dot(w) / (norm() * w.norm()));
+}
+
+constexpr Vector2 Vector2::reflect(const Vector2 &normal) const
+{
+    Vector2 d = *this;
+    return (d - (normal * (2.0f * (d.dot(normal)))));
+}
+
+constexpr Vector2 operator*(float s, const Vector2 &v) { return Vector2(v.x * s, v.y * s); }
+
+// Point2 operations involving Vector2
+
+constexpr Point2 Point2::operator+(const Vector2 &v) const { return Point2(x + v.x, y + v.y); }
+
+constexpr Point2 Point2::operator-(const Vector2 &v) const { return Point2(x - v.x, y - v.y); }
+
+constexpr Vector2 Point2::operator-(const Point2 &p) const { return Vector2(x - p.x, y - p.y); }
 
 } // namespace cg
 
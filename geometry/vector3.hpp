@@ -12,8 +12,12 @@
 #ifndef __GEOMETRY_VECTOR3_HPP__
 #define __GEOMETRY_VECTOR3_HPP__
 
+#include "geometry/constants.hpp"
 #include "geometry/point3.hpp"
 
+#include <cmath>
+#include <type_traits>
+
 namespace cg
 {
 
@@ -29,14 +33,14 @@ struct Vector3
     /**
      * Default constructor
      */
-    Vector3();
+    constexpr Vector3();
 
     /**
      * Constructor given a point.  Essentially a vector from the
      * origin to the point.
      * @param   p  Point.
      */
-    Vector3(const Point3 &p);
+    constexpr Vector3(const Point3 &p);
 
     /**
      * Constructor given 3 components of the vector.
@@ -44,27 +48,14 @@ struct Vector3
      * @param   iy   y component of the vector.
      * @param   iz   z component of the vector.
      */
-    Vector3(float ix, float iy, float iz);
+    constexpr Vector3(float ix, float iy, float iz);
 
     /**
      * Constructor from one point to another.
      * @param   from  Point at origin of the vector.
      * @param   to    Point at end of vector
      */
-    Vector3(const Point3 &from, const Point3 &to);
-
-    /**
-     * Copy constructor.
-     * @param   w  Vector to copy to the new vector.
-     */
-    Vector3(const Vector3 &w);
-
-    /**
-     * Assignment operator
-     * @param   w  Vector to copy to the current vector.
-     * @return  Returns the address of the current vector.
-     */
-    Vector3 &operator=(const Vector3 &w);
+    constexpr Vector3(const Point3 &from, const Point3 &to);
 
     /**
      * Set the current vector to the specified components.
@@ -72,21 +63,21 @@ struct Vector3
      * @param   iy   y component of the vector.
      * @param   iz   z component of the vector.
      */
-    void set(float ix, float iy, float iz);
+    constexpr void set(float ix, float iy, float iz);
 
     /**
      * Set the vector components to those of a point.  Essentially a
      * vector from the origin to the point.
      * @param   p  Point.
      */
-    void set(const Point3 &p);
+    constexpr void set(const Point3 &p);
 
     /**
      * Set the current vector to be from one point to another.
      * @param   from  Point at origin of the vector.
      * @param   to    Point at end of vector
      */
-    void set(const Point3 &from, const Point3 &to);
+    constexpr void set(const Point3 &from, const Point3 &to);
 
     /**
      * Creates a new vector that is the current vector plus the
@@ -94,14 +85,14 @@ struct Vector3
      * @param   w  Vector to add to the current vector.
      * @return   Returns the resulting vector.
      */
-    Vector3 operator+(const Vector3 &w) const;
+    constexpr Vector3 operator+(const Vector3 &w) const;
 
     /**
      * Adds vector w to the current vector.
      * @param   w  Vector to add to the current vector.
      * @return  Returns the address of the current vector.
      */
-    Vector3 &operator+=(const Vector3 &w);
+    constexpr Vector3 &operator+=(const Vector3 &w);
 
     /**
      * Creates a new vector that is the current vector minus the
@@ -109,14 +100,14 @@ struct Vector3
      * @param   w  Vector to subtract from the current vector.
      * @return   Returns the resulting vector.
      */
-    Vector3 operator-(const Vector3 &w) const;
+    constexpr Vector3 operator-(const Vector3 &w) const;
 
     /**
      * Subtracts vector w from the current vector.
      * @param   w  Vector to subtract from the current vector.
      * @return  Returns the address of the current vector.
      */
-    Vector3 &operator-=(const Vector3 &w);
+    constexpr Vector3 &operator-=(const Vector3 &w);
 
     /**
      * Creates a new vector that is the current vector multiplied
@@ -124,14 +115,14 @@ struct Vector3
      * @param   scalar   Scalar to muliply the vector with.
      * @return  Returns the resulting vector
      */
-    Vector3 operator*(float scalar) const;
+    constexpr Vector3 operator*(float scalar) const;
 
     /**
      * Multiplies the current vector by a scalar
      * @param   scalar   Scalar to muliply the vector with.
      * @return  Returns the address of the current vector.
      */
-    Vector3 &operator*=(float scalar);
+    constexpr Vector3 &operator*=(float scalar);
 
     /**
      * Equality operator.
@@ -139,7 +130,7 @@ struct Vector3
      * @return  Returns true if vector w equals the current vector,
      *          false otherwise.
      */
-    bool operator==(const Vector3 &w) const;
+    constexpr bool operator==(const Vector3 &w) const;
 
     /**
      * Computes the dot product of the current vector with the
@@ -147,14 +138,14 @@ struct Vector3
      * @param   w  Vector
      * @return  Returns the dot product (a scalar).
      */
-    float dot(const Vector3 &w) const;
+    constexpr float dot(const Vector3 &w) const;
 
     /**
      * Computes the cross product of current vector with w
      * @param   w  Vector to take the cross product with (current X w)
      * @return  Returns the resulting vector.
      */
-    Vector3 cross(const Vector3 &w) const;
+    constexpr Vector3 cross(const Vector3 &w) const;
 
     /**
      * Computes the norm (length) of the current vector.
@@ -167,7 +158,7 @@ struct Vector3
      * (Useful when absolute distance is not required)
      * @return  Returns the length squared of the vector.
      */
-    float norm_squared() const;
+    constexpr float norm_squared() const;
 
     /**
      * Normalizes the vector.
@@ -181,7 +172,7 @@ struct Vector3
      * @param   w  Vector to determine component along.
      * @return  Returns the component of the current vector along w.
      */
-    float component(const Vector3 &w) const;
+    constexpr float component(const Vector3 &w) const;
 
     /**
      * Creates a new vector that is the projection of the current
@@ -189,7 +180,7 @@ struct Vector3
      * @param   w  Vector to determine projection along.
      * @return  Returns the new vector.
      */
-    Vector3 projection(const Vector3 &w) const;
+    constexpr Vector3 projection(const Vector3 &w) const;
 
     /**
      * Calculates the angle (radians) between the current vector and
@@ -207,13 +198,160 @@ struct Vector3
      * @param   normal   unit length normal to the plane where reflection occurs
      * @return  Returns the reflected vector
      */
-    Vector3 reflect(const Vector3 &normal) const;
+    constexpr Vector3 reflect(const Vector3 &normal) const;
 };
 
+static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 must be trivially copyable");
+static_assert(std::is_standard_layout<Vector3>::value, "Vector3 must be standard layout");
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be 3 packed floats");
+
 /**
  * Overloading: allows float * Vector3
  */
-Vector3 operator*(float s, const Vector3 &v);
+constexpr Vector3 operator*(float s, const Vector3 &v);
+
+
+constexpr Vector3::Vector3() : x(0.0f), y(0.0f), z(0.0f) {}
+
+constexpr Vector3::Vector3(const Point3 &p) : x(p.x), y(p.y), z(p.z) {}
+
+constexpr Vector3::Vector3(float ix, float iy, float iz) : x(ix), y(iy), z(iz) {}
+
+constexpr Vector3::Vector3(const Point3 &from, const Point3 &to) :
+    x(to.x - from.x), y(to.y - from.y), z(to.z - from.z)
+{
+}
+
+constexpr void Vector3::set(float ix, float iy, float iz)
+{
+    x = ix;
+    y = iy;
+    z = iz;
+}
+
+constexpr void Vector3::set(const Point3 &p)
+{
+    x = p.x;
+    y = p.y;
+    z = p.z;
+}
+
+constexpr void Vector3::set(const Point3 &from, const Point3 &to)
+{
+    x = to.x - from.x;
+    y = to.y - from.y;
+    z = to.z - from.z;
+}
+
+constexpr Vector3 Vector3::operator+(const Vector3 &w) const
+{
+    return Vector3(x + w.x, y + w.y, z + w.z);
+}
+
+constexpr Vector3 &Vector3::operator+=(const Vector3 &w)
+{
+    x += w.x;
+    y += w.y;
+    z += w.z;
+    return *this;
+}
+
+constexpr Vector3 Vector3::operator-(const Vector3 &w) const
+{
+    return Vector3(x - w.x, y - w.y, z - w.z);
+}
+
+constexpr Vector3 &Vector3::operator-=(const Vector3 &w)
+{
+    x -= w.x;
+    y -= w.y;
+    z -= w.z;
+    return *this;
+}
+
+constexpr Vector3 Vector3::operator*(float scalar) const
+{
+    return Vector3(x * scalar, y * scalar, z * scalar);
+}
+
+constexpr Vector3 &Vector3::operator*=(float scalar)
+{
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+    return *this;
+}
+
+constexpr bool Vector3::operator==(const Vector3 &w) const
+{
+    return (x == w.x && y == w.y && z == w.z);
+}
+
+constexpr float Vector3::dot(const Vector3 &w) const { return (x * w.x + y * w.y + z * w.z); }
+
+constexpr Vector3 Vector3::cross(const Vector3 &w) const
+{
+    return Vector3(y * w.z - z * w.y, z * w.x - x * w.z, x * w.y - y * w.x);
+}
+
+inline float Vector3::norm() const { return std::sqrt(norm_squared()); }
+
+constexpr float Vector3::norm_squared() const { return (dot(*this)); }
+
+inline Vector3 &Vector3::normalize()
+{
+    // Normalize the vector if the norm is not 0 or 1
+    float n = norm();
+    if(n > EPSILON && n != 1.0f)
+    {
+        float inv = 1.0f / n;
+        x *= inv;
+        y *= inv;
+        z *= inv;
+    }
+    return *this;
+}
+
+constexpr float Vector3::component(const Vector3 &w) const
+{
+    float n = w.dot(w);
+    return (n != 0.0f) ? (dot(w) / n) : 0.0f;
+}
+
+constexpr Vector3 Vector3::projection(const Vector3 &w) const { return w * component(w); }
+
+inline float Vector3::angle_between(const Vector3 &w) const
+{
+    return std::acos(dot(w) / (norm() * w.norm()));
+}
+
+constexpr Vector3 Vector3::reflect(const Vector3 &normal) const
+{
+    Vector3 d = *this;
+    return (d - (normal * (2.0f * (d.dot(normal)))));
+}
+
+constexpr Vector3 operator*(float s, const Vector3 &v)
+{
+    return Vector3(v.x * s, v.y * s, v.z * s);
+}
+
+// Point3 operations involving Vector3
+
+constexpr Point3 Point3::operator+(const Vector3 &v) const
+{
+    return Point3(x + v.x, y + v.y, z + v.z);
+}
+
+constexpr Point3 Point3::operator-(const Vector3 &v) const
+{
+    return Point3(x - v.x, y - v.y, z - v.z);
+}
+
+constexpr Vector3 Point3::operator-(const Point3 &p) const
+{
+    return Vector3(x - p.x, y - p.y, z - p.z);
+}
 
 } // namespace cg
 
@@ -0,0 +1,255 @@
+#include "geometry/vector_kernels.hpp"
+
+#include "geometry/geometry.hpp"
+#include "geometry/simd.hpp"
+
+namespace cg
+{
+
+namespace
+{
+
+#if defined(CG_SIMD_SSE)
+// Same operation order as Vector3::dot
+inline __m128 dot4(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+// Scales 4 vectors to unit length. Vectors with length <= EPSILON are kept.
+inline void normalize4(__m128 &x, __m128 &y, __m128 &z)
+{
+    // Same operations and mask as Vector3::normalize (lengths not greater
+    // than EPSILON and unit lengths are left unchanged), so the results are
+    // identical. The mask needs the length, and 1 / length from it costs
+    // less than a second reciprocal square root path.
+    __m128 len = _mm_sqrt_ps(dot4(x, y, z, x, y, z));
+    __m128 mask = _mm_and_ps(_mm_cmpgt_ps(len, _mm_set1_ps(EPSILON)),
+                             _mm_cmpneq_ps(len, _mm_set1_ps(1.0f)));
+    __m128 s = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(_mm_set1_ps(1.0f), len)),
+                         _mm_andnot_ps(mask, _mm_set1_ps(1.0f)));
+    x = _mm_mul_ps(x, s);
+    y = _mm_mul_ps(y, s);
+    z = _mm_mul_ps(z, s);
+}
+
+// Same operation order as Vector3::cross
+inline void cross4(__m128  ax,
+                   __m128  ay,
+                   __m128  az,
+                   __m128  bx,
+                   __m128  by,
+                   __m128  bz,
+                   __m128 &x,
+                   __m128 &y,
+                   __m128 &z)
+{
+    x = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+    y = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+    z = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+}
+
+// Same operation order as Vector3::reflect
+inline void reflect4(__m128 &x, __m128 &y, __m128 &z, __m128 nx, __m128 ny, __m128 nz)
+{
+    __m128 s = _mm_mul_ps(_mm_set1_ps(2.0f), dot4(x, y, z, nx, ny, nz));
+    x = _mm_sub_ps(x, _mm_mul_ps(nx, s));
+    y = _mm_sub_ps(y, _mm_mul_ps(ny, s));
+    z = _mm_sub_ps(z, _mm_mul_ps(nz, s));
+}
+#endif
+
+} // namespace
+
+void normalize_all(Vector3 *v, size_t count)
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z;
+        simd::load_xyz4(&v[i].x, x, y, z);
+        normalize4(x, y, z);
+        simd::store_xyz4(&v[i].x, x, y, z);
+    }
+#endif
+    for(; i < count; i++) v[i].normalize();
+}
+
+void normalize_all(Vector3Array &v)
+{
+    size_t count = v.size();
+    float *vx = v.x();
+    float *vy = v.y();
+    float *vz = v.z();
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_load_ps(vx + i);
+        __m128 y = _mm_load_ps(vy + i);
+        __m128 z = _mm_load_ps(vz + i);
+        normalize4(x, y, z);
+        _mm_store_ps(vx + i, x);
+        _mm_store_ps(vy + i, y);
+        _mm_store_ps(vz + i, z);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        Vector3 n = Vector3(vx[i], vy[i], vz[i]).normalize();
+        vx[i] = n.x;
+        vy[i] = n.y;
+        vz[i] = n.z;
+    }
+}
+
+void dot_many(const Vector3 *a, const Vector3 *b, float *dst, size_t count)
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 ax, ay, az, bx, by, bz;
+        simd::load_xyz4(&a[i].x, ax, ay, az);
+        simd::load_xyz4(&b[i].x, bx, by, bz);
+        _mm_storeu_ps(dst + i, dot4(ax, ay, az, bx, by, bz));
+    }
+#endif
+    for(; i < count; i++) dst[i] = a[i].dot(b[i]);
+}
+
+void dot_many(const Vector3Array &a, const Vector3Array &b, float *dst)
+{
+    size_t       count = a.size();
+    const float *ax = a.x();
+    const float *ay = a.y();
+    const float *az = a.z();
+    const float *bx = b.x();
+    const float *by = b.y();
+    const float *bz = b.z();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(dst + i,
+                      dot4(_mm_load_ps(ax + i),
+                           _mm_load_ps(ay + i),
+                           _mm_load_ps(az + i),
+                           _mm_load_ps(bx + i),
+                           _mm_load_ps(by + i),
+                           _mm_load_ps(bz + i)));
+    }
+#endif
+    for(; i < count; i++) dst[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+}
+
+void cross_many(const Vector3 *a, const Vector3 *b, Vector3 *dst, size_t count)
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 ax, ay, az, bx, by, bz, x, y, z;
+        simd::load_xyz4(&a[i].x, ax, ay, az);
+        simd::load_xyz4(&b[i].x, bx, by, bz);
+        cross4(ax, ay, az, bx, by, bz, x, y, z);
+        simd::store_xyz4(&dst[i].x, x, y, z);
+    }
+#endif
+    for(; i < count; i++) dst[i] = a[i].cross(b[i]);
+}
+
+void cross_many(const Vector3Array &a, const Vector3Array &b, Vector3Array &dst)
+{
+    size_t count = a.size();
+    dst.resize(count);
+    const float *ax = a.x();
+    const float *ay = a.y();
+    const float *az = a.z();
+    const float *bx = b.x();
+    const float *by = b.y();
+    const float *bz = b.z();
+    float       *dx = dst.x();
+    float       *dy = dst.y();
+    float       *dz = dst.z();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z;
+        cross4(_mm_load_ps(ax + i),
+               _mm_load_ps(ay + i),
+               _mm_load_ps(az + i),
+               _mm_load_ps(bx + i),
+               _mm_load_ps(by + i),
+               _mm_load_ps(bz + i),
+               x,
+               y,
+               z);
+        _mm_store_ps(dx + i, x);
+        _mm_store_ps(dy + i, y);
+        _mm_store_ps(dz + i, z);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        Vector3 c = Vector3(ax[i], ay[i], az[i]).cross(Vector3(bx[i], by[i], bz[i]));
+        dx[i] = c.x;
+        dy[i] = c.y;
+        dz[i] = c.z;
+    }
+}
+
+void reflect_many(const Vector3 *v, const Vector3 *normal, Vector3 *dst, size_t count)
+{
+    size_t i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z, nx, ny, nz;
+        simd::load_xyz4(&v[i].x, x, y, z);
+        simd::load_xyz4(&normal[i].x, nx, ny, nz);
+        reflect4(x, y, z, nx, ny, nz);
+        simd::store_xyz4(&dst[i].x, x, y, z);
+    }
+#endif
+    for(; i < count; i++) dst[i] = v[i].reflect(normal[i]);
+}
+
+void reflect_many(const Vector3Array &v, const Vector3Array &normal, Vector3Array &dst)
+{
+    size_t count = v.size();
+    dst.resize(count);
+    const float *vx = v.x();
+    const float *vy = v.y();
+    const float *vz = v.z();
+    const float *nx = normal.x();
+    const float *ny = normal.y();
+    const float *nz = normal.z();
+    float       *dx = dst.x();
+    float       *dy = dst.y();
+    float       *dz = dst.z();
+    size_t       i = 0;
+#if defined(CG_SIMD_SSE)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_load_ps(vx + i);
+        __m128 y = _mm_load_ps(vy + i);
+        __m128 z = _mm_load_ps(vz + i);
+        reflect4(x, y, z, _mm_load_ps(nx + i), _mm_load_ps(ny + i), _mm_load_ps(nz + i));
+        _mm_store_ps(dx + i, x);
+        _mm_store_ps(dy + i, y);
+        _mm_store_ps(dz + i, z);
+    }
+#endif
+    for(; i < count; i++)
+    {
+        Vector3 r = Vector3(vx[i], vy[i], vz[i]).reflect(Vector3(nx[i], ny[i], nz[i]));
+        dx[i] = r.x;
+        dy[i] = r.y;
+        dz[i] = r.z;
+    }
+}
+
+} // namespace cg
@@ -0,0 +1,95 @@
+//============================================================================
+//	Johns Hopkins University Engineering for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    vector_kernels.hpp
+//	Purpose: Batch Vector3 operations (normalize, dot, cross, reflect) over
+//           contiguous array-of-structs lists or structure-of-arrays data.
+//============================================================================
+
+#ifndef __GEOMETRY_VECTOR_KERNELS_HPP__
+#define __GEOMETRY_VECTOR_KERNELS_HPP__
+
+#include "geometry/point_arrays.hpp"
+#include "geometry/vector3.hpp"
+
+#include <cstddef>
+
+namespace cg
+{
+
+/**
+ * Normalizes an array of vectors in place, 4 at a time with SSE. Results
+ * are identical to Vector3::normalize: vectors whose length is not greater
+ * than EPSILON or is exactly 1 are left unchanged.
+ * @param  v      Vectors to normalize.
+ * @param  count  Number of vectors.
+ */
+void normalize_all(Vector3 *v, size_t count);
+
+/**
+ * Normalizes structure-of-arrays vectors in place. See normalize_all above.
+ * @param  v  Vectors to normalize.
+ */
+void normalize_all(Vector3Array &v);
+
+/**
+ * Computes dst[i] = a[i].dot(b[i]).
+ * @param  a      First vectors.
+ * @param  b      Second vectors.
+ * @param  dst    Dot products (must hold count floats).
+ * @param  count  Number of vectors.
+ */
+void dot_many(const Vector3 *a, const Vector3 *b, float *dst, size_t count);
+
+/**
+ * Computes dst[i] = a[i].dot(b[i]) for structure-of-arrays vectors. a and b
+ * must be the same size.
+ * @param  a    First vectors.
+ * @param  b    Second vectors.
+ * @param  dst  Dot products (must hold a.size() floats).
+ */
+void dot_many(const Vector3Array &a, const Vector3Array &b, float *dst);
+
+/**
+ * Computes dst[i] = a[i].cross(b[i]). dst may be either source.
+ * @param  a      First vectors.
+ * @param  b      Second vectors.
+ * @param  dst    Cross products (must hold count elements).
+ * @param  count  Number of vectors.
+ */
+void cross_many(const Vector3 *a, const Vector3 *b, Vector3 *dst, size_t count);
+
+/**
+ * Computes dst[i] = a[i].cross(b[i]) for structure-of-arrays vectors. a and b
+ * must be the same size. dst is resized to match and may be either source.
+ * @param  a    First vectors.
+ * @param  b    Second vectors.
+ * @param  dst  Cross products.
+ */
+void cross_many(const Vector3Array &a, const Vector3Array &b, Vector3Array &dst);
+
+/**
+ * Computes dst[i] = v[i].reflect(normal[i]). dst may be either source.
+ * @param  v       Vectors to reflect.
+ * @param  normal  Unit length normals of the reflecting surfaces.
+ * @param  dst     Reflected vectors (must hold count elements).
+ * @param  count   Number of vectors.
+ */
+void reflect_many(const Vector3 *v, const Vector3 *normal, Vector3 *dst, size_t count);
+
+/**
+ * Computes dst[i] = v[i].reflect(normal[i]) for structure-of-arrays vectors.
+ * v and normal must be the same size. dst is resized to match and may be
+ * either source.
+ * @param  v       Vectors to reflect.
+ * @param  normal  Unit length normals of the reflecting surfaces.
+ * @param  dst     Reflected vectors.
+ */
+void reflect_many(const Vector3Array &v, const Vector3Array &normal, Vector3Array &dst);
+
+} // namespace cg
+
+#endif
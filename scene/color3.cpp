@@ -12,18 +12,8 @@ Color3::Color3() : r(0.0f), g(0.0f), b(0.0f) {}
 
 Color3::Color3(float red, float green, float blue) : r(red), g(green), b(blue) {}
 
-Color3::Color3(const Color3 &c) : r(c.r), g(c.g), b(c.b) {}
-
 Color3::Color3(const Color4 &c) : r(c.r), g(c.g), b(c.b) {}
 
-Color3 &Color3::operator=(const Color3 &c)
-{
-    r = c.r;
-    g = c.g;
-    b = c.b;
-    return *this;
-}
-
 void Color3::set(float ir, float ig, float ib)
 {
     r = ir;
@@ -13,6 +13,7 @@
 #define __SCENE_COLOR3_HPP__
 
 #include <cstdint>
+#include <type_traits>
 
 namespace cg
 {
@@ -44,25 +45,12 @@ struct Color3
      */
     Color3(float red, float green, float blue);
 
-    /**
-     * Copy constructor.
-     * @param	c	Color assigned to member.
-     */
-    Color3(const Color3 &c);
-
     /**
      * Copy constructor given an RGBA color (ignores alpha).
      * @param	c	Color assigned to member.
      */
     Color3(const Color4 &c);
 
-    /**
-     * Assignment operator.
-     * @param	c	Color to assign to the object.
-     * @return	Returns the address of the member data.
-     */
-    Color3 &operator=(const Color3 &c);
-
     /**
      *	Set the color to the specified RGB values.
      * @param	ir		Red intensity
@@ -120,6 +108,10 @@ struct Color3
     void clamp();
 };
 
+static_assert(std::is_trivially_copyable<Color3>::value, "Color3 must be trivially copyable");
+static_assert(std::is_standard_layout<Color3>::value, "Color3 must be standard layout");
+static_assert(sizeof(Color3) == 3 * sizeof(float), "Color3 must be 3 packed floats");
+
 } // namespace cg
 
 #endif
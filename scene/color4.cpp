@@ -16,17 +16,6 @@ Color4::Color4(float red, float green, float blue) : r(red), g(green), b(blue),
 
 Color4::Color4(const Color3 &c) : r(c.r), g(c.g), b(c.b), a(1.0f) {}
 
-Color4::Color4(const Color4 &c) : r(c.r), g(c.g), b(c.b), a(c.a) {}
-
-Color4 &Color4::operator=(const Color4 &c)
-{
-    r = c.r;
-    g = c.g;
-    b = c.b;
-    a = c.a;
-    return *this;
-}
-
 void Color4::set(float ir, float ig, float ib, float ia)
 {
     r = ir;
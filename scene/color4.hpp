@@ -15,6 +15,7 @@
 #include "scene/color3.hpp"
 
 #include <cstdint>
+#include <type_traits>
 
 namespace cg
 {
@@ -59,19 +60,6 @@ struct Color4
      */
     Color4(const Color3 &c);
 
-    /**
-     * Copy constructor.
-     * @param c Color assigned to member.
-     */
-    Color4(const Color4 &c);
-
-    /**
-     * Assignment operator.
-     * @param  c Color to assign to the object.
-     * @return Returns the address of the member data.
-     */
-    Color4 &operator=(const Color4 &c);
-
     /**
      *	Set the color to the specified RGB values.
      * @param	ir		Red intensity
@@ -140,6 +128,10 @@ struct Color4
     void clamp();
 };
 
+static_assert(std::is_trivially_copyable<Color4>::value, "Color4 must be trivially copyable");
+static_assert(std::is_standard_layout<Color4>::value, "Color4 must be standard layout");
+static_assert(sizeof(Color4) == 4 * sizeof(float), "Color4 must be 4 packed floats");
+
 } // namespace cg
 
 #endif
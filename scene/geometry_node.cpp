@@ -9,4 +9,6 @@ GeometryNode::~GeometryNode() {}
 
 void GeometryNode::draw(SceneState &scene_state) {}
 
+bool GeometryNode::draws_itself() const { return true; }
+
 } // namespace cg
@@ -38,6 +38,15 @@ class GeometryNode : public SceneNode
      * @param  scene_state  Current scene state
      */
     virtual void draw(SceneState &scene_state) override;
+
+  protected:
+    /**
+     * Geometry nodes draw themselves. Derived classes that do not describe
+     * their draws (override compile) are compiled as a packet drawn with
+     * draw().
+     * @return  Returns true.
+     */
+    bool draws_itself() const override;
 };
 
 } // namespace cg
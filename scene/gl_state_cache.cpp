@@ -0,0 +1,247 @@
+#include "scene/gl_state_cache.hpp"
+
+namespace cg
+{
+
+namespace
+{
+
+// Capabilities kept in the cache (others are passed through)
+constexpr GLenum CACHED_CAPS[] = {GL_BLEND,
+                                  GL_CULL_FACE,
+                                  GL_DEPTH_TEST,
+                                  GL_LINE_SMOOTH,
+                                  GL_MULTISAMPLE,
+                                  GL_POLYGON_OFFSET_FILL,
+                                  GL_PROGRAM_POINT_SIZE,
+                                  GL_SCISSOR_TEST,
+                                  GL_STENCIL_TEST};
+
+// Buffer targets kept in the cache, with their binding queries
+constexpr GLenum CACHED_BUFFER_TARGETS[] = {
+    GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER};
+constexpr GLenum BUFFER_BINDINGS[] = {
+    GL_ARRAY_BUFFER_BINDING, GL_ELEMENT_ARRAY_BUFFER_BINDING, GL_UNIFORM_BUFFER_BINDING};
+
+constexpr int ELEMENT_ARRAY = 1;
+
+int cap_index(GLenum cap)
+{
+    for(int i = 0; i < static_cast<int>(sizeof(CACHED_CAPS) / sizeof(GLenum)); i++)
+    {
+        if(CACHED_CAPS[i] == cap) return i;
+    }
+    return -1;
+}
+
+int buffer_index(GLenum target)
+{
+    for(int i = 0; i < static_cast<int>(sizeof(CACHED_BUFFER_TARGETS) / sizeof(GLenum)); i++)
+    {
+        if(CACHED_BUFFER_TARGETS[i] == target) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+GLStateCache::GLStateCache() : calls_issued_(0), calls_avoided_(0) { invalidate(); }
+
+void GLStateCache::invalidate()
+{
+    program_ = UNKNOWN;
+    vao_ = UNKNOWN;
+    for(GLuint &b : buffers_) b = UNKNOWN;
+    for(int8_t &c : caps_) c = CAP_UNKNOWN;
+    blend_src_ = UNKNOWN;
+    blend_dst_ = UNKNOWN;
+    line_width_ = -1.0f;
+}
+
+void GLStateCache::begin_frame()
+{
+    calls_issued_ = 0;
+    calls_avoided_ = 0;
+}
+
+void GLStateCache::use_program(GLuint program)
+{
+    if(program == program_)
+    {
+        calls_avoided_++;
+        return;
+    }
+    glUseProgram(program);
+    program_ = program;
+    calls_issued_++;
+}
+
+GLuint GLStateCache::get_program()
+{
+    if(program_ == UNKNOWN)
+    {
+        GLint program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        program_ = static_cast<GLuint>(program);
+        calls_issued_++;
+    }
+    else { calls_avoided_++; }
+    return program_;
+}
+
+void GLStateCache::bind_vertex_array(GLuint vao)
+{
+    if(vao == vao_)
+    {
+        calls_avoided_++;
+        return;
+    }
+    glBindVertexArray(vao);
+    vao_ = vao;
+    buffers_[ELEMENT_ARRAY] = UNKNOWN;
+    calls_issued_++;
+}
+
+GLuint GLStateCache::get_vertex_array()
+{
+    if(vao_ == UNKNOWN)
+    {
+        GLint vao = 0;
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+        vao_ = static_cast<GLuint>(vao);
+        calls_issued_++;
+    }
+    else { calls_avoided_++; }
+    return vao_;
+}
+
+void GLStateCache::bind_buffer(GLenum target, GLuint buffer)
+{
+    int i = buffer_index(target);
+    if(i >= 0 && buffers_[i] == buffer)
+    {
+        calls_avoided_++;
+        return;
+    }
+    glBindBuffer(target, buffer);
+    if(i >= 0) buffers_[i] = buffer;
+    calls_issued_++;
+}
+
+void GLStateCache::delete_vertex_array(GLuint vao)
+{
+    glDeleteVertexArrays(1, &vao);
+    if(vao == vao_)
+    {
+        vao_ = 0;
+        buffers_[ELEMENT_ARRAY] = UNKNOWN;
+    }
+}
+
+void GLStateCache::delete_buffer(GLuint buffer)
+{
+    glDeleteBuffers(1, &buffer);
+    for(GLuint &b : buffers_)
+    {
+        if(b == buffer) b = 0;
+    }
+}
+
+void GLStateCache::enable(GLenum cap) { set_enabled(cap, true); }
+
+void GLStateCache::disable(GLenum cap) { set_enabled(cap, false); }
+
+void GLStateCache::set_enabled(GLenum cap, bool enabled)
+{
+    int    i = cap_index(cap);
+    int8_t state = enabled ? CAP_ENABLED : CAP_DISABLED;
+    if(i >= 0 && caps_[i] == state)
+    {
+        calls_avoided_++;
+        return;
+    }
+    if(enabled) glEnable(cap);
+    else glDisable(cap);
+    if(i >= 0) caps_[i] = state;
+    calls_issued_++;
+}
+
+bool GLStateCache::is_enabled(GLenum cap)
+{
+    int i = cap_index(cap);
+    if(i < 0)
+    {
+        calls_issued_++;
+        return glIsEnabled(cap) == GL_TRUE;
+    }
+    return cap_state(i, cap) == CAP_ENABLED;
+}
+
+void GLStateCache::blend_func(GLenum src_factor, GLenum dst_factor)
+{
+    if(src_factor == blend_src_ && dst_factor == blend_dst_)
+    {
+        calls_avoided_++;
+        return;
+    }
+    glBlendFunc(src_factor, dst_factor);
+    blend_src_ = src_factor;
+    blend_dst_ = dst_factor;
+    calls_issued_++;
+}
+
+GLenum GLStateCache::get_blend_src()
+{
+    query_blend_func();
+    return blend_src_;
+}
+
+GLenum GLStateCache::get_blend_dst()
+{
+    query_blend_func();
+    return blend_dst_;
+}
+
+void GLStateCache::line_width(float width)
+{
+    if(width == line_width_)
+    {
+        calls_avoided_++;
+        return;
+    }
+    glLineWidth(width);
+    line_width_ = width;
+    calls_issued_++;
+}
+
+uint32_t GLStateCache::get_calls_issued() const { return calls_issued_; }
+
+uint32_t GLStateCache::get_calls_avoided() const { return calls_avoided_; }
+
+int8_t GLStateCache::cap_state(int i, GLenum cap)
+{
+    if(caps_[i] == CAP_UNKNOWN)
+    {
+        caps_[i] = glIsEnabled(cap) == GL_TRUE ? CAP_ENABLED : CAP_DISABLED;
+        calls_issued_++;
+    }
+    else { calls_avoided_++; }
+    return caps_[i];
+}
+
+void GLStateCache::query_blend_func()
+{
+    if(blend_src_ == UNKNOWN || blend_dst_ == UNKNOWN)
+    {
+        GLint src = 0;
+        GLint dst = 0;
+        glGetIntegerv(GL_BLEND_SRC_RGB, &src);
+        glGetIntegerv(GL_BLEND_DST_RGB, &dst);
+        blend_src_ = static_cast<GLenum>(src);
+        blend_dst_ = static_cast<GLenum>(dst);
+        calls_issued_ += 2;
+    }
+    else { calls_avoided_++; }
+}
+
+} // namespace cg
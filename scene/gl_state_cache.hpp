@@ -0,0 +1,210 @@
+//============================================================================
+//	Johns Hopkins University Engineering Programs for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    gl_state_cache.hpp
+//	Purpose: CPU-side copy of OpenGL binding and capability state.
+//
+//============================================================================
+
+#ifndef __SCENE_GL_STATE_CACHE_HPP__
+#define __SCENE_GL_STATE_CACHE_HPP__
+
+#include "scene/graphics.hpp"
+
+#include <cstdint>
+
+namespace cg
+{
+
+/**
+ * Shadow of the OpenGL state the scene nodes change: the program, vertex
+ * array and buffer bindings, blending and capabilities (glEnable). Setting
+ * state that already has the value skips the GL call, and queries are
+ * answered from the copy instead of glGet/glIsEnabled, which can stall the
+ * driver until the GL thread catches up.
+ *
+ * State starts unknown: the first set is always issued and the first query
+ * of a value goes to GL once. Code that changes this state without the
+ * cache must restore it afterwards or call invalidate, and vertex arrays
+ * and buffers the cache may have bound must be deleted through it. Binding
+ * a vertex array also makes the element array buffer binding unknown (it is
+ * part of the vertex array state).
+ *
+ * Capabilities outside a fixed set (GL_BLEND, GL_DEPTH_TEST, ...) and buffer
+ * targets other than the array, element array and uniform buffers are passed
+ * through to GL without caching.
+ */
+class GLStateCache
+{
+  public:
+    /**
+     * Constructor. All state is unknown.
+     */
+    GLStateCache();
+
+    /**
+     * Forget all state, so the following calls are issued to GL. Use after
+     * GL calls made without the cache or when the context changes.
+     */
+    void invalidate();
+
+    /**
+     * Reset the call counters. Call at the start of each frame.
+     */
+    void begin_frame();
+
+    /**
+     * Make a program current (glUseProgram).
+     * @param  program  Program object, 0 for none.
+     */
+    void use_program(GLuint program);
+
+    /**
+     * Get the current program.
+     * @return  Returns the program object.
+     */
+    GLuint get_program();
+
+    /**
+     * Bind a vertex array object (glBindVertexArray).
+     * @param  vao  Vertex array object, 0 to unbind.
+     */
+    void bind_vertex_array(GLuint vao);
+
+    /**
+     * Get the bound vertex array object.
+     * @return  Returns the vertex array object.
+     */
+    GLuint get_vertex_array();
+
+    /**
+     * Bind a buffer object to a target (glBindBuffer).
+     * @param  target  Buffer target (GL_ARRAY_BUFFER, ...).
+     * @param  buffer  Buffer object, 0 to unbind.
+     */
+    void bind_buffer(GLenum target, GLuint buffer);
+
+    /**
+     * Delete a vertex array object (glDeleteVertexArrays). If it is bound,
+     * the binding reverts to 0 as it does in GL, so a later object that
+     * reuses the name is bound again.
+     * @param  vao  Vertex array object.
+     */
+    void delete_vertex_array(GLuint vao);
+
+    /**
+     * Delete a buffer object (glDeleteBuffers). Targets it is bound to
+     * revert to 0.
+     * @param  buffer  Buffer object.
+     */
+    void delete_buffer(GLuint buffer);
+
+    /**
+     * Enable a capability (glEnable).
+     * @param  cap  Capability (GL_BLEND, GL_DEPTH_TEST, ...).
+     */
+    void enable(GLenum cap);
+
+    /**
+     * Disable a capability (glDisable).
+     * @param  cap  Capability (GL_BLEND, GL_DEPTH_TEST, ...).
+     */
+    void disable(GLenum cap);
+
+    /**
+     * Enable or disable a capability.
+     * @param  cap      Capability (GL_BLEND, GL_DEPTH_TEST, ...).
+     * @param  enabled  True to enable, false to disable.
+     */
+    void set_enabled(GLenum cap, bool enabled);
+
+    /**
+     * Check if a capability is enabled.
+     * @param  cap  Capability (GL_BLEND, GL_DEPTH_TEST, ...).
+     * @return  Returns true if the capability is enabled.
+     */
+    bool is_enabled(GLenum cap);
+
+    /**
+     * Set the blend function for color and alpha (glBlendFunc).
+     * @param  src_factor  Source blend factor.
+     * @param  dst_factor  Destination blend factor.
+     */
+    void blend_func(GLenum src_factor, GLenum dst_factor);
+
+    /**
+     * Get the source blend factor.
+     * @return  Returns the source factor of the blend function.
+     */
+    GLenum get_blend_src();
+
+    /**
+     * Get the destination blend factor.
+     * @return  Returns the destination factor of the blend function.
+     */
+    GLenum get_blend_dst();
+
+    /**
+     * Set the width of rasterized lines (glLineWidth).
+     * @param  width  Line width in pixels.
+     */
+    void line_width(float width);
+
+    /**
+     * Get the number of GL calls (state changes and queries) issued since
+     * begin_frame.
+     * @return  Returns the number of calls issued.
+     */
+    uint32_t get_calls_issued() const;
+
+    /**
+     * Get the number of GL calls avoided since begin_frame: state changes
+     * to the current value and queries answered from the cache.
+     * @return  Returns the number of calls avoided.
+     */
+    uint32_t get_calls_avoided() const;
+
+  private:
+    // Marks a binding or factor as unknown
+    static constexpr uint32_t UNKNOWN = UINT32_MAX;
+
+    // Capability states
+    static constexpr int8_t CAP_UNKNOWN = -1;
+    static constexpr int8_t CAP_DISABLED = 0;
+    static constexpr int8_t CAP_ENABLED = 1;
+
+    // Cached capabilities and buffer targets
+    static constexpr int CAP_COUNT = 9;
+    static constexpr int BUFFER_TARGET_COUNT = 3;
+
+    GLuint program_;
+    GLuint vao_;
+    GLuint buffers_[BUFFER_TARGET_COUNT];
+    int8_t caps_[CAP_COUNT];
+    GLenum blend_src_;
+    GLenum blend_dst_;
+    float  line_width_; // Negative when unknown
+
+    uint32_t calls_issued_;
+    uint32_t calls_avoided_;
+
+    /**
+     * Query a capability from GL if it is unknown.
+     * @param  i    Index of the capability.
+     * @param  cap  Capability.
+     * @return  Returns the capability state.
+     */
+    int8_t cap_state(int i, GLenum cap);
+
+    /**
+     * Query the blend function from GL if it is unknown.
+     */
+    void query_blend_func();
+};
+
+} // namespace cg
+
+#endif
@@ -9,6 +9,7 @@ PresentationNode::PresentationNode()
       blending_enabled_(false),
       src_blend_factor_(GL_SRC_ALPHA),
       dst_blend_factor_(GL_ONE_MINUS_SRC_ALPHA),
+      layer_(0),
       previous_blend_state_(false),
       previous_src_factor_(GL_SRC_ALPHA),
       previous_dst_factor_(GL_ONE_MINUS_SRC_ALPHA)
@@ -21,6 +22,7 @@ PresentationNode::PresentationNode(const Color4& color)
       blending_enabled_(color.a < 1.0f),  // Enable blending if not fully opaque
       src_blend_factor_(GL_SRC_ALPHA),
       dst_blend_factor_(GL_ONE_MINUS_SRC_ALPHA),
+      layer_(0),
       previous_blend_state_(false),
       previous_src_factor_(GL_SRC_ALPHA),
       previous_dst_factor_(GL_ONE_MINUS_SRC_ALPHA)
@@ -36,6 +38,7 @@ void PresentationNode::set_color(const Color4& color)
     {
         blending_enabled_ = true;
     }
+    scene_changed();
 }
 
 const Color4& PresentationNode::get_color() const
@@ -46,6 +49,7 @@ const Color4& PresentationNode::get_color() const
 void PresentationNode::set_blending_enabled(bool enable)
 {
     blending_enabled_ = enable;
+    scene_changed();
 }
 
 bool PresentationNode::is_blending_enabled() const
@@ -57,30 +61,42 @@ void PresentationNode::set_blend_function(GLenum src_factor, GLenum dst_factor)
 {
     src_blend_factor_ = src_factor;
     dst_blend_factor_ = dst_factor;
+    scene_changed();
+}
+
+void PresentationNode::set_layer(uint8_t layer)
+{
+    // Sort keys hold 4 bits of layer
+    layer_ = layer < 15 ? layer : 15;
+    scene_changed();
+}
+
+uint8_t PresentationNode::get_layer() const
+{
+    return layer_;
 }
 
 void PresentationNode::draw(SceneState& scene_state)
 {
-    // Store current OpenGL blend state
-    previous_blend_state_ = glIsEnabled(GL_BLEND) == GL_TRUE;
+    // Store current OpenGL blend state (from the state cache, not GL)
+    GLStateCache& gl = scene_state.gl_state;
+    previous_blend_state_ = gl.is_enabled(GL_BLEND);
     if (previous_blend_state_)
     {
-        glGetIntegerv(GL_BLEND_SRC_ALPHA, reinterpret_cast<GLint*>(&previous_src_factor_));
-        glGetIntegerv(GL_BLEND_DST_ALPHA, reinterpret_cast<GLint*>(&previous_dst_factor_));
+        previous_src_factor_ = gl.get_blend_src();
+        previous_dst_factor_ = gl.get_blend_dst();
     }
     
     // Set up blending if enabled
+    gl.set_enabled(GL_BLEND, blending_enabled_);
     if (blending_enabled_)
     {
-        glEnable(GL_BLEND);
-        glBlendFunc(src_blend_factor_, dst_blend_factor_);
-    }
-    else
-    {
-        glDisable(GL_BLEND);
+        gl.blend_func(src_blend_factor_, dst_blend_factor_);
     }
     
     // Set the color uniform if we have a valid location
+    Color4 previous_color = scene_state.color;
+    scene_state.color = color_;
     if (scene_state.color_loc != -1)
     {
         glUniform4f(scene_state.color_loc, color_.r, color_.g, color_.b, color_.a);
@@ -94,18 +110,35 @@ void PresentationNode::draw(SceneState& scene_state)
     // Draw all children with the current presentation state
     SceneNode::draw(scene_state);
     
-    // Restore previous blend state
-    if (previous_blend_state_)
+    // Restore previous color and blend state
+    scene_state.color = previous_color;
+    if (scene_state.color_loc != -1)
     {
-        glEnable(GL_BLEND);
-        glBlendFunc(previous_src_factor_, previous_dst_factor_);
+        glUniform4f(scene_state.color_loc, previous_color.r, previous_color.g,
+                    previous_color.b, previous_color.a);
     }
-    else
+    gl.set_enabled(GL_BLEND, previous_blend_state_);
+    if (previous_blend_state_)
     {
-        glDisable(GL_BLEND);
+        gl.blend_func(previous_src_factor_, previous_dst_factor_);
     }
     
     cg::check_error("PresentationNode::draw - end");
 }
 
+void PresentationNode::compile(RenderQueue& queue)
+{
+    RenderState state;
+    state.color = color_;
+    state.has_color = true;
+    state.blending = blending_enabled_;
+    state.src_factor = src_blend_factor_;
+    state.dst_factor = dst_blend_factor_;
+    state.layer = layer_;
+
+    queue.push_state(state);
+    compile_children(queue);
+    queue.pop_state();
+}
+
 } // namespace cg
@@ -65,17 +65,36 @@ class PresentationNode : public SceneNode
      */
     void set_blend_function(GLenum src_factor, GLenum dst_factor);
 
+    /**
+     * Set the sort layer of the draws below this node. With render queue
+     * sorting, lower layers are drawn first.
+     * @param layer Layer (0 to 15, larger values are clamped to 15)
+     */
+    void set_layer(uint8_t layer);
+
+    /**
+     * Get the sort layer
+     * @return Sort layer
+     */
+    uint8_t get_layer() const;
     
     /**
      * Draw. Sets the material properties.
      * @param  scene_state  Scene state (holds material uniform locations)
      */
     void draw(SceneState &scene_state) override;
+
+    /**
+     * Compile. Packets of the children use this color and blend state.
+     * @param  queue  Render queue being compiled
+     */
+    void compile(RenderQueue &queue) override;
   private:
     Color4 color_;              // Current color
     bool blending_enabled_;     // Whether blending is enabled
     GLenum src_blend_factor_;   // Source blend factor
     GLenum dst_blend_factor_;   // Destination blend factor
+    uint8_t layer_;             // Sort layer for the render queue
     
     // Store previous OpenGL state to restore after drawing children
     bool previous_blend_state_;
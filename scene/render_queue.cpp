@@ -0,0 +1,429 @@
+#include "scene/render_queue.hpp"
+
+#include "scene/scene_node.hpp"
+#include "scene/shader_node.hpp"
+#include "scene/transform_node.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cg
+{
+
+namespace
+{
+
+// Marks cached GL state as unknown during submit
+constexpr uint32_t UNKNOWN = UINT32_MAX;
+
+// Sort key layout, most significant bits first: layer (4), translucent (1),
+// then for opaque packets program (11), state (12), VAO (12), depth (24) and
+// for translucent packets far depth (24), program (11), state (12), VAO (12).
+// Ids past a field's largest value are clamped to it (see add_packet).
+constexpr uint32_t LAYER_SHIFT = 60;
+constexpr uint32_t TRANSLUCENT_SHIFT = 59;
+constexpr uint32_t SHADER_ID_MAX = (1 << 11) - 1;
+constexpr uint32_t STATE_ID_MAX = (1 << 12) - 1;
+constexpr uint32_t VAO_ID_MAX = (1 << 12) - 1;
+constexpr uint32_t DEPTH_MAX = (1 << 24) - 1;
+
+// Content of a render state, for sharing equal states
+std::array<uint32_t, 9> state_content(const RenderState &state)
+{
+    std::array<uint32_t, 9> c;
+    std::memcpy(&c[0], &state.color.r, sizeof(float));
+    std::memcpy(&c[1], &state.color.g, sizeof(float));
+    std::memcpy(&c[2], &state.color.b, sizeof(float));
+    std::memcpy(&c[3], &state.color.a, sizeof(float));
+    c[4] = state.has_color ? 1 : 0;
+    c[5] = state.blending ? 1 : 0;
+    c[6] = state.src_factor;
+    c[7] = state.dst_factor;
+    c[8] = state.layer;
+    return c;
+}
+
+// Stable LSD radix sort of keys (values move with them), 8 bits per pass.
+// Passes where all keys have the same byte are skipped, so keys that only
+// use a few of their bits sort in a few passes.
+void radix_sort(std::vector<uint64_t> &keys,
+                std::vector<uint32_t> &values,
+                std::vector<uint64_t> &key_scratch,
+                std::vector<uint32_t> &value_scratch)
+{
+    size_t n = keys.size();
+    if(n < 2) return;
+
+    key_scratch.resize(n);
+    value_scratch.resize(n);
+    for(uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        size_t count[256] = {};
+        for(size_t i = 0; i < n; i++) count[(keys[i] >> shift) & 0xFF]++;
+        if(count[(keys[0] >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for(size_t &c : count)
+        {
+            size_t bucket = c;
+            c = offset;
+            offset += bucket;
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+            size_t dst = count[(keys[i] >> shift) & 0xFF]++;
+            key_scratch[dst] = keys[i];
+            value_scratch[dst] = values[i];
+        }
+        keys.swap(key_scratch);
+        values.swap(value_scratch);
+    }
+}
+
+} // namespace
+
+RenderQueue::RenderQueue() : version_(0), compiled_(false), sorting_(false) {}
+
+void RenderQueue::compile(SceneNode &root)
+{
+    packets_.clear();
+    transforms_.clear();
+    sources_.clear();
+    states_.clear();
+    bounds_.clear();
+    local_bounds_.clear();
+    bounds_frame_.clear();
+    bounds_parent_.clear();
+    bounds_end_.clear();
+    transform_stack_.clear();
+    state_stack_.clear();
+    bounds_stack_.clear();
+    shader_stack_.clear();
+    sort_ids_.clear();
+    shader_ids_.clear();
+    vao_ids_.clear();
+    state_ids_.clear();
+
+    // Root state: identity transform, default presentation, no shader
+    Matrix4x4 identity;
+    transforms_.push_back(identity);
+    sources_.push_back({nullptr, identity, 0, 0, 0});
+    transform_stack_.push_back(0);
+    states_.push_back(RenderState());
+    state_ids_[state_content(states_[0])] = 0;
+    state_stack_.push_back(0);
+    bounds_stack_.push_back(NO_BOUNDS);
+    shader_stack_.push_back(nullptr);
+
+    root.compile(*this);
+
+    version_ = SceneNode::scene_version();
+    compiled_ = true;
+}
+
+bool RenderQueue::update(SceneNode &root)
+{
+    if(compiled_ && version_ == SceneNode::scene_version())
+    {
+        refresh_transforms();
+        return false;
+    }
+    compile(root);
+    return true;
+}
+
+void RenderQueue::submit(SceneState &scene_state)
+{
+    bool culling = scene_state.frustum_culling && bounds_.size() > 0;
+    if(culling)
+    {
+        Frustum frustum(scene_state.view_projection);
+        frustum.classify(bounds_, cull_results_, &cull_hints_);
+
+        // A subtree outside the frustum is culled as a whole. Enclosing
+        // bounds come before the bounds inside them, so one pass marks the
+        // nested bounds and the end of the packets to skip.
+        skip_end_.resize(bounds_.size());
+        for(size_t b = 0; b < bounds_.size(); b++)
+        {
+            uint32_t parent = bounds_parent_[b];
+            if(parent != NO_BOUNDS && cull_results_[parent] == CullResult::OUTSIDE)
+            {
+                cull_results_[b] = CullResult::OUTSIDE;
+                skip_end_[b] = skip_end_[parent];
+            }
+            else { skip_end_[b] = bounds_end_[b]; }
+        }
+    }
+
+    if(sorting_) sort_packets(scene_state);
+
+    // Last shader, state and transform set, so only changes are issued (GL
+    // bindings and blending are filtered by the state cache)
+    GLStateCache &gl = scene_state.gl_state;
+    ShaderNode   *shader = nullptr;
+    bool          shader_bound = false;
+    uint32_t      state = UNKNOWN;
+    uint32_t      transform = UNKNOWN;
+    uint32_t      n = static_cast<uint32_t>(packets_.size());
+    for(uint32_t k = 0; k < n; k++)
+    {
+        const DrawPacket &p = packets_[sorting_ ? order_[k] : k];
+        if(culling && p.bounds != NO_BOUNDS && cull_results_[p.bounds] == CullResult::OUTSIDE)
+        {
+            // In graph order the rest of the culled subtree follows
+            if(!sorting_) k = skip_end_[p.bounds] - 1;
+            continue;
+        }
+
+        // Binding a shader can change the uniform locations, so the state
+        // and transform are set again after a switch
+        if(!shader_bound || p.shader != shader)
+        {
+            if(shader_bound && shader != nullptr) shader->unbind(scene_state);
+            if(p.shader != nullptr) p.shader->bind(scene_state);
+            shader = p.shader;
+            shader_bound = true;
+            state = UNKNOWN;
+            transform = UNKNOWN;
+        }
+
+        if(p.state != state)
+        {
+            const RenderState &rs = states_[p.state];
+            gl.set_enabled(GL_BLEND, rs.blending);
+            if(rs.blending) gl.blend_func(rs.src_factor, rs.dst_factor);
+            if(rs.has_color)
+            {
+                scene_state.color = rs.color;
+                if(scene_state.color_loc != -1)
+                {
+                    glUniform4f(
+                        scene_state.color_loc, rs.color.r, rs.color.g, rs.color.b, rs.color.a);
+                }
+            }
+            state = p.state;
+        }
+
+        if(p.transform != transform)
+        {
+            if(scene_state.model_matrix_loc != -1)
+            {
+                glUniformMatrix4fv(
+                    scene_state.model_matrix_loc, 1, GL_FALSE, transforms_[p.transform].get());
+            }
+            transform = p.transform;
+        }
+
+        if(p.node != nullptr)
+        {
+            // The node can bind another shader (changing the uniform
+            // locations), so the shader is bound again after
+            Matrix4x4 saved = scene_state.model_matrix;
+            uint64_t  saved_version = scene_state.model_version;
+            scene_state.model_matrix = transforms_[p.transform];
+            scene_state.model_version = sources_[p.transform].world_version;
+            p.node->draw(scene_state);
+            scene_state.model_matrix = saved;
+            scene_state.model_version = saved_version;
+            shader_bound = false;
+            continue;
+        }
+
+        gl.bind_vertex_array(p.vao);
+        if(p.index_type != 0)
+        {
+            glDrawElements(p.mode,
+                           p.count,
+                           p.index_type,
+                           reinterpret_cast<const void *>(static_cast<uintptr_t>(p.first)));
+        }
+        else { glDrawArrays(p.mode, p.first, p.count); }
+    }
+
+    if(shader_bound && shader != nullptr) shader->unbind(scene_state);
+    gl.bind_vertex_array(0);
+    gl.disable(GL_BLEND);
+}
+
+void RenderQueue::set_sorting(bool sorting) { sorting_ = sorting; }
+
+bool RenderQueue::is_sorting() const { return sorting_; }
+
+const std::vector<DrawPacket> &RenderQueue::packets() const { return packets_; }
+
+void RenderQueue::push_transform(const Matrix4x4 &m) { add_transform(nullptr, m); }
+
+void RenderQueue::push_transform(TransformNode *node) { add_transform(node, node->get_matrix()); }
+
+void RenderQueue::pop_transform() { transform_stack_.pop_back(); }
+
+void RenderQueue::push_state(const RenderState &state)
+{
+    auto it = state_ids_.emplace(state_content(state), static_cast<uint32_t>(states_.size()));
+    if(it.second) states_.push_back(state);
+    state_stack_.push_back(it.first->second);
+}
+
+void RenderQueue::pop_state() { state_stack_.pop_back(); }
+
+void RenderQueue::push_shader(ShaderNode *shader) { shader_stack_.push_back(shader); }
+
+void RenderQueue::pop_shader() { shader_stack_.pop_back(); }
+
+void RenderQueue::push_bounds(const BoundingSphere &bounds)
+{
+    uint32_t frame = transform_stack_.back();
+    bounds_.push_back(transforms_[frame] * bounds);
+    local_bounds_.push_back(bounds);
+    bounds_frame_.push_back(frame);
+    bounds_parent_.push_back(bounds_stack_.back());
+    bounds_end_.push_back(0);
+    bounds_stack_.push_back(static_cast<uint32_t>(bounds_.size() - 1));
+}
+
+void RenderQueue::pop_bounds()
+{
+    bounds_end_[bounds_stack_.back()] = static_cast<uint32_t>(packets_.size());
+    bounds_stack_.pop_back();
+}
+
+void RenderQueue::add_draw(GLuint vao, GLenum mode, GLsizei count, GLenum index_type, GLint first)
+{
+    DrawPacket p = make_packet();
+    p.vao = vao;
+    p.mode = mode;
+    p.count = count;
+    p.index_type = index_type;
+    p.first = first;
+    add_packet(p);
+}
+
+void RenderQueue::add_node(SceneNode *node)
+{
+    DrawPacket p = make_packet();
+    p.node = node;
+    add_packet(p);
+}
+
+DrawPacket RenderQueue::make_packet() const
+{
+    DrawPacket p;
+    p.shader = shader_stack_.back();
+    p.vao = 0;
+    p.mode = GL_TRIANGLES;
+    p.count = 0;
+    p.index_type = 0;
+    p.first = 0;
+    p.state = state_stack_.back();
+    p.transform = transform_stack_.back();
+    p.bounds = bounds_stack_.back();
+    p.node = nullptr;
+    return p;
+}
+
+void RenderQueue::add_packet(const DrawPacket &p)
+{
+    // Ids in order of first use. Ids too large for their key field are
+    // clamped to its largest value rather than wrapped, so they share one
+    // group instead of aliasing the first programs, states or VAOs. Those
+    // packets still draw correctly (submit compares the actual state).
+    const RenderState &state = states_[p.state];
+    SortIds            ids;
+    uint32_t           next_shader = static_cast<uint32_t>(shader_ids_.size());
+    uint32_t           next_vao = static_cast<uint32_t>(vao_ids_.size());
+    uint32_t           shader = shader_ids_.emplace(p.shader, next_shader).first->second;
+    uint32_t           vao = vao_ids_.emplace(p.vao, next_vao).first->second;
+    ids.shader = static_cast<uint16_t>(std::min(shader, SHADER_ID_MAX));
+    ids.state = static_cast<uint16_t>(std::min(p.state, STATE_ID_MAX));
+    ids.vao = static_cast<uint16_t>(std::min(vao, VAO_ID_MAX));
+    ids.layer = std::min<uint8_t>(state.layer, 15);
+    ids.translucent = state.blending;
+    packets_.push_back(p);
+    sort_ids_.push_back(ids);
+}
+
+void RenderQueue::sort_packets(const SceneState &scene_state)
+{
+    // Depth of each model matrix origin, quantized over the NDC depth range
+    depths_.resize(transforms_.size());
+    for(size_t i = 0; i < transforms_.size(); i++)
+    {
+        const Matrix4x4 &m = transforms_[i];
+        HPoint3          c = scene_state.view_projection * Point3(m.m03(), m.m13(), m.m23());
+        float            z = c.w != 0.0f ? c.z / c.w : c.z;
+        float            d = std::min(std::max(0.5f * z + 0.5f, 0.0f), 1.0f);
+        depths_[i] = static_cast<uint32_t>(d * static_cast<float>(DEPTH_MAX));
+    }
+
+    size_t n = packets_.size();
+    keys_.resize(n);
+    order_.resize(n);
+    for(size_t i = 0; i < n; i++)
+    {
+        const SortIds &ids = sort_ids_[i];
+        uint64_t       depth = depths_[packets_[i].transform];
+        uint64_t       key = static_cast<uint64_t>(ids.layer) << LAYER_SHIFT;
+        if(ids.translucent)
+        {
+            key |= uint64_t(1) << TRANSLUCENT_SHIFT;
+            key |= (DEPTH_MAX - depth) << 35;
+            key |= static_cast<uint64_t>(ids.shader) << 24;
+            key |= static_cast<uint64_t>(ids.state) << 12;
+            key |= ids.vao;
+        }
+        else
+        {
+            key |= static_cast<uint64_t>(ids.shader) << 48;
+            key |= static_cast<uint64_t>(ids.state) << 36;
+            key |= static_cast<uint64_t>(ids.vao) << 24;
+            key |= depth;
+        }
+        keys_[i] = key;
+        order_[i] = static_cast<uint32_t>(i);
+    }
+    radix_sort(keys_, order_, key_scratch_, order_scratch_);
+}
+
+void RenderQueue::add_transform(TransformNode *node, const Matrix4x4 &local)
+{
+    uint32_t parent = transform_stack_.back();
+    uint64_t local_version = node != nullptr ? node->get_version() : 0;
+    transforms_.push_back(transforms_[parent] * local);
+    sources_.push_back({node, local, parent, local_version, TransformNode::next_world_version()});
+    transform_stack_.push_back(static_cast<uint32_t>(transforms_.size() - 1));
+}
+
+void RenderQueue::refresh_transforms()
+{
+    // Model matrices are stored in traversal order, so each parent is
+    // refreshed before its children. Clean matrices cost one compare.
+    changed_.assign(transforms_.size(), 0);
+    bool any_changed = false;
+    for(size_t i = 1; i < sources_.size(); i++)
+    {
+        TransformSource &s = sources_[i];
+        bool local_changed = s.node != nullptr && s.node->get_version() != s.local_version;
+        if(!local_changed && changed_[s.parent] == 0) continue;
+
+        if(local_changed)
+        {
+            s.local = s.node->get_matrix();
+            s.local_version = s.node->get_version();
+        }
+        transforms_[i] = transforms_[s.parent] * s.local;
+        s.world_version = TransformNode::next_world_version();
+        changed_[i] = 1;
+        any_changed = true;
+    }
+    if(!any_changed) return;
+
+    for(size_t b = 0; b < local_bounds_.size(); b++)
+    {
+        uint32_t frame = bounds_frame_[b];
+        if(changed_[frame] != 0)
+            bounds_.set(b, transforms_[frame] * local_bounds_[b]);
+    }
+}
+
+} // namespace cg
@@ -0,0 +1,314 @@
+//============================================================================
+//	Johns Hopkins University Engineering Programs for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    render_queue.hpp
+//	Purpose: Scene graph compiled into a flat list of draw packets.
+//
+//============================================================================
+
+#ifndef __SCENE_RENDER_QUEUE_HPP__
+#define __SCENE_RENDER_QUEUE_HPP__
+
+#include "scene/color4.hpp"
+#include "scene/graphics.hpp"
+#include "scene/scene_state.hpp"
+
+#include "geometry/bounding_sphere.hpp"
+#include "geometry/frustum.hpp"
+#include "geometry/matrix.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace cg
+{
+
+class SceneNode;
+class ShaderNode;
+class TransformNode;
+
+/**
+ * Presentation state shared by draw packets: color uniform, blending and
+ * the sort layer.
+ */
+struct RenderState
+{
+    Color4  color = Color4(1.0f, 1.0f, 1.0f, 1.0f); // Color uniform
+    bool    has_color = false;                      // Whether to set the color uniform
+    bool    blending = false;                       // Whether blending is enabled
+    GLenum  src_factor = GL_SRC_ALPHA;              // Source blend factor
+    GLenum  dst_factor = GL_ONE_MINUS_SRC_ALPHA;    // Destination blend factor
+    uint8_t layer = 0;                              // Sort layer (0 to 15), lower drawn first
+};
+
+/**
+ * One draw in a compiled scene. State is referenced by index so packets stay
+ * small and consecutive packets sharing state are easy to detect.
+ */
+struct DrawPacket
+{
+    ShaderNode *shader;     // Shader node binding the program (nullptr: none)
+    GLuint      vao;        // Vertex array object
+    GLenum      mode;       // Primitive type (GL_TRIANGLES, GL_LINES, ...)
+    GLsizei     count;      // Number of indices (or vertices for glDrawArrays)
+    GLenum      index_type; // Index type (GL_UNSIGNED_INT, ...), 0 for glDrawArrays
+    GLint       first;      // First vertex (glDrawArrays) or byte offset of the indices
+    uint32_t    state;      // Index of the render state
+    uint32_t    transform;  // Index of the model matrix
+    uint32_t    bounds;     // Index of the bounding sphere culling this packet
+    SceneNode  *node;       // Node drawn with SceneNode::draw instead (nullptr: none)
+};
+
+/**
+ * Render queue: the scene graph compiled into a flat array of draw packets.
+ * Compiling walks the graph once, calling SceneNode::compile on each node
+ * to accumulate transforms, presentation state and shaders. Submitting is a
+ * loop over the packets that only issues the GL calls for state that changes
+ * between consecutive packets, without virtual calls or reference counting
+ * per node.
+ *
+ * The queue is recompiled only when the scene graph changes (see
+ * SceneNode::scene_version). Changes to transform nodes do not recompile:
+ * the queue keeps the transform nodes it compiled and recomputes only the
+ * model matrices (and bounds) below the nodes that changed. Nodes that do
+ * not describe their draws (do not override SceneNode::compile) become a
+ * single packet drawn through SceneNode::draw, so any graph can be compiled.
+ *
+ * With sorting enabled, packets are drawn in the order of 64-bit keys rather
+ * than graph order, so packets sharing a program, render state and VAO are
+ * drawn together. Keys order by layer, then opaque before translucent
+ * (blending) packets. Opaque packets then sort by program, render state,
+ * VAO and depth front to back. Translucent packets sort by depth back to
+ * front first so they still blend correctly. Packets with equal keys keep
+ * graph order. Sorting reorders overlapping opaque draws, so it is meant
+ * for scenes that use depth testing or separate such draws into layers.
+ *
+ * Key layout, most significant bits first: layer (4 bits), translucent (1),
+ * then program (11), render state (12), VAO (12) and depth (24) for opaque
+ * packets, or far depth (24), program, render state and VAO for
+ * translucent packets. Programs and VAOs get dense ids in order of first
+ * use in a compile. So a key distinguishes up to 2047 programs, 4095 render
+ * states and 4095 VAOs, and layers 0 to 15. Past those limits the id is
+ * clamped to the field's largest value: the extra packets still draw
+ * correctly, but they share one group and are batched less well.
+ *
+ * Model matrices are relative to the root of the compiled graph (the
+ * scene state model matrix is not applied). Packets outside presentation
+ * nodes are drawn with blending disabled.
+ */
+class RenderQueue
+{
+  public:
+    // Bounds index of packets without bounds
+    static constexpr uint32_t NO_BOUNDS = UINT32_MAX;
+
+    /**
+     * Constructor. The queue is empty until compiled.
+     */
+    RenderQueue();
+
+    /**
+     * Compiles a scene graph, replacing the current packets.
+     * @param  root  Root of the scene graph.
+     */
+    void compile(SceneNode &root);
+
+    /**
+     * Recompiles a scene graph if it changed since the last compile.
+     * Otherwise updates the model matrices of transform nodes that changed.
+     * @param  root  Root of the scene graph.
+     * @return  Returns true if the queue was recompiled.
+     */
+    bool update(SceneNode &root);
+
+    /**
+     * Draws the packets in order. With frustum culling enabled in the scene
+     * state, packets below nodes with bounds outside the view frustum are
+     * skipped: all bounds are tested in one batch, and a culled subtree is
+     * skipped as one range of packets (when not sorting).
+     * @param  scene_state  Current scene state.
+     */
+    void submit(SceneState &scene_state);
+
+    /**
+     * Enable or disable sorting packets by draw key in submit.
+     * @param  sorting  True to sort, false to draw in graph order.
+     */
+    void set_sorting(bool sorting);
+
+    /**
+     * Check if packets are sorted by draw key.
+     * @return  Returns true if sorting is enabled.
+     */
+    bool is_sorting() const;
+
+    /**
+     * Get the draw packets.
+     * @return  Returns the packets in draw order.
+     */
+    const std::vector<DrawPacket> &packets() const;
+
+    // Compile interface, used by SceneNode::compile. Pushes and pops nest
+    // like the draw traversal.
+
+    /**
+     * Applies a fixed transform to the following packets (composed with the
+     * current model matrix, like SceneState::model_matrix in draw).
+     * Changing it requires a recompile.
+     * @param  m  Transform of the node.
+     */
+    void push_transform(const Matrix4x4 &m);
+
+    /**
+     * Applies the transform of a transform node to the following packets.
+     * The matrix is updated by update() when the node changes.
+     * @param  node  Transform node (must outlive the compiled queue).
+     */
+    void push_transform(TransformNode *node);
+
+    /**
+     * Restores the model matrix before the last push_transform.
+     */
+    void pop_transform();
+
+    /**
+     * Sets the presentation state of the following packets. Equal states
+     * share one entry, so their packets sort together.
+     * @param  state  Color, blending and layer.
+     */
+    void push_state(const RenderState &state);
+
+    /**
+     * Restores the presentation state before the last push_state.
+     */
+    void pop_state();
+
+    /**
+     * Sets the shader of the following packets.
+     * @param  shader  Shader node binding the program.
+     */
+    void push_shader(ShaderNode *shader);
+
+    /**
+     * Restores the shader before the last push_shader.
+     */
+    void pop_shader();
+
+    /**
+     * Culls the following packets with a bounding sphere in the current
+     * model frame.
+     * @param  bounds  Bounding sphere of the subtree.
+     */
+    void push_bounds(const BoundingSphere &bounds);
+
+    /**
+     * Restores the bounds before the last push_bounds.
+     */
+    void pop_bounds();
+
+    /**
+     * Adds a draw with the current state.
+     * @param  vao         Vertex array object.
+     * @param  mode        Primitive type.
+     * @param  count       Number of indices, or vertices if index_type is 0.
+     * @param  index_type  Index type (GL_UNSIGNED_INT, ...), 0 for glDrawArrays.
+     * @param  first       First vertex (glDrawArrays) or byte offset of the indices.
+     */
+    void add_draw(GLuint vao, GLenum mode, GLsizei count, GLenum index_type = 0, GLint first = 0);
+
+    /**
+     * Adds a node drawn with SceneNode::draw (with its children) in the
+     * current state.
+     * @param  node  Node to draw.
+     */
+    void add_node(SceneNode *node);
+
+  private:
+    // Source of a compiled model matrix
+    struct TransformSource
+    {
+        TransformNode *node;          // Transform node, nullptr for a fixed transform
+        Matrix4x4      local;         // Local matrix
+        uint32_t       parent;        // Index of the enclosing model matrix
+        uint64_t       local_version; // Node version the local matrix is from
+        uint64_t       world_version; // Version of the model matrix
+    };
+
+    std::vector<DrawPacket>      packets_;
+    std::vector<Matrix4x4>       transforms_; // Model matrices in the root frame
+    std::vector<TransformSource> sources_;    // Source of each model matrix
+    std::vector<uint8_t>         changed_;    // Model matrices changed by refresh
+    std::vector<RenderState>     states_;
+    BoundingSphereTable          bounds_;        // Bounds in the root frame
+    std::vector<BoundingSphere>  local_bounds_;  // Bounds in their model frame
+    std::vector<uint32_t>        bounds_frame_;  // Model matrix index of each bounds
+    std::vector<uint32_t>        bounds_parent_; // Enclosing bounds (NO_BOUNDS: none)
+    std::vector<uint32_t>        bounds_end_;    // End of the packets inside each bounds
+
+    // Compile stacks (indices into the arrays above)
+    std::vector<uint32_t>     transform_stack_;
+    std::vector<uint32_t>     state_stack_;
+    std::vector<uint32_t>     bounds_stack_;
+    std::vector<ShaderNode *> shader_stack_;
+
+    // Frustum test results and plane hints per bounding sphere, and the end
+    // of the packets to skip when a bounds is culled (its outermost culled
+    // enclosing bounds)
+    std::vector<CullResult> cull_results_;
+    std::vector<uint8_t>    cull_hints_;
+    std::vector<uint32_t>   skip_end_;
+
+    // Dense ids of the program, state and VAO of each packet for the sort
+    // keys, clamped to the key field widths
+    struct SortIds
+    {
+        uint16_t shader;
+        uint16_t state;
+        uint16_t vao;
+        uint8_t  layer;
+        bool     translucent;
+    };
+    std::vector<SortIds>                             sort_ids_;
+    std::unordered_map<const ShaderNode *, uint32_t> shader_ids_;
+    std::unordered_map<GLuint, uint32_t>             vao_ids_;
+    std::map<std::array<uint32_t, 9>, uint32_t>      state_ids_; // Render state by content
+
+    // Sort keys and packet order (with radix sort scratch arrays)
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> order_;
+    std::vector<uint64_t> key_scratch_;
+    std::vector<uint32_t> order_scratch_;
+    std::vector<uint32_t> depths_; // Quantized depth per model matrix
+
+    uint64_t version_;  // Scene version of the last compile
+    bool     compiled_; // Whether the queue was compiled
+    bool     sorting_;  // Whether submit sorts by draw key
+
+    DrawPacket make_packet() const;
+
+    void add_packet(const DrawPacket &p);
+
+    /**
+     * Build the sort keys for the current view and sort the packets.
+     * @param  scene_state  Current scene state (view-projection matrix).
+     */
+    void sort_packets(const SceneState &scene_state);
+
+    void add_transform(TransformNode *node, const Matrix4x4 &local);
+
+    /**
+     * Recompute the model matrices below changed transform nodes.
+     */
+    void refresh_transforms();
+};
+
+} // namespace cg
+
+#endif
@@ -17,8 +17,12 @@
 #include "scene/color3.hpp"
 #include "scene/color4.hpp"
 #include "scene/scene_state.hpp"
+#include "scene/render_queue.hpp"
 #include "scene/scene_node.hpp"
+#include "scene/scene_pool.hpp"
+#include "scene/scene_pool_node.hpp"
 #include "scene/transform_node.hpp"
+#include "scene/transform_node_2d.hpp"
 #include "scene/presentation_node.hpp"
 #include "scene/geometry_node.hpp"
 #include "scene/shader_node.hpp"
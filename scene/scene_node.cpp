@@ -1,8 +1,18 @@
 #include "scene/scene_node.hpp"
 
+#include "geometry/frustum.hpp"
+
 namespace cg
 {
 
+namespace
+{
+
+// Incremented by every change that affects compiled render queues
+uint64_t g_scene_version = 0;
+
+} // namespace
+
 std::ostream &operator<<(std::ostream &out, const SceneNodeType &type)
 {
     switch(type)
@@ -24,20 +34,72 @@ SceneNode::~SceneNode() { destroy(); }
 
 void SceneNode::draw(SceneState &scene_state)
 {
-    // Loop through the list and draw the children
-    for(auto c : children_) { 
-    c->draw(scene_state); }
+    // Loop through the list and draw the children. With culling enabled,
+    // children with bounds outside the view frustum (and their subtrees) are
+    // skipped. The planes are extracted in this node's model frame, which
+    // is the frame the children's bounds are in.
+    Frustum frustum;
+    bool    have_frustum = false;
+    for(auto &c : children_)
+    {
+        if(scene_state.frustum_culling && c->has_bounds_)
+        {
+            if(!have_frustum)
+            {
+                frustum.set(scene_state.view_projection * scene_state.model_matrix);
+                have_frustum = true;
+            }
+            if(frustum.classify(c->bounds_, c->cull_plane_) == CullResult::OUTSIDE) continue;
+        }
+        c->draw(scene_state);
+    }
 }
 
 void SceneNode::update(SceneState &scene_state)
 {
     // Loop through the list and update the children
-    for(auto c : children_) { c->update(scene_state); }
+    for(auto &c : children_) { c->update(scene_state); }
+}
+
+void SceneNode::compile(RenderQueue &queue)
+{
+    // Groups only hold children. Derived nodes that draw themselves but do
+    // not describe their draws are drawn through draw().
+    if(draws_itself()) queue.add_node(this);
+    else compile_children(queue);
+}
+
+bool SceneNode::draws_itself() const { return false; }
+
+void SceneNode::compile_children(RenderQueue &queue)
+{
+    for(auto &c : children_)
+    {
+        if(c->has_bounds_)
+        {
+            queue.push_bounds(c->bounds_);
+            c->compile(queue);
+            queue.pop_bounds();
+        }
+        else { c->compile(queue); }
+    }
 }
 
-void SceneNode::destroy() { children_.clear(); }
+uint64_t SceneNode::scene_version() { return g_scene_version; }
 
-void SceneNode::add_child(std::shared_ptr<SceneNode> node) { children_.push_back(node); }
+void SceneNode::scene_changed() { ++g_scene_version; }
+
+void SceneNode::destroy()
+{
+    if(!children_.empty()) scene_changed();
+    children_.clear();
+}
+
+void SceneNode::add_child(std::shared_ptr<SceneNode> node)
+{
+    children_.push_back(node);
+    scene_changed();
+}
 
 SceneNodeType SceneNode::node_type() const { return node_type_; }
 
@@ -45,16 +107,30 @@ void SceneNode::set_name(const char *nm) { name_ = nm; }
 
 const std::string &SceneNode::get_name() const { return name_; }
 
+void SceneNode::set_bounds(const BoundingSphere &bounds)
+{
+    bounds_ = bounds;
+    has_bounds_ = true;
+    cull_plane_ = 0;
+    scene_changed();
+}
+
+void SceneNode::clear_bounds()
+{
+    has_bounds_ = false;
+    scene_changed();
+}
+
 void SceneNode::print_graph(std::ostream &out, int32_t level) const
 {
-    for(size_t i = 0; i < level; ++i) out << "- ";
+    for(int32_t i = 0; i < level; ++i) out << "- ";
 
     if(name_.length() == 0) out << "[";
     else out << name_ << " - [";
 
     out << node_type_ << "]\n";
 
-    for(auto c : children_) { c->print_graph(out, level + 1); }
+    for(auto &c : children_) { c->print_graph(out, level + 1); }
 }
 
 } // namespace cg
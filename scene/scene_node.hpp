@@ -14,8 +14,11 @@
 #define __SCENE_SCENE_NODE_HPP__
 
 #include "scene/graphics.hpp"
+#include "scene/render_queue.hpp"
 #include "scene/scene_state.hpp"
 
+#include "geometry/bounding_sphere.hpp"
+
 #include <iostream>
 #include <memory>
 #include <string>
@@ -66,6 +69,24 @@ class SceneNode
      */
     virtual void update(SceneState &scene_state);
 
+    /**
+     * Compile the scene node and its children into a render queue. The base
+     * class compiles the children of groups. Nodes that draw themselves
+     * (see draws_itself) but do not override this are added as a single
+     * packet drawn with draw(). Derived classes push their state, add their
+     * draws and call compile_children.
+     * @param  queue  Render queue being compiled.
+     */
+    virtual void compile(RenderQueue &queue);
+
+    /**
+     * Get the scene version. The version changes whenever a node changes
+     * in a way that affects compiled render queues (children, bounds,
+     * transforms, presentation state).
+     * @return  Returns the scene version.
+     */
+    static uint64_t scene_version();
+
     /**
      * Destroy all the children
      */
@@ -97,10 +118,47 @@ class SceneNode
 
     void print_graph(std::ostream &out = std::cout, int32_t level = 0) const;
 
+    /**
+     * Set a bounding sphere for this node and its subtree, in the frame the
+     * node is drawn in (the model frame of its parent). When frustum culling
+     * is enabled in the scene state, the parent skips drawing this node if
+     * the sphere is outside the view frustum.
+     * @param  bounds  Bounding sphere of the node and its children.
+     */
+    void set_bounds(const BoundingSphere &bounds);
+
+    /**
+     * Remove the bounding sphere. The node is then always drawn.
+     */
+    void clear_bounds();
+
   protected:
+    /**
+     * Check if the node draws more than its children in draw(). The base
+     * compile adds such nodes as a single packet drawn with draw() rather
+     * than compiling their children. Groups return false (the default).
+     * @return  Returns true if draw() does more than draw the children.
+     */
+    virtual bool draws_itself() const;
+
+    /**
+     * Compile all children, culled by their bounds if they have any.
+     * @param  queue  Render queue being compiled.
+     */
+    void compile_children(RenderQueue &queue);
+
+    /**
+     * Mark the scene as changed so render queues are recompiled.
+     */
+    static void scene_changed();
+
     std::string                             name_;
     SceneNodeType                           node_type_;
     std::vector<std::shared_ptr<SceneNode>> children_;
+
+    BoundingSphere bounds_;             // Bounds in the parent's model frame
+    bool           has_bounds_ = false; // Whether bounds_ is set
+    uint8_t        cull_plane_ = 0;     // Frustum plane that culled this node last
 };
 
 } // namespace cg
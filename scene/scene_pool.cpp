@@ -0,0 +1,409 @@
+#include "scene/scene_pool.hpp"
+
+#include "scene/shader_node.hpp"
+
+#include <algorithm>
+
+namespace cg
+{
+
+namespace
+{
+
+// Reorders an array: dst[k] = src[order[k]]
+template <typename T> void permute(std::vector<T> &v, const std::vector<uint32_t> &order)
+{
+    std::vector<T> dst;
+    dst.reserve(order.size());
+    for(uint32_t i : order) dst.push_back(v[i]);
+    v.swap(dst);
+}
+
+bool same_state(const RenderState &a, const RenderState &b)
+{
+    return a.has_color == b.has_color && a.color.r == b.color.r && a.color.g == b.color.g &&
+           a.color.b == b.color.b && a.color.a == b.color.a && a.blending == b.blending &&
+           a.src_factor == b.src_factor && a.dst_factor == b.dst_factor;
+}
+
+// Transform of new nodes, also returned for invalid handles
+constexpr Matrix4x4 IDENTITY;
+
+} // namespace
+
+ScenePool::ScenePool() : order_dirty_(false), parent_version_(UINT64_MAX) {}
+
+size_t ScenePool::size() const { return slot_index_.size() - free_slots_.size(); }
+
+void ScenePool::reserve(size_t n)
+{
+    parent_.reserve(n);
+    first_child_.reserve(n);
+    next_sibling_.reserve(n);
+    subtree_end_.reserve(n);
+    slot_.reserve(n);
+    flags_.reserve(n);
+    local_.reserve(n);
+    world_.reserve(n);
+    local_bounds_.reserve(n);
+    world_bounds_.reserve(n);
+    draw_index_.reserve(n);
+    slot_index_.reserve(n);
+    slot_generation_.reserve(n);
+}
+
+void ScenePool::clear()
+{
+    parent_.clear();
+    first_child_.clear();
+    next_sibling_.clear();
+    subtree_end_.clear();
+    slot_.clear();
+    flags_.clear();
+    local_.clear();
+    world_.clear();
+    world_changed_.clear();
+    local_bounds_.clear();
+    world_bounds_.clear();
+    draw_index_.clear();
+    draws_.clear();
+
+    // Keep the generations so old handles stay invalid
+    free_slots_.clear();
+    for(uint32_t id = 0; id < slot_index_.size(); id++)
+    {
+        if(slot_index_[id] != NONE) slot_generation_[id]++;
+        slot_index_[id] = NONE;
+        free_slots_.push_back(id);
+    }
+    order_dirty_ = false;
+}
+
+SceneHandle ScenePool::create(SceneHandle parent)
+{
+    uint32_t p = valid(parent) ? slot_index_[parent.id] : NONE;
+    uint32_t i = static_cast<uint32_t>(parent_.size());
+
+    SceneHandle h;
+    if(free_slots_.empty())
+    {
+        h.id = static_cast<uint32_t>(slot_index_.size());
+        slot_index_.push_back(i);
+        slot_generation_.push_back(0);
+    }
+    else
+    {
+        h.id = free_slots_.back();
+        free_slots_.pop_back();
+        slot_index_[h.id] = i;
+    }
+    h.generation = slot_generation_[h.id];
+
+    parent_.push_back(p);
+    first_child_.push_back(NONE);
+    next_sibling_.push_back(NONE);
+    subtree_end_.push_back(i + 1);
+    slot_.push_back(h.id);
+    flags_.push_back(LOCAL_DIRTY);
+    local_.push_back(IDENTITY);
+    world_.push_back(IDENTITY);
+    local_bounds_.push_back(BoundingSphere(Point3(0.0f, 0.0f, 0.0f), 0.0f));
+    world_bounds_.push_back(local_bounds_.back());
+    draw_index_.push_back(NONE);
+
+    if(p != NONE)
+    {
+        // Add after the last child
+        if(first_child_[p] == NONE) first_child_[p] = i;
+        else
+        {
+            uint32_t c = first_child_[p];
+            while(next_sibling_[c] != NONE) c = next_sibling_[c];
+            next_sibling_[c] = i;
+        }
+
+        // The order stays depth-first if the parent's subtree ends at the
+        // new node. The subtrees of all its ancestors then end there too.
+        if(!order_dirty_ && subtree_end_[p] == i)
+        {
+            for(uint32_t a = p; a != NONE; a = parent_[a]) subtree_end_[a] = i + 1;
+        }
+        else { order_dirty_ = true; }
+    }
+    return h;
+}
+
+void ScenePool::remove(SceneHandle h)
+{
+    if(!valid(h)) return;
+
+    uint32_t i = slot_index_[h.id];
+    uint32_t p = parent_[i];
+    if(p != NONE)
+    {
+        // Unlink from the parent's children
+        if(first_child_[p] == i) first_child_[p] = next_sibling_[i];
+        else
+        {
+            uint32_t c = first_child_[p];
+            while(next_sibling_[c] != i) c = next_sibling_[c];
+            next_sibling_[c] = next_sibling_[i];
+        }
+    }
+
+    // Free the slots of the subtree. The storage is compacted by the next
+    // update, so this follows the links rather than the index range.
+    std::vector<uint32_t> stack(1, i);
+    while(!stack.empty())
+    {
+        uint32_t n = stack.back();
+        stack.pop_back();
+        for(uint32_t c = first_child_[n]; c != NONE; c = next_sibling_[c]) stack.push_back(c);
+
+        uint32_t id = slot_[n];
+        slot_index_[id] = NONE;
+        slot_generation_[id]++;
+        free_slots_.push_back(id);
+        slot_[n] = NONE;
+    }
+    order_dirty_ = true;
+}
+
+bool ScenePool::valid(SceneHandle h) const
+{
+    return h.id < slot_index_.size() && slot_index_[h.id] != NONE &&
+           slot_generation_[h.id] == h.generation;
+}
+
+void ScenePool::set_local(SceneHandle h, const Matrix4x4 &m)
+{
+    if(!valid(h)) return;
+
+    uint32_t i = slot_index_[h.id];
+    local_[i] = m;
+    flags_[i] |= LOCAL_DIRTY;
+}
+
+const Matrix4x4 &ScenePool::local(SceneHandle h) const
+{
+    return valid(h) ? local_[slot_index_[h.id]] : IDENTITY;
+}
+
+const Matrix4x4 &ScenePool::world(SceneHandle h) const
+{
+    return valid(h) ? world_[slot_index_[h.id]] : IDENTITY;
+}
+
+void ScenePool::set_bounds(SceneHandle h, const BoundingSphere &bounds)
+{
+    if(!valid(h)) return;
+
+    uint32_t i = slot_index_[h.id];
+    local_bounds_[i] = bounds;
+    flags_[i] |= HAS_BOUNDS | LOCAL_DIRTY;
+}
+
+void ScenePool::clear_bounds(SceneHandle h)
+{
+    if(valid(h)) flags_[slot_index_[h.id]] &= ~HAS_BOUNDS;
+}
+
+void ScenePool::set_draw(SceneHandle h, const PoolDraw &draw)
+{
+    if(!valid(h)) return;
+
+    uint32_t i = slot_index_[h.id];
+    if(draw_index_[i] == NONE)
+    {
+        draw_index_[i] = static_cast<uint32_t>(draws_.size());
+        draws_.push_back(draw);
+    }
+    else { draws_[draw_index_[i]] = draw; }
+    flags_[i] |= HAS_DRAW;
+}
+
+void ScenePool::clear_draw(SceneHandle h)
+{
+    if(valid(h)) flags_[slot_index_[h.id]] &= ~HAS_DRAW;
+}
+
+void ScenePool::update(const Matrix4x4 &parent, uint64_t parent_version)
+{
+    if(order_dirty_) reorder();
+
+    // A parent comes before its children, so one pass updates every
+    // changed subtree. Clean nodes cost a flag test.
+    bool all = parent_version != parent_version_;
+    parent_version_ = parent_version;
+    size_t n = parent_.size();
+    world_changed_.resize(n);
+    for(size_t i = 0; i < n; i++)
+    {
+        uint32_t p = parent_[i];
+        bool     dirty = all || (flags_[i] & LOCAL_DIRTY) != 0 || (p != NONE && world_changed_[p]);
+        world_changed_[i] = dirty ? 1 : 0;
+        if(!dirty) continue;
+
+        const Matrix4x4 &frame = p == NONE ? parent : world_[p];
+        world_[i] = frame * local_[i];
+        if((flags_[i] & HAS_BOUNDS) != 0) world_bounds_.set(i, frame * local_bounds_[i]);
+        flags_[i] &= ~LOCAL_DIRTY;
+    }
+}
+
+void ScenePool::submit(SceneState &scene_state)
+{
+    bool culling = scene_state.frustum_culling && parent_.size() > 0;
+    if(culling)
+    {
+        Frustum frustum(scene_state.view_projection);
+        frustum.classify(world_bounds_, cull_results_, &cull_hints_);
+    }
+
+    // Last shader and state set, so only changes are issued (GL bindings and
+    // blending are filtered by the state cache)
+    GLStateCache      &gl = scene_state.gl_state;
+    ShaderNode        *shader = nullptr;
+    bool               shader_bound = false;
+    const RenderState *state = nullptr;
+    uint32_t           n = static_cast<uint32_t>(parent_.size());
+    for(uint32_t i = 0; i < n;)
+    {
+        uint8_t flags = flags_[i];
+        if(culling && (flags & HAS_BOUNDS) != 0 && cull_results_[i] == CullResult::OUTSIDE)
+        {
+            i = subtree_end_[i];
+            continue;
+        }
+        if((flags & HAS_DRAW) == 0)
+        {
+            i++;
+            continue;
+        }
+
+        const PoolDraw &d = draws_[draw_index_[i]];
+        if(!shader_bound || d.shader != shader)
+        {
+            if(shader_bound && shader != nullptr) shader->unbind(scene_state);
+            if(d.shader != nullptr) d.shader->bind(scene_state);
+            shader = d.shader;
+            shader_bound = true;
+            state = nullptr;
+        }
+        if(state == nullptr || !same_state(*state, d.state))
+        {
+            gl.set_enabled(GL_BLEND, d.state.blending);
+            if(d.state.blending) gl.blend_func(d.state.src_factor, d.state.dst_factor);
+            if(d.state.has_color)
+            {
+                const Color4 &c = d.state.color;
+                scene_state.color = c;
+                if(scene_state.color_loc != -1)
+                    glUniform4f(scene_state.color_loc, c.r, c.g, c.b, c.a);
+            }
+            state = &d.state;
+        }
+        if(scene_state.model_matrix_loc != -1)
+            glUniformMatrix4fv(scene_state.model_matrix_loc, 1, GL_FALSE, world_[i].get());
+        gl.bind_vertex_array(d.vao);
+        if(d.index_type != 0)
+        {
+            glDrawElements(d.mode,
+                           d.count,
+                           d.index_type,
+                           reinterpret_cast<const void *>(static_cast<uintptr_t>(d.first)));
+        }
+        else { glDrawArrays(d.mode, d.first, d.count); }
+        i++;
+    }
+
+    if(shader_bound && shader != nullptr) shader->unbind(scene_state);
+    gl.bind_vertex_array(0);
+    gl.disable(GL_BLEND);
+}
+
+uint32_t ScenePool::index(SceneHandle h) const { return valid(h) ? slot_index_[h.id] : NONE; }
+
+uint32_t ScenePool::parent(uint32_t i) const { return parent_[i]; }
+
+uint32_t ScenePool::first_child(uint32_t i) const { return first_child_[i]; }
+
+uint32_t ScenePool::next_sibling(uint32_t i) const { return next_sibling_[i]; }
+
+uint32_t ScenePool::subtree_end(uint32_t i) const { return subtree_end_[i]; }
+
+void ScenePool::reorder()
+{
+    // Depth-first order of the live nodes. Roots keep their order.
+    size_t                n = parent_.size();
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> children;
+    order.reserve(n);
+    for(uint32_t r = 0; r < n; r++)
+    {
+        if(parent_[r] != NONE || slot_[r] == NONE) continue;
+        stack.push_back(r);
+        while(!stack.empty())
+        {
+            uint32_t i = stack.back();
+            stack.pop_back();
+            order.push_back(i);
+
+            // Push the children last to first so the first is visited next
+            children.clear();
+            for(uint32_t c = first_child_[i]; c != NONE; c = next_sibling_[c])
+                children.push_back(c);
+            stack.insert(stack.end(), children.rbegin(), children.rend());
+        }
+    }
+
+    std::vector<uint32_t> new_index(n, NONE);
+    for(uint32_t k = 0; k < order.size(); k++) new_index[order[k]] = k;
+    auto remap = [&new_index](uint32_t i) { return i == NONE ? NONE : new_index[i]; };
+
+    permute(parent_, order);
+    permute(first_child_, order);
+    permute(next_sibling_, order);
+    permute(slot_, order);
+    permute(flags_, order);
+    permute(local_, order);
+    permute(world_, order);
+    permute(local_bounds_, order);
+    for(uint32_t k = 0; k < order.size(); k++)
+    {
+        parent_[k] = remap(parent_[k]);
+        first_child_[k] = remap(first_child_[k]);
+        next_sibling_[k] = remap(next_sibling_[k]);
+        slot_index_[slot_[k]] = k;
+        flags_[k] |= LOCAL_DIRTY; // World bounds are rebuilt by the update
+    }
+
+    // Draws are stored in node order too
+    std::vector<PoolDraw> draws;
+    std::vector<uint32_t> draw_index(order.size(), NONE);
+    for(uint32_t k = 0; k < order.size(); k++)
+    {
+        uint32_t d = draw_index_[order[k]];
+        if(d == NONE) continue;
+        draw_index[k] = static_cast<uint32_t>(draws.size());
+        draws.push_back(draws_[d]);
+    }
+    draws_.swap(draws);
+    draw_index_.swap(draw_index);
+
+    // Subtree ends, children before parents
+    subtree_end_.resize(order.size());
+    for(uint32_t k = 0; k < order.size(); k++) subtree_end_[k] = k + 1;
+    for(uint32_t k = static_cast<uint32_t>(order.size()); k-- > 0;)
+    {
+        if(parent_[k] != NONE)
+            subtree_end_[parent_[k]] = std::max(subtree_end_[parent_[k]], subtree_end_[k]);
+    }
+
+    world_bounds_.clear();
+    for(uint32_t k = 0; k < order.size(); k++) world_bounds_.push_back(local_bounds_[k]);
+    order_dirty_ = false;
+}
+
+} // namespace cg
@@ -0,0 +1,252 @@
+//============================================================================
+//	Johns Hopkins University Engineering Programs for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    scene_pool.hpp
+//	Purpose: Scene storage in contiguous pools ordered depth-first, with
+//           handles to the nodes.
+//
+//============================================================================
+
+#ifndef __SCENE_SCENE_POOL_HPP__
+#define __SCENE_SCENE_POOL_HPP__
+
+#include "scene/graphics.hpp"
+#include "scene/render_queue.hpp"
+#include "scene/scene_state.hpp"
+
+#include "geometry/bounding_sphere.hpp"
+#include "geometry/frustum.hpp"
+#include "geometry/matrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cg
+{
+
+class ShaderNode;
+
+/**
+ * Handle to a node in a ScenePool. Stays valid while the pool reorders its
+ * storage. Handles of removed nodes become invalid (the slot generation
+ * changes when the slot is reused).
+ */
+struct SceneHandle
+{
+    uint32_t id = UINT32_MAX; // Slot of the node
+    uint32_t generation = 0;  // Generation of the slot when the handle was made
+};
+
+/**
+ * Draw of a pooled node: shader, presentation state and draw arguments.
+ */
+struct PoolDraw
+{
+    ShaderNode *shader = nullptr;    // Shader node binding the program (nullptr: none)
+    GLuint      vao = 0;             // Vertex array object
+    GLenum      mode = GL_TRIANGLES; // Primitive type
+    GLsizei     count = 0;           // Number of indices (or vertices for glDrawArrays)
+    GLenum      index_type = 0;      // Index type (GL_UNSIGNED_INT, ...), 0 for glDrawArrays
+    GLint       first = 0;           // First vertex or byte offset of the indices
+    RenderState state;               // Color and blending
+};
+
+/**
+ * Data-oriented scene storage. Instead of heap allocated nodes linked by
+ * pointers, the hierarchy (parent, first child and next sibling indices),
+ * local and world transforms, bounds and draws are kept in separate
+ * contiguous arrays, ordered depth-first. Updating world transforms and
+ * culling are then linear passes over the arrays: a parent always comes
+ * before its children, and a subtree is a contiguous range, so a culled
+ * subtree is skipped with one jump.
+ *
+ * Nodes are created and edited through handles. Adding a node at the end
+ * of the order (a child of a node on the last branch) keeps the arrays in
+ * depth-first order. Other edits mark the order dirty, and the next update
+ * reorders the arrays once. Edits through invalid handles (of removed
+ * nodes) are ignored and getters return an identity transform, so a stale
+ * handle cannot change a node that reused its slot.
+ *
+ * World transforms are recomputed only for nodes whose local transform
+ * changed and their descendants, or for all nodes when the parent frame
+ * passed to update changes (see SceneState::model_version).
+ */
+class ScenePool
+{
+  public:
+    // Index of a missing node (no parent, child or sibling)
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    /**
+     * Constructor. Creates an empty pool.
+     */
+    ScenePool();
+
+    /**
+     * Get the number of nodes.
+     * @return  Returns the number of nodes.
+     */
+    size_t size() const;
+
+    /**
+     * Reserve storage for n nodes.
+     * @param  n  Number of nodes.
+     */
+    void reserve(size_t n);
+
+    /**
+     * Remove all nodes. All handles become invalid.
+     */
+    void clear();
+
+    /**
+     * Create a node with an identity transform, no bounds and no draw.
+     * @param  parent  Parent node, or an empty handle for a root node. The
+     *                 node is added after the existing children.
+     * @return  Returns the handle of the new node.
+     */
+    SceneHandle create(SceneHandle parent = SceneHandle());
+
+    /**
+     * Remove a node and its subtree.
+     * @param  h  Node to remove.
+     */
+    void remove(SceneHandle h);
+
+    /**
+     * Check if a handle refers to a node in the pool.
+     * @param  h  Handle to check.
+     * @return  Returns true if the node exists.
+     */
+    bool valid(SceneHandle h) const;
+
+    /**
+     * Set the local transform of a node (relative to its parent).
+     * @param  h  Node.
+     * @param  m  Local transform.
+     */
+    void set_local(SceneHandle h, const Matrix4x4 &m);
+
+    /**
+     * Get the local transform of a node.
+     * @param  h  Node.
+     * @return  Returns the local transform.
+     */
+    const Matrix4x4 &local(SceneHandle h) const;
+
+    /**
+     * Get the world transform of a node as of the last update.
+     * @param  h  Node.
+     * @return  Returns the world transform.
+     */
+    const Matrix4x4 &world(SceneHandle h) const;
+
+    /**
+     * Set a bounding sphere for a node and its subtree, in the node's
+     * parent frame (like SceneNode::set_bounds).
+     * @param  h       Node.
+     * @param  bounds  Bounding sphere of the node and its subtree.
+     */
+    void set_bounds(SceneHandle h, const BoundingSphere &bounds);
+
+    /**
+     * Remove the bounding sphere of a node.
+     * @param  h  Node.
+     */
+    void clear_bounds(SceneHandle h);
+
+    /**
+     * Set the draw of a node. It is drawn with the node's world transform.
+     * @param  h     Node.
+     * @param  draw  Draw arguments and state.
+     */
+    void set_draw(SceneHandle h, const PoolDraw &draw);
+
+    /**
+     * Remove the draw of a node.
+     * @param  h  Node.
+     */
+    void clear_draw(SceneHandle h);
+
+    /**
+     * Restore depth-first order if needed and update the world transforms
+     * and bounds of changed nodes.
+     * @param  parent          Frame the root nodes are in.
+     * @param  parent_version  Version of the parent frame. All world
+     *                         transforms are recomputed when it changes.
+     */
+    void update(const Matrix4x4 &parent, uint64_t parent_version);
+
+    /**
+     * Draw the nodes in depth-first order, issuing GL calls only for state
+     * that changes between consecutive draws. With frustum culling enabled
+     * in the scene state, subtrees whose bounds are outside the frustum are
+     * skipped. Call update first.
+     * @param  scene_state  Current scene state.
+     */
+    void submit(SceneState &scene_state);
+
+    // Depth-first storage (valid after update). Node i's subtree is the
+    // index range [i, subtree_end(i)). Root nodes have no parent and no
+    // siblings; they are drawn in the order they were created.
+
+    /**
+     * Get the storage index of a node.
+     * @param  h  Node.
+     * @return  Returns the index of the node in the depth-first arrays, or
+     *          NONE for an invalid handle.
+     */
+    uint32_t index(SceneHandle h) const;
+
+    uint32_t parent(uint32_t i) const;
+    uint32_t first_child(uint32_t i) const;
+    uint32_t next_sibling(uint32_t i) const;
+    uint32_t subtree_end(uint32_t i) const;
+
+  private:
+    // Node flags
+    static constexpr uint8_t LOCAL_DIRTY = 1;
+    static constexpr uint8_t HAS_BOUNDS = 2;
+    static constexpr uint8_t HAS_DRAW = 4;
+
+    // Hierarchy (by storage index)
+    std::vector<uint32_t> parent_;
+    std::vector<uint32_t> first_child_;
+    std::vector<uint32_t> next_sibling_;
+    std::vector<uint32_t> subtree_end_;
+    std::vector<uint32_t> slot_; // Slot of each node
+    std::vector<uint8_t>  flags_;
+
+    // Transforms
+    std::vector<Matrix4x4> local_;
+    std::vector<Matrix4x4> world_;
+    std::vector<uint8_t>   world_changed_;
+
+    // Bounds (local in the parent frame, world in a table for batch culling)
+    std::vector<BoundingSphere> local_bounds_;
+    BoundingSphereTable         world_bounds_;
+    std::vector<CullResult>     cull_results_;
+    std::vector<uint8_t>        cull_hints_;
+
+    // Draws, referenced by index from the nodes that have one
+    std::vector<uint32_t> draw_index_;
+    std::vector<PoolDraw> draws_;
+
+    // Slots: storage index and generation of each handle id
+    std::vector<uint32_t> slot_index_;
+    std::vector<uint32_t> slot_generation_;
+    std::vector<uint32_t> free_slots_;
+
+    bool     order_dirty_;    // Not depth-first, or removed nodes not compacted
+    uint64_t parent_version_; // Version of the parent frame of the last update
+
+    void reorder();
+};
+
+} // namespace cg
+
+#endif
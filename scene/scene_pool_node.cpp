@@ -0,0 +1,54 @@
+#include "scene/scene_pool_node.hpp"
+
+namespace cg
+{
+
+ScenePoolNode::ScenePoolNode() : pool_(std::make_shared<ScenePool>()) {}
+
+ScenePoolNode::ScenePoolNode(std::shared_ptr<ScenePool> pool) : pool_(pool) {}
+
+ScenePool &ScenePoolNode::pool() { return *pool_; }
+
+void ScenePoolNode::draw(SceneState &scene_state)
+{
+    // The pool binds its own shaders and sets its own color, blending and
+    // model matrices. Save the state of the enclosing nodes (from the state
+    // cache, not GL) to restore it for the children and later siblings.
+    GLStateCache &gl = scene_state.gl_state;
+    GLuint        program = gl.get_program();
+    bool          blending = gl.is_enabled(GL_BLEND);
+    GLenum        src_factor = gl.get_blend_src();
+    GLenum        dst_factor = gl.get_blend_dst();
+    GLint         position_loc = scene_state.position_loc;
+    GLint         ortho_matrix_loc = scene_state.ortho_matrix_loc;
+    GLint         color_loc = scene_state.color_loc;
+    GLint         model_matrix_loc = scene_state.model_matrix_loc;
+    Color4        color = scene_state.color;
+
+    pool_->update(scene_state.model_matrix, scene_state.model_version);
+    pool_->submit(scene_state);
+
+    gl.use_program(program);
+    gl.set_enabled(GL_BLEND, blending);
+    gl.blend_func(src_factor, dst_factor);
+    scene_state.position_loc = position_loc;
+    scene_state.ortho_matrix_loc = ortho_matrix_loc;
+    scene_state.color_loc = color_loc;
+    scene_state.model_matrix_loc = model_matrix_loc;
+    scene_state.color = color;
+    if(color_loc != -1) glUniform4f(color_loc, color.r, color.g, color.b, color.a);
+    if(model_matrix_loc != -1)
+        glUniformMatrix4fv(model_matrix_loc, 1, GL_FALSE, scene_state.model_matrix.get());
+
+    SceneNode::draw(scene_state);
+}
+
+bool ScenePoolNode::draws_itself() const { return true; }
+
+void ScenePoolNode::update(SceneState &scene_state)
+{
+    pool_->update(scene_state.model_matrix, scene_state.model_version);
+    SceneNode::update(scene_state);
+}
+
+} // namespace cg
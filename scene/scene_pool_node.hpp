@@ -0,0 +1,76 @@
+//============================================================================
+//	Johns Hopkins University Engineering Programs for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:  Kyle Meyer
+//	File:    scene_pool_node.hpp
+//	Purpose: Scene graph node that draws a ScenePool.
+//
+//============================================================================
+
+#ifndef __SCENE_SCENE_POOL_NODE_HPP__
+#define __SCENE_SCENE_POOL_NODE_HPP__
+
+#include "scene/scene_node.hpp"
+#include "scene/scene_pool.hpp"
+
+#include <memory>
+
+namespace cg
+{
+
+/**
+ * Scene pool node. Places a ScenePool in the scene graph: the pool's root
+ * nodes are in the frame of this node, so large pooled scenes can be
+ * combined with regular scene nodes. The pool is edited through its
+ * handles (see ScenePool).
+ */
+class ScenePoolNode : public SceneNode
+{
+  public:
+    /**
+     * Constructor. Creates an empty pool.
+     */
+    ScenePoolNode();
+
+    /**
+     * Constructor given a pool, which can be shared with other code.
+     * @param  pool  Pool to draw.
+     */
+    explicit ScenePoolNode(std::shared_ptr<ScenePool> pool);
+
+    /**
+     * Get the pool.
+     * @return  Returns the pool drawn by this node.
+     */
+    ScenePool &pool();
+
+    /**
+     * Draw the pool, then the children of this node. The program, shader
+     * locations, color and blend state set by the enclosing nodes are
+     * restored after the pool is drawn.
+     * @param  scene_state  Current scene state
+     */
+    void draw(SceneState &scene_state) override;
+
+    /**
+     * Update the world transforms of the pool, then the children.
+     * @param  scene_state  Current scene state
+     */
+    void update(SceneState &scene_state) override;
+
+  protected:
+    /**
+     * The pool is drawn by draw(), so the node is compiled as a packet drawn
+     * with draw().
+     * @return  Returns true.
+     */
+    bool draws_itself() const override;
+
+    std::shared_ptr<ScenePool> pool_;
+};
+
+} // namespace cg
+
+#endif
@@ -12,9 +12,14 @@
 #ifndef __SCENE_SCENE_STATE_HPP__
 #define __SCENE_SCENE_STATE_HPP__
 
+#include "scene/color4.hpp"
+#include "scene/gl_state_cache.hpp"
 #include "scene/graphics.hpp"
 
+#include "geometry/matrix.hpp"
+
 #include <array>
+#include <cstdint>
 
 namespace cg
 {
@@ -29,11 +34,26 @@ struct SceneState
     GLint position_loc; // Vertex position attribute location
 
     // Uniform locations
-    GLint ortho_matrix_loc; // Orthographic projection location (2-D)
-    GLint color_loc;        // Constant color
+    GLint ortho_matrix_loc;      // Orthographic projection location (2-D)
+    GLint color_loc;             // Constant color
+    GLint model_matrix_loc = -1; // Model (composite) matrix location
+
+    // Value last set for the color uniform (by presentation nodes and render
+    // queues), so nodes that change it can restore it
+    Color4 color = Color4(1.0f, 1.0f, 1.0f, 1.0f);
 
     // Current matrices
-    std::array<float, 16> ortho; // Orthographic projection matrix (2-D)
+    std::array<float, 16> ortho;             // Orthographic projection matrix (2-D)
+    Matrix4x4             model_matrix;      // Composite of the enclosing transform nodes
+    uint64_t              model_version = 0; // Identifies model_matrix (see TransformNode)
+
+    // View frustum culling (see SceneNode::set_bounds)
+    Matrix4x4 view_projection;         // Projection * view matrix
+    bool      frustum_culling = false; // Skip nodes whose bounds are outside the frustum
+
+    // Shadow of the GL bindings and capabilities, so nodes skip redundant
+    // calls and do not query GL
+    GLStateCache gl_state;
 };
 
 } // namespace cg
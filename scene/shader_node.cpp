@@ -60,4 +60,25 @@ bool ShaderNode::create_from_source(const char *vertex_shader_source,
     return true;
 }
 
+void ShaderNode::bind(SceneState &scene_state)
+{
+    scene_state.gl_state.use_program(shader_program_.get_program());
+}
+
+void ShaderNode::unbind(SceneState &) {}
+
+void ShaderNode::draw(SceneState &scene_state)
+{
+    bind(scene_state);
+    SceneNode::draw(scene_state);
+    unbind(scene_state);
+}
+
+void ShaderNode::compile(RenderQueue &queue)
+{
+    queue.push_shader(this);
+    compile_children(queue);
+    queue.pop_shader();
+}
+
 } // namespace cg
@@ -59,6 +59,33 @@ class ShaderNode : public SceneNode
     // Derived classes must add this to set all internal uniforms and attribute locations
     virtual bool get_locations() = 0;
 
+    /**
+     * Enable the shader program and set the uniform locations in the scene
+     * state. Derived classes add their own uniforms (projection, etc.).
+     * Used by draw and by render queues when switching programs.
+     * @param  scene_state  Current scene state
+     */
+    virtual void bind(SceneState &scene_state);
+
+    /**
+     * Undo any GL state set by bind other than the program. Called when
+     * switching away from this shader.
+     * @param  scene_state  Current scene state
+     */
+    virtual void unbind(SceneState &scene_state);
+
+    /**
+     * Draw the children with this shader: bind, draw the children, unbind.
+     * @param  scene_state  Current scene state
+     */
+    void draw(SceneState &scene_state) override;
+
+    /**
+     * Compile. Packets of the children use this shader.
+     * @param  queue  Render queue being compiled
+     */
+    void compile(RenderQueue &queue) override;
+
   protected:
     GLSLVertexShader   vertex_shader_;
     GLSLFragmentShader fragment_shader_;
@@ -3,7 +3,21 @@
 namespace cg
 {
 
-TransformNode::TransformNode()
+namespace
+{
+
+// Last world matrix version handed out. Versions are unique across nodes so
+// a child can tell which parent matrix its cached world matrix came from.
+// Version 0 is the root (SceneState default).
+uint64_t g_world_version = 0;
+
+} // namespace
+
+TransformNode::TransformNode() :
+    version_(0),
+    world_version_(0),
+    world_parent_version_(UINT64_MAX),
+    world_local_version_(UINT64_MAX)
 {
     node_type_ = SceneNodeType::TRANSFORM;
     load_identity();
@@ -13,47 +27,158 @@ TransformNode::~TransformNode() {}
 
 void TransformNode::load_identity()
 {
-    // Student to complete - Module 4
+    base_.set_identity();
+    has_base_ = false;
+    translation_ = Vector3(0.0f, 0.0f, 0.0f);
+    rotation_ = Quaternion();
+    scale_ = Vector3(1.0f, 1.0f, 1.0f);
+    touch();
 }
 
 void TransformNode::translate(float x, float y, float z)
 {
-    // Student to complete - Module 4
+    // T R S T(v) = T(translation + R S v) R S
+    translation_ += rotation_.rotate(Vector3(x * scale_.x, y * scale_.y, z * scale_.z));
+    touch();
 }
 
-void TransformNode::rotate(float deg, Vector3 &v)
+void TransformNode::rotate(float deg, Vector3 &v) { rotate(Quaternion::from_axis_angle(deg, v)); }
+
+void TransformNode::rotate(const Quaternion &q)
 {
-    // Student to complete - Module 4
+    // S Rq = Rq S only holds for uniform scaling
+    if(scale_.x != scale_.y || scale_.x != scale_.z)
+    {
+        flush();
+        rotation_ = q;
+    }
+    else { rotation_ *= q; }
+
+    // Keep a unit quaternion so repeated rotations do not drift into scale
+    // and shear in the rotation matrix
+    rotation_.normalize();
+    touch();
 }
 
 void TransformNode::rotate_x(float deg)
 {
-    // Student to complete - Module 4
+    rotate(Quaternion::from_axis_angle(deg, Vector3(1.0f, 0.0f, 0.0f)));
 }
 
 void TransformNode::rotate_y(float deg)
 {
-    // Student to complete - Module 4
+    rotate(Quaternion::from_axis_angle(deg, Vector3(0.0f, 1.0f, 0.0f)));
 }
 
 void TransformNode::rotate_z(float deg)
 {
-    // Student to complete - Module 4
+    rotate(Quaternion::from_axis_angle(deg, Vector3(0.0f, 0.0f, 1.0f)));
 }
 
 void TransformNode::scale(float x, float y, float z)
 {
-    // Student to complete - Module 4
+    scale_.x *= x;
+    scale_.y *= y;
+    scale_.z *= z;
+    touch();
+}
+
+const Matrix4x4 &TransformNode::get_matrix()
+{
+    if(matrix_dirty_)
+    {
+        // R S, then T sets the last column (R S has no translation)
+        Matrix4x4 m = rotation_.get_matrix();
+        m.scale(scale_.x, scale_.y, scale_.z);
+        m.m03() = translation_.x;
+        m.m13() = translation_.y;
+        m.m23() = translation_.z;
+        matrix_ = has_base_ ? base_ * m : m;
+        matrix_dirty_ = false;
+    }
+    return matrix_;
+}
+
+uint64_t TransformNode::get_version() const { return version_; }
+
+bool TransformNode::update_world(const Matrix4x4 &parent, uint64_t parent_version)
+{
+    if(parent_version == world_parent_version_ && version_ == world_local_version_) return false;
+
+    world_ = parent * get_matrix();
+    world_version_ = next_world_version();
+    world_parent_version_ = parent_version;
+    world_local_version_ = version_;
+    return true;
+}
+
+const Matrix4x4 &TransformNode::get_world_matrix() const { return world_; }
+
+uint64_t TransformNode::get_world_version() const { return world_version_; }
+
+uint64_t TransformNode::next_world_version() { return ++g_world_version; }
+
+void TransformNode::touch()
+{
+    matrix_dirty_ = true;
+    ++version_;
+}
+
+void TransformNode::flush()
+{
+    base_ = get_matrix();
+    has_base_ = true;
+    translation_ = Vector3(0.0f, 0.0f, 0.0f);
+    rotation_ = Quaternion();
+    scale_ = Vector3(1.0f, 1.0f, 1.0f);
 }
 
 void TransformNode::draw(SceneState &scene_state)
 {
-    // Student to complete - Module 4
+    // Apply this transform to the model matrix for the children
+    Matrix4x4 saved = scene_state.model_matrix;
+    uint64_t  saved_version = scene_state.model_version;
+    update_world(saved, saved_version);
+    scene_state.model_matrix = world_;
+    scene_state.model_version = world_version_;
+    if(scene_state.model_matrix_loc != -1)
+    {
+        glUniformMatrix4fv(
+            scene_state.model_matrix_loc, 1, GL_FALSE, scene_state.model_matrix.get());
+    }
 
     // Draw all children
     SceneNode::draw(scene_state);
+
+    // Restore the model matrix
+    scene_state.model_matrix = saved;
+    scene_state.model_version = saved_version;
+    if(scene_state.model_matrix_loc != -1)
+    {
+        glUniformMatrix4fv(scene_state.model_matrix_loc, 1, GL_FALSE, saved.get());
+    }
 }
 
-void TransformNode::update(SceneState &scene_state) {}
+void TransformNode::update(SceneState &scene_state)
+{
+    // Propagate the world matrix to the children
+    Matrix4x4 saved = scene_state.model_matrix;
+    uint64_t  saved_version = scene_state.model_version;
+    update_world(saved, saved_version);
+    scene_state.model_matrix = world_;
+    scene_state.model_version = world_version_;
+
+    SceneNode::update(scene_state);
+
+    scene_state.model_matrix = saved;
+    scene_state.model_version = saved_version;
+}
+
+void TransformNode::compile(RenderQueue &queue)
+{
+    queue.push_transform(this);
+    compile_children(queue);
+    queue.pop_transform();
+}
 
 } // namespace cg
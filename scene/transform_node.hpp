@@ -22,6 +22,13 @@ namespace cg
 /**
  * Transform node. Applies a transformation. This class allows OpenGL style
  * transforms applied to the scene graph.
+ *
+ * The node caches its local matrix and its world matrix (the enclosing
+ * model matrix times the local matrix). Each change to the transform
+ * increments a version, and each world matrix computed gets a new version
+ * passed to the children in SceneState::model_version. The world matrix is
+ * recomputed only when the local transform or the enclosing world matrix
+ * changed, so clean subtrees reuse their cached matrices.
  */
 class TransformNode : public SceneNode
 {
@@ -56,6 +63,12 @@ class TransformNode : public SceneNode
      */
     void rotate(float deg, Vector3 &v);
 
+    /**
+     * Apply a rotation given as a unit quaternion.
+     * @param  q  Rotation.
+     */
+    void rotate(const Quaternion &q);
+
     /**
      * Apply rotation about the x axis.
      * @param  deg  Degrees counter-clockwise rotation.
@@ -82,6 +95,47 @@ class TransformNode : public SceneNode
      */
     void scale(float x, float y, float z);
 
+    /**
+     * Get the transformation matrix. The matrix is rebuilt only if the
+     * transform changed since the last call.
+     * @return  Returns the composite transformation matrix.
+     */
+    const Matrix4x4 &get_matrix();
+
+    /**
+     * Get the version of the local transform. Incremented by every change.
+     * @return  Returns the local transform version.
+     */
+    uint64_t get_version() const;
+
+    /**
+     * Update the world matrix if the local transform or the parent world
+     * matrix changed since the last update.
+     * @param  parent          World matrix of the enclosing transforms.
+     * @param  parent_version  Version of the parent world matrix.
+     * @return  Returns true if the world matrix was recomputed.
+     */
+    bool update_world(const Matrix4x4 &parent, uint64_t parent_version);
+
+    /**
+     * Get the world matrix from the last update_world (or draw / update).
+     * @return  Returns the world matrix.
+     */
+    const Matrix4x4 &get_world_matrix() const;
+
+    /**
+     * Get the version of the world matrix. Unique across all transform nodes.
+     * @return  Returns the world matrix version.
+     */
+    uint64_t get_world_version() const;
+
+    /**
+     * Get a new world matrix version. Used by code other than transform
+     * nodes that sets SceneState::model_matrix.
+     * @return  Returns a version not used by any other world matrix.
+     */
+    static uint64_t next_world_version();
+
     /**
      * Draw this transformation node and its children
      * @param  scene_state   Current scene state
@@ -94,8 +148,46 @@ class TransformNode : public SceneNode
      */
     void update(SceneState &scene_state) override;
 
+    /**
+     * Compile this transformation node and its children. The queue keeps a
+     * reference to the node and refreshes the compiled matrix when the
+     * transform changes, without recompiling.
+     * @param  queue  Render queue being compiled
+     */
+    void compile(RenderQueue &queue) override;
+
   protected:
-    // Student to complete - Module 4.
+    // The transform is base_ * T(translation_) * R(rotation_) * S(scale_).
+    // Translations, rotations and scales are folded into the T R S factors
+    // so composing rotations is a quaternion product rather than a 4x4
+    // multiply. base_ only holds a prefix when a rotation follows a
+    // non-uniform scale (which T R S cannot represent).
+    Matrix4x4  base_;
+    bool       has_base_;
+    Vector3    translation_;
+    Quaternion rotation_;
+    Vector3    scale_;
+
+    // Composite matrix, rebuilt on demand
+    Matrix4x4 matrix_;
+    bool      matrix_dirty_;
+    uint64_t  version_; // Local transform version
+
+    // World matrix and the versions it was computed from
+    Matrix4x4 world_;
+    uint64_t  world_version_;
+    uint64_t  world_parent_version_;
+    uint64_t  world_local_version_;
+
+    /**
+     * Mark the local transform as changed.
+     */
+    void touch();
+
+    /**
+     * Fold the current T R S factors into base_ and reset them.
+     */
+    void flush();
 };
 
 } // namespace cg
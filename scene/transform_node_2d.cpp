@@ -0,0 +1,108 @@
+#include "scene/transform_node_2d.hpp"
+
+namespace cg
+{
+
+TransformNode2D::TransformNode2D() :
+    version_(0),
+    world_version_(0),
+    world_parent_version_(UINT64_MAX),
+    world_local_version_(UINT64_MAX)
+{
+    node_type_ = SceneNodeType::TRANSFORM;
+    load_identity();
+}
+
+TransformNode2D::~TransformNode2D() {}
+
+void TransformNode2D::load_identity()
+{
+    matrix_.set_identity();
+    ++version_;
+    scene_changed();
+}
+
+void TransformNode2D::translate(float x, float y)
+{
+    matrix_.translate(x, y);
+    ++version_;
+    scene_changed();
+}
+
+void TransformNode2D::rotate(float deg)
+{
+    matrix_.rotate(deg);
+    ++version_;
+    scene_changed();
+}
+
+void TransformNode2D::scale(float x, float y)
+{
+    matrix_.scale(x, y);
+    ++version_;
+    scene_changed();
+}
+
+const Matrix3x2 &TransformNode2D::get_matrix() const { return matrix_; }
+
+void TransformNode2D::update_world(const Matrix4x4 &parent, uint64_t parent_version)
+{
+    if(parent_version == world_parent_version_ && version_ == world_local_version_) return;
+
+    world_ = parent * matrix_.get_matrix4x4();
+    world_version_ = TransformNode::next_world_version();
+    world_parent_version_ = parent_version;
+    world_local_version_ = version_;
+}
+
+void TransformNode2D::draw(SceneState &scene_state)
+{
+    // Apply this transform to the model matrix for the children
+    Matrix4x4 saved = scene_state.model_matrix;
+    uint64_t  saved_version = scene_state.model_version;
+    update_world(saved, saved_version);
+    scene_state.model_matrix = world_;
+    scene_state.model_version = world_version_;
+    if(scene_state.model_matrix_loc != -1)
+    {
+        glUniformMatrix4fv(
+            scene_state.model_matrix_loc, 1, GL_FALSE, scene_state.model_matrix.get());
+    }
+
+    // Draw all children
+    SceneNode::draw(scene_state);
+
+    // Restore the model matrix
+    scene_state.model_matrix = saved;
+    scene_state.model_version = saved_version;
+    if(scene_state.model_matrix_loc != -1)
+    {
+        glUniformMatrix4fv(scene_state.model_matrix_loc, 1, GL_FALSE, saved.get());
+    }
+}
+
+void TransformNode2D::update(SceneState &scene_state)
+{
+    // Propagate the world matrix to the children
+    Matrix4x4 saved = scene_state.model_matrix;
+    uint64_t  saved_version = scene_state.model_version;
+    update_world(saved, saved_version);
+    scene_state.model_matrix = world_;
+    scene_state.model_version = world_version_;
+
+    SceneNode::update(scene_state);
+
+    scene_state.model_matrix = saved;
+    scene_state.model_version = saved_version;
+}
+
+void TransformNode2D::compile(RenderQueue &queue)
+{
+    // Compiled matrices are 4x4, so the 2-D transform composes with any
+    // enclosing 3-D transforms
+    queue.push_transform(matrix_.get_matrix4x4());
+    compile_children(queue);
+    queue.pop_transform();
+}
+
+} // namespace cg
@@ -0,0 +1,113 @@
+//============================================================================
+//	Johns Hopkins University Engineering Programs for Professionals
+//	605.667 Computer Graphics and 605.767 Applied Computer Graphics
+//	Instructor:	Brian Russin
+//
+//	Author:	 Kyle Meyer
+//	File:    transform_node_2d.hpp
+//	Purpose: Scene graph 2-D transformation node.
+//
+//============================================================================
+
+#ifndef __SCENE_TRANSFORM_NODE_2D_HPP__
+#define __SCENE_TRANSFORM_NODE_2D_HPP__
+
+#include "scene/scene_node.hpp"
+#include "scene/transform_node.hpp"
+
+#include "geometry/geometry.hpp"
+
+namespace cg
+{
+
+/**
+ * 2-D transform node. Applies a 2-D affine transformation held as a
+ * Matrix3x2, so the translate, rotate and scale operations are done in 3x2
+ * form. The matrix is expanded to a 4x4 when composed with the enclosing
+ * model matrix, so 2-D nodes nest under 3-D transform nodes and draw the
+ * same as in a compiled render queue. Like TransformNode, the composed
+ * matrix is cached until this node or the enclosing model matrix changes.
+ */
+class TransformNode2D : public SceneNode
+{
+  public:
+    /**
+     * Constructor.
+     */
+    TransformNode2D();
+
+    /**
+     * Destructor.
+     */
+    virtual ~TransformNode2D();
+
+    /**
+     * Set the identity matrix
+     */
+    void load_identity();
+
+    /**
+     * Apply a translation
+     * @param  x  x translation
+     * @param  y  y translation
+     */
+    void translate(float x, float y);
+
+    /**
+     * Apply a rotation.
+     * @param  deg  Degrees counter-clockwise rotation.
+     */
+    void rotate(float deg);
+
+    /**
+     * Apply a scaling.
+     * @param  x  x scaling factor
+     * @param  y  y scaling factor
+     */
+    void scale(float x, float y);
+
+    /**
+     * Get the transformation matrix.
+     * @return  Returns the transformation matrix.
+     */
+    const Matrix3x2 &get_matrix() const;
+
+    /**
+     * Draw this transformation node and its children
+     * @param  scene_state   Current scene state
+     */
+    void draw(SceneState &scene_state) override;
+
+    /**
+     * Update the scene node and its children
+     * @param  scene_state   Current scene state
+     */
+    void update(SceneState &scene_state) override;
+
+    /**
+     * Compile this transformation node and its children
+     * @param  queue  Render queue being compiled
+     */
+    void compile(RenderQueue &queue) override;
+
+  protected:
+    Matrix3x2 matrix_;
+    uint64_t  version_; // Local transform version
+
+    // World matrix and the versions it was computed from
+    Matrix4x4 world_;
+    uint64_t  world_version_;
+    uint64_t  world_parent_version_;
+    uint64_t  world_local_version_;
+
+    /**
+     * Recompute the world matrix if the parent frame or this node changed.
+     * @param  parent          Model matrix of the parent frame.
+     * @param  parent_version  Version of the parent model matrix.
+     */
+    void update_world(const Matrix4x4 &parent, uint64_t parent_version);
+};
+
+} // namespace cg
+
+#endif